@@ -28,10 +28,16 @@
 #include <fstream>
 #include <iomanip>
 #include <iostream>
+#include <iterator>
 #include <memory>
+#include <set>
 #include <sstream>
 #include <string>
 
+#if ADDKERNELS_USE_BZIP2
+#include <bzlib.h>
+#endif
+
 void Bin2Hex(std::istream& source,
              std::ostream& target,
              const std::string& variable,
@@ -106,6 +112,11 @@ void PrintHelp()
     std::cout << "           -m[ark-includes] : mark variables that represent include files with "
                  "'_INCLUDE'. Default: off"
               << std::endl;
+    std::cout << "           -d[epfile] <path>: write the files the target depends on in the "
+                 "Makefile format. Default: none"
+              << std::endl;
+    std::cout << "           -c[ompress] : compress the contents with bzip2. Default: off"
+              << std::endl;
 }
 
 [[gnu::noreturn]] void WrongUsage(const std::string& error)
@@ -124,13 +135,42 @@ void PrintHelp()
     WrongUsage(ss.str());
 }
 
+std::string Compress(const std::string& source, const std::string& sourcePath)
+{
+#if ADDKERNELS_USE_BZIP2
+    // bzip2 output never exceeds the input by more than 1% plus 600 bytes.
+    std::string result(source.size() + source.size() / 100 + 600, '\0');
+    auto size   = static_cast<unsigned int>(result.size());
+    // NOLINTNEXTLINE (cppcoreguidelines-pro-type-const-cast)
+    auto* input = const_cast<char*>(source.data());
+    const auto status =
+        BZ2_bzBuffToBuffCompress(&result[0], &size, input, source.size(), 9, 0, 30);
+    if(status != BZ_OK)
+    {
+        std::cerr << "Failed to compress " << sourcePath << ": bzip2 error " << status
+                  << std::endl;
+        // NOLINTNEXTLINE (concurrency-mt-unsafe)
+        std::exit(1);
+    }
+    result.resize(size);
+    return result;
+#else
+    (void)source;
+    std::cerr << "Failed to compress " << sourcePath << ": built without bzip2" << std::endl;
+    // NOLINTNEXTLINE (concurrency-mt-unsafe)
+    std::exit(1);
+#endif
+}
+
 void Process(const std::string& sourcePath,
              std::ostream& target,
              size_t bufferSize,
              size_t lineSize,
              bool recurse,
              bool as_extern,
-             bool mark_includes)
+             bool mark_includes,
+             bool compress,
+             std::set<std::string>& dependencies)
 {
     std::string fileName(sourcePath);
     std::string extension, root;
@@ -190,8 +230,28 @@ void Process(const std::string& sourcePath,
             std::exit(1);
         }
 
+        const auto& inlined = inliner.GetDependencies();
+        dependencies.insert(inlined.begin(), inlined.end());
         source = &inlinerTemp;
     }
+    else
+    {
+        dependencies.insert(sourcePath);
+    }
+
+    // Compressed sources are unpacked by the library on first use, so only the sources that
+    // are actually compiled take memory at run time.
+    std::istringstream packed;
+    std::size_t unpacked_size = 0;
+    if(compress)
+    {
+        const std::string contents{std::istreambuf_iterator<char>{*source},
+                                   std::istreambuf_iterator<char>{}};
+        // An empty source is stored as is, as a zero size marks the data as not compressed.
+        unpacked_size = contents.size();
+        packed.str(contents.empty() ? contents : Compress(contents, sourcePath));
+        source = &packed;
+    }
 
     std::transform(variable.begin(), variable.end(), variable.begin(), ::toupper);
 
@@ -204,6 +264,61 @@ void Process(const std::string& sourcePath,
     }
 
     Bin2Hex(*source, target, variable, true, bufferSize, lineSize);
+
+    // Zero means that the contents are stored as is.
+    if(variable.length() != 0)
+    {
+        target << "extern const size_t " << variable << "_UNPACKED_SIZE;" << std::endl;
+        target << "const size_t " << variable << "_UNPACKED_SIZE = " << std::setbase(10)
+               << unpacked_size << ";" << std::endl;
+    }
+}
+
+/// Rewrites the file only when the contents change. This keeps its timestamp, so a kernel
+/// batch is not recompiled when none of its sources have changed.
+void WriteIfChanged(const std::string& path, const std::string& contents)
+{
+    {
+        std::ifstream existing(path, std::ios::in | std::ios::binary);
+        const std::string old_contents{std::istreambuf_iterator<char>{existing},
+                                       std::istreambuf_iterator<char>{}};
+        if(existing.is_open() && old_contents == contents)
+            return;
+    }
+    std::ofstream file(path, std::ios::out | std::ios::binary);
+    file << contents;
+    if(!file.good())
+    {
+        std::cerr << "Failed to write " << path << std::endl;
+        // NOLINTNEXTLINE (concurrency-mt-unsafe)
+        std::exit(1);
+    }
+}
+
+std::string EscapeForMake(const std::string& path)
+{
+    std::string result;
+    for(const auto c : path)
+    {
+        if(c == ' ' || c == '#')
+            result += '\\';
+        else if(c == '$')
+            result += '$';
+        result += c;
+    }
+    return result;
+}
+
+void WriteDepfile(const std::string& path,
+                  const std::string& target,
+                  const std::set<std::string>& dependencies)
+{
+    std::ostringstream ss;
+    ss << EscapeForMake(target) << ":";
+    for(const auto& dependency : dependencies)
+        ss << " \\" << std::endl << "  " << EscapeForMake(dependency);
+    ss << std::endl;
+    WriteIfChanged(path, ss.str());
 }
 
 int main(int argsn, char** args)
@@ -218,11 +333,13 @@ int main(int argsn, char** args)
     size_t bufferSize = 512;
     size_t lineSize   = 16;
 
-    std::ofstream targetFile;
-    std::ostream* target = &std::cout;
-    bool recurse         = true;
-    bool as_extern       = false;
-    bool mark_includes   = false;
+    std::string targetPath;
+    std::string depfilePath;
+    std::ostringstream target;
+    bool recurse       = true;
+    bool as_extern     = false;
+    bool mark_includes = false;
+    bool compress      = false;
 
     int i = 0;
     while(++i < argsn && **args != '-')
@@ -232,34 +349,52 @@ int main(int argsn, char** args)
 
         if(arg == "s" || arg == "source")
         {
+            std::set<std::string> dependencies;
+
             if(guard.length() > 0)
             {
-                *target << "#ifndef " << guard << std::endl;
-                *target << "#define " << guard << std::endl;
+                target << "#ifndef " << guard << std::endl;
+                target << "#define " << guard << std::endl;
             }
 
-            *target << "#ifndef MIOPEN_USE_CLANG_TIDY" << std::endl;
-            *target << "#include <cstddef>" << std::endl;
+            target << "#ifndef MIOPEN_USE_CLANG_TIDY" << std::endl;
+            target << "#include <cstddef>" << std::endl;
 
             while(++i < argsn)
             {
-                Process(args[i], *target, bufferSize, lineSize, recurse, as_extern, mark_includes);
+                Process(args[i],
+                        target,
+                        bufferSize,
+                        lineSize,
+                        recurse,
+                        as_extern,
+                        mark_includes,
+                        compress,
+                        dependencies);
             }
 
-            *target << "#endif" << std::endl;
+            target << "#endif" << std::endl;
 
             if(guard.length() > 0)
             {
-                *target << "#endif" << std::endl;
+                target << "#endif" << std::endl;
+            }
+
+            if(targetPath.empty())
+            {
+                std::cout << target.str();
+            }
+            else
+            {
+                WriteIfChanged(targetPath, target.str());
+                if(!depfilePath.empty())
+                    WriteDepfile(depfilePath, targetPath, dependencies);
             }
 
             return 0;
         }
         else if(arg == "t" || arg == "target")
-        {
-            targetFile.open(args[++i], std::ios::out);
-            target = &targetFile;
-        }
+            targetPath = args[++i];
         else if(arg == "l" || arg == "line-size")
             lineSize = std::stol(args[++i]);
         else if(arg == "b" || arg == "buffer")
@@ -272,6 +407,10 @@ int main(int argsn, char** args)
             mark_includes = true;
         else if(arg == "e" || arg == "extern")
             as_extern = true;
+        else if(arg == "d" || arg == "depfile")
+            depfilePath = args[++i];
+        else if(arg == "c" || arg == "compress")
+            compress = true;
         else
             UnknownArgument(arg);
     }
@@ -24,6 +24,7 @@
  *
  *******************************************************************************/
 #include <algorithm>
+#include <cstring>
 #include <exception>
 #include <fstream>
 #include <sstream>
@@ -62,6 +63,7 @@ static std::string GetAbsolutePath(const std::string& path)
     if(retval == nullptr)
         return "";
 #endif
+    result.resize(std::strlen(result.c_str()));
     return result;
 }
 } // namespace PathHelpers
@@ -82,6 +84,9 @@ void IncludeInliner::Process(std::istream& input,
                              bool allow_angle_brackets,
                              bool recurse)
 {
+    const auto abs_file_path = PathHelpers::GetAbsolutePath(file_name);
+    if(!abs_file_path.empty())
+        _dependencies.insert(abs_file_path);
     ProcessCore(input, output, root, file_name, 0, directive, allow_angle_brackets, recurse);
 }
 
@@ -167,6 +172,8 @@ void IncludeInliner::ProcessCore(std::istream& input,
                 throw IncludeCantBeOpenedException(include_file_path,
                                                    GetIncludeStackTrace(current_line));
 
+            _dependencies.insert(abs_include_file_path);
+
             ProcessCore(include_file,
                         output,
                         root,
@@ -29,6 +29,7 @@
 #include "source_file_desc.hpp"
 #include <ostream>
 #include <memory>
+#include <set>
 #include <stack>
 
 class InlineException : public std::exception
@@ -124,10 +125,13 @@ public:
                  bool allow_angle_brackets,
                  bool recurse);
     std::string GetIncludeStackTrace(int line);
+    /// Absolute paths of all the files included so far.
+    const std::set<std::string>& GetDependencies() const { return _dependencies; }
 
 private:
     int _include_depth                                   = 0;
     std::shared_ptr<SourceFileDesc> _included_stack_head = nullptr;
+    std::set<std::string> _dependencies;
 
     void ProcessCore(std::istream& input,
                      std::ostream& output,
@@ -41,6 +41,7 @@
 #include <miopen/handle.hpp>
 #include <miopen/tensor.hpp>
 #include <numeric>
+#include <sstream>
 #include <vector>
 #include <cassert>
 #include "random.hpp"
@@ -119,6 +120,7 @@ public:
 
     int RunForwardGPU() override;
     int RunForwardCPU();
+    std::string GetVerificationCacheKey() const;
 
     int RunBackwardGPU() override { return 0; };
     int RunBackwardCPU() { return 0; };
@@ -267,6 +269,7 @@ template <typename Tgpu, typename Tref>
 int CBAInferFusionDriver<Tgpu, Tref>::ParseCmdLineArgs(int argc, char* argv[])
 {
     inflags.Parse(argc, argv);
+    verification_cache = VerificationCache::FromCmdLineArgs(inflags);
 
     if(inflags.GetValueInt("time") == 1)
     {
@@ -380,6 +383,7 @@ int CBAInferFusionDriver<Tgpu, Tref>::AddCmdLineArgs()
     inflags.AddInputFlag("gamma", 'G', "1", "Activation gamma (Default=1)", "double");
     inflags.AddInputFlag("iter", 'i', "1", "Number of Iterations (Default=1)", "int");
     inflags.AddInputFlag("verify", 'V', "1", "Verify Each Layer (Default=1)", "int");
+    VerificationCache::AddCmdLineArgs(inflags);
     inflags.AddInputFlag("time", 't', "0", "Time Each Layer (Default=0)", "int");
 
     /*inflags.AddInputFlag("printconv", 'P', "1", "Print Convolution Dimensions (Default=1)",
@@ -1151,10 +1155,42 @@ int CBAInferFusionDriver<Tgpu, Tref>::RunForwardCPU()
     return miopenStatusSuccess;
 }
 
+template <typename Tgpu, typename Tref>
+std::string CBAInferFusionDriver<Tgpu, Tref>::GetVerificationCacheKey() const
+{
+    std::ostringstream ss;
+    ss << fusion_mode << "_" << bias_mode << "_" << bn_mode;
+    ss << "_" << VerificationCache::GetTensorKey(inputTensor);
+    ss << "_" << VerificationCache::GetTensorKey(outputTensor);
+    if(fusion_mode != miopen_fusion_na)
+    {
+        miopenConvolutionMode_t mode;
+        int pad_h, pad_w, stride_h, stride_w, dilation_h, dilation_w;
+        miopenGetConvolutionDescriptor(
+            convDesc, &mode, &pad_h, &pad_w, &stride_h, &stride_w, &dilation_h, &dilation_w);
+        ss << "_" << VerificationCache::GetTensorKey(weightTensor);
+        ss << "_" << mode << "_" << pad_h << "x" << pad_w << "_" << stride_h << "x" << stride_w
+           << "_" << dilation_h << "x" << dilation_w;
+    }
+    if(fusion_mode != miopen_fusion_cb && fusion_mode != miopen_fusion_cn)
+    {
+        miopenActivationMode_t mode;
+        double alpha, beta, gamma;
+        miopenGetActivationDescriptor(activDesc, &mode, &alpha, &beta, &gamma);
+        ss << "_" << mode << "_" << alpha << "_" << beta << "_" << gamma;
+    }
+    return ss.str();
+}
+
 template <typename Tgpu, typename Tref>
 int CBAInferFusionDriver<Tgpu, Tref>::VerifyForward()
 {
-    RunForwardCPU();
+    const auto key = GetVerificationCacheKey();
+    if(!verification_cache.Read("cba_infer_fwd_out", key, out_host))
+    {
+        RunForwardCPU();
+        verification_cache.Save("cba_infer_fwd_out", key, out_host);
+    }
 
     double allowedEps = std::numeric_limits<Tgpu>::epsilon() * 80;
 
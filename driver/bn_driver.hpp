@@ -29,17 +29,18 @@
 #include "../test/verify.hpp"
 #include "InputFlags.hpp"
 #include "driver.hpp"
-#include "miopen_BatchNormHost.hpp"
 #include "timer.hpp"
 #include <algorithm>
 #include <cmath>
 #include <cstdlib>
 #include <float.h>
 #include <memory>
+#include <miopen/batchnorm/host.hpp>
 #include <miopen/miopen.h>
 #include <miopen/handle.hpp>
 #include <miopen/tensor.hpp>
 #include <numeric>
+#include <sstream>
 #include <vector>
 #include "random.hpp"
 
@@ -96,6 +97,10 @@ public:
     int RunBackwardGPU() override;
     int RunBackwardCPU();
 
+    std::string GetVerificationCacheKey() const;
+    std::vector<std::pair<std::string, std::vector<Tref>*>> GetVerificationBuffers();
+    void RunCPUOrReadVerificationCache();
+
     void runGPUFwdInference(Tref epsilon, float alpha, float beta);
     void runGPUFwdTrain(Tref epsilon, Tref eAF, float alpha, float beta);
     void runGPUBwd(Tref epsilon, float alpha, float beta);
@@ -190,6 +195,7 @@ template <typename Tgpu, typename Tref, typename Tmix>
 int BatchNormDriver<Tgpu, Tref, Tmix>::ParseCmdLineArgs(int argc, char* argv[])
 {
     inflags.Parse(argc, argv);
+    verification_cache = VerificationCache::FromCmdLineArgs(inflags);
 
     if(inflags.GetValueInt("time") == 1)
     {
@@ -270,6 +276,7 @@ int BatchNormDriver<Tgpu, Tref, Tmix>::AddCmdLineArgs()
     inflags.AddInputFlag("beta", 'B', "0.", "Beta (Default=0.)", "float");
     inflags.AddInputFlag("iter", 'i', "1", "Number of Iterations (Default=1)", "int");
     inflags.AddInputFlag("verify", 'V', "1", "Verify Each Layer (Default=1)", "int");
+    VerificationCache::AddCmdLineArgs(inflags);
     inflags.AddInputFlag("time", 't', "0", "Time Each Layer (Default=0)", "int");
     inflags.AddInputFlag("printconv", 'P', "1", "Print Convolution Dimensions (Default=1)", "int");
     inflags.AddInputFlag("mode",
@@ -569,10 +576,9 @@ int BatchNormDriver<Tgpu, Tref, Tmix>::AllocateBuffersAndCopy()
         bias_host  = std::vector<Tref>(sb_sz, static_cast<Tref>(0));
 
         // Data initialization
-        for(int i = 0; i < in_sz; i++)
-        {
-            in[i] = std::fabs(RAN_GEN<Tgpu>(static_cast<Tgpu>(0.0), static_cast<Tgpu>(1.0)));
-        }
+        prng::generate(in.data(), in_sz, [](std::size_t, double u) {
+            return std::fabs(prng::scale(u, static_cast<Tgpu>(0.0), static_cast<Tgpu>(1.0)));
+        });
         status |= in_dev->ToGPU(q, in.data());
 
         // Using random beta and gamma
@@ -633,11 +639,8 @@ int BatchNormDriver<Tgpu, Tref, Tmix>::AllocateBuffersAndCopy()
         status |= dscale_dev->ToGPU(q, dscale.data());
         status |= dbias_dev->ToGPU(q, dbias.data());
 
-        for(int i = 0; i < in_sz; i++)
-        {
-            dyin[i] = RAN_GEN<Tgpu>(static_cast<Tgpu>(0.0), static_cast<Tgpu>(1.0));
-            in[i]   = RAN_GEN<Tgpu>(static_cast<Tgpu>(0.0), static_cast<Tgpu>(1.0));
-        }
+        prng::fill(dyin.data(), in_sz, static_cast<Tgpu>(0.0), static_cast<Tgpu>(1.0));
+        prng::fill(in.data(), in_sz, static_cast<Tgpu>(0.0), static_cast<Tgpu>(1.0));
         status |= dyin_dev->ToGPU(q, dyin.data());
         status |= in_dev->ToGPU(q, in.data());
         status |= dxout_dev->ToGPU(q, dxout.data());
@@ -1164,6 +1167,63 @@ int BatchNormDriver<Tgpu, Tref, Tmix>::RunBackwardGPU()
     return miopenStatusSuccess;
 }
 
+template <typename Tgpu, typename Tref, typename Tmix>
+std::string BatchNormDriver<Tgpu, Tref, Tmix>::GetVerificationCacheKey() const
+{
+    std::ostringstream ss;
+    ss << VerificationCache::GetTensorKey(inputTensor);
+    ss << "_" << bn_mode << "_" << forw << "_" << back;
+    ss << "_" << saveMeanVar << "_" << keepRunningMeanVar;
+    ss << "_" << inflags.GetValueInt("iter");
+    ss << "_" << VerificationCache::GetTypeName<Tgpu>();
+    ss << "_" << VerificationCache::GetTypeName<Tmix>();
+    return ss.str();
+}
+
+// The buffers filled by the host reference of the selected direction and mode.
+template <typename Tgpu, typename Tref, typename Tmix>
+std::vector<std::pair<std::string, std::vector<Tref>*>>
+BatchNormDriver<Tgpu, Tref, Tmix>::GetVerificationBuffers()
+{
+    if(back)
+        return {{"bn_bwd_dx", &dxout_host},
+                {"bn_bwd_dscale", &dscale_host},
+                {"bn_bwd_dbias", &dbias_host}};
+
+    std::vector<std::pair<std::string, std::vector<Tref>*>> buffers = {{"bn_fwd_out", &out_host}};
+    if(forw == 1 && keepRunningMeanVar)
+    {
+        buffers.emplace_back("bn_fwd_running_mean", &runningMean_host);
+        buffers.emplace_back("bn_fwd_running_var", &runningVariance_host);
+    }
+    if(forw == 1 && saveMeanVar)
+    {
+        buffers.emplace_back("bn_fwd_saved_mean", &saveMean_host);
+        buffers.emplace_back("bn_fwd_saved_inv_var", &saveInvVariance_host);
+    }
+    return buffers;
+}
+
+template <typename Tgpu, typename Tref, typename Tmix>
+void BatchNormDriver<Tgpu, Tref, Tmix>::RunCPUOrReadVerificationCache()
+{
+    const auto key     = GetVerificationCacheKey();
+    const auto buffers = GetVerificationBuffers();
+    const auto cached  = std::all_of(buffers.begin(), buffers.end(), [&](const auto& buffer) {
+        return verification_cache.Read(buffer.first, key, *buffer.second);
+    });
+    if(cached)
+        return;
+
+    if(back)
+        RunBackwardCPU();
+    else
+        RunForwardCPU();
+
+    for(const auto& buffer : buffers)
+        verification_cache.Save(buffer.first, key, *buffer.second);
+}
+
 template <typename Tgpu, typename Tref, typename Tmix>
 int BatchNormDriver<Tgpu, Tref, Tmix>::VerifyForward()
 {
@@ -1181,7 +1241,7 @@ int BatchNormDriver<Tgpu, Tref, Tmix>::VerifyForward()
 
     bool anError = false;
 
-    RunForwardCPU();
+    RunCPUOrReadVerificationCache();
 
     if(forw == 1)
     {
@@ -1453,7 +1513,7 @@ int BatchNormDriver<Tgpu, Tref, Tmix>::VerifyBackward()
     const Tref maxrms = static_cast<Tref>(((sizeof(Tgpu) == 4) ? RMSTOL_FP32 : RMSTOL_FP16) * 1000);
     bool anError      = false;
 
-    RunBackwardCPU();
+    RunCPUOrReadVerificationCache();
 
     dxout_dev->FromGPU(GetStream(), dxout.data());
     dscale_dev->FromGPU(GetStream(), dscale.data());
@@ -29,6 +29,7 @@
 
 #include <cmath>
 #include <cstdint>
+#include <cstring>
 
 // This works well when difference is small. When one value
 // is 0 and another is not, result is incorrect (very big)
@@ -38,25 +39,22 @@
 template <typename T_>
 float ApproxUlps(T_ c_val, T_ g_val)
 {
+    // The bits are read with memcpy, which compilers turn into plain loads.
+    const auto bits_diff = [&](auto bits) {
+        auto c_bits = bits;
+        auto g_bits = bits;
+        std::memcpy(&c_bits, &c_val, sizeof(bits));
+        std::memcpy(&g_bits, &g_val, sizeof(bits));
+        return std::abs(static_cast<double>(c_bits) - static_cast<double>(g_bits));
+    };
+
     double err = -1.0;
-    if(sizeof(T_) == 2)
-    {
-        int16_t* c_uval = reinterpret_cast<int16_t*>(&c_val);
-        int16_t* g_uval = reinterpret_cast<int16_t*>(&g_val);
-        err             = static_cast<double>(std::abs(*c_uval - *g_uval));
-    }
-    else if(sizeof(T_) == 4)
-    {
-        int32_t* c_uval = reinterpret_cast<int32_t*>(&c_val);
-        int32_t* g_uval = reinterpret_cast<int32_t*>(&g_val);
-        err             = static_cast<double>(std::abs(*c_uval - *g_uval));
-    }
-    else if(sizeof(T_) == 8)
-    {
-        int64_t* c_uval = reinterpret_cast<int64_t*>(&c_val);
-        int64_t* g_uval = reinterpret_cast<int64_t*>(&g_val);
-        err             = static_cast<double>(std::abs(*c_uval - *g_uval));
-    }
+    if constexpr(sizeof(T_) == 2)
+        err = bits_diff(int16_t{});
+    else if constexpr(sizeof(T_) == 4)
+        err = bits_diff(int32_t{});
+    else if constexpr(sizeof(T_) == 8)
+        err = bits_diff(int64_t{});
 
     // double delta = abs(c_val - g_val);
     // double nextafter_delta = nextafterf(min(abs(c_val), abs(g_val)), (T_)INFINITY) -
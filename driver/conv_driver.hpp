@@ -394,13 +394,14 @@ private:
         BwdBias
     };
 
-    std::string GetVerificationCacheFileName(const Direction& direction) const;
+    static std::string GetVerificationCacheOperation(const Direction& direction);
+    std::string GetVerificationCacheKey() const;
     bool IsInputTensorTransform() const;
 
     bool TryReadVerificationCache(const Direction& direction,
                                   miopenTensorDescriptor_t& tensorDesc,
                                   Tref* data) const;
-    void TrySaveVerificationCache(const Direction& direction, std::vector<Tref>& data) const;
+    void TrySaveVerificationCache(const Direction& direction, const std::vector<Tref>& data) const;
 
     void ResizeWorkspaceDev(context_t ctx, std::size_t size)
     {
@@ -453,6 +454,7 @@ int ConvDriver<Tgpu, Tref>::ParseCmdLineArgs(int argc, char* argv[])
 {
 
     inflags.Parse(argc, argv);
+    verification_cache = VerificationCache::FromCmdLineArgs(inflags);
 
     // try to set a default layout value for 3d conv if not specified from cmd line
     int spatial_dim = inflags.GetValueInt("spatial_dim");
@@ -766,11 +768,7 @@ int ConvDriver<Tgpu, Tref>::AddCmdLineArgs()
         "trans_output_pad_w", 'X', "0", "Zero Padding Output for Width (Default=0)", "int");
     inflags.AddInputFlag("iter", 'i', "10", "Number of Iterations (Default=10)", "int");
     inflags.AddInputFlag("verify", 'V', "1", "Verify Each Layer (Default=1)", "int");
-    inflags.AddInputFlag("verification_cache",
-                         'C',
-                         "",
-                         "Use specified directory to cache verification data. Off by default.",
-                         "string");
+    VerificationCache::AddCmdLineArgs(inflags);
     inflags.AddInputFlag("time", 't', "0", "Time Each Layer (Default=0)", "int");
     inflags.AddInputFlag("wall",
                          'w',
@@ -1073,17 +1071,17 @@ std::vector<int> ConvDriver<Tgpu, Tref>::GetOutputTensorLengths()
 namespace detail {
 
 template <typename T>
-T RanGenWeights()
+T RanGenWeights(double u)
 {
-    return RAN_GEN<T>(static_cast<T>(-0.5), static_cast<T>(0.5));
+    return prng::scale<T>(u, static_cast<T>(-0.5), static_cast<T>(0.5));
 }
 
 // Shift FP16 distribution towards positive numbers,
 // otherwise Winograd FP16 validation fails.
 template <>
-float16 RanGenWeights()
+float16 RanGenWeights(double u)
 {
-    return RAN_GEN<float16>(static_cast<float16>(-1.0 / 3.0), static_cast<float16>(0.5));
+    return prng::scale<float16>(u, static_cast<float16>(-1.0 / 3.0), static_cast<float16>(0.5));
 }
 
 } // namespace detail
@@ -1306,7 +1304,7 @@ int ConvDriver<Tgpu, Tref>::AllocateBuffersAndCopy()
 
     /* Unless seed is persistent between runs validation using cache stored in file is impossible.
      */
-    srand(0);
+    prng::reset_seed();
 
     bool dataRead = false;
     if(is_fwd || is_wrw)
@@ -1324,19 +1322,16 @@ int ConvDriver<Tgpu, Tref>::AllocateBuffersAndCopy()
 
         if(!dataRead)
         {
-            for(int i = 0; i < in_sz; i++)
-            {
-                if(is_fwd || is_wrw)
-                    in.data[i] =
-                        static_cast<Tgpu>(Data_scale * RAN_GEN<float>(static_cast<float>(0.0),
-                                                                      static_cast<float>(1.0)));
-                else /// \anchor move_rand
-                    /// Move rand() forward, even if buffer is unused. This provides the same
-                    /// initialization of input buffers regardless of which kinds of
-                    /// convolutions are currently selectedfor testing (see the "-F" option).
-                    /// Verification cache would be broken otherwise.
-                    GET_RAND();
-            }
+            if(is_fwd || is_wrw)
+                prng::generate(in.data.data(), in_sz, [=](std::size_t, double u) {
+                    return static_cast<Tgpu>(Data_scale * prng::scale(u, 0.0f, 1.0f));
+                });
+            else /// \anchor move_rand
+                /// Move the random stream forward, even if buffer is unused. This provides the
+                /// same initialization of input buffers regardless of which kinds of
+                /// convolutions are currently selectedfor testing (see the "-F" option).
+                /// Verification cache would be broken otherwise.
+                prng::skip(in_sz);
         }
 
         if(inflags.GetValueInt("bias") != 0)
@@ -1344,11 +1339,9 @@ int ConvDriver<Tgpu, Tref>::AllocateBuffersAndCopy()
             size_t b_sz = GetTensorSize(biasTensor);
             b_dev       = std::unique_ptr<GPUMem>(new GPUMem(ctx, b_sz, sizeof(float)));
             b_int8      = std::vector<float>(b_sz, static_cast<float>(0));
-            for(int i = 0; i < b_sz; i++)
-            {
-                b_int8[i] = static_cast<float>(i % 8) +
-                            RAN_GEN<float>(static_cast<float>(0.0), static_cast<float>(1.0));
-            }
+            prng::generate(b_int8.data(), b_sz, [](std::size_t i, double u) {
+                return static_cast<float>(i % 8) + prng::scale(u, 0.0f, 1.0f);
+            });
 
             if(!biasFileName.empty())
             {
@@ -1360,12 +1353,12 @@ int ConvDriver<Tgpu, Tref>::AllocateBuffersAndCopy()
 
         if(!weiRead)
         {
-            for(int i = 0; i < wei_sz; i++)
-                if(is_fwd || is_bwd)
-                    wei.data[i] =
-                        static_cast<Tgpu>(Data_scale * 2 * detail::RanGenWeights<float>());
-                else /// \ref move_rand
-                    GET_RAND();
+            if(is_fwd || is_bwd)
+                prng::generate(wei.data.data(), wei_sz, [=](std::size_t, double u) {
+                    return static_cast<Tgpu>(Data_scale * 2 * detail::RanGenWeights<float>(u));
+                });
+            else /// \ref move_rand
+                prng::skip(wei_sz);
         }
     }
     else
@@ -1379,24 +1372,18 @@ int ConvDriver<Tgpu, Tref>::AllocateBuffersAndCopy()
 
         if(!dataRead)
         {
-            for(int i = 0; i < in_sz; i++)
-            {
-                if(is_fwd || is_wrw)
-                    in.data[i] =
-                        Data_scale * RAN_GEN<Tgpu>(static_cast<Tgpu>(0.0), static_cast<Tgpu>(1.0));
-                else /// \ref move_rand
-                    GET_RAND();
-            }
+            if(is_fwd || is_wrw)
+                prng::fill(in.data.data(), in_sz, static_cast<Tgpu>(0.0), Data_scale);
+            else /// \ref move_rand
+                prng::skip(in_sz);
         }
 
         if(!doutRead)
         {
-            for(int i = 0; i < out_sz; i++)
-                if(is_bwd || is_wrw)
-                    dout.data[i] =
-                        Data_scale * RAN_GEN<Tgpu>(static_cast<Tgpu>(0.0), static_cast<Tgpu>(1.0));
-                else /// \ref move_rand
-                    GET_RAND();
+            if(is_bwd || is_wrw)
+                prng::fill(dout.data.data(), out_sz, static_cast<Tgpu>(0.0), Data_scale);
+            else /// \ref move_rand
+                prng::skip(out_sz);
         }
 
         if(inflags.GetValueInt("bias") != 0)
@@ -1407,13 +1394,12 @@ int ConvDriver<Tgpu, Tref>::AllocateBuffersAndCopy()
             b           = tensor<Tgpu>(miopen::deref(biasTensor));
             db          = std::vector<Tgpu>(b_sz, static_cast<Tgpu>(0));
             db_host     = tensor<Tref>(miopen::deref(biasTensor));
-            for(int i = 0; i < b_sz; i++)
-            {
-                b.data[i] = static_cast<Tgpu>(i % 8) +
-                            RAN_GEN<Tgpu>(static_cast<Tgpu>(0.0), static_cast<Tgpu>(1.0));
-                db[i] = static_cast<Tgpu>(i % 8) +
-                        RAN_GEN<Tgpu>(static_cast<Tgpu>(0.0), static_cast<Tgpu>(1.0));
-            }
+            const auto gen_bias = [](std::size_t i, double u) {
+                return static_cast<Tgpu>(i % 8) +
+                       prng::scale(u, static_cast<Tgpu>(0.0), static_cast<Tgpu>(1.0));
+            };
+            prng::generate(b.data.data(), b_sz, gen_bias);
+            prng::generate(db.data(), b_sz, gen_bias);
 
             if(!biasFileName.empty())
             {
@@ -1426,11 +1412,12 @@ int ConvDriver<Tgpu, Tref>::AllocateBuffersAndCopy()
 
         if(!weiRead)
         {
-            for(int i = 0; i < wei_sz; i++)
-                if(is_fwd || is_bwd)
-                    wei.data[i] = Data_scale * detail::RanGenWeights<Tgpu>();
-                else /// \ref move_rand
-                    GET_RAND();
+            if(is_fwd || is_bwd)
+                prng::generate(wei.data.data(), wei_sz, [=](std::size_t, double u) {
+                    return Data_scale * detail::RanGenWeights<Tgpu>(u);
+                });
+            else /// \ref move_rand
+                prng::skip(wei_sz);
         }
     }
 
@@ -3192,8 +3179,21 @@ int ConvDriver<Tgpu, Tref>::RunBackwardDataGPUReference()
 }
 
 template <typename Tgpu, typename Tref>
-std::string ConvDriver<Tgpu, Tref>::GetVerificationCacheFileName(
-    const ConvDriver<Tgpu, Tref>::Direction& direction) const
+std::string ConvDriver<Tgpu, Tref>::GetVerificationCacheOperation(
+    const ConvDriver<Tgpu, Tref>::Direction& direction)
+{
+    switch(direction)
+    {
+    case Direction::Fwd: return "conv_fwd_out";
+    case Direction::Bwd: return "conv_bwd_dat";
+    case Direction::WrW: return "conv_bwd_wei";
+    case Direction::BwdBias: return "bias_bwd_dat";
+    }
+    return "<error in GetVerificationCacheOperation>"; // For gcc.
+}
+
+template <typename Tgpu, typename Tref>
+std::string ConvDriver<Tgpu, Tref>::GetVerificationCacheKey() const
 {
     std::ostringstream ss;
 
@@ -3214,46 +3214,7 @@ std::string ConvDriver<Tgpu, Tref>::GetVerificationCacheFileName(
                                      conv_dilations.data(),
                                      &mode);
 
-    auto get_basename_string = [&]() {
-        switch(direction)
-        {
-        case Direction::Fwd: return "conv_fwd_out";
-        case Direction::Bwd: return "conv_bwd_dat";
-        case Direction::WrW: return "conv_bwd_wei";
-        case Direction::BwdBias: return "bias_bwd_dat";
-        }
-        return "<error in get_basename_string>"; // For gcc.
-    };
-
-    auto get_datatype_string = [](auto type) {
-        if(std::is_same<decltype(type), int8_t>::value)
-        {
-            return "int8";
-        }
-        else if(std::is_same<decltype(type), float16>::value)
-        {
-            return "float16";
-        }
-        else if(std::is_same<decltype(type), float>::value)
-        {
-            return "float";
-        }
-        else if(std::is_same<decltype(type), double>::value)
-        {
-            return "double";
-        }
-        else if(std::is_same<decltype(type), bfloat16>::value)
-        {
-            return "bfloat16";
-        }
-        else
-        {
-            MIOPEN_THROW("unknown data type");
-        }
-    };
-
-    ss << get_basename_string();
-    ss << "_" << mode;
+    ss << mode;
     ss << "_" << spatial_dim;
     ss << "_" << miopen::deref(convDesc).paddingMode;
     ss << "_" << miopen::deref(convDesc).GetGroupCount();
@@ -3266,9 +3227,7 @@ std::string ConvDriver<Tgpu, Tref>::GetVerificationCacheFileName(
     ss << "_" << inflags.GetValueInt("pad_val");
     ss << "_" << inflags.GetValueInt("bias");
     ss << "_"
-       << "GPU" << get_datatype_string(Tgpu{});
-    ss << "_"
-       << "REF" << get_datatype_string(Tref{});
+       << "GPU" << VerificationCache::GetTypeName<Tgpu>();
 
     return ss.str();
 }
@@ -3279,36 +3238,18 @@ bool ConvDriver<Tgpu, Tref>::TryReadVerificationCache(
     miopenTensorDescriptor_t& tensorDesc,
     Tref* data) const
 {
-    const auto verification_cache_path = inflags.GetValueStr("verification_cache");
-
-    if(!verification_cache_path.empty())
-    {
-        const auto file_path =
-            verification_cache_path + "/" + GetVerificationCacheFileName(direction);
-
-        if(std::ifstream(file_path).good())
-        {
-            if(readBufferFromFile<Tref>(data, GetTensorSize(tensorDesc), file_path.c_str()))
-            {
-                return true;
-            }
-        }
-    }
-
-    return false;
+    return verification_cache.Read(GetVerificationCacheOperation(direction),
+                                   GetVerificationCacheKey(),
+                                   data,
+                                   GetTensorSize(tensorDesc));
 }
 
 template <typename Tgpu, typename Tref>
 void ConvDriver<Tgpu, Tref>::TrySaveVerificationCache(
-    const ConvDriver<Tgpu, Tref>::Direction& direction, std::vector<Tref>& data) const
+    const ConvDriver<Tgpu, Tref>::Direction& direction, const std::vector<Tref>& data) const
 {
-    const auto verification_cache_path = inflags.GetValueStr("verification_cache");
-    if(!verification_cache_path.empty())
-    {
-        const auto file_path =
-            verification_cache_path + "/" + GetVerificationCacheFileName(direction);
-        dumpBufferToFile<Tref>(file_path.c_str(), data.data(), data.size());
-    }
+    verification_cache.Save(
+        GetVerificationCacheOperation(direction), GetVerificationCacheKey(), data);
 }
 
 template <typename Tgpu, typename Tref>
@@ -74,6 +74,7 @@ public:
     int VerifyBackward() override;
 
     int RunCTCLossCPU();
+    std::string GetVerificationCacheKey() const;
 
     ~CTCDriver() override
     {
@@ -120,6 +121,7 @@ template <typename Tgpu, typename Tref>
 int CTCDriver<Tgpu, Tref>::ParseCmdLineArgs(int argc, char* argv[])
 {
     inflags.Parse(argc, argv);
+    verification_cache = VerificationCache::FromCmdLineArgs(inflags);
 
     if(inflags.GetValueInt("time") == 1)
     {
@@ -164,6 +166,7 @@ int CTCDriver<Tgpu, Tref>::AddCmdLineArgs()
     inflags.AddInputFlag("batchsize", 'n', "4", "Mini-batch size (Default=4)", "int");
     inflags.AddInputFlag("iter", 'i', "1", "Number of Iterations (Default=1)", "int");
     inflags.AddInputFlag("verify", 'V', "1", "Verify CTC losses and gradients (Default=1)", "int");
+    VerificationCache::AddCmdLineArgs(inflags);
     inflags.AddInputFlag("verify_path",
                          'v',
                          "1",
@@ -303,7 +306,7 @@ int CTCDriver<Tgpu, Tref>::AllocateBuffersAndCopy()
     workspace      = std::vector<Tgpu>(workSpaceSize / sizeof(Tgpu), 0);
     workspace_host = std::vector<Tref>(workSpaceSizeCPU / sizeof(Tref), 0);
 
-    srand(0);
+    prng::reset_seed();
     double scale = 0.01;
 
     for(int i = 0; i < probs_sz; i++)
@@ -428,11 +431,29 @@ int CTCDriver<Tgpu, Tref>::RunCTCLossCPU()
     return miopenStatusSuccess;
 }
 
+template <typename Tgpu, typename Tref>
+std::string CTCDriver<Tgpu, Tref>::GetVerificationCacheKey() const
+{
+    std::ostringstream ss;
+    ss << VerificationCache::GetTensorKey(probsDesc);
+    miopen::LogRange(ss << "_", labelLengths, "x");
+    miopen::LogRange(ss << "_", inputLengths, "x");
+    ss << "_" << num_class << "_" << blank_lb << "_" << apply_softmax;
+    ss << "_" << inflags.GetValueInt("verify_path");
+    ss << "_" << VerificationCache::GetTypeName<Tgpu>();
+    return ss.str();
+}
+
 template <typename Tgpu, typename Tref>
 int CTCDriver<Tgpu, Tref>::VerifyForward()
 {
+    const auto key = GetVerificationCacheKey();
+    if(!(verification_cache.Read("ctc_fwd_losses", key, losses_host) &&
+         verification_cache.Read("ctc_fwd_gradients", key, gradients_host)))
     {
         RunCTCLossCPU();
+        verification_cache.Save("ctc_fwd_losses", key, losses_host);
+        verification_cache.Save("ctc_fwd_gradients", key, gradients_host);
     }
 
     auto error1 = miopen::rms_range(losses_host, losses);
@@ -33,6 +33,7 @@
 using float16 = half_float::half;
 
 #include "InputFlags.hpp"
+#include "verification_cache.hpp"
 #include <algorithm>
 #include <cstdio>
 #include <cstdlib>
@@ -143,6 +144,8 @@ inline void PadBufferSize(size_t& sz, int datatype_sz)
            "pool[fp16], lrn[fp16], "
            "activ[fp16], softmax[fp16], bnorm[fp16], rnn[fp16], gemm, ctc, dropout[fp16], "
            "tensorop[fp16], reduce[fp16,fp64]\n");
+    printf("Common Arguments: --trace *file* writes a Chrome trace of library startup and "
+           "kernel compilation to *file*\n");
     exit(0); // NOLINT (concurrency-mt-unsafe)
 }
 
@@ -216,6 +219,7 @@ protected:
     void InitDataType();
     miopenHandle_t handle;
     miopenDataType_t data_type;
+    VerificationCache verification_cache;
 
 #if MIOPEN_BACKEND_OPENCL
     cl_command_queue q;
@@ -268,18 +268,11 @@ int DropoutDriver<Tgpu, Tref>::AllocateBuffersAndCopy()
 
     states_host = std::vector<prngStates>(states_size);
 
-    srand(0);
+    prng::reset_seed();
     Tgpu Data_scale = static_cast<Tgpu>(0.01);
 
-    for(int i = 0; i < in_sz; i++)
-    {
-        in.data[i] = Data_scale * RAN_GEN<Tgpu>(static_cast<Tgpu>(0.0), static_cast<Tgpu>(1.0));
-    }
-
-    for(int i = 0; i < out_sz; i++)
-    {
-        dout.data[i] = Data_scale * RAN_GEN<Tgpu>(static_cast<Tgpu>(0.0), static_cast<Tgpu>(1.0));
-    }
+    prng::fill(in.data.data(), in_sz, static_cast<Tgpu>(0.0), Data_scale);
+    prng::fill(dout.data.data(), out_sz, static_cast<Tgpu>(0.0), Data_scale);
 
     if(inflags.GetValueInt("dump_output"))
     {
@@ -301,12 +294,10 @@ int DropoutDriver<Tgpu, Tref>::AllocateBuffersAndCopy()
 
     if(inflags.GetValueInt("use_mask") == 1)
     {
-        for(int i = 0; i < reserveSpaceSize; i++)
-        {
-            reservespace[i] = static_cast<unsigned char>(
-                RAN_GEN<float>(static_cast<float>(0.0), static_cast<float>(1.0)) > dropout);
-            reservespace_host[i] = reservespace[i];
-        }
+        prng::generate(reservespace.data(), reserveSpaceSize, [&](std::size_t, double u) {
+            return static_cast<unsigned char>(prng::scale(u, 0.0f, 1.0f) > dropout);
+        });
+        reservespace_host = reservespace;
         status |= reservespace_dev->ToGPU(q, reservespace.data());
     }
 
@@ -34,8 +34,10 @@
 #include <float.h>
 #include <memory>
 #include <miopen/miopen.h>
+#include <miopen/cpu_gemm.hpp>
 #include <miopen/gemm_v2.hpp>
 #include <numeric>
+#include <sstream>
 #include <vector>
 #include "random.hpp"
 
@@ -82,23 +84,19 @@ void callCpuGemmStridedBatched(bool isColMajor,
 
     for(int bi = 0; bi < batch_count; ++bi)
     {
-        for(int mi = 0; mi < m; ++mi)
-        {
-            for(int ni = 0; ni < n; ++ni)
-            {
-                double y = 0;
-                for(int ki = 0; ki < k; ++ki)
-                {
-                    int aindex = transA ? a_offset + strideA * bi + lda * ki + mi
-                                        : a_offset + strideA * bi + lda * mi + ki;
-                    int bindex = transB ? b_offset + strideB * bi + ldb * ni + ki
-                                        : b_offset + strideB * bi + ldb * ki + ni;
-                    y += a_ptr[aindex] * b_ptr[bindex];
-                }
-                int cindex    = c_offset + strideC * bi + ldc * mi + ni;
-                c_ptr[cindex] = alpha * y + beta * c_ptr[cindex];
-            }
-        }
+        miopen::CpuGemm<double>(transA,
+                                transB,
+                                m,
+                                n,
+                                k,
+                                alpha,
+                                a_ptr + a_offset + strideA * bi,
+                                lda,
+                                b_ptr + b_offset + strideB * bi,
+                                ldb,
+                                beta,
+                                c_ptr + c_offset + strideC * bi,
+                                ldc);
     }
 }
 
@@ -120,6 +118,7 @@ public:
     int RunForwardGPU() override;
 
     int RunForwardCPU();
+    std::string GetVerificationCacheKey() const;
 
     int RunBackwardGPU() override;
 
@@ -160,6 +159,8 @@ int GemmDriver<T>::AddCmdLineArgs()
     inflags.AddInputFlag("transB", 'v', "0", "Transpose B matrix (Default=0)", "int");
     inflags.AddInputFlag("iter", 'i', "10", "Number of Iterations (Default=10)", "int");
     inflags.AddInputFlag("verify", 'V', "0", "Verify Each Layer (Default=1)", "int");
+    // -C is taken by isColMajor.
+    VerificationCache::AddCmdLineArgs(inflags, 'c');
     inflags.AddInputFlag("time", 't', "0", "Time Each Layer (Default=0)", "int");
 
     return 0;
@@ -169,6 +170,7 @@ template <typename T>
 int GemmDriver<T>::ParseCmdLineArgs(int argc, char* argv[])
 {
     inflags.Parse(argc, argv);
+    verification_cache = VerificationCache::FromCmdLineArgs(inflags);
 
     if(inflags.GetValueInt("time") == 1)
     {
@@ -374,10 +376,28 @@ int GemmDriver<T>::RunBackwardGPU()
     return (0);
 }
 
+template <typename T>
+std::string GemmDriver<T>::GetVerificationCacheKey() const
+{
+    std::ostringstream ss;
+    ss << gemm_desc.isColMajor << gemm_desc.transA << gemm_desc.transB;
+    ss << "_" << gemm_desc.m << "x" << gemm_desc.n << "x" << gemm_desc.k;
+    ss << "_" << gemm_desc.lda << "x" << gemm_desc.ldb << "x" << gemm_desc.ldc;
+    ss << "_" << gemm_desc.strideA << "x" << gemm_desc.strideB << "x" << gemm_desc.strideC;
+    ss << "_" << gemm_desc.batch_count;
+    ss << "_" << gemm_desc.alpha << "_" << gemm_desc.beta;
+    return ss.str();
+}
+
 template <typename T>
 int GemmDriver<T>::VerifyForward()
 {
-    RunForwardCPU();
+    const auto key = GetVerificationCacheKey();
+    if(!verification_cache.Read("gemm_fwd_out", key, chost))
+    {
+        RunForwardCPU();
+        verification_cache.Save("gemm_fwd_out", key, chost);
+    }
 
     c_dev->FromGPU(GetStream(), c.data());
 
@@ -39,6 +39,7 @@
 #include <miopen/miopen.h>
 #include <miopen/tensor.hpp>
 #include <numeric>
+#include <sstream>
 #include <vector>
 #include "random.hpp"
 
@@ -71,6 +72,7 @@ public:
 
     int RunForwardGPU() override;
     int RunForwardCPU();
+    std::string GetVerificationCacheKey() const;
 
     int RunBackwardGPU() override;
     int RunBackwardCPU();
@@ -104,6 +106,7 @@ private:
 
     miopenLRNDescriptor_t lrnDesc;
     bool do_backward;
+    mlo_host::Impl host_ref;
 
     miopenTensorDescriptor_t dInputTensor;
     miopenTensorDescriptor_t dOutputTensor;
@@ -122,7 +125,9 @@ int LRNDriver<Tgpu, Tref>::ParseCmdLineArgs(int argc, char* argv[])
     inflags.Parse(argc, argv);
     auto dir_val = inflags.GetValueInt("forw");
 
-    do_backward = (dir_val == 0) || (dir_val == 2);
+    do_backward        = (dir_val == 0) || (dir_val == 2);
+    host_ref           = mlo_host::GetImpl(inflags.GetValueStr("host_ref"));
+    verification_cache = VerificationCache::FromCmdLineArgs(inflags);
 
     if(inflags.GetValueInt("time") == 1)
     {
@@ -165,6 +170,7 @@ int LRNDriver<Tgpu, Tref>::AddCmdLineArgs()
     inflags.AddInputFlag("lrnK", 'K', "1.0", "lrnK (Default=1.0)", "double");
     inflags.AddInputFlag("iter", 'i', "10", "Number of Iterations (Default=10)", "int");
     inflags.AddInputFlag("verify", 'V', "1", "Verify Each Layer (Default=1)", "int");
+    VerificationCache::AddCmdLineArgs(inflags);
     inflags.AddInputFlag("time", 't', "0", "Time Each Layer (Default=0)", "int");
     inflags.AddInputFlag(
         "wall", 'w', "0", "Wall-clock Time Each Layer, Requires time == 1 (Default=0)", "int");
@@ -175,6 +181,11 @@ int LRNDriver<Tgpu, Tref>::AddCmdLineArgs()
                          "within",
                          "LRN Mode (within_channel or cross_channel) (Default=within)",
                          "str");
+    inflags.AddInputFlag("host_ref",
+                         'R',
+                         "parallel",
+                         "Host reference implementation (serial, parallel) (Default=parallel)",
+                         "str");
 
     return 0;
 }
@@ -263,16 +274,12 @@ int LRNDriver<Tgpu, Tref>::AllocateBuffersAndCopy()
     dout    = std::vector<Tgpu>(out_sz, static_cast<Tgpu>(0));
     dinhost = std::vector<Tref>(in_sz, static_cast<Tref>(0));
 
-    for(int i = 0; i < in_sz; i++)
-    {
-        in[i] = RAN_GEN<Tgpu>(static_cast<Tgpu>(-1.0), static_cast<Tgpu>(1.0));
-    }
+    prng::fill(in.data(), in_sz, static_cast<Tgpu>(-1.0), static_cast<Tgpu>(1.0));
 
     Tgpu Data_scale = static_cast<Tgpu>(0.001);
-    for(int i = 0; i < out_sz; i++)
-    {
-        dout[i] = Data_scale * RAN_GEN<Tgpu>(static_cast<Tgpu>(-0.5), static_cast<Tgpu>(0.5));
-    }
+    prng::generate(dout.data(), out_sz, [=](std::size_t, double u) {
+        return Data_scale * prng::scale(u, static_cast<Tgpu>(-0.5), static_cast<Tgpu>(0.5));
+    });
 
 #if MIOPEN_BACKEND_OPENCL
     cl_int status;
@@ -413,6 +420,27 @@ int LRNDriver<Tgpu, Tref>::RunBackwardGPU()
     return miopenStatusSuccess;
 }
 
+// The backward reference takes the output of the GPU, so only the forward one is cached.
+template <typename Tgpu, typename Tref>
+std::string LRNDriver<Tgpu, Tref>::GetVerificationCacheKey() const
+{
+    miopenLRNMode_t v_mode;
+    unsigned int v_lrnN;
+    double v_lrnAlpha;
+    double v_lrnBeta;
+    double v_lrnK;
+
+    miopenGetLRNDescriptor(lrnDesc, &v_mode, &v_lrnN, &v_lrnAlpha, &v_lrnBeta, &v_lrnK);
+
+    std::ostringstream ss;
+    ss << VerificationCache::GetTensorKey(inputTensor);
+    ss << "_" << VerificationCache::GetTensorKey(outputTensor);
+    ss << "_" << v_mode << "_" << v_lrnN;
+    ss << "_" << v_lrnAlpha << "_" << v_lrnBeta << "_" << v_lrnK;
+    ss << "_" << VerificationCache::GetTypeName<Tgpu>();
+    return ss.str();
+}
+
 template <typename Tgpu, typename Tref>
 int LRNDriver<Tgpu, Tref>::VerifyForward()
 {
@@ -444,33 +472,57 @@ int LRNDriver<Tgpu, Tref>::VerifyForward()
     int pre_pad = (v_lrnN - 1) / 2;
     int pad     = v_lrnN - pre_pad - 1;
 
-    mloLRNForwardRunHost<Tgpu, Tref>(do_backward,
-                                     v_mode,
-                                     pad,
-                                     v_lrnN,
-                                     alphaoverarea,
-                                     v_lrnAlpha,
-                                     v_lrnBeta,
-                                     v_lrnK,
-                                     nIn,        // batch_sz,
-                                     cOut,       // n_outputs,
-                                     cIn,        // n_inputs,
-                                     hIn,        // bot_height,
-                                     wIn,        // bot_width,
-                                     hInStride,  // bot_stride,
-                                     cInStride,  // bot_channel_stride,
-                                     nInStride,  // bot_batch_stride,
-                                     hOut,       // top_height,
-                                     wOut,       // top_width,
-                                     hOutStride, // top_v_stride,
-                                     cOutStride, // top_v_channel_stride,
-                                     nOutStride, // top_v_batch_stride,
-                                     hOutStride, // scale_v_stride,
-                                     cOutStride, // scale_v_channel_stride,
-                                     nOutStride, // scale_v_batch_stride,
-                                     in.data(),
-                                     scalehost.data(),
-                                     outhost.data());
+    const auto key = GetVerificationCacheKey();
+    if(!verification_cache.Read("lrn_fwd_out", key, outhost))
+    {
+        if(host_ref == mlo_host::Impl::Parallel)
+        {
+            mloLRNForwardRunHostParallel<Tgpu, Tref>(do_backward,
+                                                     v_mode,
+                                                     pad,
+                                                     v_lrnN,
+                                                     alphaoverarea,
+                                                     v_lrnAlpha,
+                                                     v_lrnBeta,
+                                                     v_lrnK,
+                                                     inputTensor,
+                                                     outputTensor,
+                                                     in.data(),
+                                                     scalehost.data(),
+                                                     outhost.data());
+        }
+        else
+        {
+            mloLRNForwardRunHost<Tgpu, Tref>(do_backward,
+                                             v_mode,
+                                             pad,
+                                             v_lrnN,
+                                             alphaoverarea,
+                                             v_lrnAlpha,
+                                             v_lrnBeta,
+                                             v_lrnK,
+                                             nIn,        // batch_sz,
+                                             cOut,       // n_outputs,
+                                             cIn,        // n_inputs,
+                                             hIn,        // bot_height,
+                                             wIn,        // bot_width,
+                                             hInStride,  // bot_stride,
+                                             cInStride,  // bot_channel_stride,
+                                             nInStride,  // bot_batch_stride,
+                                             hOut,       // top_height,
+                                             wOut,       // top_width,
+                                             hOutStride, // top_v_stride,
+                                             cOutStride, // top_v_channel_stride,
+                                             nOutStride, // top_v_batch_stride,
+                                             hOutStride, // scale_v_stride,
+                                             cOutStride, // scale_v_channel_stride,
+                                             nOutStride, // scale_v_batch_stride,
+                                             in.data(),
+                                             scalehost.data(),
+                                             outhost.data());
+        }
+        verification_cache.Save("lrn_fwd_out", key, outhost);
+    }
 
     auto error           = miopen::rms_range(outhost, out);
     const Tref tolerance = 1.5e-4; // 1e-6;
@@ -533,40 +585,60 @@ int LRNDriver<Tgpu, Tref>::VerifyBackward()
     int pre_pad = (v_lrnN - 1) / 2;
     int pad     = v_lrnN - pre_pad - 1;
 
-    mloLRNBackwardRunHost<Tgpu, Tref>(static_cast<int>(v_mode),
-                                      pad,
-                                      v_lrnN,
-                                      alphaoverarea,
-                                      v_lrnAlpha,
-                                      v_lrnBeta,
-                                      v_lrnK,
-                                      nIn,         // batch_sz,
-                                      cOut,        // n_outputs,
-                                      cIn,         // n_inputs,
-                                      hIn,         // bot_height,
-                                      wIn,         // bot_width,
-                                      hInStride,   // bot_stride,
-                                      cInStride,   // bot_channel_stride,
-                                      nInStride,   // bot_batch_stride,
-                                      hdInStride,  // bot_df_v_stride,
-                                      cdInStride,  // bot_df_v_channel_stride,
-                                      ndInStride,  // bot_df_v_batch_stride,
-                                      hOut,        // top_height,
-                                      wOut,        // top_width,
-                                      hOutStride,  // top_stride,
-                                      cOutStride,  // top_channel_stride,
-                                      nOutStride,  // top_batch_stride,
-                                      hdOutStride, // top_df_stride,
-                                      cdOutStride, // top_df_channel_stride,
-                                      ndOutStride, // top_df_batch_stride,
-                                      hdOutStride, // scale_stride,
-                                      cdOutStride, // scale_channel_stride,
-                                      ndOutStride, // scale_batch_stride,
-                                      out.data(),
-                                      dout.data(),
-                                      scale.data(),
-                                      in.data(),
-                                      dinhost.data());
+    if(host_ref == mlo_host::Impl::Parallel)
+    {
+        mloLRNBackwardRunHostParallel<Tgpu, Tref>(static_cast<int>(v_mode),
+                                                  pad,
+                                                  v_lrnN,
+                                                  v_lrnAlpha,
+                                                  v_lrnBeta,
+                                                  inputTensor,
+                                                  outputTensor,
+                                                  dInputTensor,
+                                                  dOutputTensor,
+                                                  out.data(),
+                                                  dout.data(),
+                                                  scale.data(),
+                                                  in.data(),
+                                                  dinhost.data());
+    }
+    else
+    {
+        mloLRNBackwardRunHost<Tgpu, Tref>(static_cast<int>(v_mode),
+                                          pad,
+                                          v_lrnN,
+                                          alphaoverarea,
+                                          v_lrnAlpha,
+                                          v_lrnBeta,
+                                          v_lrnK,
+                                          nIn,         // batch_sz,
+                                          cOut,        // n_outputs,
+                                          cIn,         // n_inputs,
+                                          hIn,         // bot_height,
+                                          wIn,         // bot_width,
+                                          hInStride,   // bot_stride,
+                                          cInStride,   // bot_channel_stride,
+                                          nInStride,   // bot_batch_stride,
+                                          hdInStride,  // bot_df_v_stride,
+                                          cdInStride,  // bot_df_v_channel_stride,
+                                          ndInStride,  // bot_df_v_batch_stride,
+                                          hOut,        // top_height,
+                                          wOut,        // top_width,
+                                          hOutStride,  // top_stride,
+                                          cOutStride,  // top_channel_stride,
+                                          nOutStride,  // top_batch_stride,
+                                          hdOutStride, // top_df_stride,
+                                          cdOutStride, // top_df_channel_stride,
+                                          ndOutStride, // top_df_batch_stride,
+                                          hdOutStride, // scale_stride,
+                                          cdOutStride, // scale_channel_stride,
+                                          ndOutStride, // scale_batch_stride,
+                                          out.data(),
+                                          dout.data(),
+                                          scale.data(),
+                                          in.data(),
+                                          dinhost.data());
+    }
 
     auto error           = miopen::rms_range(dinhost, din);
     const Tref tolerance = 6.0e-5;
@@ -42,6 +42,9 @@
 #include "reduce_driver.hpp"
 #include <miopen/config.h>
 #include <miopen/stringutils.hpp>
+#include <miopen/trace.hpp>
+
+#include <algorithm>
 
 int main(int argc, char* argv[])
 {
@@ -63,6 +66,18 @@ int main(int argc, char* argv[])
         std::cout << " " << argv[i];
     std::cout << std::endl;
 
+    // Tracing has to be enabled before the driver creates its handle, so the option is
+    // consumed here instead of by the drivers.
+    for(int i = 2; i + 1 < argc; i++)
+    {
+        if(std::string{argv[i]} != "--trace")
+            continue;
+        miopen::EnableTrace(argv[i + 1]);
+        std::copy(argv + i + 2, argv + argc + 1, argv + i);
+        argc -= 2;
+        break;
+    }
+
     Driver* drv;
     if(base_arg == "conv")
     {
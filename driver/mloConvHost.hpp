@@ -27,11 +27,16 @@
 #ifndef MLO_CONVHOST_H_
 #define MLO_CONVHOST_H_
 
+#include <miopen/cpu_gemm.hpp>
+#include <miopen/par_for.hpp>
 #include <miopen/tensor.hpp>
 
+#include <algorithm>
 #include <cmath>
 #include <iomanip>
 #include <iostream>
+#include <tuple>
+#include <vector>
 
 #include "calcerr.hpp"
 
@@ -60,13 +65,6 @@ void ADNN_mm_cpu(const Dtype* a_ptr,
                  double d_alpha,
                  double d_beta)
 {
-    // mA
-
-    // mB
-
-    // mC
-    Dtype alpha = Dtype(d_alpha);
-    Dtype beta  = Dtype(d_beta);
     if((!(a_flags & ADNN_MM_TRANSPOSE) && !(b_flags & ADNN_MM_TRANSPOSE) &&
         ((a_cols != b_rows) || (a_rows != c_rows) || (b_cols != c_cols))) ||
        ((a_flags & ADNN_MM_TRANSPOSE) && (b_flags & ADNN_MM_TRANSPOSE) &&
@@ -88,90 +86,19 @@ void ADNN_mm_cpu(const Dtype* a_ptr,
 
     size_t inner_loop = (!(a_flags & ADNN_MM_TRANSPOSE)) ? a_cols : a_rows;
 
-    if(!(a_flags & ADNN_MM_TRANSPOSE) && !(b_flags & ADNN_MM_TRANSPOSE))
-    {
-        for(size_t n = 0; n < c_rows; ++n)
-        {
-            for(size_t k = 0; k < c_cols; ++k)
-            {
-                Dtype mm_e = static_cast<Dtype>(0);
-                for(size_t m = 0; m < inner_loop; ++m)
-                {
-                    mm_e += a_ptr[n * a_stride + m] * b_ptr[m * b_stride + k];
-                }
-                c_ptr[n * c_stride + k] = beta * c_ptr[n * c_stride + k] + alpha * mm_e;
-            }
-        }
-    }
-    else if((a_flags & ADNN_MM_TRANSPOSE) && !(b_flags & ADNN_MM_TRANSPOSE))
-    {
-        for(size_t n = 0; n < c_rows; ++n)
-        {
-            for(size_t k = 0; k < c_cols; ++k)
-            {
-
-                Dtype mm_e = static_cast<Dtype>(0);
-                for(size_t m = 0; m < inner_loop; ++m)
-                {
-                    mm_e += a_ptr[m * a_stride + n] * b_ptr[m * b_stride + k];
-#if 0
-                    if (
-                        (n == 0 && k == 33
-                        || n == 1 && k == 32
-                        || n == 3 && k == 1
-                        || n == 4 && k == 0
-
-                        )
-                        && a_ptr[m*a_stride + n] * b_ptr[m*b_stride + k] != 0
-                        )
-                    {
-                        printf("C:mm:%d %d %d   %11.9f %11.9f %11.9f %11.9f\n",
-                            n, k, m,
-                            mm_e, a_ptr[m*a_stride + n], b_ptr[m*b_stride + k], a_ptr[m*a_stride + n] * b_ptr[m*b_stride + k]);
-                    }
-#endif
-                }
-                c_ptr[n * c_stride + k] = beta * c_ptr[n * c_stride + k] + alpha * mm_e;
-            }
-        }
-    }
-    else if(!(a_flags & ADNN_MM_TRANSPOSE) && (b_flags & ADNN_MM_TRANSPOSE))
-    {
-        for(size_t n = 0; n < c_rows; ++n)
-        {
-            for(size_t k = 0; k < c_cols; ++k)
-            {
-                Dtype mm_e = static_cast<Dtype>(0);
-
-                for(size_t m = 0; m < inner_loop; ++m)
-                {
-                    mm_e += a_ptr[n * a_stride + m] * b_ptr[k * b_stride + m];
-#if 0
-                    if (n == 0 && k == 6 && a_ptr[n*a_stride + m] * b_ptr[k*b_stride + m] != 0)
-                    {
-                        printf("%4d  %11.9f %11.9f %11.9f\n", m, mm_e, a_ptr[n*a_stride + m], b_ptr[k*b_stride + m]);
-                    }
-#endif
-                }
-                c_ptr[n * c_stride + k] = beta * c_ptr[n * c_stride + k] + alpha * mm_e;
-            }
-        }
-    }
-    else
-    {
-        for(size_t n = 0; n < c_rows; ++n)
-        {
-            for(size_t k = 0; k < c_cols; ++k)
-            {
-                Dtype mm_e = static_cast<Dtype>(0);
-                for(size_t m = 0; m < inner_loop; ++m)
-                {
-                    c_ptr[n * c_stride + k] += a_ptr[m * a_stride + n] * b_ptr[k * b_stride + m];
-                }
-                c_ptr[n * c_stride + k] = beta * c_ptr[n * c_stride + k] + alpha * mm_e;
-            }
-        }
-    }
+    miopen::CpuGemm<Dtype>((a_flags & ADNN_MM_TRANSPOSE) != 0,
+                           (b_flags & ADNN_MM_TRANSPOSE) != 0,
+                           c_rows,
+                           c_cols,
+                           inner_loop,
+                           d_alpha,
+                           a_ptr,
+                           a_stride,
+                           b_ptr,
+                           b_stride,
+                           d_beta,
+                           c_ptr,
+                           c_stride);
 }
 
 template <typename Dtype>
@@ -1050,6 +977,58 @@ bool mloVerify(const miopenTensorDescriptor_t& cpu_,
     std::tie(g_batch_stride, g_channel_stride, g_depth_stride, g_height_stride, g_width_stride) =
         miopen::GetNCDHW(spatial_dim, gpu.GetStrides());
 
+    // Rows of width elements are checked in parallel. The per-row results are merged in order,
+    // so that the worst element and the first ULP failure are the same as in a serial walk.
+    struct RowResult
+    {
+        double rms_accum   = 0.0;
+        Tcheck_ worst_diff = static_cast<Tcheck_>(0);
+        size_t worst_i     = 0;
+        size_t ulps_fail_i = 0;
+        bool ulps_failed   = false;
+    };
+
+    const auto rows       = n_batchs * n_channels * depth * height;
+    const auto row_coords = [&](size_t row) {
+        const auto j = row % height;
+        row /= height;
+        const auto k = row % depth;
+        row /= depth;
+        return std::make_tuple(row / n_channels, row % n_channels, k, j);
+    };
+    const auto c_offset = [&](size_t b, size_t c, size_t k, size_t j, size_t i) {
+        return b * c_batch_stride + c * c_channel_stride + k * c_depth_stride +
+               j * c_height_stride + i * c_width_stride;
+    };
+    const auto g_offset = [&](size_t b, size_t c, size_t k, size_t j, size_t i) {
+        return b * g_batch_stride + c * g_channel_stride + k * g_depth_stride +
+               j * g_height_stride + i * g_width_stride;
+    };
+    auto results            = std::vector<RowResult>(rows);
+    const auto for_each_row = [&](auto f) {
+        const auto grain = std::max<size_t>(1, 4096 / std::max<size_t>(1, width));
+        miopen::par_for(rows, miopen::min_grain{grain}, [&](size_t row) {
+            size_t b, c, k, j;
+            std::tie(b, c, k, j) = row_coords(row);
+            f(results[row], c_ptr + c_offset(b, c, k, j, 0), g_ptr + g_offset(b, c, k, j, 0));
+        });
+    };
+
+    for_each_row([&](RowResult& result, const Tcheck_* c_row, const Tgpu_* g_row) {
+        for(size_t i = 0; i < width; ++i)
+        {
+            const Tcheck_ c_val = c_row[i * c_width_stride];
+            const auto g_val    = static_cast<Tcheck_>(g_row[i * g_width_stride]);
+            const Tcheck_ diff  = std::abs(c_val - g_val);
+            result.rms_accum += diff * diff;
+            if(diff > result.worst_diff)
+            {
+                result.worst_diff = diff;
+                result.worst_i    = i;
+            }
+        }
+    });
+
     bool match          = true;
     double rms_accum    = 0.0;
     Tcheck_ worst_c_val = static_cast<Tcheck_>(0);
@@ -1057,42 +1036,20 @@ bool mloVerify(const miopenTensorDescriptor_t& cpu_,
     Tcheck_ worst_diff  = static_cast<Tcheck_>(0);
     size_t worst_b = 0, worst_c = 0, worst_i = 0, worst_j = 0, worst_k = 0;
 
-    for(size_t b = 0; b < n_batchs; ++b)
+    for(size_t row = 0; row < rows; ++row)
     {
-        for(size_t c = 0; c < n_channels; ++c)
+        rms_accum += results[row].rms_accum;
+        // Register worst (max) abs error and its position.
+        // This info will be used to show additional diagnostics,
+        // but only if sgr_accum is too big.
+        if(results[row].worst_diff > worst_diff)
         {
-            for(size_t k = 0; k < depth; ++k)
-            {
-                for(size_t j = 0; j < height; ++j)
-                {
-                    for(size_t i = 0; i < width; ++i)
-                    {
-                        Tcheck_ c_val =
-                            c_ptr[b * c_batch_stride + c * c_channel_stride + k * c_depth_stride +
-                                  j * c_height_stride + i * c_width_stride];
-                        Tcheck_ g_val = static_cast<Tcheck_>(
-                            g_ptr[b * g_batch_stride + c * g_channel_stride + k * g_depth_stride +
-                                  j * g_height_stride + i * g_width_stride]);
-
-                        Tcheck_ diff = std::abs(c_val - g_val);
-                        rms_accum += diff * diff;
-                        // Register worst (max) abs error and its position.
-                        // This info will be used to show additional diagnostics,
-                        // but only if sgr_accum is too big.
-                        if(diff > worst_diff)
-                        {
-                            worst_diff  = diff;
-                            worst_c_val = c_val;
-                            worst_g_val = g_val;
-                            worst_b     = b;
-                            worst_c     = c;
-                            worst_i     = i;
-                            worst_j     = j;
-                            worst_k     = k;
-                        }
-                    }
-                }
-            }
+            worst_diff = results[row].worst_diff;
+            worst_i    = results[row].worst_i;
+            std::tie(worst_b, worst_c, worst_k, worst_j) = row_coords(row);
+            worst_c_val = c_ptr[c_offset(worst_b, worst_c, worst_k, worst_j, worst_i)];
+            worst_g_val =
+                static_cast<Tcheck_>(g_ptr[g_offset(worst_b, worst_c, worst_k, worst_j, worst_i)]);
         }
     }
 
@@ -1112,63 +1069,57 @@ bool mloVerify(const miopenTensorDescriptor_t& cpu_,
                   << " vs gpu_v = " << worst_g_val << std::endl;
     }
 
-    if(check_ulps)
+    if(check_ulps && match)
     {
         static int n_logged = 0;
-        for(size_t b = 0; b < n_batchs && match; ++b)
-        {
-            for(size_t c = 0; c < n_channels && match; ++c)
+
+        for_each_row([&](RowResult& result, const Tcheck_* c_row, const Tgpu_* g_row) {
+            for(size_t i = 0; i < width; ++i)
             {
-                for(size_t k = 0; k < depth && match; ++k)
+                const auto c_val = static_cast<Tgpu_>(c_row[i * c_width_stride]);
+                const auto g_val = static_cast<Tgpu_>(g_row[i * g_width_stride]);
+                const auto diff  = std::abs(c_val - g_val);
+                const bool check_failed =
+                    (diff > diff_tolerance && ApproxUlps(c_val, g_val) > ulps_tolerance) //
+                    || std::isnan(c_val)                                                 //
+                    || std::isnan(g_val)                                                 //
+                    || !std::isfinite(c_val)                                             //
+                    || !std::isfinite(g_val);
+                if(check_failed)
                 {
-                    for(size_t j = 0; j < height && match; ++j)
-                    {
-                        for(size_t i = 0; i < width && match; ++i)
-                        {
-                            auto c_val =
-                                static_cast<Tgpu_>(c_ptr[b * c_batch_stride + c * c_channel_stride +
-                                                         k * c_depth_stride + j * c_height_stride +
-                                                         i * c_width_stride]);
-                            auto g_val =
-                                static_cast<Tgpu_>(g_ptr[b * g_batch_stride + c * g_channel_stride +
-                                                         k * g_depth_stride + j * g_height_stride +
-                                                         i * g_width_stride]);
-
-                            const auto diff = std::abs(c_val - g_val);
-                            const auto ulps = ApproxUlps(c_val, g_val);
-                            const bool check_failed =
-                                (diff > diff_tolerance && ulps > ulps_tolerance) //
-                                || std::isnan(c_val)                             //
-                                || std::isnan(g_val)                             //
-                                || !std::isfinite(c_val)                         //
-                                || !std::isfinite(g_val);
-
-                            if(check_failed)
-                                match = false;
-
-                            if(check_failed)
-                            {
-                                if(!(n_logged >= 10))
-                                {
-                                    std::cout << "ULPs: " << ulps;
-                                    if(check_failed)
-                                        std::cout << " is too large (> " << ulps_tolerance << ")";
-                                    std::cout << " at {" << b << ',' << c << ',';
-                                    if(spatial_dim == 3)
-                                        std::cout << k << ',';
-                                    std::cout << j << ',' << i << "}, cpu_val = " << c_val
-                                              << ", gpu_val = " << g_val << " (diff = " << diff
-                                              << ')' << std::endl;
-                                    ++n_logged;
-                                    if(n_logged >= 10)
-                                        std::cout << "(too many lines logged, truncating output...)"
-                                                  << std::endl;
-                                }
-                            }
-                        }
-                    }
+                    result.ulps_failed = true;
+                    result.ulps_fail_i = i;
+                    return;
                 }
             }
+        });
+
+        const auto failed = std::find_if(
+            results.begin(), results.end(), [](const RowResult& r) { return r.ulps_failed; });
+        if(failed != results.end())
+        {
+            match = false;
+
+            if(!(n_logged >= 10))
+            {
+                size_t b, c, k, j;
+                std::tie(b, c, k, j) = row_coords(failed - results.begin());
+                const auto i         = failed->ulps_fail_i;
+                const auto c_val     = static_cast<Tgpu_>(c_ptr[c_offset(b, c, k, j, i)]);
+                const auto g_val     = static_cast<Tgpu_>(g_ptr[g_offset(b, c, k, j, i)]);
+                const auto diff      = std::abs(c_val - g_val);
+
+                std::cout << "ULPs: " << ApproxUlps(c_val, g_val);
+                std::cout << " is too large (> " << ulps_tolerance << ")";
+                std::cout << " at {" << b << ',' << c << ',';
+                if(spatial_dim == 3)
+                    std::cout << k << ',';
+                std::cout << j << ',' << i << "}, cpu_val = " << c_val << ", gpu_val = " << g_val
+                          << " (diff = " << diff << ')' << std::endl;
+                ++n_logged;
+                if(n_logged >= 10)
+                    std::cout << "(too many lines logged, truncating output...)" << std::endl;
+            }
         }
     }
     return match;
@@ -0,0 +1,174 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#ifndef MLO_HOSTINDEX_H_
+#define MLO_HOSTINDEX_H_
+
+#include <miopen/errors.hpp>
+#include <miopen/par_for.hpp>
+#include <miopen/tensor.hpp>
+
+#include <algorithm>
+#include <array>
+#include <numeric>
+#include <string>
+
+/// Index iteration shared by the parallel host references of the driver.
+namespace mlo_host {
+
+/// The serial references are the original nested loops, kept to cross-check the parallel ones.
+enum class Impl
+{
+    Serial,
+    Parallel,
+};
+
+inline Impl GetImpl(const std::string& name)
+{
+    if(name == "serial")
+        return Impl::Serial;
+    if(name == "parallel")
+        return Impl::Parallel;
+    MIOPEN_THROW("Unknown host reference implementation: " + name);
+}
+
+/// Position in a tensor in NCDHW order.
+using Index = std::array<int, 5>;
+
+/// Lengths and strides of a 4-D or 5-D tensor in NCDHW order, whatever its memory layout is.
+/// 4-D tensors get a depth of 1.
+struct Ncdhw
+{
+    Index lens;
+    Index strides;
+
+    std::size_t Offset(const Index& idx) const
+    {
+        std::size_t offset = 0;
+        for(std::size_t i = 0; i < idx.size(); ++i)
+            offset += static_cast<std::size_t>(idx[i]) * strides[i];
+        return offset;
+    }
+
+    std::size_t Offset(int n, int c, int d, int h, int w) const { return Offset({n, c, d, h, w}); }
+};
+
+inline Ncdhw GetNcdhw(const miopen::TensorDescriptor& desc)
+{
+    const auto spatial_dim = desc.GetLengths().size() - 2;
+    Ncdhw result{};
+    std::tie(result.lens[0], result.lens[1], result.lens[2], result.lens[3], result.lens[4]) =
+        miopen::GetNCDHW(spatial_dim, desc.GetLengths());
+    std::tie(result.strides[0],
+             result.strides[1],
+             result.strides[2],
+             result.strides[3],
+             result.strides[4]) = miopen::GetNCDHW(spatial_dim, desc.GetStrides());
+    return result;
+}
+
+inline Ncdhw GetNcdhw(const miopenTensorDescriptor_t& desc)
+{
+    return GetNcdhw(miopen::deref(desc));
+}
+
+/// The index space [0, lens) cut into rows along its innermost dimension. The loops are nested
+/// in the order of decreasing strides of the tensor the space is laid over, so a thread walks
+/// the memory sequentially for NCHW (w innermost) as well as for NHWC (c innermost). Unit
+/// dimensions go outermost: they don't move and their strides are arbitrary.
+class Rows
+{
+public:
+    Rows(const Index& lens_, const Index& strides) : Rows(lens_, strides, -1) {}
+
+    /// Dimension `outer` goes outermost, ahead of the unit ones, so that a row never spans two
+    /// of its positions, e.g. two instances of a batch when all the other dimensions are 1.
+    Rows(const Index& lens_, const Index& strides, int outer) : lens(lens_)
+    {
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(), [&](int a, int b) {
+            return std::make_tuple(a != outer, lens[a] > 1, -static_cast<long long>(strides[a])) <
+                   std::make_tuple(b != outer, lens[b] > 1, -static_cast<long long>(strides[b]));
+        });
+    }
+
+    /// Iterates over `lens` in the memory order of `layout`.
+    Rows(const Index& lens_, const Ncdhw& layout) : Rows(lens_, layout.strides) {}
+
+    explicit Rows(const Ncdhw& tensor) : Rows(tensor.lens, tensor.strides) {}
+
+    int Inner() const { return order.back(); }
+
+    std::size_t Count() const
+    {
+        std::size_t count = 1;
+        for(std::size_t i = 0; i + 1 < order.size(); ++i)
+            count *= lens[order[i]];
+        return count;
+    }
+
+    /// Position of the first element of a row.
+    Index Start(std::size_t row) const
+    {
+        Index idx{};
+        for(auto i = order.size() - 1; i-- > 0;)
+        {
+            idx[order[i]] = static_cast<int>(row % lens[order[i]]);
+            row /= lens[order[i]];
+        }
+        return idx;
+    }
+
+    /// Calls f(row, idx) for every index, rows in parallel. Rows are numbered in the loop order
+    /// whatever the number of threads, so per-row partial results merged by row number don't
+    /// depend on it.
+    template <class F>
+    void ParForEach(F f) const
+    {
+        const auto inner = Inner();
+        const auto grain = std::max<std::size_t>(1, 4096 / std::max(1, lens[inner]));
+        miopen::par_for(Count(), miopen::min_grain{grain}, [&](std::size_t row) {
+            auto idx = Start(row);
+            for(; idx[inner] < lens[inner]; ++idx[inner])
+                f(row, static_cast<const Index&>(idx));
+        });
+    }
+
+private:
+    Index lens;
+    std::array<int, 5> order{};
+};
+
+/// Calls f(idx) for every element of the tensor, in parallel and in memory order.
+template <class F>
+void ParForEachIndex(const Ncdhw& tensor, F f)
+{
+    Rows{tensor}.ParForEach([&](std::size_t, const Index& idx) { f(idx); });
+}
+
+} // namespace mlo_host
+
+#endif // MLO_HOSTINDEX_H_
@@ -27,9 +27,12 @@
 #ifndef MLO_NORMHOST_H_
 #define MLO_NORMHOST_H_
 
+#include <algorithm>
 #include <cmath>
 #include <iomanip>
 
+#include "mloHostIndex.hpp"
+
 ////////////////////////////////////////////////////////////
 //
 ///////////////////////////////////////////////////////////
@@ -570,4 +573,223 @@ int mloLRNBackwardRunHost(int norm_region,
     return (ret);
 }
 
+/// Parallel version of mloLRNForwardRunHost(), for any layout of the tensors. The scale has the
+/// layout of top.
+template <typename Tgpu_ /* the data type used in GPU computations (usually half) */,
+          typename Tcheck_ /* the data type used in CPU checkings (usually double) */>
+int mloLRNForwardRunHostParallel(bool do_scale,
+                                 int norm_region,
+                                 int pad,
+                                 int local_area,
+                                 Tcheck_ alphaoverarea,
+                                 Tcheck_ alpha,
+                                 Tcheck_ beta,
+                                 Tcheck_ K,
+                                 const miopenTensorDescriptor_t& bot_,
+                                 const miopenTensorDescriptor_t& top_,
+                                 const Tgpu_* bot_ptr,
+                                 Tcheck_* scale_v_ptr,
+                                 Tcheck_* top_v_ptr)
+{
+    if(local_area < 1 + pad)
+    {
+        std::cout << "ERROR: Lrn kernel size is insufficient." << std::endl;
+        return -1;
+    }
+
+    const auto bot = mlo_host::GetNcdhw(bot_);
+    const auto top = mlo_host::GetNcdhw(top_);
+
+    const int n_inputs   = bot.lens[1];
+    const int bot_height = bot.lens[3];
+    const int bot_width  = bot.lens[4];
+    const int n_outputs  = top.lens[1];
+
+    if(norm_region == MLO_LRN_ACROSS_CHANNELS)
+    {
+        // The window slides along the channels of each pixel: the values entering it are
+        // added, the values leaving it are subtracted.
+        auto pixels = top.lens;
+        pixels[1]   = 1;
+        mlo_host::Rows{pixels, top}.ParForEach([&](std::size_t, const mlo_host::Index& idx) {
+            const int b = idx[0], j = idx[3], i = idx[4];
+
+            const auto bot_val = [&](int c) {
+                return (c >= 0 && c < n_inputs)
+                           ? static_cast<Tcheck_>(bot_ptr[bot.Offset(b, c, 0, j, i)])
+                           : static_cast<Tcheck_>(0);
+            };
+
+            // c-emulator
+            Tcheck_ accum_scale = Tcheck_{0};
+            for(int head = 0; head < std::max(local_area, n_inputs + pad); ++head)
+            {
+                if(head < n_inputs)
+                    accum_scale += bot_val(head) * bot_val(head);
+                if(head >= local_area)
+                    accum_scale -= bot_val(head - local_area) * bot_val(head - local_area);
+
+                const int o = head - pad;
+                if(o < 0 || o >= n_outputs)
+                    continue;
+
+                Tcheck_ scale      = K + accum_scale * alphaoverarea;
+                const auto top_off = top.Offset(b, o, 0, j, i);
+                if(do_scale)
+                    scale_v_ptr[top_off] = scale;
+                top_v_ptr[top_off] = bot_val(o) * pow(scale, -beta);
+            }
+        });
+    }
+    else
+    {
+        mlo_host::ParForEachIndex(top, [&](const mlo_host::Index& idx) {
+            const int b = idx[0], o = idx[1], j = idx[3], i = idx[4];
+
+            // c-emulator
+            int hstart        = j - (local_area - 1 - pad);
+            int wstart        = i - (local_area - 1 - pad);
+            int hend          = std::min(hstart + local_area, bot_height + pad);
+            int wend          = std::min(wstart + local_area, bot_width + pad);
+            int adj_area_size = (hend - hstart) * (wend - wstart);
+            hstart            = std::max(hstart, 0);
+            wstart            = std::max(wstart, 0);
+            hend              = std::min(hend, bot_height);
+            wend              = std::min(wend, bot_width);
+            Tcheck_ accum     = static_cast<Tcheck_>(0);
+            for(int h = hstart; h < hend; ++h)
+            {
+                for(int w = wstart; w < wend; ++w)
+                {
+                    Tcheck_ bot_val = static_cast<Tcheck_>(bot_ptr[bot.Offset(b, o, 0, h, w)]);
+                    accum += bot_val * bot_val;
+                }
+            }
+
+            Tcheck_ scale      = K + accum * (alpha / adj_area_size);
+            const auto top_off = top.Offset(idx);
+            if(do_scale)
+                scale_v_ptr[top_off] = scale;
+
+            Tcheck_ bot_val    = static_cast<Tcheck_>(bot_ptr[bot.Offset(idx)]);
+            top_v_ptr[top_off] = bot_val * pow(scale, -beta);
+        });
+    }
+
+    return 0;
+}
+
+/// Parallel version of mloLRNBackwardRunHost(), for any layout of the tensors. The scale has the
+/// layout of top_df.
+template <typename Tgpu_ /* the data type used in GPU computations (usually half) */,
+          typename Tcheck_ /* the data type used in CPU checkings (usually double) */>
+int mloLRNBackwardRunHostParallel(int norm_region,
+                                  int pad,
+                                  int local_area,
+                                  Tcheck_ alpha,
+                                  Tcheck_ beta,
+                                  const miopenTensorDescriptor_t& bot_,
+                                  const miopenTensorDescriptor_t& top_,
+                                  const miopenTensorDescriptor_t& bot_df_,
+                                  const miopenTensorDescriptor_t& top_df_,
+                                  const Tgpu_* top_ptr,
+                                  const Tgpu_* top_df_ptr,
+                                  const Tgpu_* scale_ptr,
+                                  const Tgpu_* bot_ptr,
+                                  Tcheck_* bot_df_v_ptr)
+{
+    Tcheck_ negative_beta = -beta;
+    int pre_pad           = local_area - 1 - pad;
+    if(pre_pad < 0)
+    {
+        std::cout << "ERROR: Lrn kernel size is insufficient." << std::endl;
+        return -1;
+    }
+
+    const auto bot    = mlo_host::GetNcdhw(bot_);
+    const auto top    = mlo_host::GetNcdhw(top_);
+    const auto bot_df = mlo_host::GetNcdhw(bot_df_);
+    const auto top_df = mlo_host::GetNcdhw(top_df_);
+
+    const int n_inputs   = bot.lens[1];
+    const int top_height = top.lens[3];
+    const int top_width  = top.lens[4];
+
+    const auto bot_df_v = [&](const mlo_host::Index& idx, Tcheck_ accum_ratio, Tcheck_ ratio) {
+        return static_cast<Tcheck_>(top_df_ptr[top_df.Offset(idx)]) *
+                   pow(static_cast<Tcheck_>(scale_ptr[top_df.Offset(idx)]), negative_beta) -
+               ratio * static_cast<Tcheck_>(bot_ptr[bot.Offset(idx)]) * accum_ratio;
+    };
+
+    if(norm_region == MLO_LRN_ACROSS_CHANNELS)
+    {
+        Tcheck_ ratio_dta_bwd =
+            static_cast<Tcheck_>(2.) * alpha * beta / static_cast<Tcheck_>(local_area);
+
+        auto pixels = bot_df.lens;
+        pixels[1]   = 1;
+        mlo_host::Rows{pixels, bot_df}.ParForEach([&](std::size_t, const mlo_host::Index& idx) {
+            const int b = idx[0], j = idx[3], i = idx[4];
+
+            const auto adder = [&](int c) {
+                return (static_cast<Tcheck_>(top_df_ptr[top_df.Offset(b, c, 0, j, i)]) *
+                        static_cast<Tcheck_>(top_ptr[top.Offset(b, c, 0, j, i)])) /
+                       static_cast<Tcheck_>(scale_ptr[top_df.Offset(b, c, 0, j, i)]);
+            };
+
+            // c-emulator
+            Tcheck_ accum_ratio = static_cast<Tcheck_>(0);
+            for(int head = 0; head < std::max(local_area, n_inputs + pre_pad); ++head)
+            {
+                if(head < n_inputs)
+                    accum_ratio += adder(head);
+                if(head >= local_area && head - local_area < n_inputs)
+                    accum_ratio -= adder(head - local_area);
+
+                const int o = head - pre_pad;
+                if(o < 0 || o >= n_inputs)
+                    continue;
+
+                bot_df_v_ptr[bot_df.Offset(b, o, 0, j, i)] =
+                    bot_df_v({b, o, 0, j, i}, accum_ratio, ratio_dta_bwd);
+            }
+        });
+    }
+    else
+    {
+        mlo_host::ParForEachIndex(bot_df, [&](const mlo_host::Index& idx) {
+            const int b = idx[0], o = idx[1], j = idx[3], i = idx[4];
+
+            Tcheck_ accum_ratio = static_cast<Tcheck_>(0);
+
+            int hstart        = j - pad;
+            int wstart        = i - pad;
+            int hend          = std::min(hstart + local_area, top_height + pre_pad);
+            int wend          = std::min(wstart + local_area, top_width + pre_pad);
+            int adj_area_size = (hend - hstart) * (wend - wstart);
+            hstart            = std::max(hstart, 0);
+            wstart            = std::max(wstart, 0);
+            hend              = std::min(hend, top_height);
+            wend              = std::min(wend, top_width);
+            for(int h = hstart; h < hend; ++h)
+            {
+                for(int w = wstart; w < wend; ++w)
+                {
+                    accum_ratio +=
+                        static_cast<Tcheck_>(top_df_ptr[top_df.Offset(b, o, 0, h, w)]) *
+                        static_cast<Tcheck_>(top_ptr[top.Offset(b, o, 0, h, w)]) /
+                        static_cast<Tcheck_>(scale_ptr[top_df.Offset(b, o, 0, h, w)]);
+                }
+            }
+
+            Tcheck_ ratio_dta_bwd =
+                static_cast<Tcheck_>(2.) * alpha * beta / static_cast<Tcheck_>(adj_area_size);
+
+            bot_df_v_ptr[bot_df.Offset(idx)] = bot_df_v(idx, accum_ratio, ratio_dta_bwd);
+        });
+    }
+
+    return 0;
+}
+
 #endif
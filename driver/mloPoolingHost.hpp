@@ -36,8 +36,13 @@
 #include <cmath>
 #include <cstring>
 #include <iomanip>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <vector>
 
 #include "calcerr.hpp"
+#include "mloHostIndex.hpp"
 
 #if 0
 template<typename _T>
@@ -471,6 +476,308 @@ void mloPoolingBackwardRunHost(
     stats.max_num_flops_per_res = *(std::max_element(num_flops.begin(), num_flops.end()));
 }
 
+/// Parallel version of mloPoolingForwardRunHostAndVerify(). Checks all the points instead of
+/// stopping at the first mismatch, and reports the first mismatch of the walk.
+template <typename Tgpu_ /* the data type used in GPU computations (usually half) */,
+          typename Tcheck_ /* the data type used in CPU checkings (usually double) */,
+          typename Index>
+bool mloPoolingForwardRunHostAndVerifyParallel(int pooling_method,
+                                               int pad_d,
+                                               int pool_stride_d,
+                                               int filter_size_d,
+                                               int pad_h,
+                                               int pool_stride_h,
+                                               int filter_size_h,
+                                               int pad_w,
+                                               int pool_stride_w,
+                                               int filter_size_w,
+                                               const miopenTensorDescriptor_t& bot_,
+                                               const miopenTensorDescriptor_t& top_,
+                                               const Tgpu_* bot_ptr,
+                                               const Tgpu_* top_ptr,
+                                               bool do_backward,
+                                               size_t* mask_ptr,
+                                               Index* mask_gpu,
+                                               Tcheck_ allowedEps,
+                                               pooling_math_stats& stats,
+                                               int index_position = 1)
+{
+    const bool is_max = pooling_method == MLO_POOLING_OP_MAX;
+    if(!is_max && pooling_method != MLO_POOLING_OP_AVE &&
+       pooling_method != MLO_POOLING_OP_AVE_INCLUSIVE)
+    {
+        std::cout << "ERROR: unknown operator : layer: pooling." << std::endl;
+        return false;
+    }
+
+    const auto bot = mlo_host::GetNcdhw(bot_);
+    const auto top = mlo_host::GetNcdhw(top_);
+
+    const int bot_depth  = bot.lens[2];
+    const int bot_height = bot.lens[3];
+    const int bot_width  = bot.lens[4];
+
+    // Mask data is always NCDHW
+    const auto mask = mlo_host::Ncdhw{
+        top.lens,
+        {top.lens[1] * top.lens[2] * top.lens[3] * top.lens[4],
+         top.lens[2] * top.lens[3] * top.lens[4],
+         top.lens[3] * top.lens[4],
+         top.lens[4],
+         1}};
+
+    const Tcheck_ MAX_VAL(3.402823466e+38);
+    const Tgpu_ G_MAX_VAL = (sizeof(Tgpu_) == 4 || sizeof(Tgpu_) == 8)
+                                ? static_cast<Tgpu_>(3.402823466e+38)
+                                : static_cast<Tgpu_>(65504);
+
+    struct RowResult
+    {
+        double max_error          = 0.0;
+        int max_num_flops_per_res = 0;
+        bool failed               = false;
+        std::string report;
+    };
+
+    const auto rows = mlo_host::Rows{top};
+    auto results    = std::vector<RowResult>(rows.Count());
+
+    rows.ParForEach([&](std::size_t row, const mlo_host::Index& idx) {
+        auto& result = results[row];
+
+        const int b = idx[0], o = idx[1], k = idx[2], j = idx[3], i = idx[4];
+
+        // c-emulator
+        Tcheck_ res           = is_max ? -MAX_VAL : static_cast<Tcheck_>(0);
+        int num_flops_per_res = 0;
+
+        int dstart = k * pool_stride_d - pad_d;
+        int hstart = j * pool_stride_h - pad_h;
+        int wstart = i * pool_stride_w - pad_w;
+        int dend   = std::min(dstart + filter_size_d, bot_depth);
+        int hend   = std::min(hstart + filter_size_h, bot_height);
+        int wend   = std::min(wstart + filter_size_w, bot_width);
+        dstart     = std::max(dstart, 0);
+        hstart     = std::max(hstart, 0);
+        wstart     = std::max(wstart, 0);
+
+        int pool_size;
+        if(pooling_method == MLO_POOLING_OP_AVE)
+            pool_size = (dend - dstart) * (hend - hstart) * (wend - wstart);
+        else
+            pool_size = filter_size_w * filter_size_h * filter_size_d;
+        pool_size = (pool_size == 0) ? 1 : pool_size;
+
+        // special index value is used to mark top points which has no associated bottom points
+        size_t res_index     = std::numeric_limits<size_t>::max();
+        size_t res_index_gpu = std::numeric_limits<uint8_t>::max();
+        for(int d = dstart; d < dend; ++d)
+        {
+            for(int h = hstart; h < hend; ++h)
+            {
+                for(int w = wstart; w < wend; ++w)
+                {
+                    const auto bot_index = bot.Offset(b, o, d, h, w);
+                    const auto bot_val   = static_cast<Tcheck_>(bot_ptr[bot_index]);
+                    if(is_max)
+                    {
+                        if(bot_val > res)
+                        {
+                            res               = bot_val;
+                            num_flops_per_res = 0;
+                            res_index         = bot_index;
+                            res_index_gpu =
+                                index_position == 1
+                                    ? (d * bot_height * bot_width + h * bot_width + w)
+                                    : ((d - k * pool_stride_d + pad_d) * filter_size_w *
+                                       filter_size_h) +
+                                          ((h - j * pool_stride_h + pad_h) * filter_size_w) +
+                                          (w - i * pool_stride_w + pad_w);
+                        }
+                    }
+                    else
+                    {
+#if MLO_POOLING_EMULATE_VALIDATION_FAILURE
+                        if(num_flops_per_res % MLO_POOLING_EMULATE_VALIDATION_FAILURE != 0)
+#endif
+                            res += bot_val;
+                        ++num_flops_per_res;
+                    }
+                }
+            }
+        }
+
+        const auto top_index = top.Offset(idx);
+        std::ostringstream report;
+        if(is_max)
+        {
+            // the case with the odd input, the even kernel size and 2*pad == kernel size
+            mask_ptr[top_index] = res_index;
+            if(do_backward)
+            {
+                size_t mg = mask_gpu[mask.Offset(idx)];
+                if(mg != res_index_gpu)
+                {
+                    report << "Mask mismatch, gpu " << mg << " cpu " << res_index_gpu << "("
+                           << res_index << ")" << std::endl;
+                }
+            }
+        }
+        else
+        {
+            res /= pool_size;
+            ++num_flops_per_res;
+        }
+        Tcheck_ c_val = res;
+
+        Tgpu_ gg_val = (top_ptr[top_index]);
+
+        gg_val = (Tgpu_(gg_val) == Tgpu_(-G_MAX_VAL)) ? Tgpu_(0) : Tgpu_(gg_val);
+
+        c_val = (c_val == -MAX_VAL) ? 0 : c_val;
+
+        Tcheck_ g_val(gg_val);
+
+        double err = std::abs(c_val - g_val);
+
+        if(err > allowedEps || std::isnan(c_val) || std::isnan(g_val) || !std::isfinite(c_val) ||
+           !std::isfinite(g_val))
+        {
+            report << "Difference " << err << " too large (> " << allowedEps << ") at {" << b
+                   << ',' << o << ',' << j << ',' << i << "}, cpu_val = " << c_val
+                   << " vs gpu_val = " << g_val << std::endl;
+            report << "Number of flops used: " << num_flops_per_res
+                   << ", pool_size: " << pool_size << std::endl;
+        }
+
+        if(!result.failed && report.tellp() > 0)
+        {
+            result.failed = true;
+            result.report = report.str();
+        }
+        result.max_error             = std::max(result.max_error, err);
+        result.max_num_flops_per_res = std::max(result.max_num_flops_per_res, num_flops_per_res);
+    });
+
+    bool match = true;
+    for(const auto& result : results)
+    {
+        if(result.failed && match)
+        {
+            std::cout << result.report;
+            match = false;
+        }
+        stats.max_error = std::max(stats.max_error, result.max_error);
+        stats.max_num_flops_per_res =
+            std::max(stats.max_num_flops_per_res, result.max_num_flops_per_res);
+    }
+
+    return (match);
+}
+
+/// Parallel version of mloPoolingBackwardRunHost(). Each bottom point gathers the gradients of
+/// the top points whose windows cover it, in the order the serial version scatters them.
+template <typename Tgpu_ /* the data type used in GPU computations (usually half) */,
+          typename Tcheck_ /* the data type used in CPU checkings (usually double) */>
+void mloPoolingBackwardRunHostParallel(int pooling_method,
+                                       int filter_size_d,
+                                       int pad_d,
+                                       int pool_stride_d,
+                                       int filter_size_h,
+                                       int pad_h,
+                                       int pool_stride_h,
+                                       int filter_size_w,
+                                       int pad_w,
+                                       int pool_stride_w,
+                                       const miopenTensorDescriptor_t& bot_df_,
+                                       const miopenTensorDescriptor_t& top_df_,
+                                       Tcheck_* bot_df_v_ptr,
+                                       const Tgpu_* top_df_ptr,
+                                       const size_t* mask_ptr,
+                                       pooling_math_stats& stats)
+{
+    const bool is_max = pooling_method == MLO_POOLING_OP_MAX;
+    if(!is_max && pooling_method != MLO_POOLING_OP_AVE &&
+       pooling_method != MLO_POOLING_OP_AVE_INCLUSIVE)
+    {
+        std::cout << "ERROR: unknown operator : layer: pooling back-propagation." << std::endl;
+        return;
+    }
+
+    const auto bot_df = mlo_host::GetNcdhw(bot_df_);
+    const auto top_df = mlo_host::GetNcdhw(top_df_);
+
+    const int bot_d = bot_df.lens[2], bot_h = bot_df.lens[3], bot_w = bot_df.lens[4];
+    const int top_d = top_df.lens[2], top_h = top_df.lens[3], top_w = top_df.lens[4];
+
+    const auto rows = mlo_host::Rows{bot_df};
+    auto num_flops  = std::vector<int>(rows.Count(), 0);
+
+    rows.ParForEach([&](std::size_t row, const mlo_host::Index& idx) {
+        const int b = idx[0], o = idx[1], k = idx[2], j = idx[3], i = idx[4];
+
+        const auto bot_idx = bot_df.Offset(idx);
+
+        int d       = k + pad_d;
+        int h       = j + pad_h;
+        int w       = i + pad_w;
+        int pdstart = (d < filter_size_d) ? 0 : (d - filter_size_d) / pool_stride_d + 1;
+        int pdend   = std::min(d / pool_stride_d + 1, top_d);
+        int phstart = (h < filter_size_h) ? 0 : (h - filter_size_h) / pool_stride_h + 1;
+        int phend   = std::min(h / pool_stride_h + 1, top_h);
+        int pwstart = (w < filter_size_w) ? 0 : (w - filter_size_w) / pool_stride_w + 1;
+        int pwend   = std::min(w / pool_stride_w + 1, top_w);
+
+        Tcheck_ gradient     = static_cast<Tcheck_>(0);
+        int gradient_n_flops = 0;
+        for(int pd = pdstart; pd < pdend; ++pd)
+        {
+            for(int ph = phstart; ph < phend; ++ph)
+            {
+                for(int pw = pwstart; pw < pwend; ++pw)
+                {
+                    const auto top_idx = top_df.Offset(b, o, pd, ph, pw);
+                    if(is_max)
+                    {
+                        if(mask_ptr[top_idx] != bot_idx)
+                            continue;
+                        gradient += static_cast<Tcheck_>(top_df_ptr[top_idx]);
+                        ++gradient_n_flops;
+                        continue;
+                    }
+
+                    // figure out the pooling size
+                    int dstart = pd * pool_stride_d - pad_d;
+                    int hstart = ph * pool_stride_h - pad_h;
+                    int wstart = pw * pool_stride_w - pad_w;
+                    int dend   = std::min(dstart + filter_size_d, bot_d);
+                    int hend   = std::min(hstart + filter_size_h, bot_h);
+                    int wend   = std::min(wstart + filter_size_w, bot_w);
+                    dstart     = std::max(dstart, 0);
+                    hstart     = std::max(hstart, 0);
+                    wstart     = std::max(wstart, 0);
+
+                    int pool_size;
+                    if(pooling_method == MLO_POOLING_OP_AVE)
+                        pool_size = (dend - dstart) * (hend - hstart) * (wend - wstart);
+                    else
+                        pool_size = filter_size_w * filter_size_h * filter_size_d;
+                    pool_size = (pool_size == 0) ? 1 : pool_size;
+
+                    gradient += static_cast<Tcheck_>(top_df_ptr[top_idx]) /
+                                static_cast<Tcheck_>(pool_size);
+                    gradient_n_flops += 2; // pool_size is computed using integer ops, do not
+                                           // count those.
+                }
+            }
+        }
+        bot_df_v_ptr[bot_idx] = gradient;
+        num_flops[row]        = std::max(num_flops[row], gradient_n_flops);
+    });
+
+    stats.max_num_flops_per_res = *(std::max_element(num_flops.begin(), num_flops.end()));
+}
+
 #ifdef __clang__
 #pragma clang diagnostic pop
 #endif
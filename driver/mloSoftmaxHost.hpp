@@ -25,6 +25,12 @@ POSSIBILITY OF SUCH DAMAGE.
 #ifndef MLO_SOFTMAXHOST_H_
 #define MLO_SOFTMAXHOST_H_
 
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "mloHostIndex.hpp"
+
 ////////////////////////////////////////////////////////////
 //
 ///////////////////////////////////////////////////////////
@@ -364,4 +370,214 @@ int mloSoftmaxBackwardRunHost(miopenTensorDescriptor_t dInputTensor,
     return ret;
 }
 
+/// Parallel version of mloSoftmaxForwardRunHost(), for any layout of the tensors. In the instance
+/// mode the sums are accumulated per row and the rows are added in order, so the result doesn't
+/// depend on the number of threads but may differ from the serial one in the last bits.
+template <typename Tgpu, typename Tcheck /* the data type used in CPU checkings (usually double) */>
+int mloSoftmaxForwardRunHostParallel(miopenTensorDescriptor_t inputTensor,
+                                     miopenTensorDescriptor_t outputTensor,
+                                     Tgpu* in,
+                                     Tcheck* outhost,
+                                     float alpha,
+                                     float beta,
+                                     miopenSoftmaxAlgorithm_t algo,
+                                     miopenSoftmaxMode_t mode)
+{
+    const auto in_t  = mlo_host::GetNcdhw(inputTensor);
+    const auto out_t = mlo_host::GetNcdhw(outputTensor);
+    const int n      = in_t.lens[0];
+    const int c      = in_t.lens[1];
+
+    Tcheck max_val = (sizeof(Tgpu) == 4) ? 3.402823466e+38f : 65504.;
+    Tcheck neg_inf = static_cast<Tcheck>(
+        miopen::deref(inputTensor).GetType() == miopenHalf ? NEGATIVE_INF_FP16 : NEGATIVE_INF_FP32);
+
+    // Shifted inputs and then their exponents, in the layout of the output.
+    std::vector<Tcheck> results(miopen::deref(outputTensor).GetElementSpace(),
+                                static_cast<Tcheck>(0.0));
+
+    const auto write_out = [&](std::size_t out_off, Tcheck sum) {
+        if(algo == MIOPEN_SOFTMAX_LOG)
+            outhost[out_off] = alpha * (results[out_off] - sum) + beta * outhost[out_off];
+        else
+            outhost[out_off] = alpha * (results[out_off] / sum) + beta * outhost[out_off];
+    };
+
+    if(mode == MIOPEN_SOFTMAX_MODE_INSTANCE)
+    {
+        const auto rows = mlo_host::Rows{in_t.lens, in_t.strides, 0};
+        auto row_max    = std::vector<Tcheck>(rows.Count(), static_cast<Tcheck>(-max_val));
+        auto inst_max   = std::vector<Tcheck>(n, static_cast<Tcheck>(-max_val));
+
+        // logaddexp() accumulates from the negative infinity, the sum of exponents from zero.
+        const Tcheck zero = algo == MIOPEN_SOFTMAX_LOG ? neg_inf : static_cast<Tcheck>(0.0);
+        auto row_sum      = std::vector<Tcheck>(rows.Count(), zero);
+        auto inst_sum     = std::vector<Tcheck>(n, zero);
+
+        // Rows are merged in order. The batch is kept outermost, so a row never spans two
+        // instances, even if all the other dimensions are 1.
+        const auto merge = [&](const auto& per_row, auto& per_inst, auto op) {
+            for(std::size_t row = 0; row < rows.Count(); ++row)
+            {
+                auto& acc = per_inst[rows.Start(row)[0]];
+                acc       = op(per_row[row], acc);
+            }
+        };
+
+        if(algo != MIOPEN_SOFTMAX_FAST)
+        {
+            rows.ParForEach([&](std::size_t row, const mlo_host::Index& idx) {
+                row_max[row] = std::max(static_cast<Tcheck>(in[in_t.Offset(idx)]), row_max[row]);
+            });
+            merge(row_max, inst_max, [](Tcheck x, Tcheck y) { return std::max(x, y); });
+        }
+
+        rows.ParForEach([&](std::size_t row, const mlo_host::Index& idx) {
+            const auto out_off = out_t.Offset(idx);
+            results[out_off]   = static_cast<Tcheck>(in[in_t.Offset(idx)]);
+            if(algo != MIOPEN_SOFTMAX_FAST)
+                results[out_off] -= inst_max[idx[0]];
+
+            if(algo == MIOPEN_SOFTMAX_LOG)
+            {
+                row_sum[row] = logaddexp(results[out_off], row_sum[row], neg_inf);
+            }
+            else
+            {
+                results[out_off] = exp(results[out_off]);
+                row_sum[row] += results[out_off];
+            }
+        });
+
+        if(algo == MIOPEN_SOFTMAX_LOG)
+            merge(row_sum, inst_sum, [&](Tcheck x, Tcheck y) { return logaddexp(x, y, neg_inf); });
+        else
+            merge(row_sum, inst_sum, [](Tcheck x, Tcheck y) { return y + x; });
+
+        mlo_host::ParForEachIndex(in_t, [&](const mlo_host::Index& idx) {
+            write_out(out_t.Offset(idx), inst_sum[idx[0]]);
+        });
+    }
+    else
+    {
+        // Each pixel is normalized over its channels.
+        auto pixels = in_t.lens;
+        pixels[1]   = 1;
+        mlo_host::Rows{pixels, in_t}.ParForEach([&](std::size_t, const mlo_host::Index& idx) {
+            const auto in_base  = in_t.Offset(idx);
+            const auto out_base = out_t.Offset(idx);
+            const auto in_off   = [&](int j) { return in_base + j * in_t.strides[1]; };
+            const auto out_off  = [&](int j) { return out_base + j * out_t.strides[1]; };
+
+            Tcheck channel_max = static_cast<Tcheck>(-max_val);
+            if(algo != MIOPEN_SOFTMAX_FAST)
+            {
+                for(int j = 0; j < c; j++)
+                    channel_max = std::max(static_cast<Tcheck>(in[in_off(j)]), channel_max);
+            }
+            for(int j = 0; j < c; j++)
+            {
+                results[out_off(j)] = static_cast<Tcheck>(in[in_off(j)]);
+                if(algo != MIOPEN_SOFTMAX_FAST)
+                    results[out_off(j)] -= channel_max;
+            }
+
+            Tcheck sum = static_cast<Tcheck>(0.0);
+            if(algo == MIOPEN_SOFTMAX_LOG)
+            {
+                sum = results[out_off(0)];
+                for(int j = 1; j < c; j++)
+                    sum = logaddexp(results[out_off(j)], sum, neg_inf);
+            }
+            else
+            {
+                for(int j = 0; j < c; j++)
+                {
+                    results[out_off(j)] = exp(results[out_off(j)]);
+                    sum += results[out_off(j)];
+                }
+            }
+
+            for(int j = 0; j < c; j++)
+                write_out(out_off(j), sum);
+        });
+    }
+
+    return 0;
+}
+
+/// Parallel version of mloSoftmaxBackwardRunHost(), see mloSoftmaxForwardRunHostParallel().
+template <typename Tgpu /* the data type used in GPU computations (usually half) */,
+          typename Tcheck /* the data type used in CPU checkings (usually double) */>
+int mloSoftmaxBackwardRunHostParallel(miopenTensorDescriptor_t dInputTensor,
+                                      miopenTensorDescriptor_t dOutputTensor,
+                                      Tgpu* out,
+                                      Tgpu* dout,
+                                      Tcheck* dinhost,
+                                      float alpha,
+                                      float beta,
+                                      miopenSoftmaxAlgorithm_t algo,
+                                      miopenSoftmaxMode_t mode)
+{
+    const auto in_t  = mlo_host::GetNcdhw(dInputTensor);
+    const auto out_t = mlo_host::GetNcdhw(dOutputTensor);
+    const int n      = out_t.lens[0];
+    const int c      = out_t.lens[1];
+
+    const auto dot_term = [&](std::size_t out_off) {
+        if(algo == MIOPEN_SOFTMAX_LOG)
+            return static_cast<Tcheck>(dout[out_off]);
+        return static_cast<Tcheck>(out[out_off]) * static_cast<Tcheck>(dout[out_off]);
+    };
+    const auto write_din = [&](const mlo_host::Index& idx, Tcheck channel_dot) {
+        const auto out_off = out_t.Offset(idx);
+        const auto in_off  = in_t.Offset(idx);
+        Tcheck result;
+        if(algo == MIOPEN_SOFTMAX_LOG)
+        {
+            result = static_cast<Tcheck>(dout[out_off]) - channel_dot * std::exp(out[out_off]);
+        }
+        else
+        {
+            result = static_cast<Tcheck>(dout[out_off]) - channel_dot;
+            result *= static_cast<Tcheck>(out[out_off]);
+        }
+        dinhost[in_off] = alpha * result + beta * dinhost[in_off];
+    };
+
+    if(mode == MIOPEN_SOFTMAX_MODE_INSTANCE)
+    {
+        const auto rows = mlo_host::Rows{out_t.lens, out_t.strides, 0};
+        auto row_dot    = std::vector<Tcheck>(rows.Count(), static_cast<Tcheck>(0.0));
+        auto inst_dot   = std::vector<Tcheck>(n, static_cast<Tcheck>(0.0));
+
+        rows.ParForEach([&](std::size_t row, const mlo_host::Index& idx) {
+            row_dot[row] += dot_term(out_t.Offset(idx));
+        });
+        for(std::size_t row = 0; row < rows.Count(); ++row)
+            inst_dot[rows.Start(row)[0]] += row_dot[row];
+
+        mlo_host::ParForEachIndex(out_t, [&](const mlo_host::Index& idx) {
+            write_din(idx, inst_dot[idx[0]]);
+        });
+    }
+    else
+    {
+        auto pixels = out_t.lens;
+        pixels[1]   = 1;
+        mlo_host::Rows{pixels, out_t}.ParForEach([&](std::size_t, const mlo_host::Index& idx) {
+            auto channel = idx;
+
+            Tcheck channel_dot = static_cast<Tcheck>(0.0);
+            for(channel[1] = 0; channel[1] < c; channel[1]++)
+                channel_dot += dot_term(out_t.Offset(channel));
+
+            for(channel[1] = 0; channel[1] < c; channel[1]++)
+                write_din(channel, channel_dot);
+        });
+    }
+
+    return 0;
+}
+
 #endif
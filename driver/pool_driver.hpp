@@ -39,6 +39,7 @@
 #include <miopen/tensor.hpp>
 #include <miopen/pooling.hpp>
 #include <numeric>
+#include <sstream>
 #include <vector>
 #include "random.hpp"
 
@@ -81,6 +82,7 @@ public:
 
     int RunBackwardGPU() override;
     int RunBackwardCPU(); // Verify implements it
+    std::string GetVerificationCacheKey() const;
 
     int VerifyBackward() override;
     int VerifyForward() override;
@@ -111,6 +113,7 @@ private:
 
     miopenPoolingDescriptor_t poolDesc;
     bool do_backward;
+    mlo_host::Impl host_ref;
 
     miopenTensorDescriptor_t dInputTensor;
     miopenTensorDescriptor_t dOutputTensor;
@@ -134,7 +137,9 @@ int PoolDriver_impl<Tgpu, Tref, Index>::ParseCmdLineArgs(int argc, char* argv[])
 {
     inflags.Parse(argc, argv);
 
-    do_backward = !(inflags.GetValueInt("forw"));
+    do_backward        = !(inflags.GetValueInt("forw"));
+    host_ref           = mlo_host::GetImpl(inflags.GetValueStr("host_ref"));
+    verification_cache = VerificationCache::FromCmdLineArgs(inflags);
 
     if(inflags.GetValueInt("time") == 1)
     {
@@ -197,6 +202,7 @@ int PoolDriver_impl<Tgpu, Tref, Index>::AddCmdLineArgs()
         "index_position", 'M', "0", "Image index 1, mask index 0 (Default=0)", "int");
     inflags.AddInputFlag("iter", 'i', "10", "Number of Iterations (Default=10)", "int");
     inflags.AddInputFlag("verify", 'V', "1", "Verify Each Layer (Default=1)", "int");
+    VerificationCache::AddCmdLineArgs(inflags);
     inflags.AddInputFlag("time", 't', "0", "Time Each Layer (Default=0)", "int");
     inflags.AddInputFlag(
         "wall", 'w', "0", "Wall-clock Time Each Layer, Requires time == 1 (Default=0)", "int");
@@ -214,6 +220,11 @@ int PoolDriver_impl<Tgpu, Tref, Index>::AddCmdLineArgs()
     inflags.AddInputFlag("in_data", 'j', "", "Input data filename (Default=none)", "str");
     inflags.AddInputFlag("out_data", 'k', "", "Output data filename for bwd (Default=none)", "str");
     inflags.AddInputFlag("dump_root", 'l', "", "Directory to dump buffers (Default=none)", "str");
+    inflags.AddInputFlag("host_ref",
+                         'R',
+                         "parallel",
+                         "Host reference implementation (serial, parallel) (Default=parallel)",
+                         "str");
 
     return 0;
 }
@@ -327,9 +338,9 @@ std::vector<int> PoolDriver_impl<Tgpu, Tref, Index>::GetOutputTensorLengths()
 
 namespace detail {
 template <typename T>
-T RanGenInput()
+T RanGenInput(double u)
 {
-    return RAN_GEN<T>(static_cast<T>(0.0), static_cast<T>(1.0));
+    return prng::scale(u, static_cast<T>(0.0), static_cast<T>(1.0));
 }
 
 #define FP16IN_NORMAL 1
@@ -338,23 +349,24 @@ T RanGenInput()
 #define FP16IN_SPARSE_X 0 // non-zero value defines "sparsity"
 
 template <>
-float16 RanGenInput()
+float16 RanGenInput(double u)
 {
     using T = float16;
 #if FP16IN_NORMAL
-    return RAN_GEN<T>(static_cast<T>(0.0), static_cast<T>(1.0));
+    return prng::scale(u, static_cast<T>(0.0), static_cast<T>(1.0));
 #endif
 #if FP16IN_CONST_SMALLEST_NORMALIZED
     return static_cast<T>(+1.0p-eh) // (6.103515625E-05);
 #endif
 #if FP16IN_5VALUES_0_TO_1
-           const int r = GET_RAND() % 5; // values from 0 to 4
-    return static_cast<T>(r * 0.25);     // { 0.0, 0.25, 0.5, 0.75, 1.0 }
+           const int r = static_cast<int>(u * 5); // values from 0 to 4
+    return static_cast<T>(r * 0.25);              // { 0.0, 0.25, 0.5, 0.75, 1.0 }
 #endif
 #if FP16IN_SPARSE_X
-    if(GET_RAND() % (FP16IN_SPARSE_X) != 0) // produce 9 zeros in ~ each 10 values
+    const double x = u * (FP16IN_SPARSE_X);
+    if(x >= 1.0) // produce 9 zeros in ~ each 10 values
         return static_cast<T>(0.0);
-    return RAN_GEN<T>(static_cast<T>(0.0), static_cast<T>(1.0));
+    return prng::scale(x, static_cast<T>(0.0), static_cast<T>(1.0));
 #endif
 }
 } // namespace detail
@@ -398,10 +410,9 @@ int PoolDriver_impl<Tgpu, Tref, Index>::AllocateBuffersAndCopy()
 
     if(in_filename.empty() || !readBufferFromFile<Tgpu>(in.data(), in_sz, in_filename.c_str()))
     {
-        for(int i = 0; i < in_sz; i++)
-        {
-            in[i] = detail::RanGenInput<Tgpu>();
-        }
+        prng::generate(in.data(), in_sz, [](std::size_t, double u) {
+            return detail::RanGenInput<Tgpu>(u);
+        });
 
         if(!dump_root.empty())
             dumpBufferToFile<Tgpu>((dump_root + "/dump_in.bin").c_str(), in.data(), in_sz);
@@ -410,10 +421,9 @@ int PoolDriver_impl<Tgpu, Tref, Index>::AllocateBuffersAndCopy()
     if(out_filename.empty() || !readBufferFromFile<Tgpu>(dout.data(), out_sz, out_filename.c_str()))
     {
         Tgpu Data_scale = static_cast<Tgpu>(0.001);
-        for(int i = 0; i < out_sz; i++)
-        {
-            dout[i] = Data_scale * RAN_GEN<Tgpu>(static_cast<Tgpu>(-0.5), static_cast<Tgpu>(0.5));
-        }
+        prng::generate(dout.data(), out_sz, [=](std::size_t, double u) {
+            return Data_scale * prng::scale(u, static_cast<Tgpu>(-0.5), static_cast<Tgpu>(0.5));
+        });
 
         if(!dump_root.empty())
             dumpBufferToFile<Tgpu>((dump_root + "/dump_dout.bin").c_str(), dout.data(), out_sz);
@@ -652,28 +662,31 @@ int PoolDriver_impl<Tgpu, Tref, Index>::VerifyForward()
         : sizeof(Tgpu) == 4 ? 1e-5  // float
                             : 5e-3; // half
 
+    const auto verify = host_ref == mlo_host::Impl::Serial
+                            ? mloPoolingForwardRunHostAndVerify<Tgpu, Tref, Index>
+                            : mloPoolingForwardRunHostAndVerifyParallel<Tgpu, Tref, Index>;
+
     pooling_math_stats stats;
-    bool match = mloPoolingForwardRunHostAndVerify<Tgpu, Tref, Index>(
-        pooling_method,
-        pad_d,
-        stride_d,
-        windowDepth,
-        pad_h,
-        stride_h,
-        windowHeight,
-        pad_w,
-        stride_w,
-        windowWidth,
-        inputTensor,
-        outputTensor,
-        in.data(),
-        out.data(),
-        do_backward,
-        maskhost.data(),
-        mask.data(),
-        tolerance,
-        stats,
-        spatial_dim == 3 ? 1 : inflags.GetValueInt("index_position"));
+    bool match = verify(pooling_method,
+                        pad_d,
+                        stride_d,
+                        windowDepth,
+                        pad_h,
+                        stride_h,
+                        windowHeight,
+                        pad_w,
+                        stride_w,
+                        windowWidth,
+                        inputTensor,
+                        outputTensor,
+                        in.data(),
+                        out.data(),
+                        do_backward,
+                        maskhost.data(),
+                        mask.data(),
+                        tolerance,
+                        stats,
+                        spatial_dim == 3 ? 1 : inflags.GetValueInt("index_position"));
 
     if(match)
         std::cout << "Forward Pooling Verifies on CPU and GPU (" << stats.max_error << ", "
@@ -690,6 +703,28 @@ int PoolDriver_impl<Tgpu, Tref, Index>::RunBackwardCPU()
     return 0;
 }
 
+// The forward reference is computed along with the comparison, so only the backward one
+// is cached. It takes the mask of the forward reference, which is part of the problem.
+template <typename Tgpu, typename Tref, typename Index>
+std::string PoolDriver_impl<Tgpu, Tref, Index>::GetVerificationCacheKey() const
+{
+    const auto& pooling = miopen::deref(poolDesc);
+
+    std::ostringstream ss;
+    ss << VerificationCache::GetTensorKey(inputTensor);
+    ss << "_" << VerificationCache::GetTensorKey(dInputTensor);
+    ss << "_" << VerificationCache::GetTensorKey(dOutputTensor);
+    ss << "_" << pooling.GetMode() << "_" << pooling.pmode;
+    miopen::LogRange(ss << "_", pooling.GetLengths(), "x");
+    miopen::LogRange(ss << "_", pooling.GetPads(), "x");
+    miopen::LogRange(ss << "_", pooling.GetStrides(), "x");
+    ss << "_" << pooling.GetWorkspaceIndexMode();
+    ss << "_" << inflags.GetValueInt("index_position");
+    ss << "_" << VerificationCache::GetTypeName<Index>();
+    ss << "_" << VerificationCache::GetTypeName<Tgpu>();
+    return ss.str();
+}
+
 template <typename Tgpu, typename Tref, typename Index>
 int PoolDriver_impl<Tgpu, Tref, Index>::VerifyBackward()
 {
@@ -781,23 +816,32 @@ int PoolDriver_impl<Tgpu, Tref, Index>::VerifyBackward()
             : ((mode == miopenPoolingAverage) ? MLO_POOLING_OP_AVE : MLO_POOLING_OP_AVE_INCLUSIVE);
 
     pooling_math_stats stats;
-    mloPoolingBackwardRunHost<Tgpu, Tref>(pooling_method,
-                                          windowDepth,
-                                          pad_d,
-                                          stride_d,
-                                          windowHeight,
-                                          pad_h,
-                                          stride_h,
-                                          windowWidth,
-                                          pad_w,
-                                          stride_w,
-                                          dInputTensor,
-                                          dOutputTensor,
-                                          // host output
-                                          dinhost.data(),
-                                          dout.data(),
-                                          maskhost.data(),
-                                          stats);
+    const auto key = GetVerificationCacheKey();
+    if(!verification_cache.Read("pool_bwd_dat", key, dinhost))
+    {
+        const auto run_host = host_ref == mlo_host::Impl::Serial
+                                  ? mloPoolingBackwardRunHost<Tgpu, Tref>
+                                  : mloPoolingBackwardRunHostParallel<Tgpu, Tref>;
+
+        run_host(pooling_method,
+                 windowDepth,
+                 pad_d,
+                 stride_d,
+                 windowHeight,
+                 pad_h,
+                 stride_h,
+                 windowWidth,
+                 pad_w,
+                 stride_w,
+                 dInputTensor,
+                 dOutputTensor,
+                 // host output
+                 dinhost.data(),
+                 dout.data(),
+                 maskhost.data(),
+                 stats);
+        verification_cache.Save("pool_bwd_dat", key, dinhost);
+    }
 
     float ulps_tolerance = 4;
     Tref diff_tolerance  = (sizeof(Tgpu) == 4 || sizeof(Tgpu) == 8) ? static_cast<Tref>(1e-6)
@@ -1,16 +1,96 @@
 #ifndef GUARD_RANDOM_GEN_
 #define GUARD_RANDOM_GEN_
 
+#include <miopen/par_for.hpp>
+#include <miopen/xorwow.hpp>
+
+#include <algorithm>
 #include <cstdlib>
 
+/// All the input data of the driver comes from a single stream of numbers, so
+/// the data depends only on the order of requests, not on the number of threads
+/// used to generate it. The driver caches verification data, any change of the
+/// stream must update the cache key (see prng::stream_id and prng::seed).
+namespace prng {
+namespace details {
+
+// Per thread, so that the tests can draw from it in parallel (see test/random.hpp).
+inline miopen::Xorwow& get_engine()
+{
+    static thread_local miopen::Xorwow engine{};
+    return engine;
+}
+
+inline unsigned long long& get_seed()
+{
+    static thread_local unsigned long long seed = 0;
+    return seed;
+}
+
+// Fixed, so that the blocks (and their results) don't depend on the number of threads.
+constexpr std::size_t block_size = 1 << 16;
+
+} // namespace details
+
+constexpr const char* stream_id = "xorwow";
+
+/// Restarts the stream, like srand().
+inline void reset_seed(unsigned long long seed = 0)
+{
+    details::get_seed()   = seed;
+    details::get_engine() = miopen::Xorwow{seed};
+}
+
+/// The seed the stream was last restarted with.
+inline unsigned long long seed() { return details::get_seed(); }
+
+/// Moves the stream forward as if n numbers were drawn.
+inline void skip(std::size_t n) { details::get_engine().Discard(n); }
+
+/// data[i] = f(i, u_i) for i in [0, n), where u_i in [0, 1) are the next n numbers of
+/// the stream. Produces the same result as a serial loop, but runs in parallel.
+template <typename T, typename F>
+void generate(T* data, std::size_t n, F f)
+{
+    const auto& engine = details::get_engine();
+    const auto blocks  = (n + details::block_size - 1) / details::block_size;
+    miopen::par_for(blocks, miopen::min_grain{1}, [&](std::size_t block) {
+        auto block_engine = engine;
+        const auto first  = block * details::block_size;
+        const auto last   = std::min(n, first + details::block_size);
+        block_engine.Discard(first);
+        for(auto i = first; i < last; ++i)
+            data[i] = f(i, block_engine.Canonical());
+    });
+    skip(n);
+}
+
+/// Maps u in [0, 1) to [A, B) the same way as RAN_GEN<T>(A, B).
+template <typename T>
+T scale(double u, T A, T B)
+{
+    return (static_cast<T>(u) * (B - A)) + A;
+}
+
+/// Parallel equivalent of n RAN_GEN<T>(A, B) calls.
+template <typename T>
+void fill(T* data, std::size_t n, T A, T B)
+{
+    generate(data, n, [=](std::size_t, double u) { return scale(u, A, B); });
+}
+
+} // namespace prng
+
 template <typename T>
 inline T FRAND()
 {
-    double d = static_cast<double>(rand() / (static_cast<double>(RAND_MAX)));
-    return static_cast<T>(d);
+    return static_cast<T>(prng::details::get_engine().Canonical());
 }
 
-inline int GET_RAND() { return rand(); }
+inline int GET_RAND()
+{
+    return static_cast<int>(prng::details::get_engine()() % (RAND_MAX + 1U));
+}
 
 template <typename T>
 inline T RAN_GEN(T A, T B)
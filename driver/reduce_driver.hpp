@@ -39,6 +39,7 @@
 #include <miopen/reduce_common.hpp>
 #include <miopen/tensor.hpp>
 #include <numeric>
+#include <sstream>
 #include <vector>
 #include <string>
 #include <cassert>
@@ -79,6 +80,7 @@ public:
 
     int RunForwardGPU() override;
     int RunForwardCPU();
+    std::string GetVerificationCacheKey() const;
 
     int RunBackwardGPU() override;
     int RunBackwardCPU();
@@ -126,6 +128,10 @@ int ReduceDriver<Tgpu, Tref>::ParseCmdLineArgs(int argc, char* argv[])
 {
     inflags.Parse(argc, argv);
 
+    // The key does not cover the input data read from a file.
+    if(inflags.GetValueStr("in_data").empty())
+        verification_cache = VerificationCache::FromCmdLineArgs(inflags);
+
     if(inflags.GetValueInt("time") == 1)
     {
         miopenEnableProfiling(GetHandle(), true);
@@ -208,6 +214,7 @@ int ReduceDriver<Tgpu, Tref>::AddCmdLineArgs()
 
     inflags.AddInputFlag("iter", 'i', "1", "Number of Iterations (Default=1)", "int");
     inflags.AddInputFlag("verify", 'V', "1", "Verify Each Layer (Default=1)", "int");
+    VerificationCache::AddCmdLineArgs(inflags, 'c');
     inflags.AddInputFlag("time", 't', "0", "Time Each Layer (Default=0)", "int");
     inflags.AddInputFlag("dump_output", 'o', "0", "Dumps the output buffers (Default=0)", "int");
     inflags.AddInputFlag("in_data", 'd', "", "Input data filename (Default=)", "string");
@@ -462,6 +469,22 @@ int ReduceDriver<Tgpu, Tref>::RunBackwardGPU()
     return miopenStatusSuccess;
 }
 
+template <typename Tgpu, typename Tref>
+std::string ReduceDriver<Tgpu, Tref>::GetVerificationCacheKey() const
+{
+    std::ostringstream ss;
+    ss << VerificationCache::GetTensorKey(inputTensor);
+    ss << "_" << VerificationCache::GetTensorKey(outputTensor);
+    ss << "_" << inflags.GetValueInt("ReduceOp");
+    ss << "_" << inflags.GetValueInt("CompType");
+    ss << "_" << inflags.GetValueInt("NanPropagation");
+    ss << "_" << inflags.GetValueInt("IndicesUsed");
+    ss << "_" << inflags.GetValueDouble("alpha");
+    ss << "_" << inflags.GetValueDouble("beta");
+    ss << "_" << VerificationCache::GetTypeName<Tgpu>();
+    return ss.str();
+}
+
 template <typename Tgpu, typename Tref>
 int ReduceDriver<Tgpu, Tref>::VerifyForward()
 {
@@ -482,7 +505,16 @@ int ReduceDriver<Tgpu, Tref>::VerifyForward()
         beta  = 0.0f;
     };
 
-    hostReduction.Run(alpha, in.data(), beta, outhost.data(), outhost_indices.data());
+    const auto key = GetVerificationCacheKey();
+    if(!(verification_cache.Read("reduce_fwd_out", key, outhost) &&
+         (outhost_indices.empty() ||
+          verification_cache.Read("reduce_fwd_indices", key, outhost_indices))))
+    {
+        hostReduction.Run(alpha, in.data(), beta, outhost.data(), outhost_indices.data());
+        verification_cache.Save("reduce_fwd_out", key, outhost);
+        if(!outhost_indices.empty())
+            verification_cache.Save("reduce_fwd_indices", key, outhost_indices);
+    }
 
     auto error       = miopen::rms_range(outhost, out);
     double tolerance = 1.5e-4;
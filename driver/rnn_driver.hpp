@@ -653,7 +653,7 @@ int RNNDriver<Tgpu, Tref>::AllocateBuffersAndCopy()
         std::string weiFileName = inflags.GetValueStr("weights");*/
 
     // Unless seed is persistent between runs validation using cache stored in file is impossible.
-    srand(0);
+    prng::reset_seed();
     double scale = 0.01;
 
     /*    bool dataRead = false;
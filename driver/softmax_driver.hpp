@@ -39,6 +39,7 @@
 #include <miopen/miopen.h>
 #include <miopen/tensor.hpp>
 #include <numeric>
+#include <sstream>
 #include <vector>
 #include "random.hpp"
 
@@ -68,6 +69,7 @@ public:
 
     int RunForwardGPU() override;
     int RunForwardCPU();
+    std::string GetVerificationCacheKey() const;
 
     int RunBackwardGPU() override;
     int RunBackwardCPU();
@@ -111,12 +113,15 @@ private:
     float beta;
     miopenSoftmaxAlgorithm_t algo;
     miopenSoftmaxMode_t mode;
+    mlo_host::Impl host_ref;
 };
 
 template <typename Tgpu, typename Tref>
 int SoftmaxDriver<Tgpu, Tref>::ParseCmdLineArgs(int argc, char* argv[])
 {
     inflags.Parse(argc, argv);
+    host_ref           = mlo_host::GetImpl(inflags.GetValueStr("host_ref"));
+    verification_cache = VerificationCache::FromCmdLineArgs(inflags);
 
     if(inflags.GetValueInt("time") == 1)
     {
@@ -162,9 +167,15 @@ int SoftmaxDriver<Tgpu, Tref>::AddCmdLineArgs()
         "mode", 'm', "1", "instance mode (0), channel mode (1) (Default=1)", "int");
     inflags.AddInputFlag("iter", 'i', "10", "Number of Iterations (Default=10)", "int");
     inflags.AddInputFlag("verify", 'V', "1", "Verify Each Layer (Default=1)", "int");
+    VerificationCache::AddCmdLineArgs(inflags);
     inflags.AddInputFlag("time", 't', "0", "Time Each Layer (Default=0)", "int");
     inflags.AddInputFlag(
         "wall", 'w', "0", "Wall-clock Time Each Layer, Requires time == 1 (Default=0)", "int");
+    inflags.AddInputFlag("host_ref",
+                         'R',
+                         "parallel",
+                         "Host reference implementation (serial, parallel) (Default=parallel)",
+                         "str");
 
     return miopenStatusSuccess;
 }
@@ -207,16 +218,12 @@ int SoftmaxDriver<Tgpu, Tref>::AllocateBuffersAndCopy()
     dout    = std::vector<Tgpu>(out_sz, static_cast<Tgpu>(0));
     dinhost = std::vector<Tref>(in_sz, static_cast<Tref>(0));
 
-    for(int i = 0; i < in_sz; i++)
-    {
-        in[i] = RAN_GEN<Tgpu>(static_cast<Tgpu>(0.0), static_cast<Tgpu>(1.0));
-    }
+    prng::fill(in.data(), in_sz, static_cast<Tgpu>(0.0), static_cast<Tgpu>(1.0));
 
     Tgpu Data_scale = static_cast<Tgpu>(0.001);
-    for(int i = 0; i < out_sz; i++)
-    {
-        dout[i] = Data_scale * RAN_GEN<Tgpu>(static_cast<Tgpu>(-0.5), static_cast<Tgpu>(0.5));
-    }
+    prng::generate(dout.data(), out_sz, [=](std::size_t, double u) {
+        return Data_scale * prng::scale(u, static_cast<Tgpu>(-0.5), static_cast<Tgpu>(0.5));
+    });
 
 #if MIOPEN_BACKEND_OPENCL
     cl_int status;
@@ -333,11 +340,31 @@ int SoftmaxDriver<Tgpu, Tref>::RunBackwardGPU()
     return miopenStatusSuccess;
 }
 
+// The backward reference takes the output of the GPU, so only the forward one is cached.
+template <typename Tgpu, typename Tref>
+std::string SoftmaxDriver<Tgpu, Tref>::GetVerificationCacheKey() const
+{
+    std::ostringstream ss;
+    ss << VerificationCache::GetTensorKey(inputTensor);
+    ss << "_" << VerificationCache::GetTensorKey(outputTensor);
+    ss << "_" << alpha << "_" << beta;
+    ss << "_" << algo << "_" << mode;
+    ss << "_" << VerificationCache::GetTypeName<Tgpu>();
+    return ss.str();
+}
+
 template <typename Tgpu, typename Tref>
 int SoftmaxDriver<Tgpu, Tref>::VerifyForward()
 {
-    mloSoftmaxForwardRunHost<Tgpu, Tref>(
-        inputTensor, outputTensor, in.data(), outhost.data(), alpha, beta, algo, mode);
+    const auto key = GetVerificationCacheKey();
+    if(!verification_cache.Read("softmax_fwd_out", key, outhost))
+    {
+        const auto run_host = host_ref == mlo_host::Impl::Serial
+                                  ? mloSoftmaxForwardRunHost<Tgpu, Tref>
+                                  : mloSoftmaxForwardRunHostParallel<Tgpu, Tref>;
+        run_host(inputTensor, outputTensor, in.data(), outhost.data(), alpha, beta, algo, mode);
+        verification_cache.Save("softmax_fwd_out", key, outhost);
+    }
 
     auto error           = miopen::rms_range(outhost, out);
     const Tref tolerance = data_type == miopenHalf ? 5e-2 : 1e-3; // 1e-6;
@@ -363,15 +390,18 @@ int SoftmaxDriver<Tgpu, Tref>::RunBackwardCPU()
 template <typename Tgpu, typename Tref>
 int SoftmaxDriver<Tgpu, Tref>::VerifyBackward()
 {
-    mloSoftmaxBackwardRunHost<Tgpu, Tref>(inputTensor,
-                                          outputTensor,
-                                          out.data(),
-                                          dout.data(),
-                                          dinhost.data(),
-                                          alpha,
-                                          beta,
-                                          algo,
-                                          mode);
+    const auto run_host = host_ref == mlo_host::Impl::Serial
+                              ? mloSoftmaxBackwardRunHost<Tgpu, Tref>
+                              : mloSoftmaxBackwardRunHostParallel<Tgpu, Tref>;
+    run_host(inputTensor,
+             outputTensor,
+             out.data(),
+             dout.data(),
+             dinhost.data(),
+             alpha,
+             beta,
+             algo,
+             mode);
 
     auto error           = miopen::rms_range(dinhost, din);
     const Tref tolerance = data_type == miopenHalf ? 5e-2 : 1e-3; // 1e-6;
@@ -0,0 +1,404 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#ifndef GUARD_MIOPEN_VERIFICATION_CACHE_HPP
+#define GUARD_MIOPEN_VERIFICATION_CACHE_HPP
+
+#include "half.hpp"
+#include "InputFlags.hpp"
+#include "random.hpp"
+
+#include <miopen/bfloat16.hpp>
+#include <miopen/errors.hpp>
+#include <miopen/logger.hpp>
+#include <miopen/md5.hpp>
+#include <miopen/miopen.h>
+#include <miopen/par_for.hpp>
+#include <miopen/tensor.hpp>
+
+#if MIOPEN_DRIVER_COMPRESS_VERIFICATION_CACHE
+#include <bzlib.h>
+#endif
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+/// Host reference results of the drivers, kept between the runs, so that a sweep over
+/// solvers (or anything else which does not change the problem) computes them once.
+///
+/// An entry is identified by the operation, the problem key, the data type and the seed
+/// of the input data stream, and lives in a file of the directory given with -C. The file
+/// is named after the operation and the md5 of the rest of the key, which is kept in the
+/// file and compared when reading, as problem keys may be too long for a file name. The
+/// data is split into fixed size chunks, compressed separately when the driver is built
+/// with bzip2, so that both saving and reading run in parallel. The file is mapped into
+/// memory when read and the chunks are decompressed (or copied) straight into the host
+/// buffer of the driver.
+class VerificationCache
+{
+public:
+    VerificationCache() = default;
+    explicit VerificationCache(std::string directory_) : directory(std::move(directory_)) {}
+
+    static void AddCmdLineArgs(InputFlags& inflags, char short_name = 'C')
+    {
+        inflags.AddInputFlag("verification_cache",
+                             short_name,
+                             "",
+                             "Use specified directory to cache verification data. Off by default.",
+                             "string");
+    }
+
+    static VerificationCache FromCmdLineArgs(const InputFlags& inflags)
+    {
+        return VerificationCache{inflags.GetValueStr("verification_cache")};
+    }
+
+    bool IsEnabled() const { return !directory.empty(); }
+
+    template <typename T>
+    static std::string GetTypeName()
+    {
+        if(std::is_same<T, half_float::half>::value)
+            return "float16";
+        if(std::is_same<T, bfloat16>::value)
+            return "bfloat16";
+        if(std::is_same<T, float>::value)
+            return "float";
+        if(std::is_same<T, double>::value)
+            return "double";
+        if(std::is_integral<T>::value)
+            return (std::is_signed<T>::value ? "int" : "uint") + std::to_string(8 * sizeof(T));
+        MIOPEN_THROW("unknown data type");
+    }
+
+    /// Lengths and strides of the tensor, for the problem keys.
+    static std::string GetTensorKey(miopenTensorDescriptor_t tensor)
+    {
+        std::ostringstream ss;
+        miopen::LogRange(ss, miopen::deref(tensor).GetLengths(), "x");
+        miopen::LogRange(ss << "_", miopen::deref(tensor).GetStrides(), "x");
+        return ss.str();
+    }
+
+    /// Fills data with the cached entry, returns false if there is no valid one.
+    template <typename T>
+    bool Read(const std::string& operation,
+              const std::string& problem,
+              T* data,
+              std::size_t count) const
+    {
+        if(!IsEnabled())
+            return false;
+
+        const auto key       = GetKey<T>(problem);
+        const auto file_path = GetFilePath(operation, key);
+        const MappedFile file{file_path};
+        if(file.data == nullptr)
+            return false;
+
+        const auto size = count * sizeof(T);
+        Header header;
+        std::vector<Chunk> chunks;
+        if(!ReadIndex(file, key, sizeof(T), count, header, chunks))
+        {
+            printf("Ignored invalid verification cache file %s\n", file_path.c_str());
+            return false;
+        }
+
+        auto bytes = reinterpret_cast<char*>(data);
+        std::vector<char> unpacked(chunks.size(), 0);
+        miopen::par_for(chunks.size(), miopen::min_grain{1}, [&](std::size_t i) {
+            const auto& chunk   = chunks[i];
+            const auto first    = i * header.chunk_size;
+            const auto raw_size = std::min<std::size_t>(header.chunk_size, size - first);
+            const auto src      = file.data + chunk.offset;
+            if(Unpack(src, chunk.size, chunk.compressed != 0, bytes + first, raw_size))
+                unpacked[i] = 1;
+        });
+
+        if(std::find(unpacked.begin(), unpacked.end(), 0) != unpacked.end())
+        {
+            printf("Could not read verification data from file %s\n", file_path.c_str());
+            return false;
+        }
+
+        printf("Read verification data from file %s\n", file_path.c_str());
+        return true;
+    }
+
+    template <typename T>
+    bool Read(const std::string& operation, const std::string& problem, std::vector<T>& data) const
+    {
+        return Read(operation, problem, data.data(), data.size());
+    }
+
+    template <typename T>
+    void Save(const std::string& operation,
+              const std::string& problem,
+              const T* data,
+              std::size_t count) const
+    {
+        if(!IsEnabled())
+            return;
+
+        const auto size  = count * sizeof(T);
+        const auto bytes = reinterpret_cast<const char*>(data);
+
+        Header header{};
+        std::copy_n(Magic(), sizeof(header.magic), header.magic);
+        const auto key    = GetKey<T>(problem);
+        header.key_size   = key.size();
+        header.type_size  = sizeof(T);
+        header.count      = count;
+        header.chunk_size = chunk_size;
+        header.num_chunks = (size + chunk_size - 1) / chunk_size;
+
+        // Chunks which do not compress well enough are stored as is and left empty here.
+        std::vector<std::string> packed(header.num_chunks);
+        miopen::par_for(header.num_chunks, miopen::min_grain{1}, [&](std::size_t i) {
+            const auto first = i * chunk_size;
+            packed[i]        = Pack(bytes + first, std::min<std::size_t>(chunk_size, size - first));
+        });
+
+        std::vector<Chunk> chunks(header.num_chunks);
+        std::size_t offset = sizeof(Header) + key.size() + chunks.size() * sizeof(Chunk);
+        for(std::size_t i = 0; i < chunks.size(); ++i)
+        {
+            chunks[i].offset     = offset;
+            chunks[i].size       = packed[i].empty()
+                                       ? std::min<std::size_t>(chunk_size, size - i * chunk_size)
+                                       : packed[i].size();
+            chunks[i].compressed = packed[i].empty() ? 0 : 1;
+            offset += chunks[i].size;
+        }
+
+        // Written aside and renamed, so that concurrent runs never see a partial file.
+        const auto file_path = GetFilePath(operation, key);
+        const auto temp_path = file_path + "." + std::to_string(getpid()) + ".tmp";
+        {
+            std::ofstream file(temp_path, std::ios::binary);
+            file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            file.write(key.data(), static_cast<std::streamsize>(key.size()));
+            file.write(reinterpret_cast<const char*>(chunks.data()),
+                       chunks.size() * sizeof(Chunk));
+            for(std::size_t i = 0; i < chunks.size(); ++i)
+            {
+                const auto chunk_bytes = static_cast<std::streamsize>(chunks[i].size);
+                if(packed[i].empty())
+                    file.write(bytes + i * chunk_size, chunk_bytes);
+                else
+                    file.write(packed[i].data(), chunk_bytes);
+            }
+            if(!file)
+            {
+                printf("Could not write verification data to file %s\n", temp_path.c_str());
+                std::remove(temp_path.c_str());
+                return;
+            }
+        }
+
+        if(std::rename(temp_path.c_str(), file_path.c_str()) != 0)
+        {
+            printf("Could not write verification data to file %s\n", file_path.c_str());
+            std::remove(temp_path.c_str());
+            return;
+        }
+
+        printf("Wrote verification data to file %s\n", file_path.c_str());
+    }
+
+    template <typename T>
+    void
+    Save(const std::string& operation, const std::string& problem, const std::vector<T>& data) const
+    {
+        Save(operation, problem, data.data(), data.size());
+    }
+
+private:
+    struct Header
+    {
+        char magic[8];
+        std::uint64_t key_size;
+        std::uint64_t type_size;
+        std::uint64_t count;
+        std::uint64_t chunk_size;
+        std::uint64_t num_chunks;
+    };
+
+    struct Chunk
+    {
+        std::uint64_t offset;
+        std::uint64_t size;
+        std::uint64_t compressed;
+    };
+
+    struct MappedFile
+    {
+        explicit MappedFile(const std::string& path)
+        {
+            // NOLINTNEXTLINE (cppcoreguidelines-pro-type-vararg)
+            const auto fd = open(path.c_str(), O_RDONLY);
+            if(fd < 0)
+                return;
+            struct stat st = {};
+            if(fstat(fd, &st) == 0 && st.st_size > 0)
+            {
+                auto p = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+                if(p != MAP_FAILED)
+                {
+                    // The chunks are read by all threads at once.
+                    madvise(p, st.st_size, MADV_WILLNEED);
+                    data = static_cast<const char*>(p);
+                    size = st.st_size;
+                }
+            }
+            close(fd);
+        }
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+        ~MappedFile()
+        {
+            if(data != nullptr)
+                munmap(const_cast<char*>(data), size);
+        }
+
+        const char* data = nullptr;
+        std::size_t size = 0;
+    };
+
+    // Large enough to compress well, small enough to keep all the threads busy.
+    static constexpr std::size_t chunk_size = 1 << 22;
+
+    static const char* Magic() { return "MIOVC02"; }
+
+    template <typename T>
+    static std::string GetKey(const std::string& problem)
+    {
+        std::ostringstream ss;
+        ss << problem;
+        ss << "_" << GetTypeName<T>();
+        ss << "_" << prng::stream_id << prng::seed();
+        return ss.str();
+    }
+
+    std::string GetFilePath(const std::string& operation, const std::string& key) const
+    {
+        return directory + '/' + operation + "_" + miopen::md5(key);
+    }
+
+    static bool ReadIndex(const MappedFile& file,
+                          const std::string& key,
+                          std::size_t type_size,
+                          std::size_t count,
+                          Header& header,
+                          std::vector<Chunk>& chunks)
+    {
+        if(file.size < sizeof(Header))
+            return false;
+        std::memcpy(&header, file.data, sizeof(Header));
+
+        const auto size = type_size * count;
+        if(std::memcmp(header.magic, Magic(), sizeof(header.magic)) != 0 ||
+           header.key_size != key.size() || header.type_size != type_size ||
+           header.count != count || header.chunk_size == 0 ||
+           header.num_chunks != (size + header.chunk_size - 1) / header.chunk_size ||
+           file.size < sizeof(Header) + key.size() + header.num_chunks * sizeof(Chunk) ||
+           std::memcmp(file.data + sizeof(Header), key.data(), key.size()) != 0)
+            return false;
+
+        chunks.resize(header.num_chunks);
+        std::memcpy(chunks.data(),
+                    file.data + sizeof(Header) + key.size(),
+                    chunks.size() * sizeof(Chunk));
+        return std::all_of(chunks.begin(), chunks.end(), [&](const Chunk& chunk) {
+            return chunk.offset <= file.size && chunk.size <= file.size - chunk.offset;
+        });
+    }
+
+    /// Returns an empty string, if the chunk is to be stored uncompressed.
+    static std::string Pack(const char* src, std::size_t size)
+    {
+#if MIOPEN_DRIVER_COMPRESS_VERIFICATION_CACHE
+        // Decompression is not free, so it has to save at least 1/8 of the size.
+        std::string packed(size - size / 8, '\0');
+        auto packed_size = static_cast<unsigned int>(packed.size());
+        const auto e     = BZ2_bzBuffToBuffCompress(&packed[0],
+                                                &packed_size,
+                                                const_cast<char*>(src),
+                                                static_cast<unsigned int>(size),
+                                                9,
+                                                0,
+                                                30);
+        if(e != BZ_OK)
+            return {};
+        packed.resize(packed_size);
+        return packed;
+#else
+        std::ignore = src;
+        std::ignore = size;
+        return {};
+#endif
+    }
+
+    static bool
+    Unpack(const char* src, std::size_t size, bool compressed, char* dst, std::size_t raw_size)
+    {
+        if(!compressed)
+        {
+            if(size != raw_size)
+                return false;
+            std::memcpy(dst, src, size);
+            return true;
+        }
+#if MIOPEN_DRIVER_COMPRESS_VERIFICATION_CACHE
+        auto unpacked_size = static_cast<unsigned int>(raw_size);
+        const auto e       = BZ2_bzBuffToBuffDecompress(
+            dst, &unpacked_size, const_cast<char*>(src), static_cast<unsigned int>(size), 0, 0);
+        return e == BZ_OK && unpacked_size == raw_size;
+#else
+        // Written by a driver with bzip2 support.
+        return false;
+#endif
+    }
+
+    std::string directory;
+};
+
+#endif // GUARD_MIOPEN_VERIFICATION_CACHE_HPP
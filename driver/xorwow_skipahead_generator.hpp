@@ -189,6 +189,19 @@ void generate_skipahead_matrices(unsigned int* matrix, bool is_skip_seq, bool is
     }
 }
 
+// write include guard in file, host headers only
+void write_guard_begin(std::ofstream& os, const std::string& guard)
+{
+    os << "#ifndef " << guard << std::endl;
+    os << "#define " << guard << std::endl;
+    os << std::endl;
+}
+
+void write_guard_end(std::ofstream& os, const std::string& guard)
+{
+    os << "#endif // " << guard << std::endl;
+}
+
 // write macros in file
 void write_macro(std::ofstream& os, bool is_device)
 {
@@ -243,11 +256,13 @@ void generate_skipahead_file()
 
     std::ofstream os;
     os.open("../src/include/miopen/precalc_xorwow_skipahead_matrices.hpp");
+    write_guard_begin(os, "GUARD_MIOPEN_PRECALC_XORWOW_SKIPAHEAD_MATRICES_HPP");
     write_macro(os, false);
     write_mat(os,
               "precalc_xorwow_skipahead_matrices",
               static_cast<unsigned int*>(&skipahead_matrices[0][0]),
               false);
+    write_guard_end(os, "GUARD_MIOPEN_PRECALC_XORWOW_SKIPAHEAD_MATRICES_HPP");
     os.close();
     os.clear();
 
@@ -261,11 +276,13 @@ void generate_skipahead_file()
     os.clear();
 
     os.open("../src/include/miopen/precalc_xorwow_skipahead_sequence_matrices.hpp");
+    write_guard_begin(os, "GUARD_MIOPEN_PRECALC_XORWOW_SKIPAHEAD_SEQUENCE_MATRICES_HPP");
     write_macro(os, false);
     write_mat(os,
               "precalc_xorwow_skipahead_sequence_matrices",
               static_cast<unsigned int*>(&skipahead_matrices_sequence[0][0]),
               false);
+    write_guard_end(os, "GUARD_MIOPEN_PRECALC_XORWOW_SKIPAHEAD_SEQUENCE_MATRICES_HPP");
     os.close();
     os.clear();
 
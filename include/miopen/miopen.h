@@ -109,6 +109,7 @@ typedef enum
     miopenStatusUnsupportedOp        = 8, /*!< Unsupported operator for fusion. */
     miopenStatusGpuOperationsSkipped = 9, /*!< This is not an error. */
     miopenStatusVersionMismatch = 10, /*!< Version mismatch of the supplied binary data argment. */
+    miopenStatusCanceled        = 11, /*!< Operation has been cancelled. */
 } miopenStatus_t;
 
 /*! @brief Get character string for an error code.
@@ -249,6 +250,34 @@ MIOPEN_EXPORT miopenStatus_t miopenGetKernelTime(miopenHandle_t handle, float* t
  * @return           miopenStatus_t
  */
 MIOPEN_EXPORT miopenStatus_t miopenEnableProfiling(miopenHandle_t handle, bool enable);
+
+/*! @brief Get the invoker cache statistics of the handle
+ *
+ * Invokers are cached per problem and solver. Lookups that find an invoker are counted as hits,
+ * the others as misses. Evictions count problems removed from the cache because of its capacity.
+ * @param handle     MIOpen handle (input)
+ * @param hits       Number of cache hits (output)
+ * @param misses     Number of cache misses (output)
+ * @param evictions  Number of evicted problems (output)
+ * @return           miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenGetInvokerCacheStatistics(miopenHandle_t handle,
+                                                             size_t* hits,
+                                                             size_t* misses,
+                                                             size_t* evictions);
+
+/*! @brief Set the invoker cache capacity of the handle
+ *
+ * Limits the number of problems the cache keeps invokers for. The least recently used problems
+ * are evicted first. Problems holding the results of miopenFindConvolution*Algorithm are kept,
+ * as the convolution calls use them, and don't count against the capacity. Zero means unbounded,
+ * which is the default unless overridden with the MIOPEN_INVOKER_CACHE_CAPACITY environment
+ * variable.
+ * @param handle     MIOpen handle (input)
+ * @param capacity   Maximum number of problems (input)
+ * @return           miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenSetInvokerCacheCapacity(miopenHandle_t handle, size_t capacity);
 /** @} */
 // CLOSEOUT HANDLE DOXYGEN GROUP
 
@@ -4901,6 +4930,76 @@ miopenStatus_t miopenFindSolutions(miopenHandle_t handle,
                                    size_t* numSolutions,
                                    size_t maxSolutions);
 
+/*! @brief The miopenFindFuture object holds the result of an asynchronous find.
+ */
+MIOPEN_DECLARE_OBJECT(miopenFindFuture);
+
+/*! @brief Starts finding solutions to a problem on a background thread and returns immediately.
+ *
+ * Asynchronous finds are executed one at a time in the order they have been started. The handle,
+ * as well as the buffers preallocated in the find options, must stay valid until the find is
+ * completed. Using the same handle from other threads during the find is not supported, so a
+ * separate handle is recommended for the asynchronous find. The problem and the options are copied
+ * and may be destroyed right after the call.
+ *
+ * @param handle       Handle to execute the kernels
+ * @param problem      Problem to solve
+ * @param options      Find options. When null default values would be used
+ * @param maxSolutions Limits the amount of results
+ * @param future       Pointer to the future to initialize
+ * @return             miopenStatus_t
+ */
+miopenStatus_t miopenFindSolutionsAsync(miopenHandle_t handle,
+                                        miopenProblem_t problem,
+                                        miopenFindOptions_t options,
+                                        size_t maxSolutions,
+                                        miopenFindFuture_t* future);
+
+/*! @brief Checks whether an asynchronous find is completed without blocking.
+ *
+ * @param future     Future to check
+ * @param ready      Pointer to a location where to write one if the find is completed or zero
+ * otherwise
+ * @return           miopenStatus_t
+ */
+miopenStatus_t miopenIsFindFutureReady(miopenFindFuture_t future, int* ready);
+
+/*! @brief Waits for an asynchronous find to complete.
+ *
+ * @param future     Future to wait for
+ * @return           miopenStatus_t
+ */
+miopenStatus_t miopenWaitFindFuture(miopenFindFuture_t future);
+
+/*! @brief Requests cancellation of an asynchronous find. The find stops at the next benchmarking
+ * or tuning step, after which miopenGetFindFutureSolutions returns miopenStatusCanceled.
+ *
+ * @param future     Future to cancel
+ * @return           miopenStatus_t
+ */
+miopenStatus_t miopenCancelFindFuture(miopenFindFuture_t future);
+
+/*! @brief Waits for an asynchronous find to complete and gets its results. Returns the error
+ * status of the find if it has failed.
+ *
+ * @param future       Future to get the results from
+ * @param solutions    Pointer to the first result. Must not be null
+ * @param numSolutions Pointer to the amount of results. Ignored if null
+ * @param maxSolutions Limits the amount of results
+ * @return             miopenStatus_t
+ */
+miopenStatus_t miopenGetFindFutureSolutions(miopenFindFuture_t future,
+                                            miopenSolution_t* solutions,
+                                            size_t* numSolutions,
+                                            size_t maxSolutions);
+
+/*! @brief Destroys a future. A find that is still running is cancelled and waited for.
+ *
+ * @param future     Future to destroy
+ * @return           miopenStatus_t
+ */
+miopenStatus_t miopenDestroyFindFuture(miopenFindFuture_t future);
+
 /*! @brief Values of a tensor argument for the miopenRunSolution function.
  */
 struct miopenTensorArgument_t
@@ -4969,6 +5068,19 @@ miopenStatus_t miopenSaveSolution(miopenSolution_t solution, char* data);
  */
 miopenStatus_t miopenGetSolutionSize(miopenSolution_t solution, size_t* size);
 
+/*! @brief Builds the kernels of a solution and embeds their code objects into it.
+ *
+ * Embedded kernels, the performance config and the kernel launch parameters are written by
+ * miopenSaveSolution. A solution loaded from such data is run without reading the performance
+ * database and without compiling or loading kernels from the kernel cache, as long as it is run on
+ * the same device as the kernels were built for. Otherwise embedded kernels are ignored.
+ *
+ * @param handle     Handle to build the kernels with
+ * @param solution   Solution to embed the kernels into
+ * @return           miopenStatus_t
+ */
+miopenStatus_t miopenEmbedSolutionKernels(miopenHandle_t handle, miopenSolution_t solution);
+
 /*! @brief Reads the amount of workspace required to exectute the solution.
  *
  * @param solution      Solution to get required workspace size
@@ -5001,6 +5113,93 @@ miopenStatus_t miopenGetSolutionSolverId(miopenSolution_t solution, uint64_t* so
  */
 miopenStatus_t miopenGetSolverIdConvAlgorithm(uint64_t solverId, miopenConvAlgorithm_t* result);
 
+/*! @brief The miopenFindSession object collects the problems of a whole network to find them
+ * together.
+ */
+MIOPEN_DECLARE_OBJECT(miopenFindSession);
+
+/*! @brief Initializes an empty find session object.
+ *
+ * @param session    Pointer to the session to initialize
+ * @return           miopenStatus_t
+ */
+miopenStatus_t miopenCreateFindSession(miopenFindSession_t* session);
+
+/*! @brief Destroys a find session object.
+ *
+ * @param session    Session to destroy
+ * @return           miopenStatus_t
+ */
+miopenStatus_t miopenDestroyFindSession(miopenFindSession_t session);
+
+/*! @brief Adds a problem to the find session. The problem is copied, so it may be destroyed right
+ * after the call. Problems identical to the ones added before are found only once.
+ *
+ * @param session    Session to add the problem to
+ * @param problem    Problem to add
+ * @param problemId  Pointer to a location where to write the id of the problem within the session.
+ * May be null
+ * @return           miopenStatus_t
+ */
+miopenStatus_t miopenFindSessionAddProblem(miopenFindSession_t session,
+                                           miopenProblem_t problem,
+                                           size_t* problemId);
+
+/*! @brief Finds solutions to all problems of the session. The workspace and the tensors used for
+ * benchmarking are allocated once and shared by all problems, unless they are preallocated by the
+ * find options.
+ *
+ * @param handle        Handle to execute the kernels
+ * @param session       Session to run
+ * @param options       Find options. When null default values would be used
+ * @param maxSolutions  Limits the number of solutions found per problem
+ * @return              miopenStatus_t
+ */
+miopenStatus_t miopenRunFindSession(miopenHandle_t handle,
+                                    miopenFindSession_t session,
+                                    miopenFindOptions_t options,
+                                    size_t maxSolutions);
+
+/*! @brief Selects a solution for every problem of the session, so the workspace shared by all of
+ * them is as small as possible, while the total time of the selected solutions stays within the
+ * given slowdown from the fastest choice. Requires miopenRunFindSession to be called first.
+ *
+ * @param session        Session to plan
+ * @param maxSlowdown    Allowed relative increase of the total time, e.g. 0.05 for 5%
+ * @param workspaceSize  Pointer to a location where to write the size of the shared workspace
+ * @return               miopenStatus_t
+ */
+miopenStatus_t miopenPlanFindSessionWorkspace(miopenFindSession_t session,
+                                              float maxSlowdown,
+                                              size_t* workspaceSize);
+
+/*! @brief Gets the solutions found for a problem of the session.
+ *
+ * @param session       Session to get the solutions from
+ * @param problemId     Id of the problem returned by miopenFindSessionAddProblem
+ * @param solutions     Pointer to the first result. Must not be null
+ * @param numSolutions  Pointer to the amount of results. Ignored if null
+ * @param maxSolutions  Limits the amount of results
+ * @return              miopenStatus_t
+ */
+miopenStatus_t miopenGetFindSessionSolutions(miopenFindSession_t session,
+                                             size_t problemId,
+                                             miopenSolution_t* solutions,
+                                             size_t* numSolutions,
+                                             size_t maxSolutions);
+
+/*! @brief Gets the solution selected for a problem by miopenPlanFindSessionWorkspace, or the first
+ * one found if the workspace has not been planned.
+ *
+ * @param session    Session to get the solution from
+ * @param problemId  Id of the problem returned by miopenFindSessionAddProblem
+ * @param solution   Pointer to the solution to initialize
+ * @return           miopenStatus_t
+ */
+miopenStatus_t miopenGetFindSessionPlannedSolution(miopenFindSession_t session,
+                                                   size_t problemId,
+                                                   miopenSolution_t* solution);
+
 /** @} */
 // CLOSEOUT find2 DOXYGEN GROUP
 
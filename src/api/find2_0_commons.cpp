@@ -28,6 +28,8 @@
 
 #include <miopen/common.hpp>
 #include <miopen/errors.hpp>
+#include <miopen/find_future.hpp>
+#include <miopen/find_session.hpp>
 #include <miopen/handle.hpp>
 #include <miopen/logger.hpp>
 #include <miopen/problem.hpp>
@@ -38,6 +40,8 @@
 
 #include <nlohmann/json.hpp>
 
+#include <algorithm>
+
 extern "C" {
 miopenStatus_t miopenCreateConvProblem(miopenProblem_t* problem,
                                        miopenConvolutionDescriptor_t operatorDesc,
@@ -162,6 +166,73 @@ miopenStatus_t miopenFindSolutions(miopenHandle_t handle,
     });
 }
 
+miopenStatus_t miopenFindSolutionsAsync(miopenHandle_t handle,
+                                        miopenProblem_t problem,
+                                        miopenFindOptions_t options,
+                                        size_t maxSolutions,
+                                        miopenFindFuture_t* future)
+{
+    MIOPEN_LOG_FUNCTION(handle, problem, options, maxSolutions, future);
+
+    return miopen::try_([&] {
+        auto& handle_deref        = miopen::deref(handle);
+        const auto& problem_deref = miopen::deref(problem);
+        const auto& options_deref =
+            options == nullptr ? miopen::FindOptions{} : miopen::deref(options);
+
+        miopen::deref(future) =
+            new miopen::FindFuture{handle_deref, problem_deref, options_deref, maxSolutions};
+    });
+}
+
+miopenStatus_t miopenIsFindFutureReady(miopenFindFuture_t future, int* ready)
+{
+    MIOPEN_LOG_FUNCTION(future, ready);
+
+    return miopen::try_([&] {
+        if(ready == nullptr)
+            MIOPEN_THROW(miopenStatusBadParm, "Ready parameter should not be a nullptr.");
+        *ready = miopen::deref(future).IsReady() ? 1 : 0;
+    });
+}
+
+miopenStatus_t miopenWaitFindFuture(miopenFindFuture_t future)
+{
+    MIOPEN_LOG_FUNCTION(future);
+    return miopen::try_([&] { miopen::deref(future).Wait(); });
+}
+
+miopenStatus_t miopenCancelFindFuture(miopenFindFuture_t future)
+{
+    MIOPEN_LOG_FUNCTION(future);
+    return miopen::try_([&] { miopen::deref(future).Cancel(); });
+}
+
+miopenStatus_t miopenGetFindFutureSolutions(miopenFindFuture_t future,
+                                            miopenSolution_t* solutions,
+                                            size_t* numSolutions,
+                                            size_t maxSolutions)
+{
+    MIOPEN_LOG_FUNCTION(future, solutions, numSolutions, maxSolutions);
+
+    return miopen::try_([&] {
+        const auto& solutions_deref = miopen::deref(future).GetSolutions();
+        const auto count            = std::min(maxSolutions, solutions_deref.size());
+
+        for(auto i = std::size_t{0}; i < count; ++i)
+            miopen::deref(solutions + i) = new miopen::Solution{solutions_deref[i]};
+
+        if(numSolutions != nullptr)
+            *numSolutions = count;
+    });
+}
+
+miopenStatus_t miopenDestroyFindFuture(miopenFindFuture_t future)
+{
+    MIOPEN_LOG_FUNCTION(future);
+    return miopen::try_([&] { miopen_destroy_object(future); });
+}
+
 inline std::ostream& operator<<(std::ostream& stream, const miopenTensorArgument_t& tensor)
 {
     switch(tensor.id)
@@ -276,6 +347,17 @@ miopenStatus_t miopenGetSolutionSize(miopenSolution_t solution, size_t* size)
     });
 }
 
+miopenStatus_t miopenEmbedSolutionKernels(miopenHandle_t handle, miopenSolution_t solution)
+{
+    MIOPEN_LOG_FUNCTION(handle, solution);
+
+    return miopen::try_([&] {
+        auto& handle_deref   = miopen::deref(handle);
+        auto& solution_deref = miopen::deref(solution);
+        solution_deref.EmbedKernels(handle_deref);
+    });
+}
+
 miopenStatus_t miopenGetSolutionWorkspaceSize(miopenSolution_t solution, size_t* workspaceSize)
 {
     MIOPEN_LOG_FUNCTION(solution, workspaceSize);
@@ -319,4 +401,90 @@ miopenStatus_t miopenGetSolverIdConvAlgorithm(uint64_t solverId, miopenConvAlgor
         *result = id_deref.GetAlgo();
     });
 }
+
+miopenStatus_t miopenCreateFindSession(miopenFindSession_t* session)
+{
+    MIOPEN_LOG_FUNCTION(session);
+    return miopen::try_([&] { miopen::deref(session) = new miopen::FindSession(); });
+}
+
+miopenStatus_t miopenDestroyFindSession(miopenFindSession_t session)
+{
+    MIOPEN_LOG_FUNCTION(session);
+    return miopen::try_([&] { miopen_destroy_object(session); });
+}
+
+miopenStatus_t
+miopenFindSessionAddProblem(miopenFindSession_t session, miopenProblem_t problem, size_t* problemId)
+{
+    MIOPEN_LOG_FUNCTION(session, problem, problemId);
+
+    return miopen::try_([&] {
+        const auto id = miopen::deref(session).AddProblem(miopen::deref(problem));
+        if(problemId != nullptr)
+            *problemId = id;
+    });
+}
+
+miopenStatus_t miopenRunFindSession(miopenHandle_t handle,
+                                    miopenFindSession_t session,
+                                    miopenFindOptions_t options,
+                                    size_t maxSolutions)
+{
+    MIOPEN_LOG_FUNCTION(handle, session, options, maxSolutions);
+
+    return miopen::try_([&] {
+        auto& handle_deref  = miopen::deref(handle);
+        auto& session_deref = miopen::deref(session);
+        const auto& options_deref =
+            options == nullptr ? miopen::FindOptions{} : miopen::deref(options);
+
+        session_deref.Run(handle_deref, options_deref, maxSolutions);
+    });
+}
+
+miopenStatus_t miopenPlanFindSessionWorkspace(miopenFindSession_t session,
+                                              float maxSlowdown,
+                                              size_t* workspaceSize)
+{
+    MIOPEN_LOG_FUNCTION(session, maxSlowdown, workspaceSize);
+
+    return miopen::try_([&] {
+        const auto size = miopen::deref(session).PlanWorkspace(maxSlowdown);
+        if(workspaceSize != nullptr)
+            *workspaceSize = size;
+    });
+}
+
+miopenStatus_t miopenGetFindSessionSolutions(miopenFindSession_t session,
+                                             size_t problemId,
+                                             miopenSolution_t* solutions,
+                                             size_t* numSolutions,
+                                             size_t maxSolutions)
+{
+    MIOPEN_LOG_FUNCTION(session, problemId, solutions, numSolutions, maxSolutions);
+
+    return miopen::try_([&] {
+        const auto& solutions_deref = miopen::deref(session).GetSolutions(problemId);
+        const auto count            = std::min(maxSolutions, solutions_deref.size());
+
+        for(auto i = std::size_t{0}; i < count; ++i)
+            miopen::deref(solutions + i) = new miopen::Solution{solutions_deref[i]};
+
+        if(numSolutions != nullptr)
+            *numSolutions = count;
+    });
+}
+
+miopenStatus_t miopenGetFindSessionPlannedSolution(miopenFindSession_t session,
+                                                   size_t problemId,
+                                                   miopenSolution_t* solution)
+{
+    MIOPEN_LOG_FUNCTION(session, problemId, solution);
+
+    return miopen::try_([&] {
+        const auto& solution_deref = miopen::deref(session).GetPlannedSolution(problemId);
+        miopen::deref(solution)    = new miopen::Solution{solution_deref};
+    });
+}
 }
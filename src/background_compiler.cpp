@@ -0,0 +1,203 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/background_compiler.hpp>
+
+#include <miopen/env.hpp>
+#include <miopen/logger.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <thread>
+
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_AOT_COMPILE_THREADS)
+
+namespace miopen {
+
+static std::size_t GetThreadCount()
+{
+    const auto threads = Value(MIOPEN_AOT_COMPILE_THREADS{});
+    if(threads != 0)
+        return threads;
+    return std::max(std::thread::hardware_concurrency() / 4, 1u);
+}
+
+static bool& IsWorker()
+{
+    thread_local bool is_worker = false;
+    return is_worker;
+}
+
+// Set once, by the first Get(). Constant-initialized, so it is usable at any point of the exit.
+static std::atomic<BackgroundCompiler*> instance{nullptr};
+
+BackgroundCompiler& BackgroundCompiler::Get()
+{
+    // Never destroyed: handles cancel their jobs when they are destroyed, which for static ones
+    // happens at exit, after the function-local statics created later than them are gone.
+    static BackgroundCompiler* const created = []() {
+        auto* const compiler = new BackgroundCompiler{};
+        instance             = compiler;
+        return compiler;
+    }();
+    return *created;
+}
+
+// The workers are not niced: a foreground thread may have to wait for a program one of them is
+// compiling, and the priority could not be raised back then.
+BackgroundCompiler::BackgroundCompiler() : pool(GetThreadCount(), []() { IsWorker() = true; })
+{
+}
+
+bool BackgroundCompiler::IsWorkerThread() { return IsWorker(); }
+
+void BackgroundCompiler::Enqueue(const std::string& key,
+                                 std::function<void()> job,
+                                 const void* owner)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if(!pending.insert(key).second)
+            return;
+        queued.push_back({key, owner, std::move(job)});
+    }
+
+    MIOPEN_LOG_I2("Queued for background compilation: " << key);
+    // Every task runs the first queued job, if any, as the jobs may be stolen in the meantime.
+    try
+    {
+        pool.Submit([this]() {
+            auto lock = std::unique_lock<std::mutex>{mutex};
+            RunNext(lock);
+        });
+    }
+    catch(...)
+    {
+        StealJob(key);
+        throw;
+    }
+}
+
+bool BackgroundCompiler::RunNext(std::unique_lock<std::mutex>& lock)
+{
+    if(queued.empty())
+        return false;
+
+    auto job = std::move(queued.front());
+    queued.pop_front();
+    running.emplace(job.key, job.owner);
+    lock.unlock();
+
+    try
+    {
+        job.run();
+    }
+    catch(const std::exception& ex)
+    {
+        MIOPEN_LOG_W("Background compilation of " << job.key << " failed: " << ex.what());
+    }
+    catch(...)
+    {
+        MIOPEN_LOG_W("Background compilation of " << job.key << " failed");
+    }
+
+    lock.lock();
+    running.erase(job.key);
+    pending.erase(job.key);
+    ++completed;
+    done.notify_all();
+    return true;
+}
+
+void BackgroundCompiler::Steal(const std::string& key)
+{
+    auto* const compiler = instance.load();
+    if(compiler != nullptr)
+        compiler->StealJob(key);
+}
+
+void BackgroundCompiler::Cancel(const void* owner)
+{
+    auto* const compiler = instance.load();
+    if(compiler != nullptr)
+        compiler->CancelJobs(owner);
+}
+
+void BackgroundCompiler::StealJob(const std::string& key)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    const auto job = std::find_if(
+        queued.begin(), queued.end(), [&](const Job& queued_job) { return queued_job.key == key; });
+    if(job == queued.end())
+        return;
+    MIOPEN_LOG_I2("Taken over from background compilation: " << key);
+    queued.erase(job);
+    pending.erase(key);
+    done.notify_all();
+}
+
+void BackgroundCompiler::CancelJobs(const void* owner)
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    for(auto job = queued.begin(); job != queued.end();)
+    {
+        if(job->owner != owner)
+        {
+            ++job;
+            continue;
+        }
+        pending.erase(job->key);
+        job = queued.erase(job);
+    }
+    done.notify_all();
+    done.wait(lock, [&]() {
+        return std::none_of(running.begin(), running.end(), [&](const auto& job) {
+            return job.second == owner;
+        });
+    });
+}
+
+void BackgroundCompiler::Wait()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    for(;;)
+    {
+        if(RunNext(lock))
+            continue;
+        if(running.empty())
+            return;
+        done.wait(lock);
+    }
+}
+
+std::size_t BackgroundCompiler::GetCompletedCount() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return completed;
+}
+
+} // namespace miopen
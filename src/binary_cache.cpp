@@ -37,17 +37,26 @@
 #include <miopen/sqlite_db.hpp>
 #endif
 #include <miopen/kern_db.hpp>
+#include <miopen/load_file.hpp>
+#include <miopen/lock_file.hpp>
+#include <miopen/single_flight.hpp>
 #include <miopen/db.hpp>
 #include <miopen/db_path.hpp>
 #include <miopen/target_properties.hpp>
+#include <miopen/timer.hpp>
 #include <boost/filesystem.hpp>
+#include <boost/interprocess/sync/file_lock.hpp>
+#include <array>
+#include <chrono>
 #include <fstream>
 #include <iostream>
+#include <mutex>
 
 namespace miopen {
 
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_DISABLE_CACHE)
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_CUSTOM_CACHE_DIR)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_COMPILE_LOCK_TIMEOUT)
 
 static boost::filesystem::path ComputeSysCachePath()
 {
@@ -92,12 +101,17 @@ static boost::filesystem::path ComputeUserCachePath()
 #endif
 }
 
+static boost::filesystem::path& GetUserCachePathOverride()
+{
+    static boost::filesystem::path path;
+    return path;
+}
+
 boost::filesystem::path GetCachePath(bool is_system)
 {
-    static const boost::filesystem::path user_path = ComputeUserCachePath();
-    static const boost::filesystem::path sys_path  = ComputeSysCachePath();
     if(is_system)
     {
+        static const boost::filesystem::path sys_path = ComputeSysCachePath();
         if(MIOPEN_DISABLE_SYSDB)
             return {};
         else
@@ -107,11 +121,21 @@ boost::filesystem::path GetCachePath(bool is_system)
     {
         if(MIOPEN_DISABLE_USERDB)
             return {};
-        else
-            return user_path;
+        const auto& custom = GetUserCachePathOverride();
+        if(!custom.empty())
+            return custom;
+        static const boost::filesystem::path user_path = ComputeUserCachePath();
+        return user_path;
     }
 }
 
+void SetUserCachePath(const boost::filesystem::path& path)
+{
+    if(!boost::filesystem::exists(path) && !MIOPEN_DISABLE_USERDB)
+        boost::filesystem::create_directories(path);
+    GetUserCachePathOverride() = path;
+}
+
 bool IsCacheDisabled()
 {
 #ifdef MIOPEN_CACHE_DIR
@@ -128,6 +152,7 @@ bool IsCacheDisabled()
 using KDb = DbTimer<MultiFileDb<KernDb, KernDb, false>>;
 KDb GetDb(const TargetProperties& target, size_t num_cu)
 {
+    TraceScope trace{"Kernel cache open"};
     static const auto user_dir = ComputeUserCachePath();
     static const auto sys_dir  = ComputeSysCachePath();
     boost::filesystem::path user_path =
@@ -254,4 +279,140 @@ void SaveBinary(const boost::filesystem::path& binary_path,
     }
 }
 #endif
+
+static SingleFlight<std::string>& GetCompileFlights()
+{
+    static SingleFlight<std::string> flights;
+    return flights;
+}
+
+static std::string LoadCodeObject(const TargetProperties& target,
+                                  std::size_t num_cu,
+                                  const std::string& name,
+                                  const std::string& args,
+                                  bool is_kernel_str)
+{
+#if MIOPEN_ENABLE_SQLITE_KERN_CACHE
+    return LoadBinary(target, num_cu, name, args, is_kernel_str);
+#else
+    const auto path = LoadBinary(target, num_cu, name, args, is_kernel_str);
+    return path.empty() ? std::string{} : LoadFile(path.string());
+#endif
+}
+
+namespace {
+
+/// One of the lock files taken by processes sharing the user cache while they compile.
+struct CompileLockStripe
+{
+    std::mutex mutex;
+    std::size_t holders = 0;
+    std::string path;
+    boost::interprocess::file_lock flock;
+};
+
+/// Processes sharing the user cache compile a program under a file lock, so the ones that
+/// start at the same time wait for the first one and then load its binary from the cache.
+/// Programs are mapped onto 256 lock files by the md5 of their key, so the number of files in
+/// the cache directory stays bounded. The file lock is shared by the threads of a process: the
+/// first thread compiling a program of the stripe takes it and the last one releases it, so
+/// unrelated programs compiled by one process never wait for each other. CompileOnce() already
+/// lets a single thread compile a given program.
+class CompileLock
+{
+public:
+    CompileLock(const std::string& key, const boost::posix_time::ptime& deadline)
+    {
+        const auto name = "compile." + md5(key).substr(0, 2);
+        auto& candidate = GetStripe(std::stoul(name.substr(8), nullptr, 16));
+
+        const auto guard = std::lock_guard<std::mutex>{candidate.mutex};
+        if(candidate.holders == 0)
+        {
+            const auto path = LockFilePath(GetCachePath(false) / name);
+            if(path != candidate.path)
+            {
+                if(!boost::filesystem::exists(path))
+                {
+                    if(!std::ofstream{path, std::ios::app})
+                        MIOPEN_THROW("Error creating file <" + path + "> for locking.");
+                    boost::filesystem::permissions(path, boost::filesystem::all_all);
+                }
+                candidate.flock = boost::interprocess::file_lock{path.c_str()};
+                candidate.path  = path;
+            }
+            if(!candidate.flock.timed_lock(deadline))
+                return;
+        }
+        ++candidate.holders;
+        stripe = &candidate;
+    }
+
+    CompileLock(const CompileLock&) = delete;
+    CompileLock& operator=(const CompileLock&) = delete;
+
+    ~CompileLock()
+    {
+        if(stripe == nullptr)
+            return;
+        const auto guard = std::lock_guard<std::mutex>{stripe->mutex};
+        if(--stripe->holders == 0)
+            stripe->flock.unlock();
+    }
+
+    bool owns() const { return stripe != nullptr; }
+
+private:
+    CompileLockStripe* stripe = nullptr;
+
+    static CompileLockStripe& GetStripe(std::size_t index)
+    {
+        // Every stripe opens its file once: POSIX releases the locks a process holds on a file
+        // as soon as any descriptor of that file is closed. Not destroyed at exit, as background
+        // threads may still be compiling.
+        static auto* const stripes = new std::array<CompileLockStripe, 256>{};
+        return (*stripes)[index];
+    }
+};
+
+} // namespace
+
+std::string CompileOnce(const TargetProperties& target,
+                        std::size_t num_cu,
+                        const std::string& name,
+                        const std::string& args,
+                        bool is_kernel_str,
+                        const std::function<std::string()>& compile)
+{
+    const auto key = target.DbId() + (is_kernel_str ? " src:" + miopen::md5(name) : " " + name) +
+                     " " + args;
+
+    return GetCompileFlights().Do(key, [&]() {
+        const auto timeout = Value(MIOPEN_COMPILE_LOCK_TIMEOUT{}, 600);
+        if(IsCacheDisabled() || timeout == 0)
+            return compile();
+
+        const auto deadline = boost::posix_time::second_clock::universal_time() +
+                              boost::posix_time::seconds(timeout);
+        const CompileLock lock{key, deadline};
+        if(!lock.owns())
+        {
+            MIOPEN_LOG_W("Unable to lock the kernel cache in " << timeout
+                                                               << " s, compiling without it.");
+            return compile();
+        }
+
+        // Another process may have compiled the program while this one was waiting.
+        auto cached = LoadCodeObject(target, num_cu, name, args, is_kernel_str);
+        if(!cached.empty())
+        {
+            MIOPEN_LOG_I2("Program compiled by another process: " << key);
+            return cached;
+        }
+        return compile();
+    });
+}
+
+std::size_t GetDeduplicatedCompileCount() { return GetCompileFlights().GetDeduplicatedCount(); }
+
 } // namespace miopen
@@ -0,0 +1,56 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/cancellation.hpp>
+
+#include <miopen/errors.hpp>
+
+#include <utility>
+
+namespace miopen {
+
+static CancellationToken& CurrentToken()
+{
+    thread_local auto token = CancellationToken{};
+    return token;
+}
+
+void CancellationToken::ThrowIfCancelled() const
+{
+    if(IsCancelled())
+        MIOPEN_THROW(miopenStatusCanceled, "Operation has been cancelled.");
+}
+
+CancellationToken CancellationToken::Current() { return CurrentToken(); }
+
+CancellationScope::CancellationScope(CancellationToken token)
+    : previous(std::exchange(CurrentToken(), std::move(token)))
+{
+}
+
+CancellationScope::~CancellationScope() { CurrentToken() = std::move(previous); }
+
+} // namespace miopen
@@ -28,6 +28,7 @@
 
 #include <miopen/comgr.hpp>
 #include <miopen/algorithm.hpp>
+#include <miopen/background_compiler.hpp>
 #include <miopen/env.hpp>
 #include <miopen/errors.hpp>
 #include <miopen/hip_build_utils.hpp>
@@ -37,6 +38,7 @@
 #include <miopen/rocm_features.hpp>
 #include <miopen/solver/implicitgemm_util.hpp>
 #include <miopen/stringutils.hpp>
+#include <miopen/thread_pool.hpp>
 
 #if HIP_PACKAGE_VERSION_FLAT >= 5004000000ULL
 #include <amd_comgr/amd_comgr.h>
@@ -53,6 +55,8 @@
 #include <exception>
 #include <cstddef>
 #include <cstring>
+#include <deque>
+#include <thread>
 #include <tuple> // std::ignore
 #include <vector>
 
@@ -83,6 +87,8 @@ MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_SRAM_EDC_DISABLED)
 
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_OPENCL_WAVE64_NOWGP)
 
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_COMGR_BUILD_THREADS)
+
 #ifndef MIOPEN_AMD_COMGR_VERSION_MAJOR
 #define MIOPEN_AMD_COMGR_VERSION_MAJOR 0
 #endif
@@ -635,19 +641,6 @@ public:
             MIOPEN_LOG_I(text);
         }
     }
-#if PCH_IS_SUPPORTED
-    void AddDataHipPch(const char* const content, const size_t size) const
-    {
-        const char name[] = "hip.pch";
-        const Data d(AMD_COMGR_DATA_KIND_PRECOMPILED_HEADER);
-        if(miopen::IsEnabled(MIOPEN_DEBUG_COMGR_LOG_SOURCE_NAMES{}))
-            MIOPEN_LOG_I(name << ' ' << size
-                              << " bytes,  ptr = " << static_cast<const void*>(content));
-        d.SetName(name);
-        d.SetFromBuffer(content, size);
-        AddData(d);
-    }
-#endif
     size_t GetDataCount(const amd_comgr_data_kind_t kind) const
     {
         std::size_t count = 0;
@@ -751,6 +744,59 @@ static std::string GetLog(const Dataset& dataset, const bool comgr_error_handlin
     return text;
 }
 
+/// HIP include files and the HIP PCH never change, so their comgr data objects are created
+/// once and added to the inputs of every HIP build. This avoids copying all the headers (and
+/// the PCH, which is several megabytes) into new data objects for each kernel.
+class HipIncludes
+{
+public:
+    static const HipIncludes& Get()
+    {
+        static const HipIncludes instance;
+        return instance;
+    }
+
+    void AddTo(const Dataset& inputs) const
+    {
+        for(const auto& d : data)
+            inputs.AddData(d);
+    }
+
+private:
+    // deque never relocates its elements, and Data must not be moved.
+    std::deque<Data> data;
+
+    HipIncludes()
+    {
+        // Note that we do not need any "subdirs" in the include "pathnames" so far.
+        for(const auto& inc : miopen::GetHipKernelIncList())
+        {
+            const auto& d = data.emplace_back(AMD_COMGR_DATA_KIND_INCLUDE);
+            d.SetName(inc);
+            d.SetBytes(miopen::GetKernelInc(inc));
+        }
+#if PCH_IS_SUPPORTED
+        if(compiler::lc::hip::IsPchEnabled())
+        {
+            const char* pch       = nullptr;
+            unsigned int pch_size = 0;
+            __hipGetPCH(&pch, &pch_size);
+            const auto& d = data.emplace_back(AMD_COMGR_DATA_KIND_PRECOMPILED_HEADER);
+            d.SetName("hip.pch");
+            d.SetFromBuffer(pch, pch_size);
+        }
+#endif
+    }
+};
+
+/// Builds run on the threads of the build pool, each of them reuses its action info.
+/// All the properties of the action are set by every build.
+static const ActionInfo& GetActionInfo()
+{
+    thread_local const ActionInfo action;
+    return action;
+}
+
 static void SetIsaName(const ActionInfo& action,
                        const miopen::TargetProperties& target,
                        const bool isHlcBuild = false)
@@ -776,11 +822,11 @@ static inline bool IsWave64Enforced(const OptionList& opts)
         opts.begin(), opts.end(), [](const std::string& s) { return s == "-mwavefrontsize64"; });
 }
 
-void BuildHip(const std::string& name,
-              const std::string& text,
-              const std::string& options,
-              const miopen::TargetProperties& target,
-              std::vector<char>& binary)
+static void BuildHipImpl(const std::string& name,
+                         const std::string& text,
+                         const std::string& options,
+                         const miopen::TargetProperties& target,
+                         std::vector<char>& binary)
 {
     PrintVersion();
     try
@@ -792,22 +838,9 @@ void BuildHip(const std::string& name,
         // files directly into the source text during library build phase by means
         // of the addkernels tool. We don't do that for HIP sources, and, therefore
         // have to export include files prior compilation.
-        // Note that we do not need any "subdirs" in the include "pathnames" so far.
-        const auto incNames = miopen::GetHipKernelIncList();
-        for(const auto& inc : incNames)
-            inputs.AddData(inc, miopen::GetKernelInc(inc), AMD_COMGR_DATA_KIND_INCLUDE);
-
-#if PCH_IS_SUPPORTED
-        if(compiler::lc::hip::IsPchEnabled())
-        {
-            const char* pch       = nullptr;
-            unsigned int pch_size = 0;
-            __hipGetPCH(&pch, &pch_size);
-            inputs.AddDataHipPch(pch, pch_size);
-        }
-#endif
+        HipIncludes::Get().AddTo(inputs);
 
-        const ActionInfo action;
+        const auto& action = GetActionInfo();
         action.SetLanguage(AMD_COMGR_LANGUAGE_HIP);
         SetIsaName(action, target, true);
         action.SetLogging(true);
@@ -906,18 +939,18 @@ void BuildHip(const std::string& name,
     }
 }
 
-void BuildOcl(const std::string& name,
-              const std::string& text,
-              const std::string& options,
-              const miopen::TargetProperties& target,
-              std::vector<char>& binary)
+static void BuildOclImpl(const std::string& name,
+                         const std::string& text,
+                         const std::string& options,
+                         const miopen::TargetProperties& target,
+                         std::vector<char>& binary)
 {
     PrintVersion(); // Nice to see in the user's logs.
     try
     {
         const Dataset inputs;
         inputs.AddData(name, text, AMD_COMGR_DATA_KIND_SOURCE);
-        const ActionInfo action;
+        const auto& action = GetActionInfo();
 #if OCL_STANDARD == 200
         action.SetLanguage(AMD_COMGR_LANGUAGE_OPENCL_2_0);
 #else
@@ -992,11 +1025,11 @@ void BuildOcl(const std::string& name,
     }
 }
 
-void BuildAsm(const std::string& name,
-              const std::string& text,
-              const std::string& options,
-              const miopen::TargetProperties& target,
-              std::vector<char>& binary)
+static void BuildAsmImpl(const std::string& name,
+                         const std::string& text,
+                         const std::string& options,
+                         const miopen::TargetProperties& target,
+                         std::vector<char>& binary)
 {
     PrintVersion();
     try
@@ -1004,8 +1037,10 @@ void BuildAsm(const std::string& name,
         const Dataset inputs;
         inputs.AddData(name, text, AMD_COMGR_DATA_KIND_SOURCE);
 
-        const ActionInfo action;
+        const auto& action = GetActionInfo();
         SetIsaName(action, target);
+        // The action may have been used for a HIP or OpenCL build before.
+        action.SetLanguage(AMD_COMGR_LANGUAGE_NONE);
         action.SetLogging(true);
         auto optAsm = miopen::SplitSpaceSeparated(options);
 #if ROCM_FEATURE_ASM_REQUIRES_NO_XNACK_OPTION
@@ -1037,6 +1072,58 @@ void BuildAsm(const std::string& name,
     }
 }
 
+static ThreadPool& GetBuildPool()
+{
+    static ThreadPool pool{[]() -> std::size_t {
+        const auto threads = miopen::Value(MIOPEN_COMGR_BUILD_THREADS{});
+        return threads != 0 ? threads : std::thread::hardware_concurrency();
+    }()};
+    return pool;
+}
+
+/// All comgr builds of the process run on a bounded pool (MIOPEN_COMGR_BUILD_THREADS, the number
+/// of hardware threads by default). This caps the number of concurrent compiler invocations no
+/// matter how many threads request programs (compile agents of the search, background
+/// compilation, user threads) and lets the pool threads reuse their comgr objects. The background
+/// compiler workers build inline instead, so they never hold up the foreground builds.
+template <class F>
+static void RunOnBuildPool(F f)
+{
+    if(BackgroundCompiler::IsWorkerThread())
+    {
+        f();
+        return;
+    }
+    GetBuildPool().Submit(std::move(f)).get();
+}
+
+void BuildHip(const std::string& name,
+              const std::string& text,
+              const std::string& options,
+              const miopen::TargetProperties& target,
+              std::vector<char>& binary)
+{
+    RunOnBuildPool([&]() { BuildHipImpl(name, text, options, target, binary); });
+}
+
+void BuildOcl(const std::string& name,
+              const std::string& text,
+              const std::string& options,
+              const miopen::TargetProperties& target,
+              std::vector<char>& binary)
+{
+    RunOnBuildPool([&]() { BuildOclImpl(name, text, options, target, binary); });
+}
+
+void BuildAsm(const std::string& name,
+              const std::string& text,
+              const std::string& options,
+              const miopen::TargetProperties& target,
+              std::vector<char>& binary)
+{
+    RunOnBuildPool([&]() { BuildAsmImpl(name, text, options, target, binary); });
+}
+
 } // namespace comgr
 
 #if MIOPEN_USE_HIPRTC
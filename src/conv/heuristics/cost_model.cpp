@@ -0,0 +1,513 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/conv/heuristics/cost_model.hpp>
+
+#include <miopen/conv/problem_description.hpp>
+#include <miopen/db_path.hpp>
+#include <miopen/errors.hpp>
+#include <miopen/handle.hpp>
+#include <miopen/logger.hpp>
+#include <miopen/timer.hpp>
+
+#include <nlohmann/json.hpp>
+
+#include <boost/filesystem.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+
+namespace miopen {
+namespace ai {
+namespace cost_model {
+
+namespace {
+
+constexpr int model_version = 1;
+
+enum Feature
+{
+    Bias,
+    Flops,
+    Bytes,
+    Batch,
+    InChannels,
+    OutChannels,
+    OutSpatial,
+    InSpatial,
+    FilterTaps,
+    Groups,
+    Strided,
+    Dilated,
+    Is3d,
+    NonDefaultLayout,
+    Fp16,
+    Bf16,
+    Int8,
+    BackwardData,
+    BackwardWeights,
+    FeatureCount
+};
+
+std::vector<std::string> Split(const std::string& str, char sep)
+{
+    auto ret   = std::vector<std::string>{};
+    auto start = std::size_t{0};
+    while(true)
+    {
+        const auto pos = str.find(sep, start);
+        ret.push_back(str.substr(start, pos - start));
+        if(pos == std::string::npos)
+            break;
+        start = pos + 1;
+    }
+    return ret;
+}
+
+bool ParseDims(const std::string& token, char sep, std::vector<double>& dims)
+{
+    dims.clear();
+    for(const auto& item : Split(token, sep))
+    {
+        if(item.empty() || item.find_first_not_of("0123456789") != std::string::npos)
+            return false;
+        dims.push_back(std::stod(item));
+    }
+    return true;
+}
+
+double Product(const std::vector<double>& values)
+{
+    auto ret = 1.0;
+    for(const auto v : values)
+        ret *= v;
+    return ret;
+}
+
+double Log2(double value) { return std::log2(std::max(value, 1.0)); }
+
+/// Solves the symmetric positive definite system a * x = b in place (b becomes x).
+bool SolveCholesky(std::vector<double>& a, std::vector<double>& b, std::size_t n)
+{
+    for(auto j = std::size_t{0}; j < n; ++j)
+    {
+        auto d = a[j * n + j];
+        for(auto k = std::size_t{0}; k < j; ++k)
+            d -= a[j * n + k] * a[j * n + k];
+        if(d <= 0.0)
+            return false;
+        a[j * n + j] = std::sqrt(d);
+        for(auto i = j + 1; i < n; ++i)
+        {
+            auto s = a[i * n + j];
+            for(auto k = std::size_t{0}; k < j; ++k)
+                s -= a[i * n + k] * a[j * n + k];
+            a[i * n + j] = s / a[j * n + j];
+        }
+    }
+    for(auto i = std::size_t{0}; i < n; ++i)
+    {
+        auto s = b[i];
+        for(auto k = std::size_t{0}; k < i; ++k)
+            s -= a[i * n + k] * b[k];
+        b[i] = s / a[i * n + i];
+    }
+    for(auto i = n; i-- > 0;)
+    {
+        auto s = b[i];
+        for(auto k = i + 1; k < n; ++k)
+            s -= a[k * n + i] * b[k];
+        b[i] = s / a[i * n + i];
+    }
+    return true;
+}
+
+} // namespace
+
+std::size_t GetFeatureCount() { return FeatureCount; }
+
+std::vector<double> ExtractFeatures(const std::string& db_key)
+{
+    // 2D: C-H-W-FyxFx-K-OH-OW-N-PyxPx-SyxSx-DyxDx-bias-layout[-wlayout-olayout]-type-dir[_gG]
+    // 3D: C-D-H-W-FzxFyxFx-K-OD-OH-OW-N-PzxPyxPx-...
+    const auto optional_pos = db_key.find('_');
+    const auto tokens       = Split(db_key.substr(0, optional_pos), '-');
+
+    auto groups = 1.0;
+    if(optional_pos != std::string::npos)
+    {
+        for(const auto& item : Split(db_key.substr(optional_pos + 1), '_'))
+        {
+            auto g = std::vector<double>{};
+            if(item.size() > 1 && item[0] == 'g' && ParseDims(item.substr(1), 'x', g))
+                groups = g.front();
+        }
+    }
+
+    if(tokens.size() < 15)
+        return {};
+
+    const auto is_2d = tokens[3].find('x') != std::string::npos;
+    const auto sdims = std::size_t{is_2d ? 2u : 3u};
+    auto pos         = std::size_t{0};
+    auto dims        = std::vector<double>{};
+
+    const auto read_scalar = [&](double& value) {
+        if(pos >= tokens.size() || !ParseDims(tokens[pos++], 'x', dims) || dims.size() != 1)
+            return false;
+        value = dims.front();
+        return true;
+    };
+    const auto read_spatial = [&](std::vector<double>& values, bool packed) {
+        values.clear();
+        if(packed)
+            return pos < tokens.size() && ParseDims(tokens[pos++], 'x', values) &&
+                   values.size() == sdims;
+        for(auto i = std::size_t{0}; i < sdims; ++i)
+        {
+            auto value = 0.0;
+            if(!read_scalar(value))
+                return false;
+            values.push_back(value);
+        }
+        return true;
+    };
+
+    auto in_c = 0.0, out_c = 0.0, batch = 0.0, bias = 0.0;
+    auto in_sp = std::vector<double>{}, filter = std::vector<double>{};
+    auto out_sp = std::vector<double>{}, pads = std::vector<double>{};
+    auto strides = std::vector<double>{}, dilations = std::vector<double>{};
+
+    if(!read_scalar(in_c) || !read_spatial(in_sp, false) || !read_spatial(filter, true) ||
+       !read_scalar(out_c) || !read_spatial(out_sp, false) || !read_scalar(batch) ||
+       !read_spatial(pads, true) || !read_spatial(strides, true) ||
+       !read_spatial(dilations, true) || !read_scalar(bias))
+        return {};
+
+    const auto rest = tokens.size() - pos;
+    if(rest != 3 && rest != 5)
+        return {};
+    const auto non_default_layout =
+        rest == 5 || (tokens[pos] != "NCHW" && tokens[pos] != "NCDHW");
+    const auto& type      = tokens[tokens.size() - 2];
+    const auto& direction = tokens.back();
+    if(direction != "F" && direction != "B" && direction != "W")
+        return {};
+    if(groups < 1.0)
+        return {};
+
+    // The key describes the forward problem for F, and the problem with
+    // swapped input and output tensors for B and W.
+    const auto is_fwd     = direction == "F";
+    const auto fwd_in_c   = is_fwd ? in_c : out_c;
+    const auto fwd_out_c  = is_fwd ? out_c : in_c;
+    const auto fwd_in_sp  = Product(is_fwd ? in_sp : out_sp);
+    const auto fwd_out_sp = Product(is_fwd ? out_sp : in_sp);
+    const auto taps       = Product(filter);
+    const auto wei_size   = fwd_out_c * (fwd_in_c / groups) * taps;
+    const auto is_type    = [&](const char* name) { return type.compare(0, 4, name) == 0; };
+    const auto elem_size  = is_type("INT8") ? 1.0 : is_type("FP32") ? 4.0 : 2.0;
+    const auto flops      = 2.0 * batch * fwd_out_sp * wei_size;
+    const auto bytes =
+        elem_size * (batch * fwd_in_c * fwd_in_sp + batch * fwd_out_c * fwd_out_sp + wei_size);
+    const auto is_above_1 = [](const std::vector<double>& v) {
+        return std::any_of(v.begin(), v.end(), [](double x) { return x > 1.0; }) ? 1.0 : 0.0;
+    };
+
+    auto features = std::vector<double>(FeatureCount, 0.0);
+
+    features[Bias]             = 1.0;
+    features[Flops]            = Log2(flops);
+    features[Bytes]            = Log2(bytes);
+    features[Batch]            = Log2(batch);
+    features[InChannels]       = Log2(fwd_in_c);
+    features[OutChannels]      = Log2(fwd_out_c);
+    features[OutSpatial]       = Log2(fwd_out_sp);
+    features[InSpatial]        = Log2(fwd_in_sp);
+    features[FilterTaps]       = Log2(taps);
+    features[Groups]           = Log2(groups);
+    features[Strided]          = is_above_1(strides);
+    features[Dilated]          = is_above_1(dilations);
+    features[Is3d]             = is_2d ? 0.0 : 1.0;
+    features[NonDefaultLayout] = non_default_layout ? 1.0 : 0.0;
+    features[Fp16]             = is_type("FP16") ? 1.0 : 0.0;
+    features[Bf16]             = is_type("BF16") ? 1.0 : 0.0;
+    features[Int8]             = is_type("INT8") ? 1.0 : 0.0;
+    features[BackwardData]     = direction == "B" ? 1.0 : 0.0;
+    features[BackwardWeights]  = direction == "W" ? 1.0 : 0.0;
+
+    return features;
+}
+
+std::vector<Sample> ReadFindDb(std::istream& stream)
+{
+    auto samples = std::vector<Sample>{};
+    auto line    = std::string{};
+
+    while(std::getline(stream, line))
+    {
+        const auto eq = line.find('=');
+        if(line.empty() || line[0] == '#' || eq == std::string::npos)
+            continue;
+
+        auto sample = Sample{line.substr(0, eq), {}};
+        for(const auto& pair : Split(line.substr(eq + 1), ';'))
+        {
+            // solver:time,workspace,algorithm
+            // Older databases: algorithm:solver,time,workspace,algorithm,<unused>
+            const auto colon = pair.find(':');
+            if(colon == std::string::npos)
+                continue;
+            const auto values = Split(pair.substr(colon + 1), ',');
+            const auto legacy = values.size() == 5;
+            if(values.size() < (legacy ? 2 : 1))
+                continue;
+            try
+            {
+                const auto time = std::stof(values[legacy ? 1 : 0]);
+                if(time > 0.0f)
+                    sample.times.emplace(legacy ? values[0] : pair.substr(0, colon), time);
+            }
+            catch(const std::exception&)
+            {
+                MIOPEN_LOG_I2("Skipping malformed find-db value: " << pair);
+            }
+        }
+
+        if(!sample.times.empty())
+            samples.emplace_back(std::move(sample));
+    }
+
+    return samples;
+}
+
+Model Model::Train(const std::vector<Sample>& samples, double l2, std::size_t min_samples)
+{
+    const auto n = GetFeatureCount();
+
+    struct Normal
+    {
+        std::vector<double> xtx;
+        std::vector<double> xty;
+        std::size_t count = 0;
+    };
+    auto normals = std::map<std::string, Normal>{};
+
+    for(const auto& sample : samples)
+    {
+        const auto x = ExtractFeatures(sample.key);
+        if(x.empty())
+            continue;
+
+        for(const auto& solver_time : sample.times)
+        {
+            auto& normal = normals[solver_time.first];
+            if(normal.count == 0)
+            {
+                normal.xtx.assign(n * n, 0.0);
+                normal.xty.assign(n, 0.0);
+            }
+            const auto y = std::log2(static_cast<double>(solver_time.second));
+            for(auto i = std::size_t{0}; i < n; ++i)
+            {
+                for(auto j = std::size_t{0}; j < n; ++j)
+                    normal.xtx[i * n + j] += x[i] * x[j];
+                normal.xty[i] += x[i] * y;
+            }
+            ++normal.count;
+        }
+    }
+
+    auto model = Model{};
+    for(auto& solver_normal : normals)
+    {
+        auto& normal = solver_normal.second;
+        if(normal.count < min_samples)
+            continue;
+        // Ridge term keeps the system well-conditioned when some features are
+        // constant for the solver (e.g. a solver that supports only FP32).
+        for(auto i = std::size_t{0}; i < n; ++i)
+            normal.xtx[i * n + i] += l2 * static_cast<double>(normal.count);
+        if(!SolveCholesky(normal.xtx, normal.xty, n))
+        {
+            MIOPEN_LOG_W("Unable to fit cost model for " << solver_normal.first);
+            continue;
+        }
+        model.weights.emplace(solver_normal.first, std::move(normal.xty));
+    }
+
+    return model;
+}
+
+Model Model::Load(const std::string& path)
+{
+    auto file = std::ifstream{path};
+    if(!file)
+        MIOPEN_THROW(miopenStatusInternalError, "Unable to load cost model: " + path);
+
+    auto model = Model{};
+    try
+    {
+        const auto json = nlohmann::json::parse(file);
+        if(json.at("version").get<int>() != model_version ||
+           json.at("features").get<std::size_t>() != GetFeatureCount())
+            MIOPEN_THROW(miopenStatusInternalError, "Incompatible cost model: " + path);
+        for(const auto& item : json.at("solvers").items())
+            model.weights.emplace(item.key(), item.value().get<std::vector<double>>());
+    }
+    catch(const nlohmann::json::exception& ex)
+    {
+        MIOPEN_THROW(miopenStatusInternalError,
+                     "Malformed cost model " + path + ": " + std::string(ex.what()));
+    }
+    return model;
+}
+
+void Model::Save(const std::string& path) const
+{
+    auto solvers = nlohmann::json::object();
+    for(const auto& item : weights)
+        solvers[item.first] = item.second;
+
+    const auto json = nlohmann::json{
+        {"version", model_version}, {"features", GetFeatureCount()}, {"solvers", solvers}};
+
+    auto file = std::ofstream{path};
+    if(!file)
+        MIOPEN_THROW(miopenStatusInternalError, "Unable to write cost model: " + path);
+    file << json.dump(1) << std::endl;
+}
+
+boost::optional<float> Model::Predict(const std::string& solver,
+                                      const std::vector<double>& features) const
+{
+    const auto it = weights.find(solver);
+    if(it == weights.end() || features.size() != it->second.size())
+        return boost::none;
+
+    auto log_time = 0.0;
+    for(auto i = std::size_t{0}; i < features.size(); ++i)
+        log_time += it->second[i] * features[i];
+    return static_cast<float>(std::exp2(log_time));
+}
+
+Evaluation Model::Evaluate(const std::vector<Sample>& samples) const
+{
+    auto eval = Evaluation{};
+
+    for(const auto& sample : samples)
+    {
+        const auto features = ExtractFeatures(sample.key);
+        if(features.empty())
+            continue;
+
+        auto best_time      = 0.0f;
+        auto predicted_time = 0.0f;
+        auto predicted_best = 0.0f;
+        auto known          = 0;
+
+        for(const auto& solver_time : sample.times)
+        {
+            const auto prediction = Predict(solver_time.first, features);
+            if(!prediction)
+                continue;
+            if(known == 0 || solver_time.second < best_time)
+                best_time = solver_time.second;
+            if(known == 0 || *prediction < predicted_best)
+            {
+                predicted_best = *prediction;
+                predicted_time = solver_time.second;
+            }
+            ++known;
+        }
+
+        if(known < 2)
+            continue;
+
+        const auto regret = static_cast<double>(predicted_time) / best_time - 1.0;
+        ++eval.problems;
+        if(predicted_time <= best_time)
+            ++eval.top1;
+        eval.mean_regret += regret;
+        eval.max_regret = std::max(eval.max_regret, regret);
+    }
+
+    if(eval.problems != 0)
+        eval.mean_regret /= eval.problems;
+    return eval;
+}
+
+const Model* GetModel(const Handle& handle)
+{
+    static std::mutex mutex;
+    static std::map<std::string, std::unique_ptr<Model>> models;
+
+    const auto basename = handle.GetDbBasename();
+    std::lock_guard<std::mutex> lock(mutex);
+
+    const auto it = models.find(basename);
+    if(it != models.end())
+        return it->second.get();
+
+    auto model      = std::unique_ptr<Model>{};
+    const auto path = GetSystemDbPath() + "/" + basename + ".cost.model";
+    if(boost::filesystem::exists(path))
+    {
+        try
+        {
+            TraceScope trace{"Cost model load", path};
+            model = std::make_unique<Model>(Model::Load(path));
+            MIOPEN_LOG_I("Loaded cost model " << path << " (" << model->GetSolverCount()
+                                              << " solvers)");
+        }
+        catch(const Exception& ex)
+        {
+            MIOPEN_LOG_W(ex.what());
+        }
+    }
+    else
+    {
+        MIOPEN_LOG_I2("Cost model not found: " << path);
+    }
+
+    return models.emplace(basename, std::move(model)).first->second.get();
+}
+
+std::vector<double> ExtractFeatures(const conv::ProblemDescription& problem)
+{
+    std::ostringstream key;
+    problem.Serialize(key);
+    return ExtractFeatures(key.str());
+}
+
+} // namespace cost_model
+} // namespace ai
+} // namespace miopen
@@ -30,6 +30,7 @@
 #include <miopen/conv/wrw_invoke_params.hpp>
 #include <miopen/datatype.hpp>
 #include <miopen/execution_context.hpp>
+#include <miopen/key_builder.hpp>
 #include <miopen/tensor_layout.hpp>
 
 #include <sstream>
@@ -46,22 +47,6 @@ EncodeDataTypesForKey(miopenDataType_t in, miopenDataType_t weights, miopenDataT
 
 namespace conv {
 
-std::function<void(std::ostream&)>
-PrintDHW(char sep, int spatial_dims, int depth, int height, int width)
-{
-    return [=](std::ostream& stream) {
-        if(spatial_dims > 2)
-            stream << depth << sep;
-        stream << height << sep << width;
-    };
-}
-
-std::ostream& operator<<(std::ostream& stream, std::function<void(std::ostream&)>&& manipulator)
-{
-    manipulator(stream);
-    return stream;
-}
-
 void ProblemDescription::HeuristicUpdateLayouts()
 {
     const std::string labels = tensor_layout_get_default(in_layout.size());
@@ -85,95 +70,104 @@ void ProblemDescription::HeuristicUpdateLayouts()
     // If we did not find consistent layout, leave them as-is
 }
 
-void ProblemDescription::BuildConfKey(std::string& conf_key) const
+void ProblemDescription::BuildKeys()
 {
-    std::ostringstream ss;
-
-    ss << GetInChannels();
-    ss << 'x' << PrintDHW('x', GetSpatialDims(), GetInDepth(), GetInHeight(), GetInWidth());
-    ss << 'x'
-       << PrintDHW('x', GetSpatialDims(), GetWeightsDepth(), GetWeightsHeight(), GetWeightsWidth());
-    ss << 'x' << GetOutChannels();
-    ss << 'x' << PrintDHW('x', GetSpatialDims(), GetOutDepth(), GetOutHeight(), GetOutWidth());
-    ss << 'x' << GetInBatchSize();
-    if((GetInLayout() == "NCHW" && GetWeightsLayout() == "NCHW" && GetOutLayout() == "NCHW") ||
-       (GetInLayout() == "NCDHW" && GetWeightsLayout() == "NCDHW" && GetOutLayout() == "NCDHW"))
-    {
-        ss << 'x' << GetInLayout();
-    }
-    else
-    {
-        ss << 'x' << GetInLayout();
-        ss << 'x' << GetWeightsLayout();
-        ss << 'x' << GetOutLayout();
-    }
-    ss << 'x' << EncodeDataTypesForKey(GetInDataType(), GetWeightsDataType(), GetOutDataType());
-    ss << 'x' << PrintDHW('x', GetSpatialDims(), GetPadD(), GetPadH(), GetPadW());
-    ss << 'x'
-       << PrintDHW(
-              'x', GetSpatialDims(), GetKernelStrideD(), GetKernelStrideH(), GetKernelStrideW());
-    ss << 'x' << PrintDHW('x', GetSpatialDims(), GetDilationD(), GetDilationH(), GetDilationW());
-    ss << 'x' << GetGroupCount();
+    conf_key = MakeConfKey();
+    db_key   = MakeDbKey();
+}
+
+bool ProblemDescription::HasDefaultLayouts() const
+{
+    return (in_layout == "NCHW" && weights_layout == "NCHW" && out_layout == "NCHW") ||
+           (in_layout == "NCDHW" && weights_layout == "NCDHW" && out_layout == "NCDHW");
+}
+
+std::string ProblemDescription::MakeConfKey() const
+{
+    const auto dims = GetSpatialDims();
+    KeyBuilder key;
+
+    key << GetInChannels();
+    key << 'x';
+    key.DHW('x', dims, GetInDepth(), GetInHeight(), GetInWidth());
+    key << 'x';
+    key.DHW('x', dims, GetWeightsDepth(), GetWeightsHeight(), GetWeightsWidth());
+    key << 'x' << GetOutChannels();
+    key << 'x';
+    key.DHW('x', dims, GetOutDepth(), GetOutHeight(), GetOutWidth());
+    key << 'x' << GetInBatchSize();
+    key << 'x' << in_layout;
+    if(!HasDefaultLayouts())
+        key << 'x' << weights_layout << 'x' << out_layout;
+    key << 'x' << EncodeDataTypesForKey(GetInDataType(), GetWeightsDataType(), GetOutDataType());
+    key << 'x';
+    key.DHW('x', dims, GetPadD(), GetPadH(), GetPadW());
+    key << 'x';
+    key.DHW('x', dims, GetKernelStrideD(), GetKernelStrideH(), GetKernelStrideW());
+    key << 'x';
+    key.DHW('x', dims, GetDilationD(), GetDilationH(), GetDilationW());
+    key << 'x' << GetGroupCount();
 
     switch(GetDirection())
     {
-    case Direction::Forward: ss << 'x' << "F"; break;
-    case Direction::BackwardData: ss << 'x' << "B"; break;
-    case Direction::BackwardWeights: ss << 'x' << "W"; break;
+    case Direction::Forward: key << 'x' << 'F'; break;
+    case Direction::BackwardData: key << 'x' << 'B'; break;
+    case Direction::BackwardWeights: key << 'x' << 'W'; break;
     }
 
-    conf_key = ss.str();
+    return key.Str();
 }
 
-void ProblemDescription::Serialize(std::ostream& stream) const
+std::string ProblemDescription::MakeDbKey() const
 {
-    const auto sep = '-';
+    const auto sep  = '-';
+    const auto dims = GetSpatialDims();
+    KeyBuilder key;
+
     // Problem description with default layout
     // 576-4-4-1x1-192-4-4-8-1x1-2x2-3x3-0-NCHW-FP32-F
     // Problem description with non-default layout
     // 576-4-4-1x1-192-4-4-8-1x1-2x2-3x3-0-NHWC-NCHW-NCHW-FP32-F
-    // clang-format off
-    stream << GetInChannels();
-    stream << sep << PrintDHW(sep, GetSpatialDims(), GetInDepth(), GetInHeight(), GetInWidth());
-    stream << sep << PrintDHW('x', GetSpatialDims(), GetWeightsDepth(), GetWeightsHeight(), GetWeightsWidth());
-    stream << sep << GetOutChannels();
-    stream << sep << PrintDHW(sep, GetSpatialDims(), GetOutDepth(), GetOutHeight(), GetOutWidth());
-    stream << sep << GetInBatchSize();
-    stream << sep << PrintDHW('x', GetSpatialDims(), GetPadD(), GetPadH(), GetPadW());
-    stream << sep << PrintDHW('x', GetSpatialDims(), GetKernelStrideD(), GetKernelStrideH(), GetKernelStrideW());
-    stream << sep << PrintDHW('x', GetSpatialDims(), GetDilationD(), GetDilationH(), GetDilationW());
-    stream << sep << GetBias();
-    if ((GetInLayout() == "NCHW" && GetWeightsLayout() == "NCHW" && GetOutLayout() == "NCHW")
-        || (GetInLayout() == "NCDHW" && GetWeightsLayout() == "NCDHW" && GetOutLayout() == "NCDHW"))
-    {
-        stream << sep << GetInLayout();
-    }else {
-        stream << sep << GetInLayout();
-        stream << sep << GetWeightsLayout();
-        stream << sep << GetOutLayout();
-    }
-    stream << sep << EncodeDataTypesForKey(GetInDataType(), GetWeightsDataType(), GetOutDataType());
+    key << GetInChannels() << sep;
+    key.DHW(sep, dims, GetInDepth(), GetInHeight(), GetInWidth()) << sep;
+    key.DHW('x', dims, GetWeightsDepth(), GetWeightsHeight(), GetWeightsWidth()) << sep;
+    key << GetOutChannels() << sep;
+    key.DHW(sep, dims, GetOutDepth(), GetOutHeight(), GetOutWidth()) << sep;
+    key << GetInBatchSize() << sep;
+    key.DHW('x', dims, GetPadD(), GetPadH(), GetPadW()) << sep;
+    key.DHW('x', dims, GetKernelStrideD(), GetKernelStrideH(), GetKernelStrideW()) << sep;
+    key.DHW('x', dims, GetDilationD(), GetDilationH(), GetDilationW()) << sep;
+    key << GetBias();
+    key << sep << in_layout;
+    if(!HasDefaultLayouts())
+        key << sep << weights_layout << sep << out_layout;
+    key << sep << EncodeDataTypesForKey(GetInDataType(), GetWeightsDataType(), GetOutDataType());
 
     switch(GetDirection())
     {
-    case Direction::Forward: stream << sep << "F"; break;
-    case Direction::BackwardData: stream << sep << "B"; break;
-    case Direction::BackwardWeights: stream << sep << "W"; break;
+    case Direction::Forward: key << sep << 'F'; break;
+    case Direction::BackwardData: key << sep << 'B'; break;
+    case Direction::BackwardWeights: key << sep << 'W'; break;
     }
 
-    // clang-format on
     // New performance config entries shall come into variable/optional part of db key.
     // This is to support backward compatibility with previous versions of databases.
-    std::ostringstream optional;
-    {
-        // Group count > 1 identifies Group/Depthwise modes.
-        if(GetGroupCount() != 1)
-            optional << 'g' << GetGroupCount();
-    }
-    if(!optional.str().empty())
-    {
-        stream << '_' << optional.str();
-    }
+    // Group count > 1 identifies Group/Depthwise modes.
+    if(GetGroupCount() != 1)
+        key << '_' << 'g' << GetGroupCount();
+
+    return key.Str();
+}
+
+void ProblemDescription::BuildConfKey(std::string& conf_key_) const
+{
+    // Keys are built by the constructor, a default constructed problem has none.
+    conf_key_ = conf_key.empty() ? MakeConfKey() : conf_key;
+}
+
+void ProblemDescription::Serialize(std::ostream& stream) const
+{
+    stream << (db_key.empty() ? MakeDbKey() : db_key);
 }
 
 bool ProblemDescription::IsLayoutDefault() const
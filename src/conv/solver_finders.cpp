@@ -26,6 +26,7 @@
 
 #include <miopen/conv/solver_finders.hpp>
 
+#include <miopen/cancellation.hpp>
 #include <miopen/conv_algo_name.hpp>
 #include <miopen/config.h>
 #include <miopen/mlo_internal.hpp>
@@ -219,12 +220,15 @@ static void EvaluateInvokers(Handle& handle,
     if(arch != nullptr && strlen(arch) > 0)
         return;
 
-    auto selected     = miopen::solver::ConvSolution{miopenStatusUnknownError};
-    auto best         = std::numeric_limits<float>::max();
-    auto best_invoker = Invoker{};
+    auto selected           = miopen::solver::ConvSolution{miopenStatusUnknownError};
+    auto best               = std::numeric_limits<float>::max();
+    auto best_invoker       = Invoker{};
+    const auto cancellation = CancellationToken::Current();
 
     for(const auto& sol : solutions)
     {
+        cancellation.ThrowIfCancelled();
+
         if(sol.workspace_sz > 0)
         {
             if(invoke_ctx.GetWorkspace() == nullptr)
@@ -292,6 +296,9 @@ void ConvFindCore(const AnyInvokeParams& invoke_ctx,
                                   f->Find(ctx, problem, invoke_ctx, use_winograd_only));
         });
 
+    const auto cancellation = CancellationToken::Current();
+    cancellation.ThrowIfCancelled();
+
     // Precompile
     {
         auto all = std::vector<const miopen::solver::ConvSolution*>{};
@@ -304,6 +311,8 @@ void ConvFindCore(const AnyInvokeParams& invoke_ctx,
         PrecompileSolutions(handle, all);
     }
 
+    cancellation.ThrowIfCancelled();
+
     // Evaluate Invokers
     AutoEnableProfiling enableProfiling{handle};
     const auto network_config = problem.BuildConfKey();
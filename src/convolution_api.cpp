@@ -769,6 +769,7 @@ miopenConvolutionForwardGetSolution(miopenHandle_t handle,
 
         assert(found.size() <= maxSolutionCount);
         ReturnSolutions(found, solutionCount, solutions);
+        miopen::deref(convDesc).PrecompileSolutions(ctx, problem, found);
     });
 }
 
@@ -899,6 +900,7 @@ miopenConvolutionBackwardDataGetSolution(miopenHandle_t handle,
 
         assert(found.size() <= maxSolutionCount);
         ReturnSolutions(found, solutionCount, solutions);
+        miopen::deref(convDesc).PrecompileSolutions(ctx, problem, found);
     });
 }
 
@@ -1028,6 +1030,7 @@ miopenConvolutionBackwardWeightsGetSolution(miopenHandle_t handle,
 
         assert(found.size() <= maxSolutionCount);
         ReturnSolutions(found, solutionCount, solutions);
+        miopen::deref(convDesc).PrecompileSolutions(ctx, problem, found);
     });
 }
 
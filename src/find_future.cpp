@@ -0,0 +1,89 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/find_future.hpp>
+
+#include <miopen/handle.hpp>
+#include <miopen/logger.hpp>
+#include <miopen/thread_pool.hpp>
+
+#include <chrono>
+#include <utility>
+
+namespace miopen {
+
+static ThreadPool& GetFindPool()
+{
+    static auto pool = ThreadPool{1};
+    return pool;
+}
+
+FindFuture::FindFuture(Handle& handle,
+                       Problem problem,
+                       FindOptions options,
+                       std::size_t max_solutions)
+{
+    auto find = [handle = &handle,
+                 problem_ = std::move(problem),
+                 options_ = std::move(options),
+                 max_solutions,
+                 token = cancellation]() {
+        const auto scope = CancellationScope{token};
+        token.ThrowIfCancelled();
+        return problem_.FindSolutions(*handle, options_, max_solutions);
+    };
+
+    solutions = GetFindPool().Submit(std::move(find)).share();
+}
+
+FindFuture::~FindFuture()
+{
+    if(!solutions.valid())
+        return;
+    Cancel();
+    solutions.wait();
+}
+
+bool FindFuture::IsReady() const
+{
+    return solutions.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+}
+
+void FindFuture::Wait() const { solutions.wait(); }
+
+const std::vector<Solution>& FindFuture::GetSolutions() const
+{
+    try
+    {
+        return solutions.get();
+    }
+    catch(const std::future_error& ex)
+    {
+        MIOPEN_THROW(miopenStatusCanceled, std::string{"Find has been dropped: "} + ex.what());
+    }
+}
+
+} // namespace miopen
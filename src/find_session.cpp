@@ -0,0 +1,244 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/find_session.hpp>
+
+#include <miopen/conv/problem_description.hpp>
+#include <miopen/datatype.hpp>
+#include <miopen/execution_context.hpp>
+#include <miopen/handle.hpp>
+#include <miopen/logger.hpp>
+#include <miopen/search_options.hpp>
+
+#include <boost/hof/match.hpp>
+#include <boost/variant/apply_visitor.hpp>
+
+#include <algorithm>
+#include <limits>
+#include <sstream>
+#include <unordered_map>
+
+namespace miopen {
+
+namespace {
+
+conv::ProblemDescription AsConvolution(const Problem& problem, const ConvolutionDescriptor& conv)
+{
+    return conv.mode == miopenTranspose ? problem.MakeTransposed().AsConvolution()
+                                        : problem.AsConvolution();
+}
+
+/// Problems with the same find-db key have the same solutions.
+std::string GetFindKey(const Problem& problem)
+{
+    const auto get_key = boost::hof::match([&](const ConvolutionDescriptor& conv) {
+        std::ostringstream ss;
+        AsConvolution(problem, conv).Serialize(ss);
+        return ss.str();
+    });
+
+    return boost::apply_visitor(get_key, problem.GetOperatorDescriptor());
+}
+
+std::size_t GetWorkspaceSizeMax(Handle& handle, const Problem& problem)
+{
+    const auto get_size = boost::hof::match([&](const ConvolutionDescriptor& conv) {
+        return conv.GetWorkSpaceSize({&handle}, AsConvolution(problem, conv));
+    });
+
+    return boost::apply_visitor(get_size, problem.GetOperatorDescriptor());
+}
+
+} // namespace
+
+std::size_t FindSession::AddProblem(const Problem& problem)
+{
+    auto key            = GetFindKey(problem);
+    const auto found_it = std::find_if(unique_problems.begin(),
+                                       unique_problems.end(),
+                                       [&](const auto& unique) { return unique.key == key; });
+
+    if(found_it != unique_problems.end())
+    {
+        ++found_it->count;
+        problem_to_unique.push_back(std::distance(unique_problems.begin(), found_it));
+    }
+    else
+    {
+        problem_to_unique.push_back(unique_problems.size());
+        unique_problems.push_back({problem, std::move(key), 1, {}, 0});
+        found = false;
+    }
+
+    return problem_to_unique.size() - 1;
+}
+
+void FindSession::Run(Handle& handle, const FindOptions& options, std::size_t max_solutions)
+{
+    if(unique_problems.empty())
+        MIOPEN_THROW(miopenStatusBadParm, "No problems have been added to the find session.");
+
+    // Buffers are shared by all problems and sized for the largest one. Their contents don't
+    // matter for benchmarking, so they are zeroed only once.
+    auto tensor_sizes   = std::unordered_map<miopenTensorArgumentId_t, std::size_t>{};
+    auto workspace_size = std::size_t{0};
+
+    for(const auto& unique : unique_problems)
+    {
+        const auto add_tensor = [&](miopenTensorArgumentId_t id, const std::string& name) {
+            const auto& descriptor = unique.problem.GetTensorDescriptorChecked(id, name);
+            const auto size = descriptor.GetElementSpace() * get_data_size(descriptor.GetType());
+            auto& max_size  = tensor_sizes[id];
+            max_size        = std::max(max_size, size);
+        };
+
+        add_tensor(miopenTensorConvolutionX, "miopenTensorConvolutionX");
+        add_tensor(miopenTensorConvolutionW, "miopenTensorConvolutionW");
+        add_tensor(miopenTensorConvolutionY, "miopenTensorConvolutionY");
+
+        if(!options.preallocated_workspace)
+            workspace_size = std::max(workspace_size, GetWorkspaceSizeMax(handle, unique.problem));
+    }
+
+    auto shared_options = options;
+    auto owned_buffers  = std::vector<Allocator::ManageDataPtr>{};
+
+    for(const auto& tensor_size : tensor_sizes)
+    {
+        if(shared_options.preallocated_tensors.count(tensor_size.first) != 0)
+            continue;
+
+        auto buffer = handle.Write(std::vector<char>(tensor_size.second));
+        shared_options.preallocated_tensors.emplace(tensor_size.first, buffer.get());
+        owned_buffers.emplace_back(std::move(buffer));
+    }
+
+    if(!options.preallocated_workspace)
+    {
+        workspace_size = std::min(options.workspace_limit, workspace_size);
+        auto workspace = workspace_size != 0 ? handle.Create(workspace_size) : nullptr;
+        shared_options.preallocated_workspace = {workspace.get(), workspace_size};
+        owned_buffers.emplace_back(std::move(workspace));
+    }
+
+    MIOPEN_LOG_I("Find session: " << unique_problems.size() << " unique problems of "
+                                  << problem_to_unique.size() << ", shared workspace: "
+                                  << shared_options.preallocated_workspace->size);
+
+    for(auto& unique : unique_problems)
+    {
+        unique.solutions = unique.problem.FindSolutions(handle, shared_options, max_solutions);
+        unique.planned   = 0;
+    }
+
+    found = true;
+}
+
+std::size_t FindSession::PlanWorkspace(float max_slowdown)
+{
+    if(!found)
+        MIOPEN_THROW(miopenStatusBadParm, "The find session has to be run before planning.");
+
+    auto budgets = std::vector<std::size_t>{};
+    for(const auto& unique : unique_problems)
+        for(const auto& solution : unique.solutions)
+            budgets.push_back(solution.GetWorkspaceSize());
+
+    if(budgets.empty())
+        return 0;
+
+    std::sort(budgets.begin(), budgets.end());
+    budgets.erase(std::unique(budgets.begin(), budgets.end()), budgets.end());
+
+    // Every problem runs its fastest solution that fits into the budget. The time is infinite if
+    // some problem has no such solution.
+    const auto get_total_time = [&](std::size_t budget) {
+        auto total = 0.;
+        for(const auto& unique : unique_problems)
+        {
+            if(unique.solutions.empty())
+                continue;
+            auto best = std::numeric_limits<double>::infinity();
+            for(const auto& solution : unique.solutions)
+                if(solution.GetWorkspaceSize() <= budget)
+                    best = std::min(best, static_cast<double>(solution.GetTime()));
+            total += best * unique.count;
+        }
+        return total;
+    };
+
+    const auto fastest = get_total_time(budgets.back());
+    const auto limit   = fastest * (1. + std::max(max_slowdown, 0.f));
+    const auto budget  = *std::find_if(budgets.begin(), budgets.end(), [&](auto candidate) {
+        return get_total_time(candidate) <= limit;
+    });
+
+    auto peak = std::size_t{0};
+    for(auto& unique : unique_problems)
+    {
+        for(auto i = std::size_t{0}; i < unique.solutions.size(); ++i)
+        {
+            const auto& solution = unique.solutions[i];
+            const auto& planned  = unique.solutions[unique.planned];
+            if(solution.GetWorkspaceSize() > budget)
+                continue;
+            if(planned.GetWorkspaceSize() > budget || solution.GetTime() < planned.GetTime())
+                unique.planned = i;
+        }
+        if(!unique.solutions.empty())
+            peak = std::max(peak, unique.solutions[unique.planned].GetWorkspaceSize());
+    }
+
+    MIOPEN_LOG_I("Find session workspace plan: " << peak << " bytes, total time "
+                                                  << get_total_time(budget) << " ms, fastest "
+                                                  << fastest << " ms");
+    return peak;
+}
+
+const FindSession::UniqueProblem&
+FindSession::GetUniqueProblemChecked(std::size_t problem_id) const
+{
+    if(problem_id >= problem_to_unique.size())
+        MIOPEN_THROW(miopenStatusBadParm, "Invalid find session problem id.");
+    if(!found)
+        MIOPEN_THROW(miopenStatusBadParm, "The find session has not been run.");
+    return unique_problems[problem_to_unique[problem_id]];
+}
+
+const std::vector<Solution>& FindSession::GetSolutions(std::size_t problem_id) const
+{
+    return GetUniqueProblemChecked(problem_id).solutions;
+}
+
+const Solution& FindSession::GetPlannedSolution(std::size_t problem_id) const
+{
+    const auto& unique = GetUniqueProblemChecked(problem_id);
+    if(unique.solutions.empty())
+        MIOPEN_THROW(miopenStatusInvalidValue, "No solutions have been found for the problem.");
+    return unique.solutions[unique.planned];
+}
+
+} // namespace miopen
@@ -27,6 +27,7 @@
 #include <miopen/version.h>
 #include <miopen/errors.hpp>
 #include <miopen/handle.hpp>
+#include <miopen/timer.hpp>
 
 extern "C" const char* miopenGetErrorString(miopenStatus_t error)
 {
@@ -53,6 +54,8 @@ extern "C" const char* miopenGetErrorString(miopenStatus_t error)
     case miopenStatusGpuOperationsSkipped: return "miopenStatusGpuOperationsSkipped";
 
     case miopenStatusVersionMismatch: return "miopenStatusVersionMismatch";
+
+    case miopenStatusCanceled: return "miopenStatusCanceled";
     }
     return "Unknown error status";
 }
@@ -72,14 +75,20 @@ extern "C" miopenStatus_t miopenGetVersion(size_t* major, size_t* minor, size_t*
 extern "C" miopenStatus_t miopenCreate(miopenHandle_t* handle)
 {
 
-    return miopen::try_([&] { miopen::deref(handle) = new miopen::Handle(); });
+    return miopen::try_([&] {
+        miopen::TraceScope trace{"miopenCreate"};
+        miopen::deref(handle) = new miopen::Handle();
+    });
 }
 
 extern "C" miopenStatus_t miopenCreateWithStream(miopenHandle_t* handle,
                                                  miopenAcceleratorQueue_t stream)
 {
 
-    return miopen::try_([&] { miopen::deref(handle) = new miopen::Handle(stream); });
+    return miopen::try_([&] {
+        miopen::TraceScope trace{"miopenCreateWithStream"};
+        miopen::deref(handle) = new miopen::Handle(stream);
+    });
 }
 
 extern "C" miopenStatus_t miopenSetStream(miopenHandle_t handle, miopenAcceleratorQueue_t streamID)
@@ -114,3 +123,21 @@ extern "C" miopenStatus_t miopenEnableProfiling(miopenHandle_t handle, bool enab
 {
     return miopen::try_([&] { miopen::deref(handle).EnableProfiling(enable); });
 }
+
+extern "C" miopenStatus_t miopenGetInvokerCacheStatistics(miopenHandle_t handle,
+                                                          size_t* hits,
+                                                          size_t* misses,
+                                                          size_t* evictions)
+{
+    return miopen::try_([&] {
+        const auto statistics = miopen::deref(handle).GetInvokerCacheStatistics();
+        miopen::deref(hits)      = statistics.hits;
+        miopen::deref(misses)    = statistics.misses;
+        miopen::deref(evictions) = statistics.evictions;
+    });
+}
+
+extern "C" miopenStatus_t miopenSetInvokerCacheCapacity(miopenHandle_t handle, size_t capacity)
+{
+    return miopen::try_([&] { miopen::deref(handle).SetInvokerCacheCapacity(capacity); });
+}
@@ -27,6 +27,7 @@
 #include <miopen/config.h>
 #include <miopen/handle.hpp>
 
+#include <miopen/background_compiler.hpp>
 #include <miopen/binary_cache.hpp>
 #include <miopen/env.hpp>
 #include <miopen/errors.hpp>
@@ -304,7 +305,7 @@ Handle::Handle() : impl(std::make_unique<HandleImpl>())
     MIOPEN_LOG_NQI(*this);
 }
 
-Handle::~Handle() {}
+Handle::~Handle() { BackgroundCompiler::Cancel(this); }
 
 // not MT safe
 void Handle::SetStream(miopenAcceleratorQueue_t streamID) const
@@ -409,8 +410,7 @@ void Handle::Copy(ConstData_t src, Data_t dest, std::size_t size) const
         MIOPEN_THROW_HIP_STATUS(status, "Hip error copying buffer: ");
 }
 
-KernelInvoke Handle::AddKernel(const std::string& algorithm,
-                               const std::string& network_config,
+KernelInvoke Handle::AddKernel(const KernelCacheKey& key,
                                const std::string& program_name,
                                const std::string& kernel_name,
                                const std::vector<size_t>& vld,
@@ -422,8 +422,7 @@ KernelInvoke Handle::AddKernel(const std::string& algorithm,
 {
 
     auto obj = this->impl->cache.AddKernel(*this,
-                                           algorithm,
-                                           network_config,
+                                           key,
                                            program_name,
                                            kernel_name,
                                            vld,
@@ -443,8 +442,7 @@ Invoker Handle::PrepareInvoker(const InvokerFactory& factory,
     {
         MIOPEN_LOG_I2("Preparing kernel: " << k.kernel_name);
         const auto kernel = this->impl->cache.AddKernel(*this,
-                                                        "",
-                                                        "",
+                                                        KernelCacheKey{},
                                                         k.kernel_file,
                                                         k.kernel_name,
                                                         k.l_wk,
@@ -456,15 +454,11 @@ Invoker Handle::PrepareInvoker(const InvokerFactory& factory,
     return factory(built);
 }
 
-void Handle::ClearKernels(const std::string& algorithm, const std::string& network_config) const
-{
-    this->impl->cache.ClearKernels(algorithm, network_config);
-}
+void Handle::ClearKernels(const KernelCacheKey& key) const { this->impl->cache.ClearKernels(key); }
 
-const std::vector<Kernel>& Handle::GetKernelsImpl(const std::string& algorithm,
-                                                  const std::string& network_config) const
+const std::vector<Kernel>& Handle::GetKernelsImpl(const KernelCacheKey& key) const
 {
-    return this->impl->cache.GetKernels(algorithm, network_config);
+    return this->impl->cache.GetKernels(key);
 }
 
 KernelInvoke Handle::Run(Kernel k) const
@@ -476,6 +470,43 @@ KernelInvoke Handle::Run(Kernel k) const
         return k.Invoke(this->GetStream());
 }
 
+/// Compiles the program and saves it to the kernel cache. Returns the code object.
+static std::string CompileAndSave(const TargetProperties& target,
+                                  std::size_t num_cu,
+                                  const std::string& program_name,
+                                  const std::string& params,
+                                  bool is_kernel_str,
+                                  const std::string& kernel_src,
+                                  boost::optional<HIPOCProgram>& compiled)
+{
+    CompileTimer ct;
+    auto p = HIPOCProgram{program_name, params, is_kernel_str, target, kernel_src};
+    ct.Log("Kernel", is_kernel_str ? std::string() : program_name);
+
+    auto blob = p.IsCodeObjectInMemory() ? p.GetCodeObjectBlob()
+                                         : miopen::LoadFile(p.GetCodeObjectPathname().string());
+
+// Save to cache
+#if MIOPEN_ENABLE_SQLITE_KERN_CACHE
+    miopen::SaveBinary(blob, target, num_cu, program_name, params, is_kernel_str);
+#else
+    (void)num_cu;
+    auto path = miopen::GetCachePath(false) / boost::filesystem::unique_path();
+    miopen::WriteFile(blob, path);
+    miopen::SaveBinary(path, target, program_name, params, is_kernel_str);
+#endif
+    p.FreeCodeObjectFileStorage();
+    compiled = std::move(p);
+    return blob;
+}
+
+static std::string GetPrecompileKey(const TargetProperties& target,
+                                    const std::string& program_name,
+                                    const std::string& params)
+{
+    return target.DbId() + " " + program_name + " " + params;
+}
+
 Program Handle::LoadProgram(const std::string& program_name,
                             std::string params,
                             bool is_kernel_str,
@@ -495,31 +526,32 @@ Program Handle::LoadProgram(const std::string& program_name,
                                     is_kernel_str);
     if(hsaco.empty())
     {
-        CompileTimer ct;
-        auto p = HIPOCProgram{
-            program_name, params, is_kernel_str, this->GetTargetProperties(), kernel_src};
-        ct.Log("Kernel", is_kernel_str ? std::string() : program_name);
-
-// Save to cache
-#if MIOPEN_ENABLE_SQLITE_KERN_CACHE
-        miopen::SaveBinary(p.IsCodeObjectInMemory()
-                               ? p.GetCodeObjectBlob()
-                               : miopen::LoadFile(p.GetCodeObjectPathname().string()),
-                           this->GetTargetProperties(),
-                           this->GetMaxComputeUnits(),
-                           program_name,
-                           params,
-                           is_kernel_str);
-#else
-        auto path = miopen::GetCachePath(false) / boost::filesystem::unique_path();
-        if(p.IsCodeObjectInMemory())
-            miopen::WriteFile(p.GetCodeObjectBlob(), path);
-        else
-            boost::filesystem::copy_file(p.GetCodeObjectPathname(), path);
-        miopen::SaveBinary(path, this->GetTargetProperties(), program_name, params, is_kernel_str);
-#endif
-        p.FreeCodeObjectFileStorage();
-        return p;
+        // Don't wait for a background job that hasn't started behind the others in its queue.
+        if(!is_kernel_str)
+            BackgroundCompiler::Steal(
+                GetPrecompileKey(this->GetTargetProperties(), program_name, params));
+
+        // Threads requesting the same program at once share a single compilation.
+        auto compiled    = boost::optional<HIPOCProgram>{};
+        auto code_object = miopen::CompileOnce(
+            this->GetTargetProperties(),
+            this->GetMaxComputeUnits(),
+            program_name,
+            params,
+            is_kernel_str,
+            [&]() {
+                return CompileAndSave(this->GetTargetProperties(),
+                                      this->GetMaxComputeUnits(),
+                                      program_name,
+                                      params,
+                                      is_kernel_str,
+                                      kernel_src,
+                                      compiled);
+            });
+
+        if(compiled)
+            return *compiled;
+        return HIPOCProgram{program_name, code_object};
     }
     else
     {
@@ -527,6 +559,31 @@ Program Handle::LoadProgram(const std::string& program_name,
     }
 }
 
+void Handle::PrecompileProgram(const std::string& program_name, std::string params) const
+{
+    if(miopen::IsCacheDisabled())
+        return;
+
+    if(!miopen::EndsWith(program_name, ".mlir"))
+    {
+        params += " -mcpu=" + this->GetTargetProperties().Name();
+    }
+
+    const auto device = this->impl->device;
+    const auto target = this->GetTargetProperties();
+    const auto num_cu = this->GetMaxComputeUnits();
+
+    BackgroundCompiler::Get().Enqueue(GetPrecompileKey(target, program_name, params), [=]() {
+        if(!miopen::LoadBinary(target, num_cu, program_name, params).empty())
+            return;
+        miopen::set_device(device);
+        auto compiled = boost::optional<HIPOCProgram>{};
+        miopen::CompileOnce(target, num_cu, program_name, params, false, [&]() {
+            return CompileAndSave(target, num_cu, program_name, params, false, "", compiled);
+        });
+    });
+}
+
 bool Handle::HasProgram(const std::string& program_name, const std::string& params) const
 {
     return this->impl->cache.HasProgram(program_name, params);
@@ -79,6 +79,26 @@ struct ActivBwdSolver1 final : ActivSolver
                              const miopen::activ::ProblemDescription& problem) const override;
 };
 
+struct ActivFwdSolverHost final : ActivSolver
+{
+    const std::string& SolverDbId() const override { return GetSolverDbId<ActivFwdSolverHost>(); }
+
+    bool IsApplicable(const ExecutionContext& context,
+                      const miopen::activ::ProblemDescription& problem) const override;
+    ConvSolution GetSolution(const ExecutionContext& context,
+                             const miopen::activ::ProblemDescription& problem) const override;
+};
+
+struct ActivBwdSolverHost final : ActivSolver
+{
+    const std::string& SolverDbId() const override { return GetSolverDbId<ActivBwdSolverHost>(); }
+
+    bool IsApplicable(const ExecutionContext& context,
+                      const miopen::activ::ProblemDescription& problem) const override;
+    ConvSolution GetSolution(const ExecutionContext& context,
+                             const miopen::activ::ProblemDescription& problem) const override;
+};
+
 } // namespace activ
 
 } // namespace solver
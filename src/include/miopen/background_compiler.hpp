@@ -0,0 +1,99 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#pragma once
+
+#include <miopen/thread_pool.hpp>
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace miopen {
+
+/// Process-wide queue compiling programs into the kernel cache ahead of time, so that a later
+/// request for them is a cache hit. Jobs run on a few threads (MIOPEN_AOT_COMPILE_THREADS, a
+/// quarter of the hardware threads by default), which build their programs themselves instead
+/// of taking slots of the comgr build pool from the foreground. Jobs with a key that is already
+/// queued or running are dropped, and errors are only logged as the job is just an optimization.
+class BackgroundCompiler
+{
+public:
+    /// Creates the compiler and its threads on the first call. Only used when ahead of time
+    /// compilation is enabled, the instance is never destroyed.
+    static BackgroundCompiler& Get();
+
+    /// Jobs that use a handle pass it as the owner, see Cancel().
+    void Enqueue(const std::string& key, std::function<void()> job, const void* owner = nullptr);
+
+    /// Drops the job if it has not started yet. Called by a foreground thread that is about to
+    /// compile the program itself, so that it doesn't wait for the job behind the queue. A job
+    /// that has started is not interrupted: CompileOnce() makes the caller wait for its result.
+    /// Does nothing if the compiler has not been created.
+    static void Steal(const std::string& key);
+
+    /// Drops the queued jobs of the owner and waits for its running ones. Does nothing if the
+    /// compiler has not been created.
+    static void Cancel(const void* owner);
+
+    /// Blocks until all the queued jobs are done. Queued jobs are run by the calling thread too,
+    /// so this returns even if the workers are busy or gone.
+    void Wait();
+
+    std::size_t GetCompletedCount() const;
+
+    /// Whether the calling thread is one of the workers.
+    static bool IsWorkerThread();
+
+private:
+    struct Job
+    {
+        std::string key;
+        const void* owner = nullptr;
+        std::function<void()> run;
+    };
+
+    BackgroundCompiler();
+
+    bool RunNext(std::unique_lock<std::mutex>& lock);
+    void StealJob(const std::string& key);
+    void CancelJobs(const void* owner);
+
+    mutable std::mutex mutex;
+    std::condition_variable done;
+    std::deque<Job> queued;
+    std::unordered_set<std::string> pending; // Keys of the queued and running jobs.
+    std::unordered_map<std::string, const void*> running;
+    std::size_t completed = 0;
+    ThreadPool pool;
+};
+
+} // namespace miopen
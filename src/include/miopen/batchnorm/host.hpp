@@ -0,0 +1,725 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2017 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#ifndef GUARD_MIOPEN_BATCHNORM_HOST_HPP_
+#define GUARD_MIOPEN_BATCHNORM_HOST_HPP_
+
+#include <miopen/miopen.h>
+#include <miopen/par_for.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+// Host batch normalization: the host solvers run it on the nogpu backend, and the driver and
+// tests use it as the reference.
+//
+// Activations are N x C x (D*H*W), either channel-major (NCHW, NCDHW) or channel-last (NHWC,
+// NDHWC). Spatial scale/bias and statistics hold one value per channel; per-activation ones hold
+// one image worth of values in the layout of the activations.
+//
+// Statistics are accumulated in double. Spatial mode reduces blocks of every channel with a
+// two-pass mean/variance and merges the blocks pairwise (Chan et al.), per-activation mode runs
+// Welford updates over the batch. Inner loops walk contiguous memory, and blocks are spread over
+// host threads. Blocking doesn't depend on the number of threads, so results are reproducible.
+
+namespace bn_host {
+
+/// Elements reduced per block, and roughly the least work worth a thread.
+constexpr std::size_t block_size  = 4096;
+constexpr std::size_t thread_work = std::size_t{1} << 16;
+/// Per-activation features processed together; per-feature state lives on the stack.
+constexpr std::size_t features_per_block = 256;
+
+struct Shape
+{
+    Shape(int n_batchs, int channels, int depth, int height, int width, miopenTensorLayout_t layout)
+        : n(n_batchs),
+          c(channels),
+          s(static_cast<std::size_t>(depth) * height * width),
+          nhwc(layout == miopenTensorNHWC || layout == miopenTensorNDHWC)
+    {
+    }
+
+    std::size_t n;
+    std::size_t c;
+    std::size_t s; // D*H*W
+    bool nhwc;
+
+    std::size_t Elements() const { return n * c * s; }
+    std::size_t Features() const { return c * s; }
+};
+
+inline miopen::min_grain Grain(std::size_t work_per_item)
+{
+    return {std::max<std::size_t>(1, thread_work / std::max<std::size_t>(1, work_per_item))};
+}
+
+/// Sums f(0) ... f(count - 1) into independent lanes, which lets the compiler vectorize the loop
+/// without reassociating floating point math, and adds the lanes pairwise.
+template <class F>
+double Sum(std::size_t count, F f)
+{
+    constexpr std::size_t lanes = 8;
+    double acc[lanes]           = {};
+    std::size_t i               = 0;
+    for(; i + lanes <= count; i += lanes)
+    {
+        for(std::size_t j = 0; j < lanes; ++j)
+            acc[j] += f(i + j);
+    }
+    for(; i < count; ++i)
+        acc[i % lanes] += f(i);
+    return ((acc[0] + acc[1]) + (acc[2] + acc[3])) + ((acc[4] + acc[5]) + (acc[6] + acc[7]));
+}
+
+struct Moments
+{
+    std::size_t count = 0;
+    double mean       = 0;
+    double m2         = 0; // sum{ (x_i - mean)^2 }
+
+    void Merge(const Moments& other)
+    {
+        const auto total = count + other.count;
+        if(total == 0)
+            return;
+        const auto n       = static_cast<double>(count);
+        const auto other_n = static_cast<double>(other.count);
+        const auto delta   = other.mean - mean;
+        mean += delta * other_n / (n + other_n);
+        m2 += other.m2 + delta * delta * n * other_n / (n + other_n);
+        count = total;
+    }
+
+    double Variance() const { return count == 0 ? 0 : m2 / static_cast<double>(count); }
+};
+
+struct BwdSums
+{
+    double dy       = 0; // sum{ dy_i }
+    double xmean_dy = 0; // sum{ (x_i - mean) * dy_i }
+
+    void Merge(const BwdSums& other)
+    {
+        dy += other.dy;
+        xmean_dy += other.xmean_dy;
+    }
+};
+
+/// Merges count values that are stride apart into the first one, pairwise.
+template <class Acc>
+Acc MergePairwise(Acc* first, std::size_t count, std::size_t stride)
+{
+    for(std::size_t step = 1; step < count; step *= 2)
+    {
+        for(std::size_t i = 0; i + step < count; i += 2 * step)
+            first[i * stride].Merge(first[(i + step) * stride]);
+    }
+    return first[0];
+}
+
+/// Reduces every channel into an Acc.
+///
+/// Channel-major activations are cut into runs of at most block_size contiguous elements of one
+/// channel, and run(acc, channel, offset, count) reduces one of them. Channel-last activations are
+/// cut into blocks of whole pixels, and rows(accs, offset, count) reduces count pixels starting at
+/// element offset into accs[channel].
+template <class Acc, class Run, class Rows>
+std::vector<Acc> ReduceChannels(const Shape& shape, Run run, Rows rows)
+{
+    auto result = std::vector<Acc>(shape.c);
+    if(shape.Elements() == 0)
+        return result;
+
+    if(!shape.nhwc)
+    {
+        const auto segments = (shape.s + block_size - 1) / block_size;
+        const auto blocks   = shape.n * segments;
+        auto partial        = std::vector<Acc>(shape.c * blocks);
+        miopen::par_for(partial.size(), Grain(block_size), [&](std::size_t i) {
+            const auto channel = i / blocks;
+            const auto batch   = i % blocks / segments;
+            const auto first   = i % segments * block_size;
+            run(partial[i],
+                channel,
+                (batch * shape.c + channel) * shape.s + first,
+                std::min(block_size, shape.s - first));
+        });
+        for(std::size_t channel = 0; channel < shape.c; ++channel)
+            result[channel] = MergePairwise(&partial[channel * blocks], blocks, 1);
+    }
+    else
+    {
+        const auto pixels           = shape.n * shape.s;
+        const auto pixels_per_block = std::max<std::size_t>(1, block_size / shape.c);
+        const auto blocks           = (pixels + pixels_per_block - 1) / pixels_per_block;
+        auto partial                = std::vector<Acc>(blocks * shape.c);
+        miopen::par_for(blocks, Grain(pixels_per_block * shape.c), [&](std::size_t block) {
+            const auto first = block * pixels_per_block;
+            rows(&partial[block * shape.c],
+                 first * shape.c,
+                 std::min(pixels_per_block, pixels - first));
+        });
+        for(std::size_t channel = 0; channel < shape.c; ++channel)
+            result[channel] = MergePairwise(&partial[channel], blocks, shape.c);
+    }
+    return result;
+}
+
+template <class T>
+std::vector<Moments> ChannelMoments(const Shape& shape, const T* x)
+{
+    return ReduceChannels<Moments>(
+        shape,
+        [&](Moments& acc, std::size_t, std::size_t first, std::size_t count) {
+            const auto data = x + first;
+            const auto mean =
+                Sum(count, [&](std::size_t i) { return static_cast<double>(data[i]); }) / count;
+            acc.count = count;
+            acc.mean  = mean;
+            acc.m2    = Sum(count, [&](std::size_t i) {
+                const auto d = static_cast<double>(data[i]) - mean;
+                return d * d;
+            });
+        },
+        [&](Moments* acc, std::size_t first, std::size_t count) {
+            const auto channels = shape.c;
+            auto mean           = std::vector<double>(channels, 0.);
+            auto m2             = std::vector<double>(channels, 0.);
+            for(std::size_t p = 0; p < count; ++p)
+            {
+                const auto pixel = x + first + p * channels;
+                for(std::size_t ch = 0; ch < channels; ++ch)
+                    mean[ch] += static_cast<double>(pixel[ch]);
+            }
+            for(std::size_t ch = 0; ch < channels; ++ch)
+                mean[ch] /= count;
+            for(std::size_t p = 0; p < count; ++p)
+            {
+                const auto pixel = x + first + p * channels;
+                for(std::size_t ch = 0; ch < channels; ++ch)
+                {
+                    const auto d = static_cast<double>(pixel[ch]) - mean[ch];
+                    m2[ch] += d * d;
+                }
+            }
+            for(std::size_t ch = 0; ch < channels; ++ch)
+                acc[ch] = {count, mean[ch], m2[ch]};
+        });
+}
+
+template <class T, class Tref>
+std::vector<BwdSums> ChannelBwdSums(const Shape& shape, const T* x, const T* dy, const Tref* mean)
+{
+    return ReduceChannels<BwdSums>(
+        shape,
+        [&](BwdSums& acc, std::size_t channel, std::size_t first, std::size_t count) {
+            const auto m = static_cast<double>(mean[channel]);
+            acc.dy = Sum(count, [&](std::size_t i) { return static_cast<double>(dy[first + i]); });
+            acc.xmean_dy = Sum(count, [&](std::size_t i) {
+                return (static_cast<double>(x[first + i]) - m) * static_cast<double>(dy[first + i]);
+            });
+        },
+        [&](BwdSums* acc, std::size_t first, std::size_t count) {
+            const auto channels = shape.c;
+            for(std::size_t p = 0; p < count; ++p)
+            {
+                const auto offset = first + p * channels;
+                for(std::size_t ch = 0; ch < channels; ++ch)
+                {
+                    const auto d = static_cast<double>(dy[offset + ch]);
+                    acc[ch].dy += d;
+                    acc[ch].xmean_dy += (static_cast<double>(x[offset + ch]) - mean[ch]) * d;
+                }
+            }
+        });
+}
+
+/// Calls f(channel, offset) for every element, walking contiguous memory in the inner loop.
+template <class F>
+void ForEachElement(const Shape& shape, F f)
+{
+    if(!shape.nhwc)
+    {
+        miopen::par_for(shape.n * shape.c, Grain(shape.s), [&](std::size_t plane) {
+            const auto channel = plane % shape.c;
+            const auto first   = plane * shape.s;
+            for(std::size_t i = first; i < first + shape.s; ++i)
+                f(channel, i);
+        });
+    }
+    else
+    {
+        miopen::par_for(shape.n * shape.s, Grain(shape.c), [&](std::size_t pixel) {
+            const auto first = pixel * shape.c;
+            for(std::size_t channel = 0; channel < shape.c; ++channel)
+                f(channel, first + channel);
+        });
+    }
+}
+
+/// Calls f(first, count) for blocks of per-activation features. Feature i of image n is element
+/// n * Features() + i in either layout.
+template <class F>
+void ForEachFeatureBlock(const Shape& shape, F f)
+{
+    const auto features = shape.Features();
+    const auto blocks   = (features + features_per_block - 1) / features_per_block;
+    miopen::par_for(blocks, Grain(features_per_block * shape.n), [&](std::size_t block) {
+        const auto first = block * features_per_block;
+        f(first, std::min(features_per_block, features - first));
+    });
+}
+
+/// Welford mean and sum{ (x_i - mean)^2 } over the batch of count features starting at first.
+template <class T>
+void FeatureMoments(
+    const Shape& shape, const T* x, std::size_t first, std::size_t count, double* mean, double* m2)
+{
+    std::fill(mean, mean + count, 0.);
+    std::fill(m2, m2 + count, 0.);
+    for(std::size_t n = 0; n < shape.n; ++n)
+    {
+        const auto row = x + n * shape.Features() + first;
+        const auto inv = 1. / static_cast<double>(n + 1);
+        for(std::size_t i = 0; i < count; ++i)
+        {
+            const auto value = static_cast<double>(row[i]);
+            const auto delta = value - mean[i];
+            mean[i] += delta * inv;
+            m2[i] += delta * (value - mean[i]);
+        }
+    }
+}
+
+} // namespace bn_host
+
+//==================== BEGIN TRAINING KERNELS ========================
+
+template <typename Tgpu, typename Tref>
+int miopenBNFwdTrainPerActivationRunHost(
+    /*
+        T alpha,
+        T beta,
+    */
+    int n_batchs,
+    int channels,
+    int depth,
+    int height,
+    int width,
+    const Tgpu* in_ptr,
+    Tref* out_ptr,
+    const Tref* scale_ptr,
+    const Tref* bias_ptr,
+    Tref epsilon,
+    bool savemeanvar,
+    bool runningmeanvar,
+    Tref* saveMean,
+    Tref* saveInvVariance,
+    Tref* runningMean,
+    Tref* runningVariance,
+    Tref expAvgFactor,
+    miopenTensorLayout_t layout = miopenTensorNCHW)
+{
+    const auto shape = bn_host::Shape{n_batchs, channels, depth, height, width, layout};
+    const auto n     = static_cast<Tref>(n_batchs);
+
+    bn_host::ForEachFeatureBlock(shape, [&](std::size_t first, std::size_t count) {
+        double mean_accum[bn_host::features_per_block];
+        double m2_accum[bn_host::features_per_block];
+        bn_host::FeatureMoments(shape, in_ptr, first, count, mean_accum, m2_accum);
+
+        Tref mean[bn_host::features_per_block];
+        Tref invVar[bn_host::features_per_block];
+        for(std::size_t i = 0; i < count; ++i)
+        {
+            const auto adjIndex = first + i;
+            mean[i]             = static_cast<Tref>(mean_accum[i]);
+            const auto variance = static_cast<Tref>(m2_accum[i] / n_batchs);
+
+            if(savemeanvar)
+                saveMean[adjIndex] = mean[i];
+            if(runningmeanvar)
+            {
+                Tref newRunMean = runningMean[adjIndex] * (static_cast<Tref>(1) - expAvgFactor);
+                runningMean[adjIndex] = mean[i] * expAvgFactor + newRunMean;
+                // var(n+1) = p * var(n-1) + (1 - p)*(b/b-1)*var(n)
+                Tref adjust = (n_batchs == 1) ? variance : n / (n - 1) * variance;
+                runningVariance[adjIndex] =
+                    (static_cast<Tref>(1) - expAvgFactor) * runningVariance[adjIndex] +
+                    expAvgFactor * adjust;
+            }
+
+            invVar[i] = static_cast<Tref>(1.0) / sqrt(variance + epsilon);
+            if(savemeanvar)
+                saveInvVariance[adjIndex] = invVar[i];
+        }
+
+        // y_i = gamma * (x_i - mean) / sqrt(variance + epsilon) + beta
+        for(std::size_t b = 0; b < shape.n; ++b)
+        {
+            const auto row = b * shape.Features() + first;
+            for(std::size_t i = 0; i < count; ++i)
+            {
+                const Tref inhat = (static_cast<Tref>(in_ptr[row + i]) - mean[i]) * invVar[i];
+                out_ptr[row + i] = scale_ptr[first + i] * inhat + bias_ptr[first + i];
+            }
+        }
+    });
+    return 0;
+}
+
+template <typename Tgpu, typename Tref>
+int miopenBNFwdTrainSpatialRunHost(
+    /*    T alpha,
+        T beta,
+    */
+    int n_batchs,
+    int channels,
+    int depth,
+    int height,
+    int width,
+    const Tgpu* in_ptr,
+    Tref* out_ptr,
+    const Tref* scale_ptr,
+    const Tref* bias_ptr,
+    Tref epsilon,
+    bool savemeanvar,
+    bool runningmeanvar,
+    Tref* saveMean,
+    Tref* saveInvVariance,
+    Tref* runningMean,
+    Tref* runningVariance,
+    Tref expAvgFactor,
+    miopenTensorLayout_t layout = miopenTensorNCHW)
+{
+    const auto shape   = bn_host::Shape{n_batchs, channels, depth, height, width, layout};
+    const auto moments = bn_host::ChannelMoments(shape, in_ptr);
+    const auto NHW     = static_cast<Tref>(shape.n * shape.s);
+
+    auto mean   = std::vector<Tref>(shape.c);
+    auto invVar = std::vector<Tref>(shape.c);
+    for(int cidx = 0; cidx < channels; cidx++)
+    {
+        mean[cidx]          = static_cast<Tref>(moments[cidx].mean);
+        const auto variance = static_cast<Tref>(moments[cidx].Variance());
+
+        if(savemeanvar)
+            saveMean[cidx] = mean[cidx];
+        if(runningmeanvar)
+        {
+            Tref newRunMean   = runningMean[cidx] * (static_cast<Tref>(1) - expAvgFactor);
+            runningMean[cidx] = mean[cidx] * expAvgFactor + newRunMean; // newMean*factor + tmp
+            Tref adjust       = (shape.n * shape.s == 1) ? variance : NHW / (NHW - 1) * variance;
+            runningVariance[cidx] = (static_cast<Tref>(1) - expAvgFactor) * runningVariance[cidx] +
+                                    expAvgFactor * adjust;
+        }
+
+        // add epsilon for numeric stability, sqr_root, and invert
+        invVar[cidx] = static_cast<Tref>(1.0) / sqrt(variance + epsilon);
+        if(savemeanvar)
+            saveInvVariance[cidx] = invVar[cidx];
+    }
+
+    // y_i = gamma * (x_i - mean) / sqrt(variance + epsilon) + beta
+    bn_host::ForEachElement(shape, [&](std::size_t cidx, std::size_t index) {
+        const Tref elemStd = static_cast<Tref>(in_ptr[index]) - mean[cidx];
+        out_ptr[index]     = scale_ptr[cidx] * (invVar[cidx] * elemStd) + bias_ptr[cidx];
+    });
+    return 0;
+}
+
+//====================== END TRAINING KERNELS =========================
+
+//==================== BEGIN INFERENCE KERNELS ========================
+
+template <typename Tgpu, typename Tref>
+int miopenBNFwdInferPerActivationRunHost(
+    /* T alpha,
+            T beta,
+    */
+    int n_batchs,
+    int channels,
+    int depth,
+    int height,
+    int width,
+    const Tgpu* in_ptr,
+    Tref* out_ptr,
+    const Tref* scale_ptr,
+    const Tref* bias_ptr,
+    Tref epsilon,
+    bool estmeanvar,
+    const Tref* estimatedMean,
+    const Tref* estimatedVariance,
+    miopenTensorLayout_t layout = miopenTensorNCHW)
+{
+    const auto shape = bn_host::Shape{n_batchs, channels, depth, height, width, layout};
+
+    bn_host::ForEachFeatureBlock(shape, [&](std::size_t first, std::size_t count) {
+        Tref mean[bn_host::features_per_block];
+        Tref invVar[bn_host::features_per_block];
+        if(estmeanvar)
+        {
+            for(std::size_t i = 0; i < count; ++i)
+            {
+                mean[i]   = estimatedMean[first + i];
+                invVar[i] = static_cast<Tref>(1.0) /
+                            static_cast<Tref>(sqrt(estimatedVariance[first + i] + epsilon));
+            }
+        }
+        else
+        {
+            double mean_accum[bn_host::features_per_block];
+            double m2_accum[bn_host::features_per_block];
+            bn_host::FeatureMoments(shape, in_ptr, first, count, mean_accum, m2_accum);
+            for(std::size_t i = 0; i < count; ++i)
+            {
+                const auto variance = static_cast<Tref>(m2_accum[i] / n_batchs);
+                mean[i]             = static_cast<Tref>(mean_accum[i]);
+                invVar[i] = static_cast<Tref>(1.0) / static_cast<Tref>(sqrt(variance + epsilon));
+            }
+        }
+
+        for(std::size_t b = 0; b < shape.n; ++b)
+        {
+            const auto row = b * shape.Features() + first;
+            for(std::size_t i = 0; i < count; ++i)
+            {
+                const Tref inhat = (static_cast<Tref>(in_ptr[row + i]) - mean[i]) * invVar[i];
+                out_ptr[row + i] = scale_ptr[first + i] * inhat + bias_ptr[first + i];
+            }
+        }
+    });
+    return 0;
+}
+
+template <typename Tgpu, typename Tref>
+int miopenBNFwdInferSpatialRunHost(
+    /*        T alpha,
+            T beta,
+    */
+    int n_batchs,
+    int channels,
+    int depth,
+    int height,
+    int width,
+    const Tgpu* in_ptr,
+    Tref* out_ptr,
+    const Tref* scale_ptr,
+    const Tref* bias_ptr,
+    Tref epsilon,
+    bool estmeanvar,
+    const Tref* estimatedMean,
+    const Tref* estimatedVariance,
+    miopenTensorLayout_t layout = miopenTensorNCHW)
+{
+    const auto shape = bn_host::Shape{n_batchs, channels, depth, height, width, layout};
+
+    auto mean   = std::vector<Tref>(shape.c);
+    auto invVar = std::vector<Tref>(shape.c);
+    if(estmeanvar)
+    {
+        for(int cidx = 0; cidx < channels; cidx++)
+        {
+            mean[cidx]   = estimatedMean[cidx];
+            invVar[cidx] = static_cast<Tref>(1.0) /
+                           static_cast<Tref>(sqrt(estimatedVariance[cidx] + epsilon));
+        }
+    }
+    else
+    {
+        const auto moments = bn_host::ChannelMoments(shape, in_ptr);
+        for(int cidx = 0; cidx < channels; cidx++)
+        {
+            const auto variance = static_cast<Tref>(moments[cidx].Variance());
+            mean[cidx]          = static_cast<Tref>(moments[cidx].mean);
+            invVar[cidx] = static_cast<Tref>(1.0) / static_cast<Tref>(sqrt(variance + epsilon));
+        }
+    }
+
+    bn_host::ForEachElement(shape, [&](std::size_t cidx, std::size_t index) {
+        const Tref inhat = (static_cast<Tref>(in_ptr[index]) - mean[cidx]) * invVar[cidx];
+        out_ptr[index]   = scale_ptr[cidx] * inhat + bias_ptr[cidx];
+    });
+    return 0;
+}
+
+//================ END FWD INFERENCE ========================
+
+//================ START BACKWARDS PASS =====================
+
+template <typename Tgpu, typename Tref, typename Tmix>
+int miopenBNBwdPerActivationRunHost(
+    /*        T alphaDiff,
+            T betaDiff,
+            T alphaParam,
+            T betaParam,
+    */
+    int n_batchs,
+    int channels,
+    int depth,
+    int height,
+    int width,
+    const Tgpu* x_ptr,  // layer's fwd input
+    const Tgpu* dy_ptr, // fwd normalized x
+    Tref* dx_ptr,
+    const Tmix* scale_ptr,
+    Tref* dscale_ptr,
+    Tref* dbias_ptr,
+    Tref epsilon,
+    bool savedmeanvar,
+    const Tref* savedMean,
+    const Tref* savedInvVariance,
+    miopenTensorLayout_t layout = miopenTensorNCHW)
+{
+    const auto shape = bn_host::Shape{n_batchs, channels, depth, height, width, layout};
+
+    bn_host::ForEachFeatureBlock(shape, [&](std::size_t first, std::size_t count) {
+        Tref mean[bn_host::features_per_block];
+        Tref invVar[bn_host::features_per_block];
+        if(savedmeanvar)
+        {
+            std::copy(savedMean + first, savedMean + first + count, mean);
+            std::copy(savedInvVariance + first, savedInvVariance + first + count, invVar);
+        }
+        else
+        {
+            double mean_accum[bn_host::features_per_block];
+            double m2_accum[bn_host::features_per_block];
+            bn_host::FeatureMoments(shape, x_ptr, first, count, mean_accum, m2_accum);
+            for(std::size_t i = 0; i < count; ++i)
+            {
+                const auto variance = static_cast<Tref>(m2_accum[i] / n_batchs);
+                mean[i]             = static_cast<Tref>(mean_accum[i]);
+                invVar[i] = static_cast<Tref>(1.0) / static_cast<Tref>(sqrt(variance + epsilon));
+            }
+        }
+
+        double dbias[bn_host::features_per_block]    = {};
+        double dscale[bn_host::features_per_block]   = {};
+        double dxhat[bn_host::features_per_block]    = {};
+        double dxhathat[bn_host::features_per_block] = {};
+        for(std::size_t b = 0; b < shape.n; ++b)
+        {
+            const auto row = b * shape.Features() + first;
+            for(std::size_t i = 0; i < count; ++i)
+            {
+                const Tref xhat   = (static_cast<Tref>(x_ptr[row + i]) - mean[i]) * invVar[i];
+                const Tref dyelem = dy_ptr[row + i];
+                const Tref tmp1   = scale_ptr[first + i] * dyelem;
+                dbias[i] += dyelem;
+                dscale[i] += xhat * dyelem;
+                dxhat[i] += tmp1;
+                dxhathat[i] += tmp1 * xhat;
+            }
+        }
+        for(std::size_t i = 0; i < count; ++i)
+        {
+            dbias_ptr[first + i]  = static_cast<Tref>(dbias[i]);
+            dscale_ptr[first + i] = static_cast<Tref>(dscale[i]);
+        }
+
+        // dx_i = invVar/N * (N*gamma*dy_i - sum{gamma*dy} - xhat_i*sum{gamma*dy*xhat})
+        for(std::size_t b = 0; b < shape.n; ++b)
+        {
+            const auto row = b * shape.Features() + first;
+            for(std::size_t i = 0; i < count; ++i)
+            {
+                const Tref xhat = (static_cast<Tref>(x_ptr[row + i]) - mean[i]) * invVar[i];
+                const Tref tmp1 = xhat * dxhathat[i] + dxhat[i];
+                const Tref tmp2 = n_batchs * (dy_ptr[row + i] * scale_ptr[first + i]) - tmp1;
+                const Tref tmp3 = invVar[i] / static_cast<Tref>(n_batchs);
+                dx_ptr[row + i] = tmp3 * tmp2;
+            }
+        }
+    });
+    return 0;
+}
+
+template <typename Tgpu, typename Tref, typename Tmix>
+int miopenBNBwdSpatialRunHost(
+    /*      T alpha,
+            T beta,
+            T alphaParam,
+            T betaParam,
+    */
+    int n_batchs,
+    int channels,
+    int depth,
+    int height,
+    int width,
+    const Tgpu* x_ptr,  // layer's fwd input
+    const Tgpu* dy_ptr, // fwd normalized x
+    Tref* dx_ptr,
+    const Tmix* scale_ptr,
+    Tref* dscale_ptr,
+    Tref* dbias_ptr,
+    Tref epsilon,
+    bool savedmeanvar,
+    const Tref* savedMean,
+    const Tref* savedInvVariance,
+    miopenTensorLayout_t layout = miopenTensorNCHW)
+{
+    const auto shape = bn_host::Shape{n_batchs, channels, depth, height, width, layout};
+    const auto NHW   = static_cast<Tref>(shape.n * shape.s);
+
+    auto mean   = std::vector<Tref>(shape.c);
+    auto invVar = std::vector<Tref>(shape.c);
+    if(savedmeanvar)
+    {
+        std::copy(savedMean, savedMean + channels, mean.begin());
+        std::copy(savedInvVariance, savedInvVariance + channels, invVar.begin());
+    }
+    else
+    {
+        const auto moments = bn_host::ChannelMoments(shape, x_ptr);
+        for(int cidx = 0; cidx < channels; cidx++)
+        {
+            mean[cidx]   = static_cast<Tref>(moments[cidx].mean);
+            invVar[cidx] = 1. / sqrt(static_cast<Tref>(moments[cidx].Variance()) + epsilon);
+        }
+    }
+
+    const auto sums = bn_host::ChannelBwdSums(shape, x_ptr, dy_ptr, mean.data());
+    for(int cidx = 0; cidx < channels; cidx++)
+    {
+        dbias_ptr[cidx]  = static_cast<Tref>(sums[cidx].dy);
+        dscale_ptr[cidx] = static_cast<Tref>(sums[cidx].xmean_dy) * invVar[cidx];
+    }
+
+    bn_host::ForEachElement(shape, [&](std::size_t cidx, std::size_t index) {
+        const Tref xhat = (static_cast<Tref>(x_ptr[index]) - mean[cidx]) * invVar[cidx];
+        const Tref tmp1 = NHW * dy_ptr[index] - dbias_ptr[cidx];
+        const Tref tmp2 = -xhat * dscale_ptr[cidx];
+        const Tref tmp3 = (scale_ptr[cidx] * invVar[cidx]) / NHW;
+        dx_ptr[index]   = tmp3 * (tmp2 + tmp1);
+    });
+    return 0;
+}
+
+#endif
@@ -132,6 +132,36 @@ struct BnFwdInference final : BatchnormSolver
                              const miopen::batchnorm::ProblemDescription& problem) const override;
 };
 
+struct BnFwdTrainingHost final : BatchnormSolver
+{
+    const std::string& SolverDbId() const override { return GetSolverDbId<BnFwdTrainingHost>(); }
+
+    bool IsApplicable(const ExecutionContext& context,
+                      const miopen::batchnorm::ProblemDescription& problem) const override;
+    ConvSolution GetSolution(const ExecutionContext& context,
+                             const miopen::batchnorm::ProblemDescription& problem) const override;
+};
+
+struct BnBwdTrainingHost final : BatchnormSolver
+{
+    const std::string& SolverDbId() const override { return GetSolverDbId<BnBwdTrainingHost>(); }
+
+    bool IsApplicable(const ExecutionContext& context,
+                      const miopen::batchnorm::ProblemDescription& problem) const override;
+    ConvSolution GetSolution(const ExecutionContext& context,
+                             const miopen::batchnorm::ProblemDescription& problem) const override;
+};
+
+struct BnFwdInferenceHost final : BatchnormSolver
+{
+    const std::string& SolverDbId() const override { return GetSolverDbId<BnFwdInferenceHost>(); }
+
+    bool IsApplicable(const ExecutionContext& context,
+                      const miopen::batchnorm::ProblemDescription& problem) const override;
+    ConvSolution GetSolution(const ExecutionContext& context,
+                             const miopen::batchnorm::ProblemDescription& problem) const override;
+};
+
 } // namespace batchnorm
 
 } // namespace solver
@@ -27,6 +27,7 @@
 #define BFLOAT16_H_
 #include <boost/operators.hpp>
 #include <iostream>
+#include <limits>
 #include <miopen/config.h>
 
 class bfloat16 : boost::totally_ordered<bfloat16, boost::arithmetic<bfloat16>>
@@ -30,6 +30,8 @@
 #include <miopen/config.h>
 #include <miopen/target_properties.hpp>
 #include <boost/filesystem/path.hpp>
+#include <cstddef>
+#include <functional>
 #include <string>
 
 namespace miopen {
@@ -43,6 +45,10 @@ boost::filesystem::path GetCacheFile(const std::string& device,
 
 boost::filesystem::path GetCachePath(bool is_system);
 
+/// Uses path as the user kernel cache instead of the one MIOPEN_CUSTOM_CACHE_DIR or the build
+/// configuration point to. Must be called before the cache is used by other threads.
+void SetUserCachePath(const boost::filesystem::path& path);
+
 #if !MIOPEN_ENABLE_SQLITE_KERN_CACHE
 boost::filesystem::path LoadBinary(const TargetProperties& target,
                                    std::size_t num_cu,
@@ -69,6 +75,22 @@ void SaveBinary(const std::string& hsaco,
                 bool is_kernel_str = false);
 #endif
 
+/// Runs compile, which returns the code object of the program and saves it to the cache, unless
+/// the same program is already being compiled by another thread of the process. In that case
+/// waits for that compilation and returns its code object (or rethrows its exception).
+/// Processes sharing the user cache also take turns compiling a program: the ones that had to
+/// wait load it from the cache. MIOPEN_COMPILE_LOCK_TIMEOUT limits the wait in seconds, 0
+/// disables the interprocess lock.
+std::string CompileOnce(const TargetProperties& target,
+                        std::size_t num_cu,
+                        const std::string& name,
+                        const std::string& args,
+                        bool is_kernel_str,
+                        const std::function<std::string()>& compile);
+
+/// Number of compilations avoided by CompileOnce since the process start.
+std::size_t GetDeduplicatedCompileCount();
+
 } // namespace miopen
 
 #endif
@@ -0,0 +1,70 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+
+namespace miopen {
+
+/// Cooperative cancellation of long running operations such as find and tuning.
+/// The token is installed for the current thread with CancellationScope and polled
+/// by the operations at points where it is safe to stop.
+class CancellationToken
+{
+public:
+    CancellationToken() : cancelled(std::make_shared<std::atomic<bool>>(false)) {}
+
+    void Cancel() const { cancelled->store(true); }
+    bool IsCancelled() const { return cancelled->load(); }
+    /// Throws miopen::Exception with miopenStatusCanceled if the token is cancelled.
+    void ThrowIfCancelled() const;
+
+    /// Token installed for the current thread. It is never cancelled unless it was
+    /// installed with CancellationScope.
+    static CancellationToken Current();
+
+private:
+    std::shared_ptr<std::atomic<bool>> cancelled;
+
+    friend class CancellationScope;
+};
+
+class CancellationScope
+{
+public:
+    explicit CancellationScope(CancellationToken token);
+    ~CancellationScope();
+
+    CancellationScope(const CancellationScope&) = delete;
+    CancellationScope& operator=(const CancellationScope&) = delete;
+
+private:
+    CancellationToken previous;
+};
+
+} // namespace miopen
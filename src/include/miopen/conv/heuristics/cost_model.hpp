@@ -0,0 +1,112 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#ifndef GUARD_MIOPEN_CONV_COST_MODEL_HPP_
+#define GUARD_MIOPEN_CONV_COST_MODEL_HPP_
+
+#include <boost/optional.hpp>
+
+#include <cstddef>
+#include <istream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace miopen {
+
+struct Handle;
+
+namespace conv {
+struct ProblemDescription;
+} // namespace conv
+
+namespace ai {
+namespace cost_model {
+
+/// Feature vector of a convolution problem. Features are computed from the
+/// find-db key (see conv::ProblemDescription::Serialize), so the offline trainer
+/// that reads *.fdb.txt files and the library see exactly the same inputs.
+/// Returns an empty vector if the key can't be parsed.
+std::vector<double> ExtractFeatures(const std::string& db_key);
+std::vector<double> ExtractFeatures(const conv::ProblemDescription& problem);
+std::size_t GetFeatureCount();
+
+/// One find-db record: the problem key and measured times (ms) per solver name.
+struct Sample
+{
+    std::string key;
+    std::unordered_map<std::string, float> times;
+};
+
+/// Parses find-db text contents ("key=solver:time,workspace,algo;...").
+std::vector<Sample> ReadFindDb(std::istream& stream);
+
+struct Evaluation
+{
+    std::size_t problems = 0; ///< Problems with at least two solvers known to the model.
+    std::size_t top1     = 0; ///< Problems where the predicted best solver is the fastest one.
+    double mean_regret   = 0; ///< Mean of (time of predicted best / best time - 1).
+    double max_regret    = 0;
+
+    double Top1Accuracy() const
+    {
+        return problems == 0 ? 0.0 : static_cast<double>(top1) / problems;
+    }
+};
+
+/// Per-solver ridge regression of log2(time) over problem features.
+class Model
+{
+public:
+    /// Solvers that have less than min_samples records are not modeled.
+    static Model
+    Train(const std::vector<Sample>& samples, double l2 = 1e-2, std::size_t min_samples = 8);
+    static Model Load(const std::string& path);
+    void Save(const std::string& path) const;
+
+    bool IsEmpty() const { return weights.empty(); }
+    bool HasSolver(const std::string& solver) const { return weights.count(solver) != 0; }
+    std::size_t GetSolverCount() const { return weights.size(); }
+
+    /// Predicted time in ms, or none if the solver is not modeled.
+    boost::optional<float> Predict(const std::string& solver,
+                                   const std::vector<double>& features) const;
+
+    Evaluation Evaluate(const std::vector<Sample>& samples) const;
+
+private:
+    std::unordered_map<std::string, std::vector<double>> weights;
+};
+
+/// Returns the model installed next to the system find-db of the device
+/// (<system db path>/<db basename>.cost.model), or nullptr if there is none.
+const Model* GetModel(const Handle& handle);
+
+} // namespace cost_model
+} // namespace ai
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_CONV_COST_MODEL_HPP_
@@ -172,6 +172,7 @@ struct ProblemDescription : ProblemDescriptionBase
           bias(bias_)
     {
         HeuristicUpdateLayouts();
+        BuildKeys();
     }
 
     // Conv descriptor getters
@@ -365,9 +366,9 @@ struct ProblemDescription : ProblemDescriptionBase
 
     bool IsLayoutDefault() const;
 
-    void HeuristicUpdateLayouts();
-
-    void BuildConfKey(std::string& conf_key) const;
+    /// The network config and the db key are built once by the constructor and then copied out
+    /// by every find-db, perf-db and invoker cache lookup.
+    void BuildConfKey(std::string& conf_key_) const;
 
     NetworkConfig BuildConfKey() const
     {
@@ -433,6 +434,15 @@ private:
     std::string out_layout;
     Direction direction = Direction::Forward;
     int bias            = 0;
+    std::string conf_key;
+    std::string db_key;
+
+    // Both run once, in this order, by the constructor: the keys include the layouts.
+    void HeuristicUpdateLayouts();
+    void BuildKeys();
+    bool HasDefaultLayouts() const;
+    std::string MakeConfKey() const;
+    std::string MakeDbKey() const;
 };
 
 } // namespace conv
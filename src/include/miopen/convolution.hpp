@@ -244,6 +244,12 @@ struct ConvolutionDescriptor : miopenConvolutionDescriptor
                          const conv::ProblemDescription& problem,
                          solver::Id solver_id) const;
 
+    /// Queues kernels of the first MIOPEN_AOT_COMPILE_TOP_K solutions for background
+    /// compilation, so that compiling them later is a kernel cache hit.
+    void PrecompileSolutions(const ExecutionContext& ctx,
+                             const conv::ProblemDescription& problem,
+                             const std::vector<miopenConvSolution_t>& solutions) const;
+
     std::size_t GetForwardSolutionWorkspaceSize(Handle& handle,
                                                 const TensorDescriptor& wDesc,
                                                 const TensorDescriptor& xDesc,
@@ -0,0 +1,524 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#ifndef GUARD_MIOPEN_CPU_CONV_GEMM_HPP_
+#define GUARD_MIOPEN_CPU_CONV_GEMM_HPP_
+
+#include <miopen/cpu_gemm.hpp>
+#include <miopen/par_for.hpp>
+#include <miopen/tensor.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <vector>
+
+/// Host convolution over im2col + CpuGemm, and Winograd F(2,3) for the forward direction.
+/// The host convolution solvers of the nogpu backend run it, and the tests use it as one of
+/// the engines of the reference convolution.
+
+namespace miopen {
+
+namespace cpu_conv_gemm {
+
+/// Output columns lowered at once, which bounds the size of the im2col buffer.
+constexpr std::size_t chunk_columns = 4096;
+
+/// Geometry of one convolution, with tensor strides taken from the descriptors so that
+/// any layout of the non-vectorized tensors is supported. The descriptors are the input,
+/// weights and output of the forward convolution in every direction.
+template <std::size_t ConvDim>
+struct problem
+{
+    std::size_t n;
+    std::size_t groups;
+    std::size_t c_per_group;
+    std::size_t k_per_group;
+    std::array<std::size_t, ConvDim> in_len;
+    std::array<std::size_t, ConvDim> wei_len;
+    std::array<std::size_t, ConvDim> out_len;
+    std::array<std::ptrdiff_t, ConvDim> pads;
+    std::array<std::ptrdiff_t, ConvDim> strides;
+    std::array<std::ptrdiff_t, ConvDim> dilations;
+    std::vector<std::size_t> in_strides;
+    std::vector<std::size_t> wei_strides;
+    std::vector<std::size_t> out_strides;
+    std::size_t in_size;  ///< Spatial elements of one input channel.
+    std::size_t wei_size; ///< Spatial elements of one filter.
+    std::size_t out_size; ///< Spatial elements of one output channel.
+
+    template <class Range>
+    problem(const TensorDescriptor& in,
+            const TensorDescriptor& wei,
+            const TensorDescriptor& out,
+            const Range& pads_,
+            const Range& strides_,
+            const Range& dilations_,
+            std::size_t group_count)
+        : n(in.GetLengths()[0]),
+          groups(group_count),
+          c_per_group(wei.GetLengths()[1]),
+          k_per_group(wei.GetLengths()[0] / group_count),
+          in_strides(in.GetStrides()),
+          wei_strides(wei.GetStrides()),
+          out_strides(out.GetStrides()),
+          in_size(1),
+          wei_size(1),
+          out_size(1)
+    {
+        for(std::size_t i = 0; i < ConvDim; ++i)
+        {
+            in_len[i]    = in.GetLengths()[i + 2];
+            wei_len[i]   = wei.GetLengths()[i + 2];
+            out_len[i]   = out.GetLengths()[i + 2];
+            pads[i]      = pads_[i];
+            strides[i]   = strides_[i];
+            dilations[i] = dilations_[i];
+            in_size *= in_len[i];
+            wei_size *= wei_len[i];
+            out_size *= out_len[i];
+        }
+    }
+
+    std::size_t col_rows() const { return c_per_group * wei_size; }
+
+    static std::array<std::size_t, ConvDim> unflatten(std::size_t id,
+                                                     const std::array<std::size_t, ConvDim>& len)
+    {
+        auto result = std::array<std::size_t, ConvDim>{};
+        for(std::size_t i = ConvDim; i-- > 0;)
+        {
+            result[i] = id % len[i];
+            id /= len[i];
+        }
+        return result;
+    }
+
+    template <class Coords>
+    static std::size_t offset(const std::vector<std::size_t>& tensor_strides,
+                              std::size_t d0,
+                              std::size_t d1,
+                              const Coords& spatial)
+    {
+        auto result = d0 * tensor_strides[0] + d1 * tensor_strides[1];
+        for(std::size_t i = 0; i < ConvDim; ++i)
+            result += spatial[i] * tensor_strides[i + 2];
+        return result;
+    }
+
+    /// Input coordinates read by filter tap `wei_id` for output position `out_id`, or false
+    /// if they are in the padding.
+    bool input_coords(std::size_t wei_id,
+                      std::size_t out_id,
+                      std::array<std::size_t, ConvDim>& in_id) const
+    {
+        const auto wei_coords = unflatten(wei_id, wei_len);
+        const auto out_coords = unflatten(out_id, out_len);
+        for(std::size_t i = 0; i < ConvDim; ++i)
+        {
+            const auto x = static_cast<std::ptrdiff_t>(out_coords[i]) * strides[i] +
+                           static_cast<std::ptrdiff_t>(wei_coords[i]) * dilations[i] - pads[i];
+            if(x < 0 || x >= static_cast<std::ptrdiff_t>(in_len[i]))
+                return false;
+            in_id[i] = x;
+        }
+        return true;
+    }
+
+    /// Filters of a group as a k_per_group x col_rows() matrix.
+    template <class Tacc, class Twei>
+    std::vector<Tacc> filter_matrix(const Twei* wei, std::size_t group) const
+    {
+        auto result = std::vector<Tacc>(k_per_group * col_rows());
+        par_for(k_per_group, min_grain{1}, [&](std::size_t k) {
+            for(std::size_t c = 0; c < c_per_group; ++c)
+                for(std::size_t w = 0; w < wei_size; ++w)
+                    result[k * col_rows() + c * wei_size + w] = static_cast<Tacc>(wei[offset(
+                        wei_strides, group * k_per_group + k, c, unflatten(w, wei_len))]);
+        });
+        return result;
+    }
+
+    /// Lowers output columns [col0, col0 + cols) of an image into a col_rows() x cols matrix.
+    template <class Tacc, class Tin>
+    void im2col(const Tin* in,
+                std::size_t batch,
+                std::size_t group,
+                std::size_t col0,
+                std::size_t cols,
+                std::vector<Tacc>& col) const
+    {
+        col.resize(col_rows() * cols);
+        par_for(col_rows(), min_grain{8}, [&](std::size_t row) {
+            const auto c = group * c_per_group + row / wei_size;
+            auto in_id   = std::array<std::size_t, ConvDim>{};
+            for(std::size_t j = 0; j < cols; ++j)
+            {
+                col[row * cols + j] =
+                    input_coords(row % wei_size, col0 + j, in_id)
+                        ? static_cast<Tacc>(in[offset(in_strides, batch, c, in_id)])
+                        : Tacc{0};
+            }
+        });
+    }
+
+    /// Reads output columns [col0, col0 + cols) of an image as a k_per_group x cols matrix.
+    template <class Tacc, class Tout>
+    void gather_output(const Tout* out,
+                       std::size_t batch,
+                       std::size_t group,
+                       std::size_t col0,
+                       std::size_t cols,
+                       std::vector<Tacc>& result) const
+    {
+        result.resize(k_per_group * cols);
+        par_for(k_per_group, min_grain{1}, [&](std::size_t k) {
+            for(std::size_t j = 0; j < cols; ++j)
+                result[k * cols + j] = static_cast<Tacc>(out[offset(
+                    out_strides, batch, group * k_per_group + k, unflatten(col0 + j, out_len))]);
+        });
+    }
+};
+
+template <std::size_t ConvDim, class Tacc, class Tin, class Twei, class Tout>
+void forward(const Tin* in, const Twei* wei, Tout* out, const problem<ConvDim>& p)
+{
+    auto col = std::vector<Tacc>{};
+    auto res = std::vector<Tacc>{};
+    for(std::size_t g = 0; g < p.groups; ++g)
+    {
+        const auto filters = p.template filter_matrix<Tacc>(wei, g);
+        for(std::size_t n = 0; n < p.n; ++n)
+        {
+            for(std::size_t col0 = 0; col0 < p.out_size; col0 += chunk_columns)
+            {
+                const auto cols = std::min(chunk_columns, p.out_size - col0);
+                p.im2col(in, n, g, col0, cols, col);
+                res.resize(p.k_per_group * cols);
+                CpuGemm<Tacc>(false,
+                                      false,
+                                      p.k_per_group,
+                                      cols,
+                                      p.col_rows(),
+                                      1.0,
+                                      filters.data(),
+                                      p.col_rows(),
+                                      col.data(),
+                                      cols,
+                                      0.0,
+                                      res.data(),
+                                      cols);
+                for(std::size_t k = 0; k < p.k_per_group; ++k)
+                    for(std::size_t j = 0; j < cols; ++j)
+                        out[p.offset(p.out_strides,
+                                     n,
+                                     g * p.k_per_group + k,
+                                     p.unflatten(col0 + j, p.out_len))] =
+                            static_cast<Tout>(res[k * cols + j]);
+            }
+        }
+    }
+}
+
+template <std::size_t ConvDim, class Tacc, class Tin, class Twei, class Tout>
+void backward_data(Tin* in, const Twei* wei, const Tout* out, const problem<ConvDim>& p)
+{
+    auto dout = std::vector<Tacc>{};
+    auto col  = std::vector<Tacc>{};
+    auto din  = std::vector<Tacc>{};
+    for(std::size_t g = 0; g < p.groups; ++g)
+    {
+        const auto filters = p.template filter_matrix<Tacc>(wei, g);
+        for(std::size_t n = 0; n < p.n; ++n)
+        {
+            din.assign(p.c_per_group * p.in_size, Tacc{0});
+            for(std::size_t col0 = 0; col0 < p.out_size; col0 += chunk_columns)
+            {
+                const auto cols = std::min(chunk_columns, p.out_size - col0);
+                p.gather_output(out, n, g, col0, cols, dout);
+                col.resize(p.col_rows() * cols);
+                CpuGemm<Tacc>(true,
+                                      false,
+                                      p.col_rows(),
+                                      cols,
+                                      p.k_per_group,
+                                      1.0,
+                                      filters.data(),
+                                      p.col_rows(),
+                                      dout.data(),
+                                      cols,
+                                      0.0,
+                                      col.data(),
+                                      cols);
+
+                // col2im: taps of a channel overlap, so each channel is owned by one thread.
+                par_for(p.c_per_group, min_grain{1}, [&](std::size_t c) {
+                    auto in_id = std::array<std::size_t, ConvDim>{};
+                    for(std::size_t w = 0; w < p.wei_size; ++w)
+                    {
+                        const auto* const row = &col[(c * p.wei_size + w) * cols];
+                        for(std::size_t j = 0; j < cols; ++j)
+                        {
+                            if(!p.input_coords(w, col0 + j, in_id))
+                                continue;
+                            auto flat = std::size_t{0};
+                            for(std::size_t i = 0; i < ConvDim; ++i)
+                                flat = flat * p.in_len[i] + in_id[i];
+                            din[c * p.in_size + flat] += row[j];
+                        }
+                    }
+                });
+            }
+            for(std::size_t c = 0; c < p.c_per_group; ++c)
+                for(std::size_t i = 0; i < p.in_size; ++i)
+                    in[p.offset(
+                        p.in_strides, n, g * p.c_per_group + c, p.unflatten(i, p.in_len))] =
+                        static_cast<Tin>(din[c * p.in_size + i]);
+        }
+    }
+}
+
+template <std::size_t ConvDim, class Tacc, class Tin, class Twei, class Tout>
+void backward_weights(const Tin* in, Twei* wei, const Tout* out, const problem<ConvDim>& p)
+{
+    auto dout = std::vector<Tacc>{};
+    auto col  = std::vector<Tacc>{};
+    auto dwei = std::vector<Tacc>{};
+    for(std::size_t g = 0; g < p.groups; ++g)
+    {
+        dwei.assign(p.k_per_group * p.col_rows(), Tacc{0});
+        for(std::size_t n = 0; n < p.n; ++n)
+        {
+            for(std::size_t col0 = 0; col0 < p.out_size; col0 += chunk_columns)
+            {
+                const auto cols = std::min(chunk_columns, p.out_size - col0);
+                p.im2col(in, n, g, col0, cols, col);
+                p.gather_output(out, n, g, col0, cols, dout);
+                CpuGemm<Tacc>(false,
+                                      true,
+                                      p.k_per_group,
+                                      p.col_rows(),
+                                      cols,
+                                      1.0,
+                                      dout.data(),
+                                      cols,
+                                      col.data(),
+                                      cols,
+                                      1.0,
+                                      dwei.data(),
+                                      p.col_rows());
+            }
+        }
+        for(std::size_t k = 0; k < p.k_per_group; ++k)
+            for(std::size_t c = 0; c < p.c_per_group; ++c)
+                for(std::size_t w = 0; w < p.wei_size; ++w)
+                    wei[p.offset(
+                        p.wei_strides, g * p.k_per_group + k, c, p.unflatten(w, p.wei_len))] =
+                        static_cast<Twei>(dwei[k * p.col_rows() + c * p.wei_size + w]);
+    }
+}
+
+/// Winograd F(2x2, 3x3) applies to 2D 3x3 filters with unit strides and dilations.
+template <std::size_t ConvDim>
+bool winograd_applicable(const problem<ConvDim>& p)
+{
+    if(ConvDim != 2)
+        return false;
+    for(std::size_t i = 0; i < ConvDim; ++i)
+        if(p.wei_len[i] != 3 || p.strides[i] != 1 || p.dilations[i] != 1)
+            return false;
+    return true;
+}
+
+/// Forward convolution as Winograd F(2x2, 3x3): Y = A^T [(G g G^T) . (B^T d B)] A, where the
+/// element-wise products summed over input channels are 16 GEMMs over a chunk of 4x4 tiles.
+template <std::size_t ConvDim, class Tacc, class Tin, class Twei, class Tout>
+void forward_winograd(const Tin* in, const Twei* wei, Tout* out, const problem<ConvDim>& p)
+{
+    static_assert(ConvDim == 2, "Winograd F(2,3) is two-dimensional");
+    constexpr std::size_t tile_elems  = 16;
+    constexpr std::size_t chunk_tiles = 1024;
+
+    const auto tiles_h = (p.out_len[0] + 1) / 2;
+    const auto tiles_w = (p.out_len[1] + 1) / 2;
+    const auto tiles   = p.n * tiles_h * tiles_w;
+    const auto kpg     = p.k_per_group;
+    const auto cpg     = p.c_per_group;
+
+    auto u = std::vector<Tacc>(tile_elems * kpg * cpg);
+    auto v = std::vector<Tacc>{};
+    auto m = std::vector<Tacc>{};
+
+    for(std::size_t g = 0; g < p.groups; ++g)
+    {
+        // u[e][k][c] = (G g G^T)[e]
+        par_for(kpg, min_grain{1}, [&](std::size_t k) {
+            for(std::size_t c = 0; c < cpg; ++c)
+            {
+                Tacc f[3][3];
+                for(std::size_t y = 0; y < 3; ++y)
+                    for(std::size_t x = 0; x < 3; ++x)
+                        f[y][x] = static_cast<Tacc>(wei[p.offset(
+                            p.wei_strides, g * kpg + k, c, std::array<std::size_t, 2>{y, x})]);
+                Tacc gf[4][3];
+                for(std::size_t x = 0; x < 3; ++x)
+                {
+                    gf[0][x] = f[0][x];
+                    gf[1][x] = (f[0][x] + f[1][x] + f[2][x]) / 2;
+                    gf[2][x] = (f[0][x] - f[1][x] + f[2][x]) / 2;
+                    gf[3][x] = f[2][x];
+                }
+                for(std::size_t y = 0; y < 4; ++y)
+                {
+                    const Tacc row[4] = {gf[y][0],
+                                         (gf[y][0] + gf[y][1] + gf[y][2]) / 2,
+                                         (gf[y][0] - gf[y][1] + gf[y][2]) / 2,
+                                         gf[y][2]};
+                    for(std::size_t x = 0; x < 4; ++x)
+                        u[((y * 4 + x) * kpg + k) * cpg + c] = row[x];
+                }
+            }
+        });
+
+        for(std::size_t t0 = 0; t0 < tiles; t0 += chunk_tiles)
+        {
+            const auto nt = std::min(chunk_tiles, tiles - t0);
+            v.resize(tile_elems * cpg * nt);
+            m.resize(tile_elems * kpg * nt);
+
+            // v[e][c][t] = (B^T d B)[e]
+            par_for(cpg, min_grain{1}, [&](std::size_t c) {
+                for(std::size_t t = 0; t < nt; ++t)
+                {
+                    const auto tile = t0 + t;
+                    const auto n    = tile / (tiles_h * tiles_w);
+                    const auto th   = tile / tiles_w % tiles_h;
+                    const auto tw   = tile % tiles_w;
+                    Tacc d[4][4];
+                    for(std::size_t y = 0; y < 4; ++y)
+                    {
+                        for(std::size_t x = 0; x < 4; ++x)
+                        {
+                            const auto iy = static_cast<std::ptrdiff_t>(2 * th + y) - p.pads[0];
+                            const auto ix = static_cast<std::ptrdiff_t>(2 * tw + x) - p.pads[1];
+                            const auto inside =
+                                iy >= 0 && iy < static_cast<std::ptrdiff_t>(p.in_len[0]) &&
+                                ix >= 0 && ix < static_cast<std::ptrdiff_t>(p.in_len[1]);
+                            const auto at   = std::array<std::size_t, 2>{
+                                static_cast<std::size_t>(iy), static_cast<std::size_t>(ix)};
+                            d[y][x] = inside ? static_cast<Tacc>(
+                                                   in[p.offset(p.in_strides, n, g * cpg + c, at)])
+                                             : Tacc{0};
+                        }
+                    }
+                    Tacc bd[4][4];
+                    for(std::size_t x = 0; x < 4; ++x)
+                    {
+                        bd[0][x] = d[0][x] - d[2][x];
+                        bd[1][x] = d[1][x] + d[2][x];
+                        bd[2][x] = d[2][x] - d[1][x];
+                        bd[3][x] = d[1][x] - d[3][x];
+                    }
+                    for(std::size_t y = 0; y < 4; ++y)
+                    {
+                        const Tacc row[4] = {bd[y][0] - bd[y][2],
+                                             bd[y][1] + bd[y][2],
+                                             bd[y][2] - bd[y][1],
+                                             bd[y][1] - bd[y][3]};
+                        for(std::size_t x = 0; x < 4; ++x)
+                            v[((y * 4 + x) * cpg + c) * nt + t] = row[x];
+                    }
+                }
+            });
+
+            for(std::size_t e = 0; e < tile_elems; ++e)
+                CpuGemm<Tacc>(false,
+                                      false,
+                                      kpg,
+                                      nt,
+                                      cpg,
+                                      1.0,
+                                      &u[e * kpg * cpg],
+                                      cpg,
+                                      &v[e * cpg * nt],
+                                      nt,
+                                      0.0,
+                                      &m[e * kpg * nt],
+                                      nt);
+
+            // Y = A^T m A
+            par_for(kpg, min_grain{1}, [&](std::size_t k) {
+                for(std::size_t t = 0; t < nt; ++t)
+                {
+                    const auto tile = t0 + t;
+                    const auto n    = tile / (tiles_h * tiles_w);
+                    const auto th   = tile / tiles_w % tiles_h;
+                    const auto tw   = tile % tiles_w;
+                    Tacc am[2][4];
+                    for(std::size_t x = 0; x < 4; ++x)
+                    {
+                        const auto at = [&](std::size_t y) {
+                            return m[((y * 4 + x) * kpg + k) * nt + t];
+                        };
+                        am[0][x] = at(0) + at(1) + at(2);
+                        am[1][x] = at(1) - at(2) - at(3);
+                    }
+                    for(std::size_t y = 0; y < 2; ++y)
+                    {
+                        const Tacc row[2] = {am[y][0] + am[y][1] + am[y][2],
+                                             am[y][1] - am[y][2] - am[y][3]};
+                        for(std::size_t x = 0; x < 2; ++x)
+                        {
+                            const auto oy = 2 * th + y;
+                            const auto ox = 2 * tw + x;
+                            if(oy < p.out_len[0] && ox < p.out_len[1])
+                                out[p.offset(p.out_strides,
+                                             n,
+                                             g * kpg + k,
+                                             std::array<std::size_t, 2>{oy, ox})] =
+                                    static_cast<Tout>(row[x]);
+                        }
+                    }
+                }
+            });
+        }
+    }
+}
+
+/// The gemm engines read the tensors through their strides, which doesn't cover
+/// vectorized layouts. They also need a floating point accumulator, which is checked at
+/// compile time by the callers.
+inline bool applicable(const TensorDescriptor& in, const TensorDescriptor& wei)
+{
+    return in.GetVectorLength() == 1 && wei.GetVectorLength() == 1 &&
+           wei.GetLayout_str() != "CHWNc";
+}
+
+} // namespace cpu_conv_gemm
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_CPU_CONV_GEMM_HPP_
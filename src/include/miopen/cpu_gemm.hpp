@@ -0,0 +1,294 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#pragma once
+
+#include <miopen/float_equal.hpp>
+#include <miopen/par_for.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define MIOPEN_CPU_GEMM_X86_DISPATCH 1
+#else
+#define MIOPEN_CPU_GEMM_X86_DISPATCH 0
+#endif
+
+namespace miopen {
+
+/// Host GEMM used by the reference implementations of the driver and the tests:
+///
+///     C = alpha * op(A) * op(B) + beta * C
+///
+/// All matrices are row-major, op(A) is m x k, op(B) is k x n and C is m x n. Inputs of
+/// any type convertible to Tacc (including half and bfloat16) are widened while being
+/// packed, and all products are accumulated in Tacc. C is read only when beta != 0.
+///
+/// C is split in tiles that are computed in parallel. Each tile is computed by a register
+/// blocked micro-kernel over A and B panels packed into contiguous buffers. On x86 the
+/// micro-kernel is compiled for AVX-512 and AVX2 as well, and the widest one supported by
+/// the CPU is used.
+template <class Tacc, class TA, class TB, class TC>
+void CpuGemm(bool trans_a,
+             bool trans_b,
+             std::size_t m,
+             std::size_t n,
+             std::size_t k,
+             double alpha,
+             const TA* a,
+             std::size_t lda,
+             const TB* b,
+             std::size_t ldb,
+             double beta,
+             TC* c,
+             std::size_t ldc);
+
+namespace cpu_gemm {
+
+template <class T>
+struct Blocking
+{
+    static_assert(std::is_floating_point<T>{}, "accumulation type must be floating point");
+
+    // 6 rows of two 256-bit vectors keep 12 accumulators in registers.
+    static constexpr std::size_t mr = 6;
+    static constexpr std::size_t nr = 64 / sizeof(T);
+    static constexpr std::size_t mc = mr * 16;
+    static constexpr std::size_t nc = nr * 16;
+    static constexpr std::size_t kc = 256;
+};
+
+template <class T>
+using MicroKernel = void (*)(std::size_t kc, const T* a, const T* b, T* c, std::size_t ldc);
+
+/// c[mr x nr] += a[mr x kc] * b[kc x nr], where a is packed column by column and b row by row.
+template <class T, std::size_t MR, std::size_t NR>
+#if MIOPEN_CPU_GEMM_X86_DISPATCH
+__attribute__((always_inline))
+#endif
+inline void MicroKernelImpl(std::size_t kc,
+                            const T* __restrict a,
+                            const T* __restrict b,
+                            T* __restrict c,
+                            std::size_t ldc)
+{
+    T acc[MR][NR] = {};
+    for(std::size_t p = 0; p < kc; ++p, a += MR, b += NR)
+    {
+        for(std::size_t i = 0; i < MR; ++i)
+        {
+            const auto ai = a[i];
+            for(std::size_t j = 0; j < NR; ++j)
+                acc[i][j] += ai * b[j];
+        }
+    }
+    for(std::size_t i = 0; i < MR; ++i)
+        for(std::size_t j = 0; j < NR; ++j)
+            c[i * ldc + j] += acc[i][j];
+}
+
+template <class T, std::size_t MR, std::size_t NR>
+void MicroKernelGeneric(std::size_t kc, const T* a, const T* b, T* c, std::size_t ldc)
+{
+    MicroKernelImpl<T, MR, NR>(kc, a, b, c, ldc);
+}
+
+#if MIOPEN_CPU_GEMM_X86_DISPATCH
+template <class T, std::size_t MR, std::size_t NR>
+__attribute__((target("avx2,fma"))) void
+MicroKernelAvx2(std::size_t kc, const T* a, const T* b, T* c, std::size_t ldc)
+{
+    MicroKernelImpl<T, MR, NR>(kc, a, b, c, ldc);
+}
+
+template <class T, std::size_t MR, std::size_t NR>
+__attribute__((target("avx512f"))) void
+MicroKernelAvx512(std::size_t kc, const T* a, const T* b, T* c, std::size_t ldc)
+{
+    MicroKernelImpl<T, MR, NR>(kc, a, b, c, ldc);
+}
+#endif
+
+template <class T>
+MicroKernel<T> GetMicroKernel()
+{
+    using B = Blocking<T>;
+    static const auto kernel = []() -> MicroKernel<T> {
+#if MIOPEN_CPU_GEMM_X86_DISPATCH
+        __builtin_cpu_init();
+        if(__builtin_cpu_supports("avx512f"))
+            return &MicroKernelAvx512<T, B::mr, B::nr>;
+        if(__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+            return &MicroKernelAvx2<T, B::mr, B::nr>;
+#endif
+        return &MicroKernelGeneric<T, B::mr, B::nr>;
+    }();
+    return kernel;
+}
+
+/// Packs rows [i0, i0 + mc) and columns [p0, p0 + kc) of op(A) into mr-row slivers,
+/// each stored column by column. Rows past the matrix are zero.
+template <class T, class TA>
+void PackA(bool trans,
+           const TA* a,
+           std::size_t lda,
+           std::size_t m,
+           std::size_t i0,
+           std::size_t mc,
+           std::size_t p0,
+           std::size_t kc,
+           T* packed)
+{
+    constexpr auto mr = Blocking<T>::mr;
+    for(std::size_t ii = 0; ii < mc; ii += mr)
+    {
+        for(std::size_t p = 0; p < kc; ++p)
+        {
+            for(std::size_t i = 0; i < mr; ++i)
+            {
+                const auto row = i0 + ii + i;
+                const auto col = p0 + p;
+                *packed++      = row >= m ? T{0}
+                                          : static_cast<T>(trans ? a[col * lda + row]
+                                                                 : a[row * lda + col]);
+            }
+        }
+    }
+}
+
+/// Packs rows [p0, p0 + kc) and columns [j0, j0 + nc) of op(B) into nr-column slivers,
+/// each stored row by row. Columns past the matrix are zero.
+template <class T, class TB>
+void PackB(bool trans,
+           const TB* b,
+           std::size_t ldb,
+           std::size_t n,
+           std::size_t j0,
+           std::size_t nc,
+           std::size_t p0,
+           std::size_t kc,
+           T* packed)
+{
+    constexpr auto nr = Blocking<T>::nr;
+    for(std::size_t jj = 0; jj < nc; jj += nr)
+    {
+        for(std::size_t p = 0; p < kc; ++p)
+        {
+            for(std::size_t j = 0; j < nr; ++j)
+            {
+                const auto row = p0 + p;
+                const auto col = j0 + jj + j;
+                *packed++      = col >= n ? T{0}
+                                          : static_cast<T>(trans ? b[col * ldb + row]
+                                                                 : b[row * ldb + col]);
+            }
+        }
+    }
+}
+
+inline std::size_t RoundUp(std::size_t x, std::size_t multiple)
+{
+    return (x + multiple - 1) / multiple * multiple;
+}
+
+} // namespace cpu_gemm
+
+template <class Tacc, class TA, class TB, class TC>
+void CpuGemm(bool trans_a,
+             bool trans_b,
+             std::size_t m,
+             std::size_t n,
+             std::size_t k,
+             double alpha,
+             const TA* a,
+             std::size_t lda,
+             const TB* b,
+             std::size_t ldb,
+             double beta,
+             TC* c,
+             std::size_t ldc)
+{
+    using B = cpu_gemm::Blocking<Tacc>;
+
+    if(m == 0 || n == 0)
+        return;
+
+    const auto tiles_m = (m + B::mc - 1) / B::mc;
+    const auto tiles_n = (n + B::nc - 1) / B::nc;
+    const auto kernel  = cpu_gemm::GetMicroKernel<Tacc>();
+    const auto read_c  = !miopen::float_equal(beta, 0);
+
+    const auto compute_tile = [&](std::size_t tile) {
+        const auto i0 = tile / tiles_n * B::mc;
+        const auto j0 = tile % tiles_n * B::nc;
+        const auto mc = std::min(B::mc, m - i0);
+        const auto nc = std::min(B::nc, n - j0);
+        const auto mp = cpu_gemm::RoundUp(mc, B::mr);
+        const auto np = cpu_gemm::RoundUp(nc, B::nr);
+
+        thread_local std::vector<Tacc> packed_a, packed_b, acc;
+        packed_a.resize(B::mc * B::kc);
+        packed_b.resize(B::nc * B::kc);
+        acc.assign(mp * np, Tacc{0});
+
+        for(std::size_t p0 = 0; p0 < k; p0 += B::kc)
+        {
+            const auto kc = std::min(B::kc, k - p0);
+            cpu_gemm::PackA(trans_a, a, lda, m, i0, mp, p0, kc, packed_a.data());
+            cpu_gemm::PackB(trans_b, b, ldb, n, j0, np, p0, kc, packed_b.data());
+            for(std::size_t jj = 0; jj < np; jj += B::nr)
+                for(std::size_t ii = 0; ii < mp; ii += B::mr)
+                    kernel(kc, &packed_a[ii * kc], &packed_b[jj * kc], &acc[ii * np + jj], np);
+        }
+
+        for(std::size_t i = 0; i < mc; ++i)
+        {
+            auto* c_row = c + (i0 + i) * ldc + j0;
+            for(std::size_t j = 0; j < nc; ++j)
+            {
+                const auto prior = read_c ? beta * static_cast<Tacc>(c_row[j]) : 0;
+                c_row[j]         = static_cast<TC>(alpha * acc[i * np + j] + prior);
+            }
+        }
+    };
+
+    // Threads are not worth starting for the small products RNN references issue per step.
+    const auto tiles = tiles_m * tiles_n;
+    const auto flops = 2.0 * m * n * k;
+    if(tiles == 1 || flops < 1.0e7)
+    {
+        for(std::size_t tile = 0; tile < tiles; ++tile)
+            compute_tile(tile);
+        return;
+    }
+    par_for(tiles, min_grain{1}, compute_tile);
+}
+
+} // namespace miopen
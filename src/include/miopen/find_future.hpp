@@ -0,0 +1,78 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#pragma once
+
+#include <miopen/miopen.h>
+
+#include <miopen/cancellation.hpp>
+#include <miopen/object.hpp>
+#include <miopen/problem.hpp>
+#include <miopen/search_options.hpp>
+#include <miopen/solution.hpp>
+
+#include <cstddef>
+#include <future>
+#include <vector>
+
+namespace miopen {
+
+struct Handle;
+
+/// Result of Problem::FindSolutions running on a background thread. Finds are executed one
+/// at a time, because concurrent benchmarks on the same device would distort each other's
+/// timings, while compilation inside each find is still parallel.
+struct FindFuture : miopenFindFuture
+{
+    FindFuture(Handle& handle, Problem problem, FindOptions options, std::size_t max_solutions);
+    /// Cancels the find if it is still running and waits for it to stop, as it uses the handle.
+    ~FindFuture();
+
+    FindFuture(const FindFuture&) = delete;
+    FindFuture& operator=(const FindFuture&) = delete;
+
+    bool IsReady() const;
+    void Wait() const;
+    /// Cancellation is cooperative: the find stops at the next benchmark or tuning step and
+    /// the future then holds a miopen::Exception with miopenStatusCanceled.
+    void Cancel() const { cancellation.Cancel(); }
+    /// Waits for the find and rethrows its exception, if any.
+    const std::vector<Solution>& GetSolutions() const;
+
+private:
+    CancellationToken cancellation;
+    std::shared_future<std::vector<Solution>> solutions;
+};
+
+} // namespace miopen
+
+inline std::ostream& operator<<(std::ostream& stream, const miopen::FindFuture& future)
+{
+    stream << &future;
+    return stream;
+}
+
+MIOPEN_DEFINE_OBJECT(miopenFindFuture, miopen::FindFuture);
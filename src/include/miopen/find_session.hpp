@@ -0,0 +1,94 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#pragma once
+
+#include <miopen/miopen.h>
+
+#include <miopen/object.hpp>
+#include <miopen/problem.hpp>
+#include <miopen/solution.hpp>
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace miopen {
+
+struct Handle;
+struct FindOptions;
+
+/// Finds solutions for all problems of a network at once. Identical problems are found only
+/// once, and all of them are benchmarked with the same workspace and tensor buffers, which are
+/// sized for the largest problem instead of being allocated per call.
+struct FindSession : miopenFindSession
+{
+    FindSession() = default;
+
+    /// Returns the id of the problem within the session.
+    std::size_t AddProblem(const Problem& problem);
+    std::size_t GetProblemCount() const { return problem_to_unique.size(); }
+    std::size_t GetUniqueProblemCount() const { return unique_problems.size(); }
+
+    void Run(Handle& handle, const FindOptions& options, std::size_t max_solutions);
+
+    /// Selects a solution for every problem, so the workspace shared by the layers, which is the
+    /// maximum of the selected solutions' workspaces, is minimal while the sum of the selected
+    /// solutions' times is within (1 + max_slowdown) of the fastest possible. Returns the size of
+    /// the shared workspace.
+    std::size_t PlanWorkspace(float max_slowdown);
+
+    const std::vector<Solution>& GetSolutions(std::size_t problem_id) const;
+    /// Returns the solution selected by the last PlanWorkspace() call, or the first one found.
+    const Solution& GetPlannedSolution(std::size_t problem_id) const;
+
+private:
+    struct UniqueProblem
+    {
+        Problem problem;
+        std::string key;
+        std::size_t count = 0;
+        std::vector<Solution> solutions;
+        std::size_t planned = 0;
+    };
+
+    std::vector<UniqueProblem> unique_problems;
+    std::vector<std::size_t> problem_to_unique;
+    bool found = false;
+
+    const UniqueProblem& GetUniqueProblemChecked(std::size_t problem_id) const;
+};
+
+} // namespace miopen
+
+inline std::ostream& operator<<(std::ostream& stream, const miopen::FindSession& session)
+{
+    stream << "find session(problems: " << session.GetProblemCount()
+           << ", unique: " << session.GetUniqueProblemCount() << ")";
+    return stream;
+}
+
+MIOPEN_DEFINE_OBJECT(miopenFindSession, miopen::FindSession);
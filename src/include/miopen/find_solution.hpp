@@ -57,6 +57,18 @@ auto FindSolutionImpl(rank<1>,
     const FindEnforce enforce;
     if(context.disable_perfdb_access)
     {
+        if(!perf_cfg.empty())
+        {
+            using PerformanceConfig = decltype(s.GetDefaultPerformanceConfig(context, problem));
+            PerformanceConfig config{};
+            if(config.Deserialize(perf_cfg) && s.IsValidPerformanceConfig(context, problem, config))
+            {
+                MIOPEN_LOG_I(s.SolverDbId() << " (db access disabled, config provided)");
+                return s.GetSolution(context, problem, config);
+            }
+            MIOPEN_LOG_WE("Invalid config provided: " << s.SolverDbId() << ": " << perf_cfg
+                                                      << ". Performance may degrade.");
+        }
         MIOPEN_LOG_I(s.SolverDbId() << " (db access disabled)");
         return s.GetSolution(context, problem, s.GetDefaultPerformanceConfig(context, problem));
     }
@@ -125,6 +137,8 @@ auto FindSolutionImpl(rank<1>,
             }
             catch(const miopen::Exception& ex)
             {
+                if(ex.status == miopenStatusCanceled)
+                    throw;
                 MIOPEN_LOG_E("Search failed for: " << s.SolverDbId() << ": " << ex.what());
             }
         }
@@ -28,6 +28,7 @@
 #define GUARD_MIOPEN_GENERIC_SEARCH_HPP_
 
 #include <miopen/binary_cache.hpp>
+#include <miopen/cancellation.hpp>
 #include <miopen/config.h>
 #include <miopen/conv/context.hpp>
 #include <miopen/conv_solution.hpp>
@@ -310,7 +311,8 @@ void CompileAgent(size_t thread_index,
                   const Context& context,
                   const Problem& problem,
                   std::vector<PerformanceConfig>& data,
-                  ThreadSafeQueue<std::tuple<PerformanceConfig, ConvSolution, bool>>& comp_queue)
+                  ThreadSafeQueue<std::tuple<PerformanceConfig, ConvSolution, bool>>& comp_queue,
+                  const CancellationToken& cancellation)
 {
     const auto start_time =
         std::chrono::time_point_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now());
@@ -330,6 +332,13 @@ void CompileAgent(size_t thread_index,
             comp_queue.push(std::move(tmp));
             break;
         }
+        if(cancellation.IsCancelled())
+        {
+            MIOPEN_LOG_I2("Thread: " << thread_index << " Done, cancelled");
+            auto tmp = std::make_tuple<PerformanceConfig, ConvSolution, bool>({}, {}, true);
+            comp_queue.push(std::move(tmp));
+            break;
+        }
         auto& current_config          = data.at(idx);
         ConvSolution current_solution = s.GetSolution(context, problem, current_config);
         for(const auto& kernel : current_solution.construction_params)
@@ -392,6 +401,7 @@ auto GenericSearch(const Solver s,
     heartbeat.Start();
 
     const auto total_threads = GetTuningThreadsMax();
+    const auto cancellation  = CancellationToken::Current();
 
     ThreadSafeQueue<std::tuple<PerformanceConfig, ConvSolution, bool>> solution_queue;
     std::vector<std::thread> compile_agents;
@@ -405,7 +415,8 @@ auto GenericSearch(const Solver s,
                                     std::cref(context),
                                     std::cref(problem),
                                     std::ref(all_configs),
-                                    std::ref(solution_queue));
+                                    std::ref(solution_queue),
+                                    std::cref(cancellation));
     }
 
     if(!IsEnabled(MIOPEN_DEBUG_COMPILE_ONLY{}))
@@ -414,7 +425,7 @@ auto GenericSearch(const Solver s,
         auto threads_remaining = total_threads;
         while(true)
         {
-            if(n_current >= n_runs_total)
+            if(n_current >= n_runs_total || cancellation.IsCancelled())
                 break;
             MIOPEN_LOG_I2("Waiting for item in queue");
             const auto kinder     = solution_queue.pop();
@@ -548,6 +559,8 @@ auto GenericSearch(const Solver s,
     for(auto& agent : compile_agents)
         agent.join();
 
+    cancellation.ThrowIfCancelled();
+
     MIOPEN_LOG_W("Done: " << n_runs_total << '/' << n_failed << '/' << n_runs_total << ", best #"
                           << n_best << ' ' << best_time << ' ' << best_config);
 
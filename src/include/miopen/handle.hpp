@@ -31,6 +31,7 @@
 #include <miopen/common.hpp>
 #include <miopen/invoker_cache.hpp>
 #include <miopen/kernel.hpp>
+#include <miopen/kernel_cache_key.hpp>
 #include <miopen/miopen.h>
 #include <miopen/names.hpp>
 #include <miopen/object.hpp>
@@ -83,6 +84,12 @@ struct Handle : miopenHandle
     miopenAcceleratorQueue_t GetStream() const;
     void SetStream(miopenAcceleratorQueue_t streamID) const;
     void SetStreamFromPool(int streamID) const;
+#if MIOPEN_MODE_NOGPU
+    /// Sets the device programs are compiled for, e.g. "gfx90a:sramecc+:xnack-", and its
+    /// number of compute units.
+    void SetTargetDevice(const std::string& arch, std::size_t num_cu);
+    bool HasTargetDevice() const;
+#endif
     void ReserveExtraStreamsInPool(int cnt) const;
 
     void SetAllocator(miopenAllocatorFunction allocator,
@@ -97,6 +104,18 @@ struct Handle : miopenHandle
     float GetKernelTime() const;
     bool IsProfilingEnabled() const;
 
+    /// A caller that looks the kernels up before adding them should make the key once and pass
+    /// it to both calls, so that the strings are hashed once.
+    KernelInvoke AddKernel(const KernelCacheKey& key,
+                           const std::string& program_name,
+                           const std::string& kernel_name,
+                           const std::vector<size_t>& vld,
+                           const std::vector<size_t>& vgd,
+                           const std::string& params,
+                           std::size_t cache_index       = 0,
+                           bool is_kernel_str            = false,
+                           const std::string& kernel_src = "") const;
+
     KernelInvoke AddKernel(const std::string& algorithm,
                            const std::string& network_config,
                            const std::string& program_name,
@@ -106,34 +125,59 @@ struct Handle : miopenHandle
                            const std::string& params,
                            std::size_t cache_index       = 0,
                            bool is_kernel_str            = false,
-                           const std::string& kernel_src = "") const;
+                           const std::string& kernel_src = "") const
+    {
+        return AddKernel(KernelCacheKey{algorithm, network_config},
+                         program_name,
+                         kernel_name,
+                         vld,
+                         vgd,
+                         params,
+                         cache_index,
+                         is_kernel_str,
+                         kernel_src);
+    }
 
-    void ClearKernels(const std::string& algorithm, const std::string& network_config) const;
+    void ClearKernels(const KernelCacheKey& key) const;
+    void ClearKernels(const std::string& algorithm, const std::string& network_config) const
+    {
+        ClearKernels(KernelCacheKey{algorithm, network_config});
+    }
 
-    auto GetKernels(const std::string& algorithm, const std::string& network_config) const
+    auto GetKernels(const KernelCacheKey& key) const
     {
-        return this->GetKernelsImpl(algorithm, network_config) |
+        return this->GetKernelsImpl(key) |
                boost::adaptors::transformed([this](Kernel k) { return this->Run(k); });
     }
-    KernelInvoke GetKernel(const std::string& algorithm, const std::string& network_config) const
+    auto GetKernels(const std::string& algorithm, const std::string& network_config) const
+    {
+        return GetKernels(KernelCacheKey{algorithm, network_config});
+    }
+    KernelInvoke GetKernel(const KernelCacheKey& key) const
     {
-        auto ks = this->GetKernelsImpl(algorithm, network_config);
+        auto ks = this->GetKernelsImpl(key);
         if(ks.empty())
         {
-            MIOPEN_THROW("looking for default kernel (does not exist): " + algorithm + ", " +
-                         network_config);
+            MIOPEN_THROW("looking for default kernel (does not exist): " + key.GetFirst() + ", " +
+                         key.GetSecond());
         }
         return this->Run(ks.front());
     }
+    KernelInvoke GetKernel(const std::string& algorithm, const std::string& network_config) const
+    {
+        return GetKernel(KernelCacheKey{algorithm, network_config});
+    }
 
     KernelInvoke Run(Kernel k) const;
-    const std::vector<Kernel>& GetKernelsImpl(const std::string& algorithm,
-                                              const std::string& network_config) const;
+    const std::vector<Kernel>& GetKernelsImpl(const KernelCacheKey& key) const;
 
     Program LoadProgram(const std::string& program_name,
                         std::string params,
                         bool is_kernel_str,
                         const std::string& kernel_src) const;
+    /// Queues the program to be compiled into the kernel cache on a background thread, so that
+    /// loading it later is a cache hit. Does nothing when the cache is disabled.
+    void PrecompileProgram(const std::string& program_name, std::string params) const;
 
     bool HasProgram(const std::string& program_name, const std::string& params) const;
     void ClearProgram(const std::string& program_name, const std::string& params) const;
@@ -238,7 +282,7 @@ public:
             invokers.SetAsFound1_0(config, *algo, solver);
     }
 
-    boost::optional<const Invoker&>
+    boost::optional<Invoker>
     GetInvoker(const NetworkConfig& config,
                const boost::optional<solver::Id>& solver,
                const boost::optional<AlgorithmName>& algo = boost::none) const
@@ -262,6 +306,13 @@ public:
         return invokers.GetFound1_0SolverId(config, algo);
     }
 
+    InvokerCache::Statistics GetInvokerCacheStatistics() const
+    {
+        return invokers.GetStatistics();
+    }
+    std::size_t GetInvokerCacheSize() const { return invokers.GetSize(); }
+    void SetInvokerCacheCapacity(std::size_t capacity) { invokers.SetCapacity(capacity); }
+
 #if MIOPEN_USE_ROCBLAS
     const rocblas_handle_ptr& rhandle() const;
 
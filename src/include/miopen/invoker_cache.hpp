@@ -31,22 +31,51 @@
 
 #include <boost/optional.hpp>
 
-#include <map>
+#include <cstddef>
+#include <list>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <unordered_map>
+#include <unordered_set>
 #include <utility>
 
 namespace miopen {
 
+/// Invokers by network config and solver id. Network configs are stored once as hashed keys,
+/// solver ids and algorithm names are interned, as there are only few of them. Network configs
+/// are evicted in the least recently used order when the capacity is exceeded, with all their
+/// invokers at once. Configs holding find 1.0 results are never evicted and don't count
+/// against the capacity, as the immediate calls of find 1.0 rely on them.
+///
+/// Lookups reorder the lru list, so all the members are guarded by a mutex. Invokers are returned
+/// by value, as another thread may evict the entry as soon as the lookup returns.
 class InvokerCache
 {
 public:
     // network_config, solver_id
     using Key = std::pair<std::string, std::string>;
 
-    boost::optional<const Invoker&> operator[](const Key& key) const;
+    struct Statistics
+    {
+        std::size_t hits      = 0;
+        std::size_t misses    = 0;
+        std::size_t evictions = 0;
+    };
+
+    /// The capacity is the maximum number of evictable network configs, zero means unbounded.
+    /// Defaults to the value of MIOPEN_INVOKER_CACHE_CAPACITY.
+    InvokerCache();
+    explicit InvokerCache(std::size_t capacity_);
+    // The lru list points into items, so a copy would refer to the original cache.
+    InvokerCache(const InvokerCache&) = delete;
+    InvokerCache& operator=(const InvokerCache&) = delete;
+    InvokerCache(InvokerCache&& other) noexcept;
+    InvokerCache& operator=(InvokerCache&& other) noexcept;
+
+    boost::optional<Invoker> operator[](const Key& key) const;
     // For find 1.0
-    boost::optional<const Invoker&> GetFound1_0(const std::string& network_config,
+    boost::optional<Invoker> GetFound1_0(const std::string& network_config,
                                                 const std::string& algorithm) const;
     boost::optional<const std::string&> GetFound1_0SolverId(const std::string& network_config,
                                                             const std::string& algorithm) const;
@@ -57,18 +86,42 @@ public:
                        const std::string& algorithm,
                        const std::string& solver_id);
 
+    std::size_t GetCapacity() const;
+    void SetCapacity(std::size_t value);
+    std::size_t GetSize() const;
+    Statistics GetStatistics() const;
+    void ResetStatistics();
+
 private:
+    using LruList = std::list<const std::string*>;
+    // Interned solver ids and algorithm names, the pointers are stable and unique per name.
+    using Name = const std::string*;
+
     struct Item
     {
         // algorithm -> solver_id
         // for find 1.0
-        std::map<std::string, std::string> found_1_0;
+        std::unordered_map<Name, Name> found_1_0;
         // solver_id -> invoker
-        std::map<std::string, Invoker> invokers;
+        std::unordered_map<Name, Invoker> invokers;
+        // position of the network config in the lru list, unless it holds find 1.0 results
+        LruList::iterator lru_position;
     };
 
+    std::size_t capacity;
+    std::unordered_set<std::string> names;
     // network_config -> Item
-    std::map<std::string, Item> invokers;
+    std::unordered_map<std::string, Item> items;
+    // Most recently used evictable network configs first, pointing to the keys of items.
+    mutable LruList lru;
+    mutable Statistics statistics;
+    mutable std::mutex mutex;
+
+    Name Intern(const std::string& name);
+    Name FindName(const std::string& name) const;
+    /// Finds the item and marks it as the most recently used one.
+    const Item* Find(const std::string& network_config) const;
+    void EvictExcess();
 };
 
 } // namespace miopen
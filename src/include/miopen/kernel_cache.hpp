@@ -44,7 +44,7 @@
 
 #include <miopen/handle.hpp>
 #include <miopen/kernel.hpp>
-#include <miopen/simple_hash.hpp>
+#include <miopen/kernel_cache_key.hpp>
 #include <miopen/miopen.h>
 #include <string>
 #include <unordered_map>
@@ -60,13 +60,14 @@ class KernelCache
 {
 
 public:
-    using Key        = std::pair<std::string, std::string>;
-    using KernelMap  = std::unordered_map<Key, std::vector<Kernel>, SimpleHash>;
-    using ProgramMap = std::unordered_map<Key, Program, SimpleHash>;
+    /// Kernels are keyed by {algorithm, network config} and programs by {name, build params}.
+    using Key        = KernelCacheKey;
+    using KernelMap  = std::unordered_map<Key, std::vector<Kernel>, KernelCacheKeyHash>;
+    using ProgramMap = std::unordered_map<Key, Program, KernelCacheKeyHash>;
 
+    /// The kernel is not kept in the cache if the algorithm or the network config is empty.
     Kernel AddKernel(const Handle& h,
-                     const std::string& algorithm,
-                     const std::string& network_config,
+                     const Key& key,
                      const std::string& program_name,
                      const std::string& kernel_name,
                      const std::vector<size_t>& vld,
@@ -78,10 +79,9 @@ public:
 
     void AddKernel(Key key, Kernel k, std::size_t cache_index);
 
-    void ClearKernels(const std::string& algorithm, const std::string& network_config);
+    void ClearKernels(const Key& key);
 
-    const std::vector<Kernel>& GetKernels(const std::string& algorithm,
-                                          const std::string& network_config);
+    const std::vector<Kernel>& GetKernels(const Key& key) const;
 
     bool HasProgram(const std::string& name, const std::string& params) const;
     void ClearProgram(const std::string& name, const std::string& params);
@@ -27,38 +27,51 @@
 #ifndef MIOPEN_GUARD_MLOPEN_KERNEL_CACHE_KEY_HPP
 #define MIOPEN_GUARD_MLOPEN_KERNEL_CACHE_KEY_HPP
 
-#include <miopen/errors.hpp>
-
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
 #include <string>
 
 namespace miopen {
 
-struct KCacheKey
+/// Pair of strings (algorithm and network config of a kernel, or name and build parameters of
+/// a program) along with their 128-bit hash. The hash is computed once, when the key is made, so
+/// a key that is passed along to several kernel cache calls is hashed only once. Keys are
+/// compared by the hash first, the strings are only compared when the hashes are equal.
+class KernelCacheKey
 {
-    std::string algorithm_name = {};
-    std::string network_config = {};
+public:
+    KernelCacheKey() = default;
+    KernelCacheKey(std::string first_, std::string second_);
 
-    KCacheKey() = default;
+    const std::string& GetFirst() const { return first; }
+    const std::string& GetSecond() const { return second; }
+    std::uint64_t GetLow() const { return low; }
+    std::uint64_t GetHigh() const { return high; }
 
-    KCacheKey(std::string algorithm_name_, std::string network_config_)
-        : algorithm_name(algorithm_name_), network_config(network_config_)
+    friend bool operator==(const KernelCacheKey& l, const KernelCacheKey& r)
     {
-        if(!IsValid())
-            MIOPEN_THROW("Invalid kernel cache key: " + algorithm_name + ", " + network_config);
+        return l.low == r.low && l.high == r.high && l.first == r.first && l.second == r.second;
     }
+    friend bool operator!=(const KernelCacheKey& l, const KernelCacheKey& r) { return !(l == r); }
+
+    friend std::ostream& operator<<(std::ostream& stream, const KernelCacheKey& key);
 
-    bool IsValid() const { return !algorithm_name.empty() && !network_config.empty(); }
-    bool IsUnused() const { return network_config == GetUnusedNetworkConfig(); }
+private:
+    std::string first;
+    std::string second;
+    std::uint64_t low  = 0;
+    std::uint64_t high = 0;
+};
 
-    static KCacheKey MakeUnused(const std::string& algo_name)
+struct KernelCacheKeyHash
+{
+    std::size_t operator()(const KernelCacheKey& key) const
     {
-        return {algo_name, GetUnusedNetworkConfig()};
+        return static_cast<std::size_t>(key.GetLow());
     }
-
-private:
-    static const char* GetUnusedNetworkConfig() { return "<unused>"; }
 };
 
 } // namespace miopen
 
-#endif
+#endif // MIOPEN_GUARD_MLOPEN_KERNEL_CACHE_KEY_HPP
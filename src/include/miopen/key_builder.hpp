@@ -0,0 +1,99 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#pragma once
+
+#include <miopen/errors.hpp>
+
+#include <array>
+#include <charconv>
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <type_traits>
+
+namespace miopen {
+
+/// Composes database and network config keys in a fixed stack buffer, numbers are written with
+/// std::to_chars. This is several times faster than std::ostringstream, which matters because
+/// keys of each problem are needed by the find-db, perf-db and invoker cache lookups.
+class KeyBuilder
+{
+public:
+    static constexpr std::size_t capacity = 512;
+
+    template <class T, std::enable_if_t<std::is_integral<T>{}, bool> = true>
+    KeyBuilder& operator<<(T value)
+    {
+        const auto result = std::to_chars(buffer.data() + size, buffer.data() + capacity, value);
+        if(result.ec != std::errc{})
+            MIOPEN_THROW("Key is longer than " + std::to_string(capacity) + " characters");
+        size = result.ptr - buffer.data();
+        return *this;
+    }
+
+    KeyBuilder& operator<<(char c)
+    {
+        Reserve(1);
+        buffer[size++] = c;
+        return *this;
+    }
+
+    KeyBuilder& operator<<(const char* str) { return Append(str, std::strlen(str)); }
+    KeyBuilder& operator<<(const std::string& str) { return Append(str.data(), str.size()); }
+
+    /// D, H and W separated by sep, D is omitted for 2D problems.
+    template <class T>
+    KeyBuilder& DHW(char sep, std::size_t spatial_dims, T depth, T height, T width)
+    {
+        if(spatial_dims > 2)
+            *this << depth << sep;
+        return *this << height << sep << width;
+    }
+
+    std::size_t Size() const { return size; }
+    std::string Str() const { return {buffer.data(), size}; }
+
+private:
+    std::array<char, capacity> buffer;
+    std::size_t size = 0;
+
+    void Reserve(std::size_t length) const
+    {
+        if(size + length > capacity)
+            MIOPEN_THROW("Key is longer than " + std::to_string(capacity) + " characters");
+    }
+
+    KeyBuilder& Append(const char* str, std::size_t length)
+    {
+        Reserve(length);
+        std::memcpy(buffer.data() + size, str, length);
+        size += length;
+        return *this;
+    }
+};
+
+} // namespace miopen
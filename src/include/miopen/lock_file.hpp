@@ -165,7 +165,7 @@ public:
     }
 
 private:
-    const char* path; // For logging purposes
+    std::string path;
     std::shared_timed_mutex access_mutex;
     boost::interprocess::file_lock flock;
 
@@ -1,3 +1,6 @@
+#ifndef GUARD_MIOPEN_PRECALC_XORWOW_SKIPAHEAD_SEQUENCE_MATRICES_HPP
+#define GUARD_MIOPEN_PRECALC_XORWOW_SKIPAHEAD_SEQUENCE_MATRICES_HPP
+
 #define XORWOW_DIM 5
 #define XORWOW_BITS 32
 #define XORWOW_PRECALC_MATRICES_SZ (XORWOW_BITS * XORWOW_DIM * XORWOW_DIM)
@@ -3753,3 +3756,5 @@ static const unsigned int precalc_xorwow_skipahead_sequence_matrices
             3780826558, 1018851411,
         },
 };
+
+#endif // GUARD_MIOPEN_PRECALC_XORWOW_SKIPAHEAD_SEQUENCE_MATRICES_HPP
@@ -0,0 +1,93 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <future>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace miopen {
+
+/// Deduplicates concurrent executions of the same work. The first caller of Do for a key runs
+/// the function; callers that come while it is running wait for and share its result or
+/// exception instead of running the function again. Once the function completes the key is
+/// released, so later callers run it again (they are expected to hit a cache by then).
+template <class Value>
+class SingleFlight
+{
+public:
+    template <class F>
+    Value Do(const std::string& key, F f)
+    {
+        auto promise = std::promise<Value>{};
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            const auto in_flight = flights.find(key);
+            if(in_flight != flights.end())
+            {
+                auto future = in_flight->second;
+                lock.unlock();
+                ++deduplicated;
+                return future.get();
+            }
+            flights.emplace(key, promise.get_future().share());
+        }
+
+        try
+        {
+            auto value = f();
+            promise.set_value(value);
+            Release(key);
+            return value;
+        }
+        catch(...)
+        {
+            promise.set_exception(std::current_exception());
+            Release(key);
+            throw;
+        }
+    }
+
+    /// Number of calls that waited for another call instead of running the function.
+    std::size_t GetDeduplicatedCount() const { return deduplicated; }
+
+private:
+    std::mutex mutex;
+    std::unordered_map<std::string, std::shared_future<Value>> flights;
+    std::atomic<std::size_t> deduplicated{0};
+
+    void Release(const std::string& key)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        flights.erase(key);
+    }
+};
+
+} // namespace miopen
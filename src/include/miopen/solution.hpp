@@ -29,6 +29,7 @@
 #include <miopen/miopen.h>
 
 #include <miopen/errors.hpp>
+#include <miopen/kernel_info.hpp>
 #include <miopen/object.hpp>
 #include <miopen/problem.hpp>
 #include <miopen/solver_id.hpp>
@@ -39,7 +40,9 @@
 #include <boost/optional.hpp>
 
 #include <optional>
+#include <string>
 #include <unordered_map>
+#include <vector>
 
 namespace miopen {
 
@@ -76,6 +79,23 @@ struct Solution : miopenSolution
         }
     };
 
+    /// Compiled program of the solution, keyed the same way as in the kernel cache.
+    struct EmbeddedProgram
+    {
+        std::string name;
+        std::string params;
+        std::string code_object;
+    };
+
+    /// Everything needed to build the invoker without accessing the databases or the compiler.
+    struct EmbeddedKernels
+    {
+        /// TargetProperties::DbId() of the device the programs were built for.
+        std::string target;
+        std::vector<solver::KernelInfo> construction_params;
+        std::vector<EmbeddedProgram> programs;
+    };
+
     float GetTime() const { return time; }
     void SetTime(float value) { time = value; }
     std::size_t GetWorkspaceSize() const { return workspace_required; }
@@ -85,6 +105,13 @@ struct Solution : miopenSolution
     void SetPerfConfig(const std::optional<std::string>& cfg) { perf_cfg = cfg; }
     const Problem& GetProblem() const { return problem; }
     void SetProblem(Problem value) { problem = std::move(value); }
+    bool HasEmbeddedKernels() const { return kernels.has_value(); }
+
+    /// Builds the kernels of the solution and stores their code objects along with the perf
+    /// config and the invoker construction params, so they become a part of the serialized
+    /// solution. A loaded solution with embedded kernels is run without perf-db lookups and
+    /// without compilation if the device matches the one the kernels were built for.
+    void EmbedKernels(Handle& handle);
 
     void Run(Handle& handle,
              const std::unordered_map<miopenTensorArgumentId_t, RunInput>& inputs,
@@ -99,7 +126,8 @@ private:
     std::size_t workspace_required = 0;
     solver::Id solver;
     Problem problem;
-    std::optional<std::string> perf_cfg = std::nullopt;
+    std::optional<std::string> perf_cfg    = std::nullopt;
+    std::optional<EmbeddedKernels> kernels = std::nullopt;
 
     void RunImpl(Handle& handle,
                  const std::unordered_map<miopenTensorArgumentId_t, RunInput>& inputs,
@@ -107,6 +135,9 @@ private:
                  std::size_t workspace_size,
                  const ConvolutionDescriptor& conv_desc);
 
+    void EmbedKernelsImpl(Handle& handle, const ConvolutionDescriptor& conv_desc);
+    bool AddEmbeddedPrograms(const Handle& handle) const;
+
     static Problem Transpose(const Problem& problem, RunInput* x, const RunInput& w, RunInput* y);
 };
 
@@ -3023,6 +3023,37 @@ struct ConvDirectNaiveConvWrw final : ConvSolver
     ConvSolution GetSolution(const ConvolutionContext&, const ProblemDescription&) const override;
 };
 
+/// Direct loops on the host, all directions (see miopen/solver/host.hpp).
+struct ConvDirectHost final : ConvSolver
+{
+    const std::string& SolverDbId() const override { return GetSolverDbId<ConvDirectHost>(); }
+
+    bool IsApplicable(const ConvolutionContext&, const ProblemDescription&) const override;
+    bool IsDynamic() const override { return true; }
+    /// GPU solvers can only be compiled on the nogpu backend, so host solvers
+    /// must rank above all of them (WTI is at most 1.0 for GPU solvers).
+    float GetWti(const ConvolutionContext&, const ProblemDescription&) const override
+    {
+        return 2.0f;
+    }
+    ConvSolution GetSolution(const ConvolutionContext&, const ProblemDescription&) const override;
+};
+
+/// im2col + GEMM on the host, all directions (see miopen/cpu_conv_gemm.hpp).
+struct ConvGemmHost final : ConvSolver
+{
+    const std::string& SolverDbId() const override { return GetSolverDbId<ConvGemmHost>(); }
+
+    bool IsApplicable(const ConvolutionContext&, const ProblemDescription&) const override;
+    bool IsDynamic() const override { return true; }
+    /// Ahead of ConvDirectHost, which it outperforms except for tiny problems.
+    float GetWti(const ConvolutionContext&, const ProblemDescription&) const override
+    {
+        return 4.0f;
+    }
+    ConvSolution GetSolution(const ConvolutionContext&, const ProblemDescription&) const override;
+};
+
 struct GemmFwdBase : ConvSolver
 {
     // To suppress -Woverloaded-virtual
@@ -0,0 +1,153 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#pragma once
+
+#include <miopen/common.hpp>
+#include <miopen/miopen.h>
+#include <miopen/par_for.hpp>
+#include <miopen/tensor.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <vector>
+
+namespace miopen {
+
+struct Handle;
+
+namespace solver {
+
+/// Host solvers compute on the CPU. They are applicable only with the nogpu backend,
+/// where Handle allocates buffers in host memory, unless the handle compiles for a target
+/// device (see Handle::SetTargetDevice). They can be turned off there by setting
+/// MIOPEN_DEBUG_HOST_SOLVERS=0.
+bool IsHostSolverEnabled(const Handle& handle);
+
+/// Host solvers implement fp32 only.
+bool IsHostSolverType(const TensorDescriptor& desc);
+
+namespace host {
+
+/// Calls f(offsets, len, inner_strides) for every innermost row of N tensors that share
+/// `lens`, in parallel over rows. offsets[i] is the element offset of the row in the i-th
+/// tensor, inner_strides[i] is the stride of the innermost dimension of the i-th tensor.
+template <std::size_t N, class F>
+void ParForEachRow(const std::vector<std::size_t>& lens,
+                   const std::array<const std::vector<std::size_t>*, N>& strides,
+                   F f)
+{
+    if(lens.empty())
+        return;
+
+    const auto last  = lens.size() - 1;
+    const auto inner = lens[last];
+    auto rows        = std::size_t{1};
+    for(std::size_t d = 0; d < last; ++d)
+        rows *= lens[d];
+    if(rows == 0 || inner == 0)
+        return;
+
+    auto inner_strides = std::array<std::size_t, N>{};
+    for(std::size_t i = 0; i < N; ++i)
+        inner_strides[i] = (*strides[i])[last];
+
+    // Keep at least a few thousand elements per thread so small tensors stay serial.
+    const auto grain = std::max<std::size_t>(1, 4096 / inner);
+    par_for(rows, min_grain{grain}, [&](std::size_t row) {
+        auto offsets = std::array<std::size_t, N>{};
+        for(auto d = last; d-- > 0;)
+        {
+            const auto idx = row % lens[d];
+            row /= lens[d];
+            for(std::size_t i = 0; i < N; ++i)
+                offsets[i] += idx * (*strides[i])[d];
+        }
+        f(offsets, inner, inner_strides);
+    });
+}
+
+/// Host versions of the primitives that have no solvers. They take the arguments of the
+/// functions they back (see miopen/softmax.hpp and miopen/tensor_ops.hpp), which call them
+/// after validating the arguments, when IsHostSolverEnabled() and the tensors are fp32
+/// (any type for CopyTensor).
+void SoftmaxForward(const void* alpha,
+                    const void* beta,
+                    const TensorDescriptor& xDesc,
+                    ConstData_t x,
+                    const TensorDescriptor& yDesc,
+                    Data_t y,
+                    miopenSoftmaxAlgorithm_t algorithm,
+                    miopenSoftmaxMode_t mode,
+                    int x_offset,
+                    int y_offset);
+
+void SoftmaxBackward(const void* alpha,
+                     const TensorDescriptor& yDesc,
+                     ConstData_t y,
+                     const TensorDescriptor& dyDesc,
+                     ConstData_t dy,
+                     const void* beta,
+                     const TensorDescriptor& dxDesc,
+                     Data_t dx,
+                     miopenSoftmaxAlgorithm_t algorithm,
+                     miopenSoftmaxMode_t mode,
+                     int y_offset,
+                     int dy_offset,
+                     int dx_offset);
+
+/// B is broadcast over the dimensions where its length is 1.
+void OpTensor(miopenTensorOp_t tensorOp,
+              const void* alpha0,
+              const TensorDescriptor& aTensorDesc,
+              ConstData_t ATensor,
+              const void* alpha1,
+              const TensorDescriptor& bTensorDesc,
+              ConstData_t BTensor,
+              const void* beta,
+              const TensorDescriptor& cTensorDesc,
+              Data_t CTensor,
+              std::size_t Aoffset,
+              std::size_t Boffset,
+              std::size_t Coffset);
+
+void SetTensor(const TensorDescriptor& yDesc, Data_t y, const void* alpha, int offset);
+
+void ScaleTensor(const TensorDescriptor& yDesc, Data_t y, const void* alpha, int offset);
+
+void CopyTensor(const TensorDescriptor& srcDesc,
+                ConstData_t src,
+                const TensorDescriptor& dstDesc,
+                Data_t dst,
+                int srcOffset,
+                int dstOffset);
+
+} // namespace host
+
+} // namespace solver
+
+} // namespace miopen
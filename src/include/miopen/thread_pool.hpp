@@ -0,0 +1,78 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace miopen {
+
+/// Fixed number of worker threads executing submitted tasks in FIFO order.
+/// Tasks that have not been started when the pool is destroyed are dropped, so
+/// their futures report std::future_errc::broken_promise.
+class ThreadPool
+{
+public:
+    explicit ThreadPool(std::size_t threads);
+    /// init is called on every worker thread before it starts executing tasks.
+    ThreadPool(std::size_t threads, const std::function<void()>& init);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    template <class F>
+    auto Submit(F f) -> std::future<decltype(f())>
+    {
+        using Result = decltype(f());
+        auto task    = std::make_shared<std::packaged_task<Result()>>(std::move(f));
+        auto future  = task->get_future();
+        Enqueue([task]() { (*task)(); });
+        return future;
+    }
+
+    std::size_t GetThreadCount() const { return workers.size(); }
+
+private:
+    std::mutex mutex;
+    std::condition_variable has_tasks;
+    std::deque<std::function<void()>> tasks;
+    bool stopping = false;
+    std::vector<std::thread> workers;
+
+    void Enqueue(std::function<void()> task);
+    void Work(const std::function<void()>& init);
+};
+
+} // namespace miopen
@@ -27,6 +27,7 @@
 #define GUARD_MIOPEN_TIMER_HPP_
 
 #include <miopen/logger.hpp>
+#include <miopen/trace.hpp>
 
 namespace miopen {
 
@@ -35,6 +36,7 @@ class Timer
 public:
     Timer(){};
     void start() { st = std::chrono::steady_clock::now(); }
+    std::chrono::steady_clock::time_point start_time() const { return st; }
     float elapsed_ms()
     {
         capture();
@@ -50,28 +52,56 @@ private:
 
 class CompileTimer
 {
-#if MIOPEN_BUILD_DEV
     Timer timer;
-#endif
+
 public:
-    CompileTimer()
-    {
-#if MIOPEN_BUILD_DEV
-        timer.start();
-#endif
-    }
+    CompileTimer() { timer.start(); }
     void Log(const std::string& s1, const std::string& s2 = {})
     {
+        if(IsTraceEnabled())
+            AddTraceSpan("compile",
+                         s2.empty() ? s1 : s1 + " " + s2,
+                         timer.start_time(),
+                         std::chrono::steady_clock::now());
 #if MIOPEN_BUILD_DEV
         MIOPEN_LOG_I2(s1 << (s2.empty() ? "" : " ") << s2
                          << " Compile Time, ms: " << timer.elapsed_ms());
-#else
-        (void)s1;
-        (void)s2;
 #endif
     }
 };
 
+/// Records the lifetime of the scope as a span of the startup trace (see trace.hpp).
+/// Costs a single flag check when tracing is off.
+class TraceScope
+{
+    Timer timer;
+    const char* category;
+    const char* name;
+    std::string detail;
+    bool enabled;
+
+public:
+    explicit TraceScope(const char* name_) : TraceScope(name_, {}) {}
+    TraceScope(const char* name_, const std::string& detail_, const char* category_ = "startup")
+        : category(category_), name(name_), enabled(IsTraceEnabled())
+    {
+        if(!enabled)
+            return;
+        detail = detail_;
+        timer.start();
+    }
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+    ~TraceScope()
+    {
+        if(enabled)
+            AddTraceSpan(category,
+                         detail.empty() ? std::string{name} : std::string{name} + " " + detail,
+                         timer.start_time(),
+                         std::chrono::steady_clock::now());
+    }
+};
+
 } // namespace miopen
 
 #endif // GUARD_MIOPEN_TIMER_HPP_
@@ -0,0 +1,53 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#pragma once
+
+#include <chrono>
+#include <iosfwd>
+#include <string>
+
+namespace miopen {
+
+/// Opt-in tracing of library startup and first-call latency. Tracing is off unless
+/// MIOPEN_TRACE_FILE names an output file or EnableTrace() is called. Spans are kept in
+/// memory and written as Chrome trace JSON (chrome://tracing, ui.perfetto.dev) at exit.
+/// See TraceScope and CompileTimer in timer.hpp for the producers.
+bool IsTraceEnabled();
+void EnableTrace(const std::string& path);
+
+/// Records a complete span of the calling thread. Does nothing if tracing is off.
+void AddTraceSpan(const char* category,
+                  std::string name,
+                  std::chrono::steady_clock::time_point start,
+                  std::chrono::steady_clock::time_point end);
+
+/// Writes the spans recorded so far. WriteTrace() writes to the file set by
+/// EnableTrace() or MIOPEN_TRACE_FILE, which also happens automatically at exit.
+void WriteTrace(std::ostream& os);
+void WriteTrace();
+
+} // namespace miopen
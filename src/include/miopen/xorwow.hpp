@@ -0,0 +1,139 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#ifndef GUARD_MIOPEN_XORWOW_HPP
+#define GUARD_MIOPEN_XORWOW_HPP
+
+#include <miopen/precalc_xorwow_skipahead_matrices.hpp>
+#include <miopen/precalc_xorwow_skipahead_sequence_matrices.hpp>
+
+#include <cstdint>
+#include <limits>
+
+namespace miopen {
+
+/// Host implementation of the XORWOW generator used by the dropout kernels,
+/// seeded the same way as rocRAND. The precalculated matrices let the state
+/// jump ahead by any number of steps or subsequences in a logarithmic number of
+/// matrix-vector products, so a buffer can be filled in parallel with exactly
+/// the numbers a serial loop would draw.
+class Xorwow
+{
+public:
+    using result_type = std::uint32_t;
+
+    explicit Xorwow(unsigned long long seed        = 0,
+                    unsigned long long subsequence = 0,
+                    unsigned long long offset      = 0)
+    {
+        const auto s0 = static_cast<std::uint32_t>(seed) ^ 0x2c7f967fU;
+        const auto s1 = static_cast<std::uint32_t>(seed >> 32) ^ 0xa03697cbU;
+        const auto t0 = 1228688033U * s0;
+        const auto t1 = 2073658381U * s1;
+        state[0] += t0;
+        state[1] ^= t0;
+        state[2] += t1;
+        state[3] ^= t1;
+        state[4] += t0;
+        weyl += t1 + t0;
+
+        DiscardSubsequences(subsequence);
+        Discard(offset);
+    }
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+    result_type operator()()
+    {
+        const auto t = state[0] ^ (state[0] >> 2);
+        state[0]     = state[1];
+        state[1]     = state[2];
+        state[2]     = state[3];
+        state[3]     = state[4];
+        state[4]     = (state[4] ^ (state[4] << 4)) ^ (t ^ (t << 1));
+        weyl += 362437;
+        return weyl + state[4];
+    }
+
+    /// Uniformly distributed in [0, 1).
+    double Canonical() { return (*this)() * (1.0 / 4294967296.0); }
+
+    /// Same as calling operator() n times.
+    void Discard(unsigned long long n)
+    {
+        Skip(precalc_xorwow_skipahead_matrices, n);
+        weyl += static_cast<std::uint32_t>(n) * 362437;
+    }
+
+    /// Subsequences are 2^67 numbers apart, so they never overlap in practice.
+    /// The Weyl sequence advances by a multiple of 2^32 and stays the same.
+    void DiscardSubsequences(unsigned long long n)
+    {
+        Skip(precalc_xorwow_skipahead_sequence_matrices, n);
+    }
+
+private:
+    using Matrices = unsigned int[XORWOW_PRECALC_MATRICES_NUM][XORWOW_PRECALC_MATRICES_SZ];
+
+    static_assert(XORWOW_PRECALC_MATRICES_NUM * XORWOW_JUMP_LOG2 >= 64,
+                  "Precalculated matrices must cover 64-bit skips");
+
+    // The k-th matrix advances the state by 2^(k * XORWOW_JUMP_LOG2) steps.
+    void Skip(const Matrices& matrices, unsigned long long n)
+    {
+        for(auto k = 0; n != 0; ++k, n >>= XORWOW_JUMP_LOG2)
+        {
+            for(auto i = 0ull; i < (n & XORWOW_JUMP_LOG2_MASK); ++i)
+                MatVec(matrices[k]);
+        }
+    }
+
+    void MatVec(const unsigned int* matrix)
+    {
+        std::uint32_t result[XORWOW_DIM] = {};
+        for(auto i = 0; i < XORWOW_DIM; ++i)
+        {
+            for(auto j = 0; j < XORWOW_BITS; ++j)
+            {
+                if((state[i] & (1U << j)) == 0)
+                    continue;
+                const auto* row = matrix + XORWOW_DIM * (i * XORWOW_BITS + j);
+                for(auto k = 0; k < XORWOW_DIM; ++k)
+                    result[k] ^= row[k];
+            }
+        }
+        for(auto k = 0; k < XORWOW_DIM; ++k)
+            state[k] = result[k];
+    }
+
+    std::uint32_t state[XORWOW_DIM] = {123456789, 362436069, 521288629, 88675123, 5783321};
+    std::uint32_t weyl              = 6615241;
+};
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_XORWOW_HPP
@@ -25,50 +25,115 @@
  *******************************************************************************/
 
 #include <miopen/invoker_cache.hpp>
+#include <miopen/env.hpp>
 #include <miopen/logger.hpp>
 
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_INVOKER_CACHE_CAPACITY)
+
 namespace miopen {
 
-boost::optional<const Invoker&> InvokerCache::operator[](const Key& key) const
+InvokerCache::InvokerCache() : InvokerCache(Value(MIOPEN_INVOKER_CACHE_CAPACITY{})) {}
+
+InvokerCache::InvokerCache(std::size_t capacity_) : capacity(capacity_) {}
+
+// Moving the containers keeps their nodes, so the lru list still points into items.
+InvokerCache::InvokerCache(InvokerCache&& other) noexcept
+    : capacity(other.capacity),
+      names(std::move(other.names)),
+      items(std::move(other.items)),
+      lru(std::move(other.lru)),
+      statistics(other.statistics)
 {
-    const auto item = invokers.find(key.first);
-    if(item == invokers.end())
+}
+
+InvokerCache& InvokerCache::operator=(InvokerCache&& other) noexcept
+{
+    if(this == &other)
+        return *this;
+    std::scoped_lock lock(mutex, other.mutex);
+    capacity   = other.capacity;
+    names      = std::move(other.names);
+    items      = std::move(other.items);
+    lru        = std::move(other.lru);
+    statistics = other.statistics;
+    return *this;
+}
+
+InvokerCache::Name InvokerCache::Intern(const std::string& name)
+{
+    return &*names.insert(name).first;
+}
+
+InvokerCache::Name InvokerCache::FindName(const std::string& name) const
+{
+    const auto interned = names.find(name);
+    return interned == names.end() ? nullptr : &*interned;
+}
+
+const InvokerCache::Item* InvokerCache::Find(const std::string& network_config) const
+{
+    const auto item = items.find(network_config);
+    if(item == items.end())
+        return nullptr;
+    if(item->second.found_1_0.empty())
+        lru.splice(lru.begin(), lru, item->second.lru_position);
+    return &item->second;
+}
+
+boost::optional<Invoker> InvokerCache::operator[](const Key& key) const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    const auto item      = Find(key.first);
+    const auto solver_id = FindName(key.second);
+    if(item == nullptr || solver_id == nullptr)
+    {
+        ++statistics.misses;
         return boost::none;
-    const auto& item_invokers = item->second.invokers;
-    const auto invoker        = item_invokers.find(key.second);
+    }
+    const auto& item_invokers = item->invokers;
+    const auto invoker        = item_invokers.find(solver_id);
     if(invoker == item_invokers.end())
+    {
+        ++statistics.misses;
         return boost::none;
+    }
+    ++statistics.hits;
     return invoker->second;
 }
 
-boost::optional<const Invoker&> InvokerCache::GetFound1_0(const std::string& network_config,
+boost::optional<Invoker> InvokerCache::GetFound1_0(const std::string& network_config,
                                                           const std::string& algorithm) const
 {
-    const auto item = invokers.find(network_config);
-    if(item == invokers.end())
+    std::lock_guard<std::mutex> lock(mutex);
+    const auto item = Find(network_config);
+    if(item == nullptr)
     {
         MIOPEN_LOG_I2("No invokers found for " << network_config);
+        ++statistics.misses;
         return boost::none;
     }
-    if(item->second.found_1_0.empty())
+    if(item->found_1_0.empty())
     {
         MIOPEN_LOG_I2("Invokers found for " << network_config
                                             << " but there is no find 1.0 result.");
+        ++statistics.misses;
         return boost::none;
     }
-    const auto& item_invokers = item->second.invokers;
-    const auto& found_1_0_ids = item->second.found_1_0;
-    const auto found_1_0_id   = found_1_0_ids.find(algorithm);
+    const auto& item_invokers = item->invokers;
+    const auto& found_1_0_ids = item->found_1_0;
+    const auto found_1_0_id   = found_1_0_ids.find(FindName(algorithm));
     if(found_1_0_id == found_1_0_ids.end())
     {
         MIOPEN_LOG_I2("Invokers found for "
                       << network_config << " but there is no one with an algorithm " << algorithm);
+        ++statistics.misses;
         return boost::none;
     }
     const auto invoker = item_invokers.find(found_1_0_id->second);
     if(invoker == item_invokers.end())
-        MIOPEN_THROW("No invoker with solver_id of " + found_1_0_id->second +
+        MIOPEN_THROW("No invoker with solver_id of " + *found_1_0_id->second +
                      " was registered for " + network_config);
+    ++statistics.hits;
     return invoker->second;
 }
 
@@ -76,59 +141,118 @@ boost::optional<const std::string&>
 InvokerCache::GetFound1_0SolverId(const std::string& network_config,
                                   const std::string& algorithm) const
 {
-    const auto item = invokers.find(network_config);
-    if(item == invokers.end())
+    std::lock_guard<std::mutex> lock(mutex);
+    const auto item = Find(network_config);
+    if(item == nullptr)
     {
         MIOPEN_LOG_I2("No invokers found for " << network_config);
         return boost::none;
     }
-    if(item->second.found_1_0.empty())
+    if(item->found_1_0.empty())
     {
         MIOPEN_LOG_I2("Invokers found for " << network_config
                                             << " but there is no find 1.0 result.");
         return boost::none;
     }
-    const auto& found_1_0_ids = item->second.found_1_0;
-    const auto found_1_0_id   = found_1_0_ids.find(algorithm);
+    const auto& found_1_0_ids = item->found_1_0;
+    const auto found_1_0_id   = found_1_0_ids.find(FindName(algorithm));
     if(found_1_0_id == found_1_0_ids.end())
     {
         MIOPEN_LOG_I2("Invokers found for "
                       << network_config << " but there is no one with an algorithm " << algorithm);
         return boost::none;
     }
-    return found_1_0_id->second;
+    return *found_1_0_id->second;
 }
 
 void InvokerCache::Register(const Key& key, const Invoker& invoker)
 {
-    auto it = invokers.find(key.first);
-    if(it != invokers.end())
-        it->second.invokers.insert({key.second, invoker});
-    auto& item = invokers.insert({key.first, Item{}}).first->second;
-    item.invokers.insert({key.second, invoker});
+    std::lock_guard<std::mutex> lock(mutex);
+    const auto inserted = items.emplace(key.first, Item{});
+    auto& item          = inserted.first->second;
+    if(inserted.second)
+    {
+        lru.push_front(&inserted.first->first);
+        item.lru_position = lru.begin();
+    }
+    else if(item.found_1_0.empty())
+    {
+        lru.splice(lru.begin(), lru, item.lru_position);
+    }
+    item.invokers.insert({Intern(key.second), invoker});
     MIOPEN_LOG_I2("Invoker registered for algorithm " << key.first << " and solver " << key.second);
+    EvictExcess();
 }
 
 void InvokerCache::SetAsFound1_0(const std::string& network_config,
                                  const std::string& algorithm,
                                  const std::string& solver_id)
 {
-    const auto item = invokers.find(network_config);
-    if(item == invokers.end())
+    std::lock_guard<std::mutex> lock(mutex);
+    const auto item = items.find(network_config);
+    if(item == items.end())
         MIOPEN_THROW("No invoker was registered for " + network_config);
 
+    const auto solver = FindName(solver_id);
     {
         // Validating at find time
         const auto& item_invokers = item->second.invokers;
-        const auto invoker        = item_invokers.find(solver_id);
+        const auto invoker        = item_invokers.find(solver);
         if(invoker == item_invokers.end())
             MIOPEN_THROW("No invoker with solver_id of " + solver_id + " was registered for " +
                          network_config);
     }
 
-    item->second.found_1_0[algorithm] = solver_id;
+    // From now on the config is kept, the convolution calls of find 1.0 look it up.
+    if(item->second.found_1_0.empty())
+        lru.erase(item->second.lru_position);
+    item->second.found_1_0[Intern(algorithm)] = solver;
     MIOPEN_LOG_I2("Solver " << solver_id << " registered as find 1.0 best for " << algorithm
                             << " in " << network_config);
 }
 
+std::size_t InvokerCache::GetCapacity() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return capacity;
+}
+
+void InvokerCache::SetCapacity(std::size_t value)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    capacity = value;
+    EvictExcess();
+}
+
+std::size_t InvokerCache::GetSize() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return items.size();
+}
+
+InvokerCache::Statistics InvokerCache::GetStatistics() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return statistics;
+}
+
+void InvokerCache::ResetStatistics()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    statistics = {};
+}
+
+void InvokerCache::EvictExcess()
+{
+    while(capacity != 0 && lru.size() > capacity)
+    {
+        // The key is copied as the list points into the node being erased.
+        const auto network_config = *lru.back();
+        lru.pop_back();
+        items.erase(network_config);
+        ++statistics.evictions;
+        MIOPEN_LOG_I2("Invokers evicted for " << network_config);
+    }
+}
+
 } // namespace miopen
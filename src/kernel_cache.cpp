@@ -52,48 +52,33 @@ MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEVICE_ARCH)
 
 namespace miopen {
 
-const std::vector<Kernel>& KernelCache::GetKernels(const std::string& algorithm,
-                                                   const std::string& network_config)
+const std::vector<Kernel>& KernelCache::GetKernels(const Key& key) const
 {
-
-    std::pair<std::string, std::string> key = std::make_pair(algorithm, network_config);
-
-    const auto it = kernel_map.find(key);
-    if(it != kernel_map.end())
-    {
-        MIOPEN_LOG_I2(it->second.size()
-                      << " kernels for key: " << key.first << " \"" << key.second << '\"');
-        return it->second;
-    }
-
     static const std::vector<Kernel> empty{};
-    MIOPEN_LOG_I2("0 kernels for key: " << key.first << " \"" << key.second << '\"');
-    return empty;
+    const auto it       = kernel_map.find(key);
+    const auto& kernels = it != kernel_map.end() ? it->second : empty;
+    MIOPEN_LOG_I2(kernels.size() << " kernels for key: " << key.GetFirst() << " \""
+                                 << key.GetSecond() << '\"');
+    return kernels;
 }
 
 bool KernelCache::HasProgram(const std::string& name, const std::string& params) const
 {
-    const auto key = std::make_pair(name, params);
-    return program_map.count(key) > 0;
+    return program_map.count(Key{name, params}) > 0;
 }
 
 void KernelCache::ClearProgram(const std::string& name, const std::string& params)
 {
-    if(HasProgram(name, params))
-    {
-        const auto key = std::make_pair(name, params);
-        program_map.erase(key);
-    }
+    program_map.erase(Key{name, params});
 }
 
 void KernelCache::AddProgram(Program prog, const std::string& program_name, std::string params)
 {
-    program_map[std::make_pair(program_name, params)] = prog;
+    program_map[Key{program_name, params}] = prog;
 }
 
 Kernel KernelCache::AddKernel(const Handle& h,
-                              const std::string& algorithm,
-                              const std::string& network_config,
+                              const Key& key,
                               const std::string& program_name,
                               const std::string& kernel_name,
                               const std::vector<size_t>& vld,
@@ -103,13 +88,15 @@ Kernel KernelCache::AddKernel(const Handle& h,
                               bool is_kernel_miopengemm_str,
                               const std::string& kernel_src)
 {
-    const std::pair<std::string, std::string> key = std::make_pair(algorithm, network_config);
+    const auto& algorithm      = key.GetFirst();
+    const auto& network_config = key.GetSecond();
     if(!network_config.empty() || !algorithm.empty()) // Don't log only _empty_ keys.
-        MIOPEN_LOG_I2("Key: " << key.first << " \"" << key.second << '\"');
+        MIOPEN_LOG_I2("Key: " << algorithm << " \"" << network_config << '\"');
 
     Program program;
 
-    auto program_it = program_map.find(std::make_pair(program_name, params));
+    const auto program_key = Key{program_name, params};
+    auto program_it        = program_map.find(program_key);
     if(program_it != program_map.end())
     {
         program = program_it->second;
@@ -120,12 +107,13 @@ Kernel KernelCache::AddKernel(const Handle& h,
             is_kernel_miopengemm_str = algorithm.find("ImplicitGEMM") == std::string::npos &&
                                        algorithm.find("GEMM") != std::string::npos;
         program = h.LoadProgram(program_name, params, is_kernel_miopengemm_str, kernel_src);
-        program_map[std::make_pair(program_name, params)] = program;
+        program_map[program_key] = program;
     }
 
     Kernel kernel{};
     const char* const arch = miopen::GetStringEnv(MIOPEN_DEVICE_ARCH{});
-    if(arch != nullptr && strlen(arch) > 0)
+    // Without a device kernels are never launched, and programs are not loaded into modules.
+    if(MIOPEN_MODE_NOGPU || (arch != nullptr && strlen(arch) > 0))
     {
         kernel = Kernel{program, kernel_name};
     }
@@ -151,19 +139,19 @@ void KernelCache::AddKernel(Key key, Kernel k, std::size_t cache_index)
     v[cache_index] = k;
 }
 
-void KernelCache::ClearKernels(const std::string& algorithm, const std::string& network_config)
+void KernelCache::ClearKernels(const Key& key)
 {
-    if(network_config.empty() || algorithm.empty())
+    if(key.GetSecond().empty() || key.GetFirst().empty())
     {
         MIOPEN_THROW("Network config or algorithm empty.");
     }
-    const std::pair<std::string, std::string> key = std::make_pair(algorithm, network_config);
-    auto&& v                                      = this->kernel_map[key];
-    if(!v.empty())
+    const auto it = this->kernel_map.find(key);
+    if(it != this->kernel_map.end() && !it->second.empty())
     {
-        MIOPEN_LOG_I2(v.size() << " kernels for key: " << key.first << " \"" << key.second << '\"');
+        MIOPEN_LOG_I2(it->second.size() << " kernels for key: " << key.GetFirst() << " \""
+                                        << key.GetSecond() << '\"');
+        it->second.clear();
     }
-    v.clear();
 }
 
 KernelCache::KernelCache() {}
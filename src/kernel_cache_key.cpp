@@ -0,0 +1,142 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/kernel_cache_key.hpp>
+
+#include <cstring>
+#include <iomanip>
+#include <utility>
+
+namespace miopen {
+
+namespace {
+
+inline std::uint64_t Rotl(std::uint64_t x, int r) { return (x << r) | (x >> (64 - r)); }
+
+inline std::uint64_t FMix(std::uint64_t k)
+{
+    k ^= k >> 33;
+    k *= 0xff51afd7ed558ccdull;
+    k ^= k >> 33;
+    k *= 0xc4ceb9fe1a85ec53ull;
+    k ^= k >> 33;
+    return k;
+}
+
+inline std::uint64_t Load64(const char* p)
+{
+    std::uint64_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+/// MurmurHash3 x64_128 with both halves of the state seeded, so that strings can be chained.
+void Murmur3(const std::string& str, std::uint64_t& h1, std::uint64_t& h2)
+{
+    constexpr std::uint64_t c1 = 0x87c37b91114253d5ull;
+    constexpr std::uint64_t c2 = 0x4cf5ad432745937full;
+
+    const auto* const data = str.data();
+    const auto len         = str.size();
+    const auto blocks      = len / 16;
+
+    for(std::size_t i = 0; i < blocks; ++i)
+    {
+        auto k1 = Load64(data + i * 16);
+        auto k2 = Load64(data + i * 16 + 8);
+
+        k1 *= c1;
+        k1 = Rotl(k1, 31);
+        k1 *= c2;
+        h1 ^= k1;
+        h1 = Rotl(h1, 27);
+        h1 += h2;
+        h1 = h1 * 5 + 0x52dce729;
+
+        k2 *= c2;
+        k2 = Rotl(k2, 33);
+        k2 *= c1;
+        h2 ^= k2;
+        h2 = Rotl(h2, 31);
+        h2 += h1;
+        h2 = h2 * 5 + 0x38495ab5;
+    }
+
+    const auto* const tail = reinterpret_cast<const unsigned char*>(data + blocks * 16);
+    const auto rest        = len % 16;
+    std::uint64_t k1       = 0;
+    std::uint64_t k2       = 0;
+    for(std::size_t i = rest; i > 8; --i)
+        k2 = (k2 << 8) | tail[i - 1];
+    for(std::size_t i = rest < 8 ? rest : 8; i > 0; --i)
+        k1 = (k1 << 8) | tail[i - 1];
+
+    if(rest > 8)
+    {
+        k2 *= c2;
+        k2 = Rotl(k2, 33);
+        k2 *= c1;
+        h2 ^= k2;
+    }
+    if(rest > 0)
+    {
+        k1 *= c1;
+        k1 = Rotl(k1, 31);
+        k1 *= c2;
+        h1 ^= k1;
+    }
+
+    h1 ^= len;
+    h2 ^= len;
+    h1 += h2;
+    h2 += h1;
+    h1 = FMix(h1);
+    h2 = FMix(h2);
+    h1 += h2;
+    h2 += h1;
+}
+
+} // namespace
+
+KernelCacheKey::KernelCacheKey(std::string first_, std::string second_)
+    : first(std::move(first_)), second(std::move(second_))
+{
+    // The length of each string is mixed into the state, so {"ab", "c"} and {"a", "bc"} differ.
+    Murmur3(first, low, high);
+    Murmur3(second, low, high);
+}
+
+std::ostream& operator<<(std::ostream& stream, const KernelCacheKey& key)
+{
+    const auto flags = stream.flags();
+    const auto fill  = stream.fill('0');
+    stream << std::hex << std::setw(16) << key.high << std::setw(16) << key.low;
+    stream.flags(flags);
+    stream.fill(fill);
+    return stream;
+}
+
+} // namespace miopen
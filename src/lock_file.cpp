@@ -75,7 +75,7 @@ LockFile::LockFile(const char* path_, PassKey) : path(path_)
                 MIOPEN_THROW(std::string("Error creating file <") + path + "> for locking.");
             fs::permissions(path, fs::all_all);
         }
-        flock = path;
+        flock = path.c_str();
     }
     catch(const fs::filesystem_error& ex)
     {
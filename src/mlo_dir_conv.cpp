@@ -92,7 +92,8 @@ mlo_construct_direct2D_fusion::FindSolution(const std::vector<miopen::solver::An
 
 static auto GetGemmSolvers()
 {
-    return miopen::solver::SolverContainer<miopen::solver::GemmFwd1x1_0_1,
+    return miopen::solver::SolverContainer<miopen::solver::ConvGemmHost,
+                                           miopen::solver::GemmFwd1x1_0_1,
                                            miopen::solver::GemmFwd1x1_0_1_int8,
                                            miopen::solver::GemmFwd1x1_0_2,
                                            miopen::solver::GemmFwdRest,
@@ -107,7 +108,8 @@ static auto GetGemmSolvers()
 
 static auto GetDirectSolvers()
 {
-    return miopen::solver::SolverContainer<miopen::solver::ConvAsm3x3U,
+    return miopen::solver::SolverContainer<miopen::solver::ConvDirectHost,
+                                           miopen::solver::ConvAsm3x3U,
                                            miopen::solver::ConvAsm1x1U,
                                            miopen::solver::ConvAsm1x1UV2,
                                            miopen::solver::ConvAsm5x10u2v2f1,
@@ -208,7 +210,8 @@ static auto GetWindogradWrWSolvers()
 
 static auto GetBwdWrW2DSolvers()
 {
-    return miopen::solver::SolverContainer<miopen::solver::ConvAsmBwdWrW1x1,
+    return miopen::solver::SolverContainer<miopen::solver::ConvDirectHost,
+                                           miopen::solver::ConvAsmBwdWrW1x1,
                                            miopen::solver::ConvAsmBwdWrW3x3,
                                            miopen::solver::ConvOclBwdWrW2<1>,
                                            miopen::solver::ConvOclBwdWrW2<2>,
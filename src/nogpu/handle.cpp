@@ -27,6 +27,7 @@
 #include "miopen/common.hpp"
 #include <miopen/config.h>
 #include <miopen/handle.hpp>
+#include <miopen/background_compiler.hpp>
 #include <miopen/binary_cache.hpp>
 #include <miopen/target_properties.hpp>
 #include <miopen/errors.hpp>
@@ -54,31 +55,73 @@
 #include <algorithm>
 #include <cassert>
 #include <chrono>
+#include <cstring>
+#include <new>
 #include <thread>
 #include <miopen/nogpu/handle_impl.hpp>
 namespace miopen {
 
+namespace {
+
+// Without a device, "device" buffers live in host memory, so the host
+// solvers can use them directly. The alignment matches what the vectorized
+// host loops prefer.
+constexpr std::size_t host_buffer_alignment = 64;
+
+void* default_allocator(void*, size_t sz)
+{
+    // Aligned operator new, as std::aligned_alloc is not available with MSVC.
+    auto ptr = ::operator new(
+        std::max<std::size_t>(sz, 1), std::align_val_t{host_buffer_alignment}, std::nothrow);
+    if(ptr == nullptr)
+        MIOPEN_THROW(miopenStatusAllocFailed,
+                     "Host allocation of " + std::to_string(sz) + " bytes failed");
+    MIOPEN_LOG_I2("aligned new " << sz << " at " << ptr << " Ok");
+    return ptr;
+}
+
+void default_deallocator(void*, void* mem)
+{
+    ::operator delete(mem, std::align_val_t{host_buffer_alignment});
+}
+
+} // namespace
+
 Handle::Handle(miopenAcceleratorQueue_t /* stream */) : Handle::Handle() {}
 
 Handle::Handle() : impl(new HandleImpl())
 {
     this->impl->target_properties.Init(this);
+    this->SetAllocator(nullptr, nullptr, nullptr);
     MIOPEN_LOG_NQI(*this);
 }
 
-Handle::~Handle() {}
+Handle::~Handle() { BackgroundCompiler::Cancel(this); }
 
 void Handle::SetStream(miopenAcceleratorQueue_t /* streamID */) const {}
 
 void Handle::SetStreamFromPool(int) const {}
+
+void Handle::SetTargetDevice(const std::string& arch, std::size_t num_cu)
+{
+    this->impl->device_name = arch;
+    this->impl->num_cu      = num_cu;
+    this->impl->target_properties.Init(this);
+}
+
+bool Handle::HasTargetDevice() const { return !this->impl->device_name.empty(); }
 void Handle::ReserveExtraStreamsInPool(int) const {}
 
 miopenAcceleratorQueue_t Handle::GetStream() const { return {}; }
 
-void Handle::SetAllocator(miopenAllocatorFunction /* allocator */,
-                          miopenDeallocatorFunction /* deallocator */,
-                          void* /* allocatorContext */) const
+void Handle::SetAllocator(miopenAllocatorFunction allocator,
+                          miopenDeallocatorFunction deallocator,
+                          void* allocatorContext) const
 {
+    this->impl->allocator.allocator   = allocator == nullptr ? default_allocator : allocator;
+    this->impl->allocator.deallocator = deallocator == nullptr ? default_deallocator : deallocator;
+
+    this->impl->allocator.context = allocatorContext;
 }
 
 void Handle::EnableProfiling(bool enable) const { this->impl->enable_profiling = enable; }
@@ -88,23 +131,31 @@ float Handle::GetKernelTime() const { return this->impl->profiling_result; }
 Allocator::ManageDataPtr Handle::Create(std::size_t sz) const { return this->impl->allocator(sz); }
 
 Allocator::ManageDataPtr&
-Handle::WriteTo(const void* /* data */, Allocator::ManageDataPtr& ddata, std::size_t /* sz */) const
+Handle::WriteTo(const void* data, Allocator::ManageDataPtr& ddata, std::size_t sz) const
 {
+    if(sz != 0)
+        std::memcpy(ddata.get(), data, sz);
     return ddata;
 }
 
-void Handle::ReadTo(void* /* data */,
-                    const Allocator::ManageDataPtr& /* ddata */,
-                    std::size_t /* sz */) const
+void Handle::ReadTo(void* data, const Allocator::ManageDataPtr& ddata, std::size_t sz) const
 {
+    this->ReadTo(data, ddata.get(), sz);
 }
 
-void Handle::ReadTo(void* /* data */, ConstData_t /* ddata */, std::size_t /* sz */) const {}
+void Handle::ReadTo(void* data, ConstData_t ddata, std::size_t sz) const
+{
+    if(sz != 0)
+        std::memcpy(data, ddata, sz);
+}
 
-void Handle::Copy(ConstData_t /* src */, Data_t /* dest */, std::size_t /* size */) const {}
+void Handle::Copy(ConstData_t src, Data_t dest, std::size_t size) const
+{
+    if(size != 0)
+        std::memmove(dest, src, size);
+}
 
-KernelInvoke Handle::AddKernel(const std::string& algorithm,
-                               const std::string& network_config,
+KernelInvoke Handle::AddKernel(const KernelCacheKey& key,
                                const std::string& program_name,
                                const std::string& kernel_name,
                                const std::vector<size_t>& vld,
@@ -115,8 +166,7 @@ KernelInvoke Handle::AddKernel(const std::string& algorithm,
                                const std::string& kernel_src) const
 {
     auto obj = this->impl->cache.AddKernel(*this,
-                                           algorithm,
-                                           network_config,
+                                           key,
                                            program_name,
                                            kernel_name,
                                            vld,
@@ -136,8 +186,7 @@ Invoker Handle::PrepareInvoker(const InvokerFactory& factory,
     {
         MIOPEN_LOG_I2("Preparing kernel: " << k.kernel_name);
         const auto kernel = this->impl->cache.AddKernel(*this,
-                                                        "",
-                                                        "",
+                                                        KernelCacheKey{},
                                                         k.kernel_file,
                                                         k.kernel_name,
                                                         k.l_wk,
@@ -149,19 +198,15 @@ Invoker Handle::PrepareInvoker(const InvokerFactory& factory,
     return factory(built);
 }
 
-void Handle::ClearKernels(const std::string& algorithm, const std::string& network_config) const
-{
-    this->impl->cache.ClearKernels(algorithm, network_config);
-}
+void Handle::ClearKernels(const KernelCacheKey& key) const { this->impl->cache.ClearKernels(key); }
 void Handle::ClearProgram(const std::string& program_name, const std::string& params) const
 {
     this->impl->cache.ClearProgram(program_name, params);
 }
 
-const std::vector<Kernel>& Handle::GetKernelsImpl(const std::string& algorithm,
-                                                  const std::string& network_config) const
+const std::vector<Kernel>& Handle::GetKernelsImpl(const KernelCacheKey& key) const
 {
-    return this->impl->cache.GetKernels(algorithm, network_config);
+    return this->impl->cache.GetKernels(key);
 }
 
 KernelInvoke Handle::Run(Kernel /* k */) const { return {}; }
@@ -220,6 +265,12 @@ Program Handle::LoadProgram(const std::string& program_name,
     return p;
 }
 
+void Handle::PrecompileProgram(const std::string& /* program_name */,
+                               std::string /* params */) const
+{
+    // Programs are compiled on demand without a device.
+}
+
 bool Handle::HasProgram(const std::string& program_name, const std::string& params) const
 {
     return this->impl->cache.HasProgram(program_name, params);
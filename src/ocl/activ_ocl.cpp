@@ -68,8 +68,9 @@ miopenStatus_t ActivationDescriptor::Forward(Handle& handle,
     }();
 
     const auto algo = AlgorithmName{"miopenActivationForward"};
-    const auto solvers =
-        solver::SolverContainer<solver::activ::ActivFwdSolver0, solver::activ::ActivFwdSolver1>{};
+    const auto solvers = solver::SolverContainer<solver::activ::ActivFwdSolverHost,
+                                                 solver::activ::ActivFwdSolver0,
+                                                 solver::activ::ActivFwdSolver1>{};
     solvers.ExecutePrimitive(handle, problem, algo, invoke_params);
     return miopenStatusSuccess;
 }
@@ -120,7 +121,8 @@ miopenStatus_t ActivationDescriptor::Backward(Handle& handle,
     }();
 
     const auto algo    = AlgorithmName{"miopenActivationBackward"};
-    const auto solvers = solver::SolverContainer<solver::activ::ActivBwdSolver0>{};
+    const auto solvers =
+        solver::SolverContainer<solver::activ::ActivBwdSolverHost, solver::activ::ActivBwdSolver0>{};
     solvers.ExecutePrimitive(handle, problem, algo, invoke_params);
     return miopenStatusSuccess;
 }
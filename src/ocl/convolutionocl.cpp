@@ -26,6 +26,7 @@
 #include <miopen/algorithm.hpp>
 #include <miopen/conv_algo_name.hpp>
 #include <miopen/conv/solver_finders.hpp>
+#include <miopen/background_compiler.hpp>
 #include <miopen/check_numerics.hpp>
 #include <miopen/config.h>
 #include <miopen/convolution.hpp>
@@ -38,6 +39,7 @@
 #include <miopen/invoker.hpp>
 #include <miopen/kernel.hpp>
 #include <miopen/solver.hpp>
+#include <miopen/solver/host.hpp>
 #include <miopen/tensor_ops.hpp>
 #include <miopen/tensor.hpp>
 #include <miopen/util.hpp>
@@ -49,6 +51,7 @@
 #include <miopen/conv/data_invoke_params.hpp>
 #include <miopen/conv/wrw_invoke_params.hpp>
 #include <miopen/conv/heuristics/ai_heuristics.hpp>
+#include <miopen/conv/heuristics/cost_model.hpp>
 
 #include <cassert>
 #include <functional>
@@ -64,6 +67,8 @@ MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_COMPILE_ONLY)
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_DUMP_TENSOR_PATH)
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_ENABLE_AI_IMMED_MODE_FALLBACK)
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_FORCE_IMMED_MODE_FALLBACK)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_CONV_COST_MODEL)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_AOT_COMPILE_TOP_K)
 
 size_t GetKernelGlobalWorkDim(const KernelInvoke& kernel, int dim) { return kernel.gdims[dim]; }
 
@@ -545,9 +550,17 @@ ConvolutionDescriptor::GetSolutionsFallback(const ExecutionContext& exec_ctx,
     auto interim = std::vector<miopenConvSolution_t>{};
     interim.reserve(maxSolutionCount); // For speed. In most cases we have less entries than asked.
 
+    // Only the host solvers can run when they are enabled. TunaNet and the cost model
+    // know nothing about them, so these are skipped and the host solvers are ranked by WTI.
+    const auto host_only      = solver::IsHostSolverEnabled(exec_ctx.GetStream());
+    const auto is_host_solver = [](const solver::Id& id) {
+        return id == solver::Id{solver::ConvDirectHost{}.SolverDbId()} ||
+               id == solver::Id{solver::ConvGemmHost{}.SolverDbId()};
+    };
+
     // TunaNet Fallback
 #if MIOPEN_ENABLE_AI_IMMED_MODE_FALLBACK
-    if(!miopen::IsDisabled(MIOPEN_DEBUG_ENABLE_AI_IMMED_MODE_FALLBACK{}))
+    if(!host_only && !miopen::IsDisabled(MIOPEN_DEBUG_ENABLE_AI_IMMED_MODE_FALLBACK{}))
     {
         const static std::string arch = exec_ctx.GetStream().GetDeviceName();
         auto solvers                  = ai::immed_mode::PredictSolver(legacy_problem, ctx, arch);
@@ -589,10 +602,22 @@ ConvolutionDescriptor::GetSolutionsFallback(const ExecutionContext& exec_ctx,
             return 10.0f / wti; // Assume WTI == 1.0 (100%) is 10 ms.
         };
 
+        // Times predicted by the cost model trained on the system find-db take
+        // precedence over WTI estimates. Solvers the model doesn't know are ranked by WTI,
+        // after the ones it knows.
+        auto estimated        = std::vector<miopenConvSolution_t>{};
+        const auto cost_model = host_only || miopen::IsDisabled(MIOPEN_DEBUG_CONV_COST_MODEL{})
+                                    ? nullptr
+                                    : ai::cost_model::GetModel(exec_ctx.GetStream());
+        const auto features   = cost_model != nullptr ? ai::cost_model::ExtractFeatures(problem)
+                                                      : std::vector<double>{};
+
         for(const auto& solver_id : solver::GetSolversByPrimitive(solver::Primitive::Convolution))
         {
             // solver_id is always valid here, because taken from registry.
             // Validity check is not required.
+            if(host_only && !is_host_solver(solver_id))
+                continue;
             const auto algo = solver_id.GetAlgo();
             if(IsAlgorithmDisabled(algo)) // Algos can be disabled globally.
                 continue;
@@ -601,13 +626,34 @@ ConvolutionDescriptor::GetSolutionsFallback(const ExecutionContext& exec_ctx,
             if(s.IsEmpty() || !s.IsDynamic() || !s.IsApplicable(ctx, problem))
                 continue;
 
+            if(cost_model != nullptr)
+            {
+                const auto time = cost_model->Predict(solver_id.ToString(), features);
+                if(time)
+                {
+                    MIOPEN_LOG_I2(solver_id.ToString() << " Predicted time = " << *time);
+                    interim.emplace_back(miopenConvSolution_t{
+                        *time, s.GetWorkspaceSize(ctx, problem), solver_id.Value(), algo});
+                    continue;
+                }
+            }
+
             const auto wti = s.GetWti(ctx, problem);
             MIOPEN_LOG_I2(solver_id.ToString() << " Estimated WTI = " << wti);
             if(wti < 0.0f) // Skip unknown WTIs.
                 continue;
-            interim.emplace_back(miopenConvSolution_t{
+            estimated.emplace_back(miopenConvSolution_t{
                 wti2time(wti), s.GetWorkspaceSize(ctx, problem), solver_id.Value(), algo});
         }
+
+        // Predicted times and WTI estimates are on different scales, so they are not compared:
+        // the estimates are moved past the slowest prediction and rank among themselves.
+        auto slowest_predicted = 0.0f;
+        for(const auto& sol : interim)
+            slowest_predicted = std::max(slowest_predicted, sol.time);
+        for(auto& sol : estimated)
+            sol.time += slowest_predicted;
+        interim.insert(interim.end(), estimated.begin(), estimated.end());
     }
     MIOPEN_LOG_I2("maxSolutionCount = " << maxSolutionCount << ", available = " << interim.size());
     for(const auto& s : interim)
@@ -739,6 +785,47 @@ void ConvolutionDescriptor::CompileSolution(const ExecutionContext& ctx,
     miopen::CompileSolution(solver_id, ctx, problem);
 }
 
+void ConvolutionDescriptor::PrecompileSolutions(
+    const ExecutionContext& ctx,
+    const conv::ProblemDescription& problem,
+    const std::vector<miopenConvSolution_t>& solutions) const
+{
+    const auto top_k = std::min<std::size_t>(Value(MIOPEN_AOT_COMPILE_TOP_K{}), solutions.size());
+    if(top_k == 0)
+        return;
+
+    auto exec_ctx = ctx;
+    exec_ctx.DetectRocm();
+    problem.SetupFloats(exec_ctx);
+    exec_ctx.do_search = false;
+
+    const auto legacy_ctx     = ConvolutionContext{exec_ctx};
+    const auto legacy_problem = ProblemDescription{problem};
+    const auto config         = problem.BuildConfKey();
+    const auto& handle        = exec_ctx.GetStream();
+
+    // Finding the solutions may take a while too, so that is left to the background workers.
+    for(auto i = std::size_t{0}; i < top_k; ++i)
+    {
+        const auto solver_id = solver::Id{solutions[i].solution_id};
+        if(handle.GetInvoker(config, solver_id))
+            continue;
+
+        BackgroundCompiler::Get().Enqueue(
+            "solution " + config.ToString() + " " + solver_id.ToString(),
+            [=, &handle]() {
+                auto db = GetDb(legacy_ctx);
+                const auto solution =
+                    solver_id.GetSolver().FindSolution(legacy_ctx, legacy_problem, db, {});
+                MIOPEN_LOG_I2("Precompiling " << solution.construction_params.size()
+                                              << " kernels of " << solver_id.ToString());
+                for(const auto& kernel : solution.construction_params)
+                    handle.PrecompileProgram(kernel.kernel_file, kernel.comp_options);
+            },
+            &handle);
+    }
+}
+
 void ConvolutionDescriptor::ConvolutionForwardImmediate(Handle& handle,
                                                         const TensorDescriptor& wDesc,
                                                         ConstData_t w,
@@ -26,6 +26,7 @@
 
 #include <miopen/handle.hpp>
 
+#include <miopen/background_compiler.hpp>
 #include <miopen/binary_cache.hpp>
 #include <miopen/config.h>
 #include <miopen/env.hpp>
@@ -271,7 +272,7 @@ Handle::Handle() : impl(new HandleImpl())
 }
 
 Handle::Handle(Handle&&) noexcept = default;
-Handle::~Handle()                 = default;
+Handle::~Handle() { BackgroundCompiler::Cancel(this); }
 
 void Handle::SetStream(miopenAcceleratorQueue_t streamID) const
 {
@@ -316,8 +317,7 @@ void Handle::AccumKernelTime(float curr_time) const { this->impl->AccumProfiling
 
 float Handle::GetKernelTime() const { return this->impl->profiling_result; }
 
-KernelInvoke Handle::AddKernel(const std::string& algorithm,
-                               const std::string& network_config,
+KernelInvoke Handle::AddKernel(const KernelCacheKey& key,
                                const std::string& program_name,
                                const std::string& kernel_name,
                                const std::vector<size_t>& vld,
@@ -329,8 +329,7 @@ KernelInvoke Handle::AddKernel(const std::string& algorithm,
 {
 
     auto obj = this->impl->cache.AddKernel(*this,
-                                           algorithm,
-                                           network_config,
+                                           key,
                                            program_name,
                                            kernel_name,
                                            vld,
@@ -350,8 +349,7 @@ Invoker Handle::PrepareInvoker(const InvokerFactory& factory,
     {
         MIOPEN_LOG_I2("Preparing kernel: " << k.kernel_name);
         const auto kernel = this->impl->cache.AddKernel(*this,
-                                                        "",
-                                                        "",
+                                                        KernelCacheKey{},
                                                         k.kernel_file,
                                                         k.kernel_name,
                                                         k.l_wk,
@@ -363,16 +361,11 @@ Invoker Handle::PrepareInvoker(const InvokerFactory& factory,
     return factory(built);
 }
 
-void Handle::ClearKernels(const std::string& algorithm, const std::string& network_config) const
-{
-
-    this->impl->cache.ClearKernels(algorithm, network_config);
-}
+void Handle::ClearKernels(const KernelCacheKey& key) const { this->impl->cache.ClearKernels(key); }
 
-const std::vector<Kernel>& Handle::GetKernelsImpl(const std::string& algorithm,
-                                                  const std::string& network_config) const
+const std::vector<Kernel>& Handle::GetKernelsImpl(const KernelCacheKey& key) const
 {
-    return this->impl->cache.GetKernels(algorithm, network_config);
+    return this->impl->cache.GetKernels(key);
 }
 
 KernelInvoke Handle::Run(Kernel k) const
@@ -448,6 +441,12 @@ void Handle::ClearProgram(const std::string& program_name, const std::string& pa
     this->impl->cache.ClearProgram(program_name, params);
 }
 
+void Handle::PrecompileProgram(const std::string& /* program_name */,
+                               std::string /* params */) const
+{
+    // Background compilation is only implemented for HIP.
+}
+
 bool Handle::HasProgram(const std::string& program_name, const std::string& params) const
 {
     return this->impl->cache.HasProgram(program_name, params);
@@ -116,7 +116,8 @@ miopenStatus_t LRNDescriptor::Forward(Handle& handle,
         std::to_string(hInStride) + std::to_string(hOutStride) + std::to_string(hIn) +
         std::to_string(hOut) + std::to_string(wIn) + std::to_string(wOut);
 
-    auto&& kernels = handle.GetKernels(algo_name, network_config);
+    const auto kernel_key = KernelCacheKey{algo_name, std::move(network_config)};
+    auto&& kernels        = handle.GetKernels(kernel_key);
     if(!kernels.empty())
     {
         visit_float(xDesc.GetType(), [&](auto as_float) {
@@ -151,7 +152,7 @@ miopenStatus_t LRNDescriptor::Forward(Handle& handle,
         const std::vector<size_t>& vgd = construct_params.getGlobalWkSize();
 
         KernelInvoke obj = handle.AddKernel(
-            algo_name, network_config, program_name, kernel_name, vld, vgd, compiler_parms);
+            kernel_key, program_name, kernel_name, vld, vgd, compiler_parms);
         visit_float(xDesc.GetType(), [&](auto as_float) {
             if(do_backward)
             {
@@ -292,7 +293,8 @@ miopenStatus_t LRNDescriptor::Backward(Handle& handle,
         std::to_string(hInStride) + std::to_string(hOutStride) + std::to_string(hIn) +
         std::to_string(hOut) + std::to_string(wIn) + std::to_string(wOut);
 
-    auto&& kernels = handle.GetKernels(algo_name, network_config);
+    const auto kernel_key = KernelCacheKey{algo_name, std::move(network_config)};
+    auto&& kernels        = handle.GetKernels(kernel_key);
     if(!kernels.empty())
     {
         visit_float(xDesc.GetType(), [&](auto as_float) {
@@ -317,8 +319,7 @@ miopenStatus_t LRNDescriptor::Backward(Handle& handle,
         const std::vector<size_t>& vgd = construct_params.getGlobalWkSize();
 
         visit_float(xDesc.GetType(), [&](auto as_float) {
-            handle.AddKernel(
-                algo_name, network_config, program_name, kernel_name, vld, vgd, compiler_parms)(
+            handle.AddKernel(kernel_key, program_name, kernel_name, vld, vgd, compiler_parms)(
                 y,
                 x,
                 dy,
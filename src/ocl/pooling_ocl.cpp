@@ -39,7 +39,8 @@ namespace miopen {
 
 static auto PoolingForwardSolvers()
 {
-    return solver::SolverContainer<solver::pooling::PoolingForward2d,
+    return solver::SolverContainer<solver::pooling::PoolingForwardHost,
+                                   solver::pooling::PoolingForward2d,
                                    solver::pooling::PoolingForwardNd,
                                    solver::pooling::TransposedPoolingFwd2d,
                                    solver::pooling::TransposedPoolingFwdNd>{};
@@ -47,7 +48,8 @@ static auto PoolingForwardSolvers()
 
 static auto PoolingBackwardSolvers()
 {
-    return solver::SolverContainer<solver::pooling::PoolingBackward2d,
+    return solver::SolverContainer<solver::pooling::PoolingBackwardHost,
+                                   solver::pooling::PoolingBackward2d,
                                    solver::pooling::PoolingBackwardNd,
                                    solver::pooling::TransposedPoolingBwd2d,
                                    solver::pooling::TransposedPoolingBwdNd>{};
@@ -27,6 +27,7 @@
 #include <miopen/softmax.hpp>
 #include <miopen/float_equal.hpp>
 #include <miopen/check_numerics.hpp>
+#include <miopen/solver/host.hpp>
 #include <miopen/tensor.hpp>
 
 namespace miopen {
@@ -78,6 +79,13 @@ miopenStatus_t SoftmaxForward(const Handle& handle,
         MIOPEN_THROW(miopenStatusBadParm, "Tensor dimension lengths do not match.");
     }
 
+    if(solver::IsHostSolverEnabled(handle) && solver::IsHostSolverType(yDesc))
+    {
+        solver::host::SoftmaxForward(
+            alpha, beta, xDesc, x, yDesc, y, algorithm, mode, x_offset, y_offset);
+        return miopenStatusSuccess;
+    }
+
     int n, c, h, w;
     std::tie(n, c, h, w) = tien<4>(yDesc.GetLengths());
 
@@ -129,7 +137,8 @@ miopenStatus_t SoftmaxForward(const Handle& handle,
             "b" + std::to_string(beta_fp) + "algo" + std::to_string(static_cast<int>(algorithm)) +
             "mode" + std::to_string(static_cast<int>(mode));
 
-        auto&& kernels = handle.GetKernels(algo_name, network_config);
+        const auto kernel_key = KernelCacheKey{algo_name, std::move(network_config)};
+        auto&& kernels        = handle.GetKernels(kernel_key);
 
         if(!kernels.empty())
         {
@@ -183,7 +192,7 @@ miopenStatus_t SoftmaxForward(const Handle& handle,
             if(!float_equal(beta_fp, 0))
                 parms += " -DUSE_BETA=1";
 
-            handle.AddKernel(algo_name, network_config, program_name, kernel_name, vld, vgd, parms)(
+            handle.AddKernel(kernel_key, program_name, kernel_name, vld, vgd, parms)(
                 x,
                 y,
                 vector_size,
@@ -232,7 +241,8 @@ miopenStatus_t SoftmaxForward(const Handle& handle,
             "b" + std::to_string(beta_fp) + "algo" + std::to_string(static_cast<int>(algorithm)) +
             "mode" + std::to_string(static_cast<int>(mode));
 
-        auto&& kernels = handle.GetKernels(algo_name, network_config);
+        const auto kernel_key = KernelCacheKey{algo_name, std::move(network_config)};
+        auto&& kernels        = handle.GetKernels(kernel_key);
 
         if(!kernels.empty())
         {
@@ -286,7 +296,7 @@ miopenStatus_t SoftmaxForward(const Handle& handle,
             if(!float_equal(beta_fp, 0))
                 parms += " -DUSE_BETA=1";
 
-            handle.AddKernel(algo_name, network_config, program_name, kernel_name, vld, vgd, parms)(
+            handle.AddKernel(kernel_key, program_name, kernel_name, vld, vgd, parms)(
                 x,
                 y,
                 vector_size,
@@ -348,6 +358,24 @@ miopenStatus_t SoftmaxBackward(const Handle& handle,
         MIOPEN_THROW(miopenStatusBadParm, "Tensor dimension lengths do not match.");
     }
 
+    if(solver::IsHostSolverEnabled(handle) && solver::IsHostSolverType(dxDesc))
+    {
+        solver::host::SoftmaxBackward(alpha,
+                                      yDesc,
+                                      y,
+                                      dyDesc,
+                                      dy,
+                                      beta,
+                                      dxDesc,
+                                      dx,
+                                      algorithm,
+                                      mode,
+                                      y_offset,
+                                      dy_offset,
+                                      dx_offset);
+        return miopenStatusSuccess;
+    }
+
     if(miopen::CheckNumericsEnabled())
     {
         miopen::checkNumericsInput(handle, yDesc, y);
@@ -408,7 +436,8 @@ miopenStatus_t SoftmaxBackward(const Handle& handle,
             "b" + std::to_string(beta_fp) + "algo" + std::to_string(static_cast<int>(algorithm)) +
             "mode" + std::to_string(static_cast<int>(mode));
 
-        auto&& kernels = handle.GetKernels(algo_name, network_config);
+        const auto kernel_key = KernelCacheKey{algo_name, std::move(network_config)};
+        auto&& kernels        = handle.GetKernels(kernel_key);
 
         if(!kernels.empty())
         {
@@ -466,7 +495,7 @@ miopenStatus_t SoftmaxBackward(const Handle& handle,
             if(!float_equal(beta_fp, 0))
                 parms += " -DUSE_BETA=1";
 
-            handle.AddKernel(algo_name, network_config, program_name, kernel_name, vld, vgd, parms)(
+            handle.AddKernel(kernel_key, program_name, kernel_name, vld, vgd, parms)(
                 y,
                 dy,
                 dx,
@@ -517,7 +546,8 @@ miopenStatus_t SoftmaxBackward(const Handle& handle,
             "b" + std::to_string(beta_fp) + "algo" + std::to_string(static_cast<int>(algorithm)) +
             "mode" + std::to_string(static_cast<int>(mode));
 
-        auto&& kernels = handle.GetKernels(algo_name, network_config);
+        const auto kernel_key = KernelCacheKey{algo_name, std::move(network_config)};
+        auto&& kernels        = handle.GetKernels(kernel_key);
 
         if(!kernels.empty())
         {
@@ -577,7 +607,7 @@ miopenStatus_t SoftmaxBackward(const Handle& handle,
             if(!float_equal(beta_fp, 0))
                 parms += " -DUSE_BETA=1";
 
-            handle.AddKernel(algo_name, network_config, program_name, kernel_name, vld, vgd, parms)(
+            handle.AddKernel(kernel_key, program_name, kernel_name, vld, vgd, parms)(
                 y,
                 dy,
                 dx,
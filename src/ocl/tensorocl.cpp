@@ -32,6 +32,7 @@
 #include <miopen/visit_float.hpp>
 #include <miopen/util.hpp>
 #include <miopen/logger.hpp>
+#include <miopen/solver/host.hpp>
 #include <algorithm>
 #include <cassert>
 #include <numeric>
@@ -1289,6 +1290,25 @@ void OpTensor(const Handle& handle,
         }
     }
 
+    if(!is_squash && solver::IsHostSolverEnabled(handle) && solver::IsHostSolverType(aTensorDesc) &&
+       solver::IsHostSolverType(cTensorDesc))
+    {
+        solver::host::OpTensor(tensorOp,
+                               alpha0,
+                               aTensorDesc,
+                               ATensor,
+                               alpha1,
+                               bTensorDesc,
+                               BTensor,
+                               beta,
+                               cTensorDesc,
+                               CTensor,
+                               Aoffset,
+                               Boffset,
+                               Coffset);
+        return;
+    }
+
     auto bsize = blens.size();
     if(bsize == 3)
     {
@@ -1401,6 +1421,12 @@ void SetTensor(const Handle& handle,
         MIOPEN_THROW(miopenStatusBadParm);
     }
 
+    if(solver::IsHostSolverEnabled(handle) && solver::IsHostSolverType(yDesc))
+    {
+        solver::host::SetTensor(yDesc, y, alpha, offset);
+        return;
+    }
+
     const TensorDescriptor yDesc_flat = GetFlattenedTensorDescriptor(yDesc);
 
 #ifndef NDEBUG
@@ -1555,6 +1581,12 @@ void ScaleTensor(const Handle& handle,
         MIOPEN_THROW(miopenStatusBadParm);
     }
 
+    if(solver::IsHostSolverEnabled(handle) && solver::IsHostSolverType(yDesc))
+    {
+        solver::host::ScaleTensor(yDesc, y, alpha, offset);
+        return;
+    }
+
     const TensorDescriptor yDesc_flat = GetFlattenedTensorDescriptor(yDesc);
 
 #ifndef NDEBUG
@@ -1728,6 +1760,12 @@ void CopyTensor(const Handle& handle,
         MIOPEN_THROW(miopenStatusBadParm, "Tensor dimension lengths do not match.");
     }
 
+    if(solver::IsHostSolverEnabled(handle))
+    {
+        solver::host::CopyTensor(srcDesc, src, dstDesc, dst, srcOffset, dstOffset);
+        return;
+    }
+
     auto flat_descriptors = GetConsistentFlattenedTensorDescriptors(srcDesc, dstDesc);
     const TensorDescriptor& srcDesc_flat = std::get<0>(flat_descriptors);
     const TensorDescriptor& dstDesc_flat = std::get<1>(flat_descriptors);
@@ -1,29 +1,12 @@
 #include <miopen/problem_description.hpp>
 
 #include <miopen/convolution.hpp>
+#include <miopen/key_builder.hpp>
 
-#include <functional>
-#include <sstream>
 #include <tuple>
 
 namespace miopen {
 
-std::function<void(std::ostream&)>
-PrintDHW(char sep, int spatial_dims, int depth, int height, int width)
-{
-    return [=](std::ostream& stream) {
-        if(spatial_dims > 2)
-            stream << depth << sep;
-        stream << height << sep << width;
-    };
-}
-
-std::ostream& operator<<(std::ostream& stream, std::function<void(std::ostream&)>&& manipulator)
-{
-    manipulator(stream);
-    return stream;
-}
-
 int ProblemDescription::mloBuildConf_Key(std::string& conf_key) const
 {
     conv_problem.BuildConfKey(conf_key);
@@ -57,45 +40,35 @@ void ProblemDescription::Serialize(std::ostream& stream) const
     if(!direction.IsKnown())
         MIOPEN_THROW("!direction.IsKnown()");
     const auto sep = '-';
+    KeyBuilder key;
+
     // Problem description with default NCHW-NCHW-NCHW layout
     // 576-4-4-1x1-192-4-4-8-1x1-2x2-3x3-0-NCHW-FP32-F
     // Problem description with non-default layout
     // 576-4-4-1x1-192-4-4-8-1x1-2x2-3x3-0-NHWC-NCHW-NCHW-FP32-F
-    // clang-format off
-    stream << n_inputs;
-    stream << sep << PrintDHW(sep, spatial_dims, in_depth, in_height, in_width);
-    stream << sep << PrintDHW('x', spatial_dims, kernel_size_d, kernel_size_h, kernel_size_w);
-    stream << sep << n_outputs;
-    stream << sep << PrintDHW(sep, spatial_dims, out_depth, out_height, out_width);
-    stream << sep << batch_sz;
-    stream << sep << PrintDHW('x', spatial_dims, pad_d, pad_h, pad_w);
-    stream << sep << PrintDHW('x', spatial_dims, kernel_stride_d, kernel_stride_h, kernel_stride_w);
-    stream << sep << PrintDHW('x', spatial_dims, kernel_dilation_d, kernel_dilation_h, kernel_dilation_w);
-    stream << sep << bias;
-    if ((in_layout == "NCHW" && weights_layout == "NCHW" && out_layout == "NCHW")
-        || (in_layout == "NCDHW" && weights_layout == "NCDHW" && out_layout == "NCDHW"))
-    {
-        stream << sep << in_layout;
-    } else {
-        stream << sep << in_layout;
-        stream << sep << weights_layout;
-        stream << sep << out_layout;
-    }
-    stream << sep << EncodeDataTypesForKey(in_data_type, weights_data_type, out_data_type);
-    stream << sep << (direction.IsForward() ? "F" : direction.IsBackwardData() ? "B" : "W");
-    // clang-format on
+    key << n_inputs << sep;
+    key.DHW(sep, spatial_dims, in_depth, in_height, in_width) << sep;
+    key.DHW('x', spatial_dims, kernel_size_d, kernel_size_h, kernel_size_w) << sep;
+    key << n_outputs << sep;
+    key.DHW(sep, spatial_dims, out_depth, out_height, out_width) << sep;
+    key << batch_sz << sep;
+    key.DHW('x', spatial_dims, pad_d, pad_h, pad_w) << sep;
+    key.DHW('x', spatial_dims, kernel_stride_d, kernel_stride_h, kernel_stride_w) << sep;
+    key.DHW('x', spatial_dims, kernel_dilation_d, kernel_dilation_h, kernel_dilation_w) << sep;
+    key << bias;
+    key << sep << in_layout;
+    if(!((in_layout == "NCHW" && weights_layout == "NCHW" && out_layout == "NCHW") ||
+         (in_layout == "NCDHW" && weights_layout == "NCDHW" && out_layout == "NCDHW")))
+        key << sep << weights_layout << sep << out_layout;
+    key << sep << EncodeDataTypesForKey(in_data_type, weights_data_type, out_data_type);
+    key << sep << (direction.IsForward() ? 'F' : direction.IsBackwardData() ? 'B' : 'W');
     // New performance config entries shall come into variable/optional part of db key.
     // This is to support backward compatibility with previous versions of databases.
-    std::ostringstream optional;
-    {
-        // Group count > 1 identifies Group/Depthwise modes.
-        if(group_counts != 1)
-            optional << 'g' << group_counts;
-    }
-    if(!optional.str().empty())
-    {
-        stream << '_' << optional.str();
-    }
+    // Group count > 1 identifies Group/Depthwise modes.
+    if(group_counts != 1)
+        key << '_' << 'g' << group_counts;
+
+    stream << key.Str();
 }
 
 ProblemDescription::ProblemDescription(const TensorDescriptor& in,
@@ -30,6 +30,7 @@
 #include <miopen/lock_file.hpp>
 #include <miopen/logger.hpp>
 #include <miopen/md5.hpp>
+#include <miopen/timer.hpp>
 
 #include <boost/filesystem/operations.hpp>
 #include <boost/filesystem.hpp>
@@ -311,6 +312,8 @@ void RamDb::Prefetch()
     if(DisableUserDbFileIO)
         MIOPEN_THROW("Prefetch should never happen with disabled File IO");
 
+    TraceScope trace{"RamDb::Prefetch", GetFileName()};
+
     Measure("Prefetch", [this]() {
         auto file = std::ifstream{GetFileName()};
 
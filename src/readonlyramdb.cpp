@@ -27,6 +27,7 @@
 #include <miopen/readonlyramdb.hpp>
 #include <miopen/logger.hpp>
 #include <miopen/errors.hpp>
+#include <miopen/timer.hpp>
 
 #if MIOPEN_EMBED_DB
 #include <miopen_data.hpp>
@@ -128,6 +129,7 @@ void ReadonlyRamDb::ParseAndLoadDb(std::istream& input_stream, bool warn_if_unre
 
 void ReadonlyRamDb::Prefetch(bool warn_if_unreadable)
 {
+    TraceScope trace{"ReadonlyRamDb::Prefetch", db_path};
     Measure("Prefetch", [this, warn_if_unreadable]() {
         if(db_path.empty())
             return;
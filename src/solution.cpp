@@ -26,15 +26,27 @@
 
 #include <miopen/solution.hpp>
 
+#include <miopen/binary_cache.hpp>
 #include <miopen/check_numerics.hpp>
 #include <miopen/conv/data_invoke_params.hpp>
 #include <miopen/conv/wrw_invoke_params.hpp>
 #include <miopen/any_solver.hpp>
+#include <miopen/load_file.hpp>
+#include <miopen/logger.hpp>
+#include <miopen/stringutils.hpp>
+#include <miopen/target_properties.hpp>
+
+#if MIOPEN_BACKEND_HIP
+#include <miopen/hipoc_program.hpp>
+#endif
 
 #include <nlohmann/json.hpp>
 
 #include <boost/hof/match.hpp>
 
+#include <algorithm>
+#include <tuple>
+
 namespace miopen {
 
 void Solution::Run(Handle& handle,
@@ -55,6 +67,20 @@ void Solution::Run(Handle& handle,
     boost::apply_visitor(run, problem.GetOperatorDescriptor());
 }
 
+static bool IsSameKernels(const std::vector<solver::KernelInfo>& l,
+                          const std::vector<solver::KernelInfo>& r)
+{
+    return std::equal(l.begin(),
+                      l.end(),
+                      r.begin(),
+                      r.end(),
+                      [](const solver::KernelInfo& a, const solver::KernelInfo& b) {
+                          return a.kernel_file == b.kernel_file &&
+                                 a.kernel_name == b.kernel_name &&
+                                 a.comp_options == b.comp_options;
+                      });
+}
+
 void Solution::RunImpl(Handle& handle,
                        const std::unordered_map<miopenTensorArgumentId_t, RunInput>& inputs,
                        Data_t workspace,
@@ -150,9 +176,21 @@ void Solution::RunImpl(Handle& handle,
     conv_ctx.DetectRocm();
     conv_problem.SetupFloats(conv_ctx);
 
-    decltype(auto) db        = GetDb(conv_ctx);
+    // Embedded kernels come with the exact perf config they were built with, so neither the
+    // perf-db nor the binary cache has to be queried.
+    const auto embedded            = AddEmbeddedPrograms(handle);
+    conv_ctx.disable_perfdb_access = conv_ctx.disable_perfdb_access || embedded;
+
+    auto db                  = GetDb(conv_ctx);
     const auto conv_solution = GetSolver().GetSolver().FindSolution(
         conv_ctx, legacy_problem, db, invoke_ctx, perf_cfg.value_or(""));
+
+    // The invoker and its kernels have to come from the same solution. With the pinned perf
+    // config they are the embedded ones, unless the solver has changed since the embedding.
+    if(embedded && !IsSameKernels(conv_solution.construction_params, kernels->construction_params))
+        MIOPEN_LOG_W("Embedded kernels don't match the ones of " << GetSolver().ToString()
+                                                                 << ", they will be compiled.");
+
     decltype(auto) invoker =
         handle.PrepareInvoker(*conv_solution.invoker_factory, conv_solution.construction_params);
     handle.RegisterInvoker(invoker, net_cfg, GetSolver().ToString());
@@ -160,6 +198,122 @@ void Solution::RunImpl(Handle& handle,
     checkNumericsOutput_();
 }
 
+#if MIOPEN_BACKEND_HIP
+static std::string GetCodeObject(const Handle& handle, const solver::KernelInfo& kernel)
+{
+    auto params = kernel.comp_options;
+    if(!EndsWith(kernel.kernel_file, ".mlir"))
+        params += " -mcpu=" + handle.GetTargetProperties().Name();
+
+    const auto cached = LoadBinary(
+        handle.GetTargetProperties(), handle.GetMaxComputeUnits(), kernel.kernel_file, params);
+    if(!cached.empty())
+    {
+#if MIOPEN_ENABLE_SQLITE_KERN_CACHE
+        return cached;
+#else
+        return LoadFile(cached);
+#endif
+    }
+
+    // The binary cache is disabled, so the program has to be built once more.
+    const auto program =
+        HIPOCProgram{kernel.kernel_file, params, false, handle.GetTargetProperties(), ""};
+    return program.IsCodeObjectInMemory() ? program.GetCodeObjectBlob()
+                                          : LoadFile(program.GetCodeObjectPathname());
+}
+#endif
+
+void Solution::EmbedKernels(Handle& handle)
+{
+    const auto embed = boost::hof::match([&](const ConvolutionDescriptor& op_desc) {
+        EmbedKernelsImpl(handle, op_desc);
+    });
+
+    boost::apply_visitor(embed, problem.GetOperatorDescriptor());
+    serialization_cache = {};
+}
+
+void Solution::EmbedKernelsImpl(Handle& handle, const ConvolutionDescriptor& conv_desc)
+{
+#if MIOPEN_BACKEND_HIP
+    const auto problem_ =
+        conv_desc.mode == miopenTranspose ? GetProblem().MakeTransposed() : GetProblem();
+    const auto conv_problem   = problem_.AsConvolution();
+    const auto legacy_problem = ProblemDescription{conv_problem};
+    auto conv_ctx             = ConvolutionContext{{&handle}};
+    conv_ctx.DetectRocm();
+    conv_problem.SetupFloats(conv_ctx);
+
+    const auto& solver = GetSolver().GetSolver();
+    decltype(auto) db  = GetDb(conv_ctx);
+
+    // Pin the perf config, so a loaded solution doesn't depend on the perf-db contents.
+    if(!perf_cfg.has_value())
+    {
+        auto params = solver.GetPerfCfgParams(conv_ctx, legacy_problem, db);
+        if(!params.empty())
+            perf_cfg = std::move(params);
+    }
+
+    const auto conv_solution =
+        solver.FindSolution(conv_ctx, legacy_problem, db, AnyInvokeParams{}, perf_cfg.value_or(""));
+    if(!conv_solution.Succeeded())
+        MIOPEN_THROW(miopenStatusInternalError,
+                     "Unable to build " + GetSolver().ToString() + " to embed its kernels.");
+
+    auto embedded                = EmbeddedKernels{};
+    embedded.target              = handle.GetTargetProperties().DbId();
+    embedded.construction_params = conv_solution.construction_params;
+
+    for(const auto& kernel : conv_solution.construction_params)
+    {
+        const auto same_program = [&](const EmbeddedProgram& program) {
+            return program.name == kernel.kernel_file && program.params == kernel.comp_options;
+        };
+        if(std::any_of(embedded.programs.begin(), embedded.programs.end(), same_program))
+            continue;
+        embedded.programs.push_back(
+            {kernel.kernel_file, kernel.comp_options, GetCodeObject(handle, kernel)});
+    }
+
+    kernels = std::move(embedded);
+#else
+    std::ignore = handle;
+    std::ignore = conv_desc;
+    MIOPEN_THROW(miopenStatusNotImplemented, "Kernels can be embedded only with the HIP backend.");
+#endif
+}
+
+bool Solution::AddEmbeddedPrograms(const Handle& handle) const
+{
+    if(!kernels.has_value())
+        return false;
+
+#if MIOPEN_BACKEND_HIP
+    if(kernels->target != handle.GetTargetProperties().DbId())
+    {
+        MIOPEN_LOG_W("Solution kernels have been built for "
+                     << kernels->target << ", but running on "
+                     << handle.GetTargetProperties().DbId() << ". Embedded kernels are ignored.");
+        return false;
+    }
+
+    for(const auto& program : kernels->programs)
+    {
+        if(handle.HasProgram(program.name, program.params))
+            continue;
+        handle.AddProgram(
+            HIPOCProgram{program.name, program.code_object}, program.name, program.params);
+    }
+
+    return true;
+#else
+    std::ignore = handle;
+    return false;
+#endif
+}
+
 Problem Solution::Transpose(const Problem& problem, RunInput* x, const RunInput& w, RunInput* y)
 {
     auto transposed = problem.MakeTransposed();
@@ -201,6 +355,40 @@ void to_json(nlohmann::json& json, const Solution& solution)
 
     if(solution.perf_cfg.has_value())
         json["perf_cfg"] = *solution.perf_cfg;
+
+    if(solution.kernels.has_value())
+    {
+        auto construction_params = nlohmann::json::array();
+        for(const auto& kernel : solution.kernels->construction_params)
+        {
+            construction_params.push_back(nlohmann::json{
+                {"file", kernel.kernel_file},
+                {"name", kernel.kernel_name},
+                {"options", kernel.comp_options},
+                {"l_wk", kernel.l_wk},
+                {"g_wk", kernel.g_wk},
+            });
+        }
+
+        // Code objects are stored as raw binaries, which keeps msgpack output compact.
+        auto programs = nlohmann::json::array();
+        for(const auto& program : solution.kernels->programs)
+        {
+            const auto& blob = program.code_object;
+            programs.push_back(nlohmann::json{
+                {"name", program.name},
+                {"params", program.params},
+                {"code_object",
+                 nlohmann::json::binary(std::vector<std::uint8_t>(blob.begin(), blob.end()))},
+            });
+        }
+
+        json["kernels"] = nlohmann::json{
+            {"target", solution.kernels->target},
+            {"construction_params", std::move(construction_params)},
+            {"programs", std::move(programs)},
+        };
+    }
 }
 
 void from_json(const nlohmann::json& json, Solution& solution)
@@ -227,5 +415,38 @@ void from_json(const nlohmann::json& json, Solution& solution)
     solution.perf_cfg        = perf_cfg_json != json.end()
                                    ? std::optional{perf_cfg_json->get<std::string>()}
                                    : std::nullopt;
+
+    const auto kernels_json = json.find("kernels");
+    if(kernels_json == json.end())
+    {
+        solution.kernels = std::nullopt;
+        return;
+    }
+
+    auto kernels = Solution::EmbeddedKernels{};
+    kernels_json->at("target").get_to(kernels.target);
+
+    for(const auto& kernel_json : kernels_json->at("construction_params"))
+    {
+        auto kernel = solver::KernelInfo{};
+        kernel_json.at("file").get_to(kernel.kernel_file);
+        kernel_json.at("name").get_to(kernel.kernel_name);
+        kernel_json.at("options").get_to(kernel.comp_options);
+        kernel_json.at("l_wk").get_to(kernel.l_wk);
+        kernel_json.at("g_wk").get_to(kernel.g_wk);
+        kernels.construction_params.push_back(std::move(kernel));
+    }
+
+    for(const auto& program_json : kernels_json->at("programs"))
+    {
+        auto program = Solution::EmbeddedProgram{};
+        program_json.at("name").get_to(program.name);
+        program_json.at("params").get_to(program.params);
+        const auto& blob = program_json.at("code_object").get_binary();
+        program.code_object.assign(blob.begin(), blob.end());
+        kernels.programs.push_back(std::move(program));
+    }
+
+    solution.kernels = std::move(kernels);
 }
 } // namespace miopen
@@ -41,7 +41,9 @@
 #include <miopen/timer.hpp>
 
 #include <boost/range/adaptor/transformed.hpp>
+#include <mutex>
 #include <ostream>
+#include <unordered_map>
 
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_ENABLE_DEPRECATED_SOLVERS)
 
@@ -112,455 +114,360 @@ std::ostream& operator<<(std::ostream& os, const ConvSolution& s)
     return os;
 }
 
-struct IdRegistryEntry
+template <class TSolver>
+const std::string& SolverDbIdOf()
 {
-    std::string str_value          = "";
-    Primitive primitive            = Primitive::Convolution;
-    miopenConvAlgorithm_t convAlgo = miopenConvolutionAlgoDirect;
-    AnySolver solver;
-};
+    return TSolver{}.SolverDbId();
+}
 
-struct IdRegistryData
+template <class TSolver>
+AnySolver MakeAnySolver()
 {
-    std::unordered_map<uint64_t, IdRegistryEntry> value_to_entry;
-    std::unordered_map<std::string, uint64_t> str_to_value;
-    std::unordered_map<Primitive, std::vector<Id>> primitive_to_ids;
-};
+    return TSolver{};
+}
 
-struct SolverRegistrar
+/// Static description of a registered id. Names and AnySolver objects are only produced by
+/// the function pointers when they are requested, so the registry costs nothing until used.
+struct IdRegistryEntry
 {
-    SolverRegistrar(IdRegistryData& registry);
+    Primitive primitive               = Primitive::Invalid;
+    miopenConvAlgorithm_t convAlgo    = miopenConvolutionAlgoDirect;
+    const std::string& (*str_value)() = nullptr;
+    AnySolver (*make_solver)()        = nullptr;
+
+    constexpr bool IsRegistered() const { return str_value != nullptr; }
 };
 
-static auto& IdRegistry()
+template <class TSolver>
+constexpr IdRegistryEntry Conv(miopenConvAlgorithm_t algo)
 {
-    // NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
-    static auto data            = IdRegistryData{};
-    static const auto registrar = SolverRegistrar{data};
-    (void)registrar; // clang-tidy
-    return data;
+    return {Primitive::Convolution, algo, &SolverDbIdOf<TSolver>, &MakeAnySolver<TSolver>};
 }
 
-const std::vector<Id>& GetSolversByPrimitive(Primitive primitive)
+template <class TSolver>
+constexpr IdRegistryEntry WithoutSolver(Primitive primitive,
+                                        miopenConvAlgorithm_t algo = miopenConvolutionAlgoDirect)
 {
-    return IdRegistry().primitive_to_ids[primitive];
+    return {primitive, algo, &SolverDbIdOf<TSolver>, nullptr};
 }
 
-Id::Id(uint64_t value_) : value(value_)
-{
-    is_valid = (IdRegistry().value_to_entry.find(value) != IdRegistry().value_to_entry.end());
-}
+constexpr IdRegistryEntry Removed() { return {}; }
+
+// Id of an entry is its index in the table plus one, 0 is reserved for invalid value.
+// When solver gets removed its entry should be replaced with Removed() to keep backwards
+// compatibility. New solvers should only be added to the end of the table unless it is
+// intended to reuse an id of a removed solver.
+// IMPORTANT: New solvers should be added to the end of the table!
+constexpr IdRegistryEntry id_registry[] = {
+    Conv<ConvAsm3x3U>(miopenConvolutionAlgoDirect),
+    Conv<ConvAsm1x1U>(miopenConvolutionAlgoDirect),
+    Conv<ConvAsm1x1UV2>(miopenConvolutionAlgoDirect),
+    WithoutSolver<solver::fusion::ConvBiasActivAsm1x1U>(Primitive::Fusion,
+                                                        miopenConvolutionAlgoDirect),
+    Conv<ConvAsm5x10u2v2f1>(miopenConvolutionAlgoDirect),
+    Conv<ConvAsm5x10u2v2b1>(miopenConvolutionAlgoDirect),
+    Conv<ConvAsm7x7c3h224w224k64u2v2p3q3f1>(miopenConvolutionAlgoDirect),
+    Conv<ConvOclDirectFwd11x11>(miopenConvolutionAlgoDirect),
+    Conv<ConvOclDirectFwdGen>(miopenConvolutionAlgoDirect),
+    Removed(), // removed ConvOclDirectFwd3x3
+    Conv<ConvOclDirectFwd>(miopenConvolutionAlgoDirect),
+    WithoutSolver<solver::fusion::ConvOclDirectFwdFused>(Primitive::Fusion,
+                                                         miopenConvolutionAlgoDirect),
+    Conv<ConvOclDirectFwd1x1>(miopenConvolutionAlgoDirect),
+    Conv<ConvBinWinograd3x3U>(miopenConvolutionAlgoWinograd),
+    Conv<ConvBinWinogradRxS>(miopenConvolutionAlgoWinograd),
+    Conv<ConvAsmBwdWrW3x3>(miopenConvolutionAlgoDirect),
+    Conv<ConvAsmBwdWrW1x1>(miopenConvolutionAlgoDirect),
+    Conv<ConvOclBwdWrW2<1>>(miopenConvolutionAlgoDirect),
+    Conv<ConvOclBwdWrW2<2>>(miopenConvolutionAlgoDirect),
+    Conv<ConvOclBwdWrW2<4>>(miopenConvolutionAlgoDirect),
+    Conv<ConvOclBwdWrW2<8>>(miopenConvolutionAlgoDirect),
+    Conv<ConvOclBwdWrW2<16>>(miopenConvolutionAlgoDirect),
+    Conv<ConvOclBwdWrW2NonTunable>(miopenConvolutionAlgoDirect),
+    Conv<ConvOclBwdWrW53>(miopenConvolutionAlgoDirect),
+    Conv<ConvOclBwdWrW1x1>(miopenConvolutionAlgoDirect),
+    Conv<ConvHipImplicitGemmV4R1Fwd>(miopenConvolutionAlgoImplicitGEMM),
+    Removed(), // removed solver ConvHipImplicitGemmV4Fwd
+    Removed(), // removed solver ConvHipImplicitGemmV4_1x1
+    Removed(), // removed solver ConvHipImplicitGemmV4R4FwdXdlops
+    Removed(), // removed solver ConvHipImplicitGemmV4R4Xdlops_1x1
+    Conv<ConvHipImplicitGemmV4R1WrW>(miopenConvolutionAlgoImplicitGEMM),
+    Removed(), // removed solver ConvHipImplicitGemmV4WrW
 
-Id::Id(ForceInit, uint64_t value_) : value(value_), is_valid(true) {}
+    // Several ids w/o solver for immediate mode
+    Removed(), // old gemm pseudo-solverid
 
-Id::Id(const std::string& str) : Id(str.c_str()) {}
+    Conv<fft>(miopenConvolutionAlgoFFT),
 
-Id::Id(const char* str)
-{
-    const auto it = IdRegistry().str_to_value.find(str);
-    is_valid      = (it != IdRegistry().str_to_value.end());
-    value         = is_valid ? it->second : invalid_value;
-}
+    Conv<ConvWinograd3x3MultipassWrW<3, 4>>(miopenConvolutionAlgoWinograd),
+    Removed(), // Id for ConvSCGemmFGemm.
+    Conv<ConvBinWinoRxS<3, 2>>(miopenConvolutionAlgoWinograd),
+    Conv<ConvWinograd3x3MultipassWrW<3, 5>>(miopenConvolutionAlgoWinograd),
+    Conv<ConvWinograd3x3MultipassWrW<3, 6>>(miopenConvolutionAlgoWinograd),
+    Conv<ConvWinograd3x3MultipassWrW<3, 2>>(miopenConvolutionAlgoWinograd),
+    Conv<ConvWinograd3x3MultipassWrW<3, 3>>(miopenConvolutionAlgoWinograd),
+    Conv<ConvWinograd3x3MultipassWrW<7, 2>>(miopenConvolutionAlgoWinograd),
+    Conv<ConvWinograd3x3MultipassWrW<7, 3>>(miopenConvolutionAlgoWinograd),
+    Conv<ConvWinograd3x3MultipassWrW<7, 2, 1, 1>>(miopenConvolutionAlgoWinograd),
+    Conv<ConvWinograd3x3MultipassWrW<7, 3, 1, 1>>(miopenConvolutionAlgoWinograd),
+    Conv<ConvWinograd3x3MultipassWrW<1, 1, 7, 2>>(miopenConvolutionAlgoWinograd),
+    Conv<ConvWinograd3x3MultipassWrW<1, 1, 7, 3>>(miopenConvolutionAlgoWinograd),
+    Conv<ConvWinograd3x3MultipassWrW<5, 3>>(miopenConvolutionAlgoWinograd),
+    Conv<ConvWinograd3x3MultipassWrW<5, 4>>(miopenConvolutionAlgoWinograd),
 
-std::string Id::ToString() const
-{
-    if(!IsValid())
-        return "INVALID_SOLVER_ID_" + std::to_string(value);
-    return IdRegistry().value_to_entry[value].str_value;
-}
+    Removed(), // removed solver ConvHipImplicitGemmV4R4WrWXdlops
+    Removed(), // removed solver ConvHipImplicitGemmV4R4GenFwdXdlops
+    Removed(), // removed solver ConvHipImplicitGemmV4R4GenWrWXdlops
 
-AnySolver Id::GetSolver() const
-{
-    const auto it = IdRegistry().value_to_entry.find(value);
-    return it != IdRegistry().value_to_entry.end() ? it->second.solver : AnySolver{};
-}
+    Conv<ConvBinWinoRxS<2, 3>>(miopenConvolutionAlgoWinograd),
 
-std::string Id::GetAlgo(conv::Direction dir) const
+    Conv<ConvHipImplicitGemmV4R4Fwd>(miopenConvolutionAlgoImplicitGEMM),
+
+    Conv<ConvHipImplicitGemmBwdDataV1R1>(miopenConvolutionAlgoImplicitGEMM),
+    Conv<ConvHipImplicitGemmBwdDataV4R1>(miopenConvolutionAlgoImplicitGEMM),
+
+    Conv<ConvHipImplicitGemmBwdDataV1R1Xdlops>(miopenConvolutionAlgoImplicitGEMM),
+
+    Removed(), // removed solver ConvHipImplicitGemmV4R4GenXdlopsFwdFp32
+    Removed(), // removed solver ConvHipImplicitGemmV4R4GenXdlopsWrWFp32
+
+    Conv<ConvHipImplicitGemmBwdDataV4R1Xdlops>(miopenConvolutionAlgoImplicitGEMM),
+
+    Conv<ConvHipImplicitGemmV4R4WrW>(miopenConvolutionAlgoImplicitGEMM),
+
+    Conv<ConvAsmImplicitGemmV4R1DynamicFwd>(miopenConvolutionAlgoImplicitGEMM),
+
+    Conv<ConvAsmImplicitGemmV4R1DynamicFwd_1x1>(miopenConvolutionAlgoImplicitGEMM),
+
+    Conv<ConvHipImplicitGemmForwardV4R4Xdlops>(miopenConvolutionAlgoImplicitGEMM),
+
+    Conv<ConvAsmImplicitGemmV4R1DynamicBwd>(miopenConvolutionAlgoImplicitGEMM),
+
+    Conv<ConvAsmImplicitGemmV4R1DynamicWrw>(miopenConvolutionAlgoImplicitGEMM),
+
+    Conv<ConvMPBidirectWinograd<2, 3>>(miopenConvolutionAlgoWinograd),
+    Conv<ConvMPBidirectWinograd<3, 3>>(miopenConvolutionAlgoWinograd),
+    Conv<ConvMPBidirectWinograd<4, 3>>(miopenConvolutionAlgoWinograd),
+    Conv<ConvMPBidirectWinograd<5, 3>>(miopenConvolutionAlgoWinograd),
+    Conv<ConvMPBidirectWinograd<6, 3>>(miopenConvolutionAlgoWinograd),
+
+    Conv<ConvAsmImplicitGemmGTCDynamicWrwXdlops>(miopenConvolutionAlgoImplicitGEMM),
+    Conv<ConvHipImplicitGemmWrwV4R4Xdlops>(miopenConvolutionAlgoImplicitGEMM),
+
+    Conv<ConvAsmImplicitGemmGTCDynamicFwdXdlops>(miopenConvolutionAlgoImplicitGEMM),
+
+    Conv<ConvMPBidirectWinograd_xdlops<2, 3>>(miopenConvolutionAlgoWinograd),
+    Conv<ConvMPBidirectWinograd_xdlops<3, 3>>(miopenConvolutionAlgoWinograd),
+    Conv<ConvMPBidirectWinograd_xdlops<4, 3>>(miopenConvolutionAlgoWinograd),
+    Conv<ConvMPBidirectWinograd_xdlops<5, 3>>(miopenConvolutionAlgoWinograd),
+    Conv<ConvMPBidirectWinograd_xdlops<6, 3>>(miopenConvolutionAlgoWinograd),
+
+    Conv<ConvHipImplicitGemmForwardV4R5Xdlops>(miopenConvolutionAlgoImplicitGEMM),
+
+    Conv<ConvHipImplicitGemmForwardV4R4Xdlops_Padded_Gemm>(miopenConvolutionAlgoImplicitGEMM),
+
+    Conv<ConvAsmImplicitGemmGTCDynamicBwdXdlops>(miopenConvolutionAlgoImplicitGEMM),
+    Conv<ConvHipImplicitGemmWrwV4R4Xdlops_Padded_Gemm>(miopenConvolutionAlgoImplicitGEMM),
+    Conv<ConvBinWinogradRxSf2x3g1>(miopenConvolutionAlgoWinograd),
+
+    Conv<ConvDirectNaiveConvFwd>(miopenConvolutionAlgoDirect),
+    Conv<ConvDirectNaiveConvBwd>(miopenConvolutionAlgoDirect),
+    Conv<ConvDirectNaiveConvWrw>(miopenConvolutionAlgoDirect),
+
+    Conv<GemmFwd1x1_0_1>(miopenConvolutionAlgoGEMM),
+    Conv<GemmFwd1x1_0_1_int8>(miopenConvolutionAlgoGEMM),
+    Conv<GemmFwd1x1_0_2>(miopenConvolutionAlgoGEMM),
+    Conv<GemmFwdRest>(miopenConvolutionAlgoGEMM),
+
+    Removed(), // removed solver ConvHipImplicitGemmMlirCppFwd
+    Removed(), // removed solver ConvHipImplicitGemmMlirCppBwd
+    Removed(), // removed solver ConvHipImplicitGemmMlirCppWrW
+
+    Conv<GemmBwd1x1_stride2>(miopenConvolutionAlgoGEMM),
+    Conv<GemmBwd1x1_stride1>(miopenConvolutionAlgoGEMM),
+    Conv<GemmBwdRest>(miopenConvolutionAlgoGEMM),
+
+    Conv<ConvMlirIgemmFwd>(miopenConvolutionAlgoImplicitGEMM),
+    Conv<ConvMlirIgemmBwd>(miopenConvolutionAlgoImplicitGEMM),
+    Conv<ConvMlirIgemmWrW>(miopenConvolutionAlgoImplicitGEMM),
+
+    Conv<GemmWrw1x1_stride1>(miopenConvolutionAlgoGEMM),
+    Conv<GemmWrwUniversal>(miopenConvolutionAlgoGEMM),
+
+    Conv<ConvMlirIgemmFwdXdlops>(miopenConvolutionAlgoImplicitGEMM),
+    Conv<ConvMlirIgemmBwdXdlops>(miopenConvolutionAlgoImplicitGEMM),
+    Conv<ConvMlirIgemmWrWXdlops>(miopenConvolutionAlgoImplicitGEMM),
+
+    WithoutSolver<activ::ActivFwdSolver0>(Primitive::Activation),
+
+    Conv<ConvAsmImplicitGemmGTCDynamicFwdXdlopsNHWC>(miopenConvolutionAlgoImplicitGEMM),
+    Conv<ConvAsmImplicitGemmGTCDynamicBwdXdlopsNHWC>(miopenConvolutionAlgoImplicitGEMM),
+
+    WithoutSolver<activ::ActivFwdSolver1>(Primitive::Activation),
+    Conv<ConvAsmImplicitGemmGTCDynamicWrwXdlopsNHWC>(miopenConvolutionAlgoImplicitGEMM),
+
+    WithoutSolver<activ::ActivBwdSolver0>(Primitive::Activation),
+    WithoutSolver<activ::ActivBwdSolver1>(Primitive::Activation),
+
+    WithoutSolver<batchnorm::BnFwdTrainingSpatialSingle>(Primitive::Batchnorm),
+
+    Conv<ConvCkIgemmFwdV6r1DlopsNchw>(miopenConvolutionAlgoImplicitGEMM),
+
+    WithoutSolver<batchnorm::BnFwdTrainingSpatialMultiple>(Primitive::Batchnorm),
+
+    WithoutSolver<batchnorm::BnFwdTrainingPerActivation>(Primitive::Batchnorm),
+
+    WithoutSolver<batchnorm::BnBwdTrainingSpatialSingle>(Primitive::Batchnorm),
+    WithoutSolver<batchnorm::BnBwdTrainingSpatialMultiple>(Primitive::Batchnorm),
+    WithoutSolver<batchnorm::BnBwdTrainingPerActivation>(Primitive::Batchnorm),
+
+    WithoutSolver<batchnorm::BnFwdInference>(Primitive::Batchnorm),
+
+    WithoutSolver<pooling::PoolingForward2d>(Primitive::Pooling),
+    WithoutSolver<pooling::PoolingForwardNd>(Primitive::Pooling),
+
+    WithoutSolver<pooling::TransposedPoolingFwd2d>(Primitive::Pooling),
+    WithoutSolver<pooling::TransposedPoolingFwdNd>(Primitive::Pooling),
+
+    WithoutSolver<pooling::PoolingBackward2d>(Primitive::Pooling),
+    WithoutSolver<pooling::PoolingBackwardNd>(Primitive::Pooling),
+
+    Conv<ConvAsmImplicitGemmGTCDynamicFwdDlopsNCHWC>(miopenConvolutionAlgoImplicitGEMM),
+    Conv<ConvHipImplicitGemmFwdXdlops>(miopenConvolutionAlgoImplicitGEMM),
+    Conv<ConvHipImplicitGemmBwdXdlops>(miopenConvolutionAlgoImplicitGEMM),
+    WithoutSolver<solver::fusion::ConvBinWinogradRxSFused>(Primitive::Fusion,
+                                                           miopenConvolutionAlgoWinograd),
+    WithoutSolver<solver::fusion::ConvBinWinogradRxSf2x3g1Fused>(Primitive::Fusion,
+                                                                 miopenConvolutionAlgoWinograd),
+    WithoutSolver<solver::fusion::BnFwdInferActivationFused>(Primitive::Fusion),
+    WithoutSolver<solver::fusion::BnFwdTrgActivationFused>(Primitive::Fusion),
+    WithoutSolver<solver::fusion::BnBwdTrgActivationFused>(Primitive::Fusion),
+    WithoutSolver<solver::fusion::ConvCKIgemmFwdBiasActivFused>(Primitive::Fusion,
+                                                                miopenConvolutionAlgoImplicitGEMM),
+    WithoutSolver<activ::ActivFwdSolverHost>(Primitive::Activation),
+    WithoutSolver<activ::ActivBwdSolverHost>(Primitive::Activation),
+    WithoutSolver<batchnorm::BnFwdTrainingHost>(Primitive::Batchnorm),
+    WithoutSolver<batchnorm::BnBwdTrainingHost>(Primitive::Batchnorm),
+    WithoutSolver<batchnorm::BnFwdInferenceHost>(Primitive::Batchnorm),
+    WithoutSolver<pooling::PoolingForwardHost>(Primitive::Pooling),
+    WithoutSolver<pooling::PoolingBackwardHost>(Primitive::Pooling),
+    Conv<ConvDirectHost>(miopenConvolutionAlgoDirect),
+    Conv<ConvGemmHost>(miopenConvolutionAlgoGEMM),
+    // IMPORTANT: New solvers should be added to the end of the table!
+};
+
+constexpr std::size_t id_registry_size = sizeof(id_registry) / sizeof(id_registry[0]);
+
+static const IdRegistryEntry* FindEntry(uint64_t value)
 {
-    return ConvolutionAlgoToDirectionalString(GetAlgo(), dir);
+    if(value == Id::invalid_value || value > id_registry_size)
+        return nullptr;
+    const auto& entry = id_registry[value - 1];
+    return entry.IsRegistered() ? &entry : nullptr;
 }
 
-Primitive Id::GetPrimitive() const
+static const IdRegistryEntry& GetEntry(uint64_t value)
 {
-    const auto it = IdRegistry().value_to_entry.find(value);
-    if(it == IdRegistry().value_to_entry.end())
+    const auto entry = FindEntry(value);
+    if(entry == nullptr)
         MIOPEN_THROW(miopenStatusInternalError);
-    return it->second.primitive;
+    return *entry;
 }
 
-miopenConvAlgorithm_t Id::GetAlgo() const
+/// Name lookups need the names of all the solvers, so they are collected on the first one.
+static const std::unordered_map<std::string, uint64_t>& GetIdsByName()
 {
-    const auto it = IdRegistry().value_to_entry.find(value);
-    if(it == IdRegistry().value_to_entry.end())
-        MIOPEN_THROW(miopenStatusInternalError);
-    return it->second.convAlgo;
+    static const auto ids = [] {
+        TraceScope trace{"Solver registry: names"};
+        auto result = std::unordered_map<std::string, uint64_t>{};
+        for(uint64_t value = 1; value <= id_registry_size; ++value)
+        {
+            const auto entry = FindEntry(value);
+            if(entry == nullptr)
+                continue;
+            const auto& str = entry->str_value();
+            const auto it   = result.find(str);
+            if(it != result.end())
+            {
+                MIOPEN_LOG_E("Registered duplicate ids: [" << value << "]" << str << " and ["
+                                                           << it->second << "]" << it->first);
+                continue;
+            }
+            result.emplace(str, value);
+        }
+        return result;
+    }();
+    return ids;
 }
 
-inline bool
-Register(IdRegistryData& registry, uint64_t value, Primitive primitive, const std::string& str)
+const std::vector<Id>& GetSolversByPrimitive(Primitive primitive)
 {
-    if(value == Id::invalid_value)
-    {
-        MIOPEN_LOG_E(Id::invalid_value << " is special id value for invalid solver (" << str
-                                       << ")");
-        return false;
-    }
+    static const auto ids_by_primitive = [] {
+        TraceScope trace{"Solver registry: primitives"};
+        auto result = std::unordered_map<Primitive, std::vector<Id>>{};
+        for(uint64_t value = 1; value <= id_registry_size; ++value)
+        {
+            const auto entry = FindEntry(value);
+            if(entry != nullptr)
+                result[entry->primitive].emplace_back(ForceInit{}, value);
+        }
+        return result;
+    }();
 
-    if(registry.value_to_entry.find(value) != registry.value_to_entry.end())
-    {
-        MIOPEN_LOG_E("Registered duplicate ids: ["
-                     << value << "]" << str << " and ["
-                     << registry.value_to_entry.find(value)->first << "]"
-                     << registry.value_to_entry.find(value)->second.str_value);
-        return false;
-    }
+    static const auto empty = std::vector<Id>{};
+    const auto it           = ids_by_primitive.find(primitive);
+    return it != ids_by_primitive.end() ? it->second : empty;
+}
 
-    if(registry.str_to_value.find(str) != registry.str_to_value.end())
-    {
-        MIOPEN_LOG_E("Registered duplicate ids: [" << value << "]" << str << " and ["
-                                                   << registry.str_to_value.find(str)->second << "]"
-                                                   << registry.str_to_value.find(str)->first);
-        return false;
-    }
+Id::Id(uint64_t value_) : value(value_) { is_valid = FindEntry(value) != nullptr; }
 
-    auto entry      = IdRegistryEntry{};
-    entry.str_value = str;
-    entry.primitive = {primitive};
+Id::Id(ForceInit, uint64_t value_) : value(value_), is_valid(true) {}
 
-    registry.value_to_entry.emplace(value, std::move(entry));
-    registry.str_to_value.emplace(str, value);
-    registry.primitive_to_ids[primitive].emplace_back(ForceInit{}, value);
-    return true;
-}
+Id::Id(const std::string& str) : Id(str.c_str()) {}
 
-inline bool Register(IdRegistryData& registry,
-                     uint64_t value,
-                     Primitive primitive,
-                     const std::string& str,
-                     miopenConvAlgorithm_t algo)
+Id::Id(const char* str)
 {
-    if(!Register(registry, value, primitive, str))
-        return false;
-    registry.value_to_entry.at(value).convAlgo = algo;
-    return true;
+    const auto& ids = GetIdsByName();
+    const auto it   = ids.find(str);
+    is_valid        = (it != ids.end());
+    value           = is_valid ? it->second : invalid_value;
 }
 
-inline bool Register(IdRegistryData& registry,
-                     uint64_t value,
-                     const std::string& str,
-                     miopenConvAlgorithm_t algo)
+std::string Id::ToString() const
 {
-    if(!Register(registry, value, Primitive::Convolution, str))
-        return false;
-    registry.value_to_entry.at(value).convAlgo = algo;
-    return true;
+    if(!IsValid())
+        return "INVALID_SOLVER_ID_" + std::to_string(value);
+    return GetEntry(value).str_value();
 }
 
-template <class TSolver>
-inline void
-RegisterWithSolver(IdRegistryData& registry, uint64_t value, TSolver, miopenConvAlgorithm_t algo)
+AnySolver Id::GetSolver() const
 {
-    if(!Register(registry, value, TSolver{}.SolverDbId(), algo))
-        return;
-    registry.value_to_entry.at(value).solver = TSolver{};
+    struct LazySolver
+    {
+        std::once_flag once;
+        AnySolver solver;
+    };
+    // NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
+    static LazySolver solvers[id_registry_size];
+
+    const auto entry = FindEntry(value);
+    if(entry == nullptr || entry->make_solver == nullptr)
+        return {};
+
+    auto& lazy = solvers[value - 1];
+    std::call_once(lazy.once, [&]() { lazy.solver = entry->make_solver(); });
+    return lazy.solver;
 }
 
-inline SolverRegistrar::SolverRegistrar(IdRegistryData& registry)
+std::string Id::GetAlgo(conv::Direction dir) const
 {
-    // When solver gets removed its registration line should be replaced with ++id to keep
-    // backwards compatibility. New solvers should only be added to the end of list unless it is
-    // intended to reuse an id of a removed solver.
-
-    uint64_t id = 0; // 0 is reserved for invalid value.
-
-    // IMPORTANT: New solvers should be added to the end of the function!
-    RegisterWithSolver(registry, ++id, ConvAsm3x3U{}, miopenConvolutionAlgoDirect);
-    RegisterWithSolver(registry, ++id, ConvAsm1x1U{}, miopenConvolutionAlgoDirect);
-    RegisterWithSolver(registry, ++id, ConvAsm1x1UV2{}, miopenConvolutionAlgoDirect);
-    Register(registry,
-             ++id,
-             Primitive::Fusion,
-             solver::fusion::ConvBiasActivAsm1x1U{}.SolverDbId(),
-             miopenConvolutionAlgoDirect);
-    RegisterWithSolver(registry, ++id, ConvAsm5x10u2v2f1{}, miopenConvolutionAlgoDirect);
-    RegisterWithSolver(registry, ++id, ConvAsm5x10u2v2b1{}, miopenConvolutionAlgoDirect);
-    RegisterWithSolver(
-        registry, ++id, ConvAsm7x7c3h224w224k64u2v2p3q3f1{}, miopenConvolutionAlgoDirect);
-    RegisterWithSolver(registry, ++id, ConvOclDirectFwd11x11{}, miopenConvolutionAlgoDirect);
-    RegisterWithSolver(registry, ++id, ConvOclDirectFwdGen{}, miopenConvolutionAlgoDirect);
-    ++id; // removed ConvOclDirectFwd3x3
-    RegisterWithSolver(registry, ++id, ConvOclDirectFwd{}, miopenConvolutionAlgoDirect);
-    Register(registry,
-             ++id,
-             Primitive::Fusion,
-             solver::fusion::ConvOclDirectFwdFused{}.SolverDbId(),
-             miopenConvolutionAlgoDirect);
-    RegisterWithSolver(registry, ++id, ConvOclDirectFwd1x1{}, miopenConvolutionAlgoDirect);
-    RegisterWithSolver(registry, ++id, ConvBinWinograd3x3U{}, miopenConvolutionAlgoWinograd);
-    RegisterWithSolver(registry, ++id, ConvBinWinogradRxS{}, miopenConvolutionAlgoWinograd);
-    RegisterWithSolver(registry, ++id, ConvAsmBwdWrW3x3{}, miopenConvolutionAlgoDirect);
-    RegisterWithSolver(registry, ++id, ConvAsmBwdWrW1x1{}, miopenConvolutionAlgoDirect);
-    RegisterWithSolver(registry, ++id, ConvOclBwdWrW2<1>{}, miopenConvolutionAlgoDirect);
-    RegisterWithSolver(registry, ++id, ConvOclBwdWrW2<2>{}, miopenConvolutionAlgoDirect);
-    RegisterWithSolver(registry, ++id, ConvOclBwdWrW2<4>{}, miopenConvolutionAlgoDirect);
-    RegisterWithSolver(registry, ++id, ConvOclBwdWrW2<8>{}, miopenConvolutionAlgoDirect);
-    RegisterWithSolver(registry, ++id, ConvOclBwdWrW2<16>{}, miopenConvolutionAlgoDirect);
-    RegisterWithSolver(registry, ++id, ConvOclBwdWrW2NonTunable{}, miopenConvolutionAlgoDirect);
-    RegisterWithSolver(registry, ++id, ConvOclBwdWrW53{}, miopenConvolutionAlgoDirect);
-    RegisterWithSolver(registry, ++id, ConvOclBwdWrW1x1{}, miopenConvolutionAlgoDirect);
-    RegisterWithSolver(
-        registry, ++id, ConvHipImplicitGemmV4R1Fwd{}, miopenConvolutionAlgoImplicitGEMM);
-    ++id; // removed solver ConvHipImplicitGemmV4Fwd
-    ++id; // removed solver ConvHipImplicitGemmV4_1x1
-    ++id; // removed solver ConvHipImplicitGemmV4R4FwdXdlops
-    ++id; // removed solver ConvHipImplicitGemmV4R4Xdlops_1x1
-    RegisterWithSolver(
-        registry, ++id, ConvHipImplicitGemmV4R1WrW{}, miopenConvolutionAlgoImplicitGEMM);
-    ++id; // removed solver ConvHipImplicitGemmV4WrW
-
-    // Several ids w/o solver for immediate mode
-    ++id; // old gemm pseudo-solverid
-
-    RegisterWithSolver(registry, ++id, fft{}, miopenConvolutionAlgoFFT);
-
-    RegisterWithSolver(
-        registry, ++id, ConvWinograd3x3MultipassWrW<3, 4>{}, miopenConvolutionAlgoWinograd);
-    ++id; // Id for ConvSCGemmFGemm.
-    RegisterWithSolver(registry, ++id, ConvBinWinoRxS<3, 2>{}, miopenConvolutionAlgoWinograd);
-    RegisterWithSolver(
-        registry, ++id, ConvWinograd3x3MultipassWrW<3, 5>{}, miopenConvolutionAlgoWinograd);
-    RegisterWithSolver(
-        registry, ++id, ConvWinograd3x3MultipassWrW<3, 6>{}, miopenConvolutionAlgoWinograd);
-    RegisterWithSolver(
-        registry, ++id, ConvWinograd3x3MultipassWrW<3, 2>{}, miopenConvolutionAlgoWinograd);
-    RegisterWithSolver(
-        registry, ++id, ConvWinograd3x3MultipassWrW<3, 3>{}, miopenConvolutionAlgoWinograd);
-    RegisterWithSolver(
-        registry, ++id, ConvWinograd3x3MultipassWrW<7, 2>{}, miopenConvolutionAlgoWinograd);
-    RegisterWithSolver(
-        registry, ++id, ConvWinograd3x3MultipassWrW<7, 3>{}, miopenConvolutionAlgoWinograd);
-    RegisterWithSolver(
-        registry, ++id, ConvWinograd3x3MultipassWrW<7, 2, 1, 1>{}, miopenConvolutionAlgoWinograd);
-    RegisterWithSolver(
-        registry, ++id, ConvWinograd3x3MultipassWrW<7, 3, 1, 1>{}, miopenConvolutionAlgoWinograd);
-    RegisterWithSolver(
-        registry, ++id, ConvWinograd3x3MultipassWrW<1, 1, 7, 2>{}, miopenConvolutionAlgoWinograd);
-    RegisterWithSolver(
-        registry, ++id, ConvWinograd3x3MultipassWrW<1, 1, 7, 3>{}, miopenConvolutionAlgoWinograd);
-    RegisterWithSolver(
-        registry, ++id, ConvWinograd3x3MultipassWrW<5, 3>{}, miopenConvolutionAlgoWinograd);
-    RegisterWithSolver(
-        registry, ++id, ConvWinograd3x3MultipassWrW<5, 4>{}, miopenConvolutionAlgoWinograd);
-
-    ++id; // removed solver ConvHipImplicitGemmV4R4WrWXdlops
-    ++id; // removed solver ConvHipImplicitGemmV4R4GenFwdXdlops
-    ++id; // removed solver ConvHipImplicitGemmV4R4GenWrWXdlops
-
-    RegisterWithSolver(registry, ++id, ConvBinWinoRxS<2, 3>{}, miopenConvolutionAlgoWinograd);
-
-    RegisterWithSolver(
-        registry, ++id, ConvHipImplicitGemmV4R4Fwd{}, miopenConvolutionAlgoImplicitGEMM);
-
-    RegisterWithSolver(
-        registry, ++id, ConvHipImplicitGemmBwdDataV1R1{}, miopenConvolutionAlgoImplicitGEMM);
-    RegisterWithSolver(
-        registry, ++id, ConvHipImplicitGemmBwdDataV4R1{}, miopenConvolutionAlgoImplicitGEMM);
-
-    RegisterWithSolver(
-        registry, ++id, ConvHipImplicitGemmBwdDataV1R1Xdlops{}, miopenConvolutionAlgoImplicitGEMM);
-
-    ++id; // removed solver ConvHipImplicitGemmV4R4GenXdlopsFwdFp32
-    ++id; // removed solver ConvHipImplicitGemmV4R4GenXdlopsWrWFp32
-
-    RegisterWithSolver(
-        registry, ++id, ConvHipImplicitGemmBwdDataV4R1Xdlops{}, miopenConvolutionAlgoImplicitGEMM);
-
-    RegisterWithSolver(
-        registry, ++id, ConvHipImplicitGemmV4R4WrW{}, miopenConvolutionAlgoImplicitGEMM);
-
-    RegisterWithSolver(
-        registry, ++id, ConvAsmImplicitGemmV4R1DynamicFwd{}, miopenConvolutionAlgoImplicitGEMM);
-
-    RegisterWithSolver(
-        registry, ++id, ConvAsmImplicitGemmV4R1DynamicFwd_1x1{}, miopenConvolutionAlgoImplicitGEMM);
-
-    RegisterWithSolver(
-        registry, ++id, ConvHipImplicitGemmForwardV4R4Xdlops{}, miopenConvolutionAlgoImplicitGEMM);
-
-    RegisterWithSolver(
-        registry, ++id, ConvAsmImplicitGemmV4R1DynamicBwd{}, miopenConvolutionAlgoImplicitGEMM);
-
-    RegisterWithSolver(
-        registry, ++id, ConvAsmImplicitGemmV4R1DynamicWrw{}, miopenConvolutionAlgoImplicitGEMM);
-
-    RegisterWithSolver(
-        registry, ++id, ConvMPBidirectWinograd<2, 3>{}, miopenConvolutionAlgoWinograd);
-    RegisterWithSolver(
-        registry, ++id, ConvMPBidirectWinograd<3, 3>{}, miopenConvolutionAlgoWinograd);
-    RegisterWithSolver(
-        registry, ++id, ConvMPBidirectWinograd<4, 3>{}, miopenConvolutionAlgoWinograd);
-    RegisterWithSolver(
-        registry, ++id, ConvMPBidirectWinograd<5, 3>{}, miopenConvolutionAlgoWinograd);
-    RegisterWithSolver(
-        registry, ++id, ConvMPBidirectWinograd<6, 3>{}, miopenConvolutionAlgoWinograd);
-
-    RegisterWithSolver(registry,
-                       ++id,
-                       ConvAsmImplicitGemmGTCDynamicWrwXdlops{},
-                       miopenConvolutionAlgoImplicitGEMM);
-    RegisterWithSolver(
-        registry, ++id, ConvHipImplicitGemmWrwV4R4Xdlops{}, miopenConvolutionAlgoImplicitGEMM);
-
-    RegisterWithSolver(registry,
-                       ++id,
-                       ConvAsmImplicitGemmGTCDynamicFwdXdlops{},
-                       miopenConvolutionAlgoImplicitGEMM);
-
-    RegisterWithSolver(
-        registry, ++id, ConvMPBidirectWinograd_xdlops<2, 3>{}, miopenConvolutionAlgoWinograd);
-    RegisterWithSolver(
-        registry, ++id, ConvMPBidirectWinograd_xdlops<3, 3>{}, miopenConvolutionAlgoWinograd);
-    RegisterWithSolver(
-        registry, ++id, ConvMPBidirectWinograd_xdlops<4, 3>{}, miopenConvolutionAlgoWinograd);
-    RegisterWithSolver(
-        registry, ++id, ConvMPBidirectWinograd_xdlops<5, 3>{}, miopenConvolutionAlgoWinograd);
-    RegisterWithSolver(
-        registry, ++id, ConvMPBidirectWinograd_xdlops<6, 3>{}, miopenConvolutionAlgoWinograd);
-
-    RegisterWithSolver(
-        registry, ++id, ConvHipImplicitGemmForwardV4R5Xdlops{}, miopenConvolutionAlgoImplicitGEMM);
-
-    RegisterWithSolver(registry,
-                       ++id,
-                       ConvHipImplicitGemmForwardV4R4Xdlops_Padded_Gemm{},
-                       miopenConvolutionAlgoImplicitGEMM);
-
-    RegisterWithSolver(registry,
-                       ++id,
-                       ConvAsmImplicitGemmGTCDynamicBwdXdlops{},
-                       miopenConvolutionAlgoImplicitGEMM);
-    RegisterWithSolver(registry,
-                       ++id,
-                       ConvHipImplicitGemmWrwV4R4Xdlops_Padded_Gemm{},
-                       miopenConvolutionAlgoImplicitGEMM);
-    RegisterWithSolver(registry, ++id, ConvBinWinogradRxSf2x3g1{}, miopenConvolutionAlgoWinograd);
-
-    RegisterWithSolver(registry, ++id, ConvDirectNaiveConvFwd{}, miopenConvolutionAlgoDirect);
-    RegisterWithSolver(registry, ++id, ConvDirectNaiveConvBwd{}, miopenConvolutionAlgoDirect);
-    RegisterWithSolver(registry, ++id, ConvDirectNaiveConvWrw{}, miopenConvolutionAlgoDirect);
-
-    RegisterWithSolver(registry, ++id, GemmFwd1x1_0_1{}, miopenConvolutionAlgoGEMM);
-    RegisterWithSolver(registry, ++id, GemmFwd1x1_0_1_int8{}, miopenConvolutionAlgoGEMM);
-    RegisterWithSolver(registry, ++id, GemmFwd1x1_0_2{}, miopenConvolutionAlgoGEMM);
-    RegisterWithSolver(registry, ++id, GemmFwdRest{}, miopenConvolutionAlgoGEMM);
-
-    ++id; // removed solver ConvHipImplicitGemmMlirCppFwd
-    ++id; // removed solver ConvHipImplicitGemmMlirCppBwd
-    ++id; // removed solver ConvHipImplicitGemmMlirCppWrW
-
-    RegisterWithSolver(registry, ++id, GemmBwd1x1_stride2{}, miopenConvolutionAlgoGEMM);
-    RegisterWithSolver(registry, ++id, GemmBwd1x1_stride1{}, miopenConvolutionAlgoGEMM);
-    RegisterWithSolver(registry, ++id, GemmBwdRest{}, miopenConvolutionAlgoGEMM);
-
-    RegisterWithSolver(registry, ++id, ConvMlirIgemmFwd{}, miopenConvolutionAlgoImplicitGEMM);
-    RegisterWithSolver(registry, ++id, ConvMlirIgemmBwd{}, miopenConvolutionAlgoImplicitGEMM);
-    RegisterWithSolver(registry, ++id, ConvMlirIgemmWrW{}, miopenConvolutionAlgoImplicitGEMM);
-
-    RegisterWithSolver(registry, ++id, GemmWrw1x1_stride1{}, miopenConvolutionAlgoGEMM);
-    RegisterWithSolver(registry, ++id, GemmWrwUniversal{}, miopenConvolutionAlgoGEMM);
-
-    RegisterWithSolver(registry, ++id, ConvMlirIgemmFwdXdlops{}, miopenConvolutionAlgoImplicitGEMM);
-    RegisterWithSolver(registry, ++id, ConvMlirIgemmBwdXdlops{}, miopenConvolutionAlgoImplicitGEMM);
-    RegisterWithSolver(registry, ++id, ConvMlirIgemmWrWXdlops{}, miopenConvolutionAlgoImplicitGEMM);
-
-    Register(registry, ++id, Primitive::Activation, activ::ActivFwdSolver0{}.SolverDbId());
-
-    RegisterWithSolver(registry,
-                       ++id,
-                       ConvAsmImplicitGemmGTCDynamicFwdXdlopsNHWC{},
-                       miopenConvolutionAlgoImplicitGEMM);
-    RegisterWithSolver(registry,
-                       ++id,
-                       ConvAsmImplicitGemmGTCDynamicBwdXdlopsNHWC{},
-                       miopenConvolutionAlgoImplicitGEMM);
-
-    Register(registry, ++id, Primitive::Activation, activ::ActivFwdSolver1{}.SolverDbId());
-    RegisterWithSolver(registry,
-                       ++id,
-                       ConvAsmImplicitGemmGTCDynamicWrwXdlopsNHWC{},
-                       miopenConvolutionAlgoImplicitGEMM);
-
-    Register(registry, ++id, Primitive::Activation, activ::ActivBwdSolver0{}.SolverDbId());
-    Register(registry, ++id, Primitive::Activation, activ::ActivBwdSolver1{}.SolverDbId());
-
-    Register(
-        registry, ++id, Primitive::Batchnorm, batchnorm::BnFwdTrainingSpatialSingle{}.SolverDbId());
-
-    RegisterWithSolver(
-        registry, ++id, ConvCkIgemmFwdV6r1DlopsNchw{}, miopenConvolutionAlgoImplicitGEMM);
-
-    Register(registry,
-             ++id,
-             Primitive::Batchnorm,
-             batchnorm::BnFwdTrainingSpatialMultiple{}.SolverDbId());
-
-    Register(
-        registry, ++id, Primitive::Batchnorm, batchnorm::BnFwdTrainingPerActivation{}.SolverDbId());
-
-    Register(
-        registry, ++id, Primitive::Batchnorm, batchnorm::BnBwdTrainingSpatialSingle{}.SolverDbId());
-    Register(registry,
-             ++id,
-             Primitive::Batchnorm,
-             batchnorm::BnBwdTrainingSpatialMultiple{}.SolverDbId());
-    Register(
-        registry, ++id, Primitive::Batchnorm, batchnorm::BnBwdTrainingPerActivation{}.SolverDbId());
-
-    Register(registry, ++id, Primitive::Batchnorm, batchnorm::BnFwdInference{}.SolverDbId());
-
-    Register(registry, ++id, Primitive::Pooling, pooling::PoolingForward2d{}.SolverDbId());
-    Register(registry, ++id, Primitive::Pooling, pooling::PoolingForwardNd{}.SolverDbId());
-
-    Register(registry, ++id, Primitive::Pooling, pooling::TransposedPoolingFwd2d{}.SolverDbId());
-    Register(registry, ++id, Primitive::Pooling, pooling::TransposedPoolingFwdNd{}.SolverDbId());
-
-    Register(registry, ++id, Primitive::Pooling, pooling::PoolingBackward2d{}.SolverDbId());
-    Register(registry, ++id, Primitive::Pooling, pooling::PoolingBackwardNd{}.SolverDbId());
-
-    RegisterWithSolver(registry,
-                       ++id,
-                       ConvAsmImplicitGemmGTCDynamicFwdDlopsNCHWC{},
-                       miopenConvolutionAlgoImplicitGEMM);
-    RegisterWithSolver(
-        registry, ++id, ConvHipImplicitGemmFwdXdlops{}, miopenConvolutionAlgoImplicitGEMM);
-    RegisterWithSolver(
-        registry, ++id, ConvHipImplicitGemmBwdXdlops{}, miopenConvolutionAlgoImplicitGEMM);
-    Register(registry,
-             ++id,
-             Primitive::Fusion,
-             solver::fusion::ConvBinWinogradRxSFused{}.SolverDbId(),
-             miopenConvolutionAlgoWinograd);
-    Register(registry,
-             ++id,
-             Primitive::Fusion,
-             solver::fusion::ConvBinWinogradRxSf2x3g1Fused{}.SolverDbId(),
-             miopenConvolutionAlgoWinograd);
-    Register(registry,
-             ++id,
-             Primitive::Fusion,
-             solver::fusion::BnFwdInferActivationFused{}.SolverDbId());
-    Register(
-        registry, ++id, Primitive::Fusion, solver::fusion::BnFwdTrgActivationFused{}.SolverDbId());
-    Register(
-        registry, ++id, Primitive::Fusion, solver::fusion::BnBwdTrgActivationFused{}.SolverDbId());
-    Register(registry,
-             ++id,
-             Primitive::Fusion,
-             solver::fusion::ConvCKIgemmFwdBiasActivFused{}.SolverDbId(),
-             miopenConvolutionAlgoImplicitGEMM);
-    // IMPORTANT: New solvers should be added to the end of the function!
+    return ConvolutionAlgoToDirectionalString(GetAlgo(), dir);
 }
 
+Primitive Id::GetPrimitive() const { return GetEntry(value).primitive; }
+
+miopenConvAlgorithm_t Id::GetAlgo() const { return GetEntry(value).convAlgo; }
+
 bool ThisSolverIsDeprecatedStatic::IsDisabled(const ConvolutionContext& ctx)
 {
     static const bool device_is_allowed = [&]() {
@@ -0,0 +1,228 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/activ/solvers.hpp>
+
+#include <miopen/activ/invoke_params.hpp>
+#include <miopen/solver/host.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+
+namespace miopen {
+
+namespace solver {
+
+namespace activ {
+
+namespace {
+
+/// Calls f with the element-wise forward function of the mode, so that the dispatch is done
+/// once per call and the row loops below are specialized per mode.
+template <class F>
+void VisitForward(miopenActivationMode_t mode, float alpha, float beta, float gamma, F f)
+{
+    switch(mode)
+    {
+    case miopenActivationPASTHRU: f([](float x) { return x; }); break;
+    case miopenActivationLOGISTIC: f([](float x) { return 1.f / (1.f + std::exp(-x)); }); break;
+    case miopenActivationTANH: f([=](float x) { return beta * std::tanh(alpha * x); }); break;
+    case miopenActivationRELU: f([](float x) { return x > 0.f ? x : 0.f; }); break;
+    case miopenActivationSOFTRELU: f([](float x) { return std::log1p(std::exp(x)); }); break;
+    case miopenActivationABS: f([](float x) { return std::abs(x); }); break;
+    case miopenActivationPOWER:
+        f([=](float x) {
+            const auto v = alpha + beta * x;
+            return v <= std::numeric_limits<float>::epsilon() ? 0.f : std::pow(v, gamma);
+        });
+        break;
+    case miopenActivationCLIPPEDRELU:
+        f([=](float x) { return std::min(alpha, std::max(0.f, x)); });
+        break;
+    case miopenActivationLEAKYRELU: f([=](float x) { return x > 0.f ? x : alpha * x; }); break;
+    case miopenActivationELU:
+        f([=](float x) { return x > 0.f ? x : alpha * std::expm1(x); });
+        break;
+    default: MIOPEN_THROW(miopenStatusBadParm, "Unsupported activation mode");
+    }
+}
+
+/// Same as VisitForward for the gradient, g(dy, x, y) -> dx. It follows the GPU kernels,
+/// including POWER not being scaled by dy.
+template <class F>
+void VisitBackward(miopenActivationMode_t mode, float alpha, float beta, float gamma, F f)
+{
+    switch(mode)
+    {
+    case miopenActivationPASTHRU: f([](float dy, float, float) { return dy; }); break;
+    case miopenActivationLOGISTIC:
+        f([](float dy, float, float y) { return dy * y * (1.f - y); });
+        break;
+    case miopenActivationTANH:
+        f([=](float dy, float, float y) { return dy * alpha * (beta - y * y / beta); });
+        break;
+    case miopenActivationRELU:
+        f([](float dy, float x, float) { return x > 0.f ? dy : 0.f; });
+        break;
+    case miopenActivationSOFTRELU:
+        f([](float dy, float x, float) {
+            const auto e = std::exp(std::min(x, 50.f));
+            return dy * e / (e + 1.f);
+        });
+        break;
+    case miopenActivationABS:
+        f([](float dy, float x, float) { return x > 0.f ? dy : -dy; });
+        break;
+    case miopenActivationPOWER:
+        f([=](float, float x, float y) {
+            const auto v = alpha + beta * x;
+            return v <= std::numeric_limits<float>::epsilon() ? 0.f : gamma * beta * y / v;
+        });
+        break;
+    case miopenActivationCLIPPEDRELU:
+        f([=](float dy, float x, float) { return x > 0.f && x <= alpha ? dy : 0.f; });
+        break;
+    case miopenActivationLEAKYRELU:
+        f([=](float dy, float x, float) { return x > 0.f ? dy : alpha * dy; });
+        break;
+    case miopenActivationELU:
+        f([=](float dy, float x, float y) { return x > 0.f ? dy : dy * (y + alpha); });
+        break;
+    default: MIOPEN_THROW(miopenStatusBadParm, "Unsupported activation mode");
+    }
+}
+
+bool SameLengths(const TensorDescriptor& a, const TensorDescriptor& b)
+{
+    return a.GetLengths() == b.GetLengths();
+}
+
+} // namespace
+
+bool ActivFwdSolverHost::IsApplicable(const ExecutionContext& ctx,
+                                      const miopen::activ::ProblemDescription& problem) const
+{
+    if(!IsHostSolverEnabled(ctx.GetStream()))
+        return false;
+    if(problem.GetDirection() != miopen::activ::Direction::Forward)
+        return false;
+    return IsHostSolverType(problem.GetXDesc()) && IsHostSolverType(problem.GetYDesc()) &&
+           SameLengths(problem.GetXDesc(), problem.GetYDesc());
+}
+
+ConvSolution ActivFwdSolverHost::GetSolution(const ExecutionContext&,
+                                             const miopen::activ::ProblemDescription& problem) const
+{
+    auto result = ConvSolution{miopenStatusSuccess};
+    const auto mode = problem.GetActivDesc().GetMode();
+
+    result.invoker_factory = [=](const std::vector<Kernel>&) {
+        return [=](const Handle&, const AnyInvokeParams& raw_params) {
+            decltype(auto) params = raw_params.CastTo<miopen::activ::InvokeParams>();
+
+            const auto x = static_cast<const float*>(params.x) + params.x_offset;
+            const auto y = static_cast<float*>(params.y) + params.y_offset;
+
+            const auto& lens    = params.x_desc.GetLengths();
+            const auto strides = std::array<const std::vector<std::size_t>*, 2>{
+                &params.x_desc.GetStrides(), &params.y_desc.GetStrides()};
+
+            const auto run = [&](auto activ) {
+                host::ParForEachRow(lens, strides, [&](const auto& off, auto len, const auto& str) {
+                    for(std::size_t i = 0; i < len; ++i)
+                        y[off[1] + i * str[1]] = activ(x[off[0] + i * str[0]]);
+                });
+            };
+
+            const auto alpha = static_cast<float>(params.alpha);
+            const auto beta  = static_cast<float>(params.beta);
+            const auto gamma = static_cast<float>(params.gamma);
+            VisitForward(mode, alpha, beta, gamma, run);
+        };
+    };
+
+    return result;
+}
+
+bool ActivBwdSolverHost::IsApplicable(const ExecutionContext& ctx,
+                                      const miopen::activ::ProblemDescription& problem) const
+{
+    if(!IsHostSolverEnabled(ctx.GetStream()))
+        return false;
+    if(problem.GetDirection() != miopen::activ::Direction::Backward)
+        return false;
+    return IsHostSolverType(problem.GetXDesc()) && IsHostSolverType(problem.GetYDesc()) &&
+           SameLengths(problem.GetXDesc(), problem.GetYDesc());
+}
+
+ConvSolution ActivBwdSolverHost::GetSolution(const ExecutionContext&,
+                                             const miopen::activ::ProblemDescription& problem) const
+{
+    auto result = ConvSolution{miopenStatusSuccess};
+    const auto mode = problem.GetActivDesc().GetMode();
+
+    result.invoker_factory = [=](const std::vector<Kernel>&) {
+        return [=](const Handle&, const AnyInvokeParams& raw_params) {
+            decltype(auto) params = raw_params.CastTo<miopen::activ::BwdInvokeParams>();
+
+            const auto x  = static_cast<const float*>(params.x) + params.x_offset;
+            const auto y  = static_cast<const float*>(params.y) + params.y_offset;
+            const auto dy = static_cast<const float*>(params.dy) + params.dy_offset;
+            const auto dx = static_cast<float*>(params.dx) + params.dx_offset;
+
+            const auto& lens    = params.dx_desc.GetLengths();
+            const auto strides = std::array<const std::vector<std::size_t>*, 4>{
+                &params.dy_desc.GetStrides(),
+                &params.x_desc.GetStrides(),
+                &params.y_desc.GetStrides(),
+                &params.dx_desc.GetStrides()};
+
+            const auto run = [&](auto grad) {
+                host::ParForEachRow(lens, strides, [&](const auto& off, auto len, const auto& str) {
+                    for(std::size_t i = 0; i < len; ++i)
+                        dx[off[3] + i * str[3]] = grad(dy[off[0] + i * str[0]],
+                                                       x[off[1] + i * str[1]],
+                                                       y[off[2] + i * str[2]]);
+                });
+            };
+
+            const auto alpha = static_cast<float>(params.alpha);
+            const auto beta  = static_cast<float>(params.beta);
+            const auto gamma = static_cast<float>(params.gamma);
+            VisitBackward(mode, alpha, beta, gamma, run);
+        };
+    };
+
+    return result;
+}
+
+} // namespace activ
+
+} // namespace solver
+
+} // namespace miopen
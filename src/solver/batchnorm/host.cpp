@@ -0,0 +1,252 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/batchnorm/solvers.hpp>
+
+#include <miopen/batchnorm/host.hpp>
+#include <miopen/batchnorm/invoke_params.hpp>
+#include <miopen/solver/host.hpp>
+
+namespace miopen {
+
+namespace solver {
+
+namespace batchnorm {
+
+namespace {
+
+/// Arguments of the bn_host functions for a packed NC[D]HW or N[D]HWC tensor.
+struct HostShape
+{
+    explicit HostShape(const TensorDescriptor& desc)
+    {
+        const auto& lens = desc.GetLengths();
+        const auto dims  = lens.size();
+        n                = static_cast<int>(lens[0]);
+        c                = static_cast<int>(lens[1]);
+        d                = dims == 5 ? static_cast<int>(lens[2]) : 1;
+        h                = static_cast<int>(lens[dims - 2]);
+        w                = static_cast<int>(lens[dims - 1]);
+        layout           = IsChannelLast(desc) ? miopenTensorNHWC : miopenTensorNCHW;
+    }
+
+    static bool IsChannelLast(const TensorDescriptor& desc)
+    {
+        const auto layout = desc.GetLayout(desc.GetLengths().size() == 4 ? "NCHW" : "NCDHW");
+        return layout == "NHWC" || layout == "NDHWC";
+    }
+
+    int n, c, d, h, w;
+    miopenTensorLayout_t layout;
+};
+
+/// The host functions walk packed activations in one layout. Per-activation statistics are
+/// laid out like one image of the activations, which the API only defines for NC[D]HW.
+bool IsHostApplicable(const ExecutionContext& ctx,
+                      const miopen::batchnorm::ProblemDescription& problem,
+                      const TensorDescriptor& x,
+                      const TensorDescriptor& y,
+                      const TensorDescriptor& scale)
+{
+    if(!IsHostSolverEnabled(ctx.GetStream()))
+        return false;
+    const auto dims = x.GetLengths().size();
+    if(dims != 4 && dims != 5)
+        return false;
+    if(!IsHostSolverType(x) || !IsHostSolverType(y) || !IsHostSolverType(scale))
+        return false;
+    if(!x.IsPacked() || !y.IsPacked() || x.GetLengths() != y.GetLengths())
+        return false;
+    const auto nhwc = HostShape::IsChannelLast(x);
+    if(nhwc != HostShape::IsChannelLast(y))
+        return false;
+    return !(nhwc && problem.GetMode() == miopenBNPerActivation);
+}
+
+} // namespace
+
+bool BnFwdTrainingHost::IsApplicable(const ExecutionContext& ctx,
+                                     const miopen::batchnorm::ProblemDescription& problem) const
+{
+    if(problem.GetDirection() != miopen::batchnorm::Direction::ForwardTraining)
+        return false;
+    return IsHostApplicable(ctx,
+                            problem,
+                            problem.GetXDesc(),
+                            problem.GetYDesc(),
+                            problem.GetBnScaleBiasMeanVarDesc());
+}
+
+ConvSolution
+BnFwdTrainingHost::GetSolution(const ExecutionContext&,
+                               const miopen::batchnorm::ProblemDescription& problem) const
+{
+    auto result = ConvSolution{miopenStatusSuccess};
+
+    // The network config has the sizes and the save/running flags, like the GPU kernels.
+    const auto shape   = HostShape{problem.GetXDesc()};
+    const auto spatial = problem.GetMode() == miopenBNSpatial;
+    const auto save    = problem.GetResultSave();
+    const auto running = problem.GetResultRunning();
+
+    result.invoker_factory = [=](const std::vector<Kernel>&) {
+        return [=](const Handle&, const AnyInvokeParams& raw_params) {
+            decltype(auto) params = raw_params.CastTo<miopen::batchnorm::InvokeParams>();
+
+            const auto run = spatial ? miopenBNFwdTrainSpatialRunHost<float, float>
+                                     : miopenBNFwdTrainPerActivationRunHost<float, float>;
+            run(shape.n,
+                shape.c,
+                shape.d,
+                shape.h,
+                shape.w,
+                static_cast<const float*>(params.x),
+                static_cast<float*>(params.y),
+                static_cast<const float*>(params.bnScale),
+                static_cast<const float*>(params.bnBias),
+                static_cast<float>(params.epsilon),
+                save,
+                running,
+                static_cast<float*>(params.resultSaveMean),
+                static_cast<float*>(params.resultSaveInvVariance),
+                static_cast<float*>(params.resultRunningMean),
+                static_cast<float*>(params.resultRunningVariance),
+                static_cast<float>(params.expAvgFactor),
+                shape.layout);
+        };
+    };
+
+    return result;
+}
+
+bool BnBwdTrainingHost::IsApplicable(const ExecutionContext& ctx,
+                                     const miopen::batchnorm::ProblemDescription& problem) const
+{
+    if(problem.GetDirection() != miopen::batchnorm::Direction::Backward)
+        return false;
+    return IsHostApplicable(ctx,
+                            problem,
+                            problem.GetXDesc(),
+                            problem.GetDYDesc(),
+                            problem.GetScaleBiasDiffDesc()) &&
+           IsHostApplicable(ctx,
+                            problem,
+                            problem.GetXDesc(),
+                            problem.GetDXDesc(),
+                            problem.GetScaleBiasDiffDesc());
+}
+
+ConvSolution
+BnBwdTrainingHost::GetSolution(const ExecutionContext&,
+                               const miopen::batchnorm::ProblemDescription& problem) const
+{
+    auto result = ConvSolution{miopenStatusSuccess};
+
+    const auto shape     = HostShape{problem.GetXDesc()};
+    const auto spatial   = problem.GetMode() == miopenBNSpatial;
+    const auto use_saved = problem.UseSaved();
+
+    result.invoker_factory = [=](const std::vector<Kernel>&) {
+        return [=](const Handle&, const AnyInvokeParams& raw_params) {
+            decltype(auto) params = raw_params.CastTo<miopen::batchnorm::BwdInvokeParams>();
+
+            const auto run = spatial ? miopenBNBwdSpatialRunHost<float, float, float>
+                                     : miopenBNBwdPerActivationRunHost<float, float, float>;
+            run(shape.n,
+                shape.c,
+                shape.d,
+                shape.h,
+                shape.w,
+                static_cast<const float*>(params.x),
+                static_cast<const float*>(params.dy),
+                static_cast<float*>(params.dx),
+                static_cast<const float*>(params.bnScale),
+                static_cast<float*>(params.resultBnScaleDiff),
+                static_cast<float*>(params.resultBnBiasDiff),
+                static_cast<float>(params.epsilon),
+                use_saved,
+                static_cast<const float*>(params.savedMean),
+                static_cast<const float*>(params.savedInvVariance),
+                shape.layout);
+        };
+    };
+
+    return result;
+}
+
+bool BnFwdInferenceHost::IsApplicable(const ExecutionContext& ctx,
+                                      const miopen::batchnorm::ProblemDescription& problem) const
+{
+    if(problem.GetDirection() != miopen::batchnorm::Direction::ForwardInference)
+        return false;
+    return IsHostApplicable(ctx,
+                            problem,
+                            problem.GetXDesc(),
+                            problem.GetYDesc(),
+                            problem.GetBnScaleBiasMeanVarDesc());
+}
+
+ConvSolution
+BnFwdInferenceHost::GetSolution(const ExecutionContext&,
+                                const miopen::batchnorm::ProblemDescription& problem) const
+{
+    auto result = ConvSolution{miopenStatusSuccess};
+
+    const auto spatial = problem.GetMode() == miopenBNSpatial;
+
+    result.invoker_factory = [=](const std::vector<Kernel>&) {
+        return [=](const Handle&, const AnyInvokeParams& raw_params) {
+            decltype(auto) params = raw_params.CastTo<miopen::batchnorm::InfInvokeParams>();
+
+            // The inference network config has no batch size, so it is taken from the call.
+            const auto shape = HostShape{*params.xDesc};
+            const auto run   = spatial ? miopenBNFwdInferSpatialRunHost<float, float>
+                                       : miopenBNFwdInferPerActivationRunHost<float, float>;
+            run(shape.n,
+                shape.c,
+                shape.d,
+                shape.h,
+                shape.w,
+                static_cast<const float*>(params.x),
+                static_cast<float*>(params.y),
+                static_cast<const float*>(params.bnScale),
+                static_cast<const float*>(params.bnBias),
+                static_cast<float>(params.epsilon),
+                true,
+                static_cast<const float*>(params.estimatedMean),
+                static_cast<const float*>(params.estimatedVariance),
+                shape.layout);
+        };
+    };
+
+    return result;
+}
+
+} // namespace batchnorm
+
+} // namespace solver
+
+} // namespace miopen
@@ -0,0 +1,318 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/solver.hpp>
+
+#include <miopen/conv/data_invoke_params.hpp>
+#include <miopen/conv/wrw_invoke_params.hpp>
+#include <miopen/cpu_conv_gemm.hpp>
+#include <miopen/solver/host.hpp>
+#include <miopen/timer.hpp>
+
+#include <vector>
+
+namespace miopen {
+namespace solver {
+
+namespace {
+
+template <std::size_t ConvDim>
+using HostConvProblem = cpu_conv_gemm::problem<ConvDim>;
+
+template <std::size_t ConvDim>
+std::size_t Flatten(const std::array<std::size_t, ConvDim>& id,
+                    const std::array<std::size_t, ConvDim>& len)
+{
+    auto result = std::size_t{0};
+    for(std::size_t i = 0; i < ConvDim; ++i)
+        result = result * len[i] + id[i];
+    return result;
+}
+
+/// Every output element is a gather over its receptive field, every thread owns whole
+/// channels of the written tensor, and sums are accumulated in double.
+struct DirectEngine
+{
+    template <std::size_t ConvDim>
+    static void
+    Forward(const float* in, const float* wei, float* out, const HostConvProblem<ConvDim>& p)
+    {
+        const auto k_total = p.groups * p.k_per_group;
+        par_for(p.n * k_total, min_grain{1}, [&](std::size_t i) {
+            const auto b = i / k_total;
+            const auto k = i % k_total;
+            const auto g = k / p.k_per_group;
+            auto in_id   = std::array<std::size_t, ConvDim>{};
+            for(std::size_t o = 0; o < p.out_size; ++o)
+            {
+                auto acc = 0.0;
+                for(std::size_t c = 0; c < p.c_per_group; ++c)
+                {
+                    for(std::size_t w = 0; w < p.wei_size; ++w)
+                    {
+                        if(!p.input_coords(w, o, in_id))
+                            continue;
+                        acc += static_cast<double>(
+                                   in[p.offset(p.in_strides, b, g * p.c_per_group + c, in_id)]) *
+                               wei[p.offset(p.wei_strides, k, c, p.unflatten(w, p.wei_len))];
+                    }
+                }
+                out[p.offset(p.out_strides, b, k, p.unflatten(o, p.out_len))] =
+                    static_cast<float>(acc);
+            }
+        });
+    }
+
+    template <std::size_t ConvDim>
+    static void
+    BackwardData(float* in, const float* wei, const float* out, const HostConvProblem<ConvDim>& p)
+    {
+        const auto c_total = p.groups * p.c_per_group;
+        par_for(p.n * c_total, min_grain{1}, [&](std::size_t i) {
+            const auto b = i / c_total;
+            const auto c = i % c_total;
+            const auto g = c / p.c_per_group;
+            auto acc     = std::vector<double>(p.in_size, 0.0);
+            auto in_id   = std::array<std::size_t, ConvDim>{};
+            for(std::size_t kg = 0; kg < p.k_per_group; ++kg)
+            {
+                const auto k = g * p.k_per_group + kg;
+                for(std::size_t o = 0; o < p.out_size; ++o)
+                {
+                    const auto dy = static_cast<double>(
+                        out[p.offset(p.out_strides, b, k, p.unflatten(o, p.out_len))]);
+                    for(std::size_t w = 0; w < p.wei_size; ++w)
+                    {
+                        if(!p.input_coords(w, o, in_id))
+                            continue;
+                        acc[Flatten(in_id, p.in_len)] +=
+                            dy * wei[p.offset(p.wei_strides,
+                                              k,
+                                              c % p.c_per_group,
+                                              p.unflatten(w, p.wei_len))];
+                    }
+                }
+            }
+            for(std::size_t x = 0; x < p.in_size; ++x)
+                in[p.offset(p.in_strides, b, c, p.unflatten(x, p.in_len))] =
+                    static_cast<float>(acc[x]);
+        });
+    }
+
+    template <std::size_t ConvDim>
+    static void BackwardWeights(const float* in,
+                                float* wei,
+                                const float* out,
+                                const HostConvProblem<ConvDim>& p)
+    {
+        const auto k_total = p.groups * p.k_per_group;
+        par_for(k_total * p.c_per_group, min_grain{1}, [&](std::size_t i) {
+            const auto k = i / p.c_per_group;
+            const auto c = i % p.c_per_group;
+            const auto g = k / p.k_per_group;
+            auto in_id   = std::array<std::size_t, ConvDim>{};
+            for(std::size_t w = 0; w < p.wei_size; ++w)
+            {
+                auto acc = 0.0;
+                for(std::size_t b = 0; b < p.n; ++b)
+                {
+                    for(std::size_t o = 0; o < p.out_size; ++o)
+                    {
+                        if(!p.input_coords(w, o, in_id))
+                            continue;
+                        acc += static_cast<double>(
+                                   out[p.offset(p.out_strides, b, k, p.unflatten(o, p.out_len))]) *
+                               in[p.offset(p.in_strides, b, g * p.c_per_group + c, in_id)];
+                    }
+                }
+                wei[p.offset(p.wei_strides, k, c, p.unflatten(w, p.wei_len))] =
+                    static_cast<float>(acc);
+            }
+        });
+    }
+};
+
+struct GemmEngine
+{
+    template <std::size_t ConvDim>
+    static void
+    Forward(const float* in, const float* wei, float* out, const HostConvProblem<ConvDim>& p)
+    {
+        if constexpr(ConvDim == 2)
+        {
+            if(cpu_conv_gemm::winograd_applicable(p))
+            {
+                cpu_conv_gemm::forward_winograd<ConvDim, float>(in, wei, out, p);
+                return;
+            }
+        }
+        cpu_conv_gemm::forward<ConvDim, float>(in, wei, out, p);
+    }
+
+    template <std::size_t ConvDim>
+    static void
+    BackwardData(float* in, const float* wei, const float* out, const HostConvProblem<ConvDim>& p)
+    {
+        cpu_conv_gemm::backward_data<ConvDim, float>(in, wei, out, p);
+    }
+
+    template <std::size_t ConvDim>
+    static void BackwardWeights(const float* in,
+                                float* wei,
+                                const float* out,
+                                const HostConvProblem<ConvDim>& p)
+    {
+        cpu_conv_gemm::backward_weights<ConvDim, float>(in, wei, out, p);
+    }
+};
+
+bool IsHostConvApplicable(const ConvolutionContext& ctx, const ProblemDescription& problem)
+{
+    if(!IsHostSolverEnabled(ctx.GetStream()))
+        return false;
+    if(!problem.IsFp32())
+        return false;
+    if(!problem.Is2d() && !problem.Is3d())
+        return false;
+    const auto& conv_problem = problem.conv_problem;
+    return cpu_conv_gemm::applicable(conv_problem.GetIn(), conv_problem.GetWeights()) &&
+           conv_problem.GetOut().GetVectorLength() == 1;
+}
+
+/// Calls f with the geometry of the convolution whose forward input, weights and output are
+/// described by in, wei and out.
+template <class F>
+void VisitHostConvProblem(const TensorDescriptor& in,
+                          const TensorDescriptor& wei,
+                          const TensorDescriptor& out,
+                          const std::vector<int>& pads,
+                          const std::vector<int>& strides,
+                          const std::vector<int>& dilations,
+                          std::size_t groups,
+                          F f)
+{
+    if(in.GetLengths().size() == 5)
+        f(HostConvProblem<3>{in, wei, out, pads, strides, dilations, groups});
+    else
+        f(HostConvProblem<2>{in, wei, out, pads, strides, dilations, groups});
+}
+
+/// The geometry is taken from the descriptors of the invoke parameters, so that the invoker
+/// can be reused for every problem with the same network config.
+template <class Engine>
+ConvSolution MakeHostConvSolution(const ProblemDescription& problem)
+{
+    const auto& conv     = problem.conv_problem.GetConv();
+    const auto direction = problem.conv_problem.GetDirection();
+    const auto pads      = conv.GetConvPads();
+    const auto strides   = conv.GetConvStrides();
+    const auto dilations = conv.GetConvDilations();
+    const auto groups    = static_cast<std::size_t>(conv.GetGroupCount());
+
+    auto result = ConvSolution{miopenStatusSuccess};
+
+    result.invoker_factory = [=](const std::vector<Kernel>&) {
+        return [=](const Handle& handle, const AnyInvokeParams& raw_params) {
+            auto timer = Timer{};
+            timer.start();
+            const auto visit = [&](const TensorDescriptor& in,
+                                   const TensorDescriptor& wei,
+                                   const TensorDescriptor& out,
+                                   auto f) {
+                VisitHostConvProblem(in, wei, out, pads, strides, dilations, groups, f);
+            };
+
+            if(direction == conv::Direction::BackwardWeights)
+            {
+                const auto& tensors = raw_params.CastTo<conv::WrWInvokeParams>().tensors;
+                visit(tensors.xDesc, tensors.dwDesc, tensors.dyDesc, [&](const auto& p) {
+                    Engine::BackwardWeights(static_cast<const float*>(tensors.x),
+                                            static_cast<float*>(tensors.dw),
+                                            static_cast<const float*>(tensors.dy),
+                                            p);
+                });
+            }
+            else if(direction == conv::Direction::BackwardData)
+            {
+                // Backward data tensors are (dy, w, dx).
+                const auto& tensors = raw_params.CastTo<conv::DataInvokeParams>().tensors;
+                visit(tensors.outDesc, tensors.wDesc, tensors.inDesc, [&](const auto& p) {
+                    Engine::BackwardData(static_cast<float*>(tensors.out),
+                                         static_cast<const float*>(tensors.w),
+                                         static_cast<const float*>(tensors.in),
+                                         p);
+                });
+            }
+            else
+            {
+                const auto& tensors = raw_params.CastTo<conv::DataInvokeParams>().tensors;
+                visit(tensors.inDesc, tensors.wDesc, tensors.outDesc, [&](const auto& p) {
+                    Engine::Forward(static_cast<const float*>(tensors.in),
+                                    static_cast<const float*>(tensors.w),
+                                    static_cast<float*>(tensors.out),
+                                    p);
+                });
+            }
+
+            if(handle.IsProfilingEnabled())
+            {
+                handle.ResetKernelTime();
+                handle.AccumKernelTime(timer.elapsed_ms());
+            }
+        };
+    };
+
+    return result;
+}
+
+} // namespace
+
+bool ConvDirectHost::IsApplicable(const ConvolutionContext& ctx,
+                                  const ProblemDescription& problem) const
+{
+    return IsHostConvApplicable(ctx, problem);
+}
+
+ConvSolution ConvDirectHost::GetSolution(const ConvolutionContext&,
+                                         const ProblemDescription& problem) const
+{
+    return MakeHostConvSolution<DirectEngine>(problem);
+}
+
+bool ConvGemmHost::IsApplicable(const ConvolutionContext& ctx,
+                                const ProblemDescription& problem) const
+{
+    return IsHostConvApplicable(ctx, problem);
+}
+
+ConvSolution ConvGemmHost::GetSolution(const ConvolutionContext&,
+                                       const ProblemDescription& problem) const
+{
+    return MakeHostConvSolution<GemmEngine>(problem);
+}
+
+} // namespace solver
+} // namespace miopen
@@ -0,0 +1,293 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/solver/host.hpp>
+
+#include <miopen/errors.hpp>
+#include <miopen/float_equal.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace miopen {
+
+namespace solver {
+
+namespace host {
+
+namespace {
+
+/// out = alpha * value + beta * out, where out is not read when beta is zero so that
+/// uninitialized outputs don't propagate NaNs.
+inline void Blend(float& out, double value, float alpha, float beta)
+{
+    const auto scaled = alpha * static_cast<float>(value);
+    out               = miopen::float_equal(beta, 0) ? scaled : scaled + beta * out;
+}
+
+/// Softmax normalizes `inner` elements in each of `outer` groups: C, H and W of an image in
+/// the instance mode, C of a pixel in the channel mode.
+class SoftmaxGroups
+{
+public:
+    SoftmaxGroups(const TensorDescriptor& desc, miopenSoftmaxMode_t mode_) : mode(mode_)
+    {
+        std::tie(n, c, h, w) = tien<4>(desc.GetLengths());
+        outer                = mode == MIOPEN_SOFTMAX_MODE_INSTANCE ? n : n * h * w;
+        inner                = mode == MIOPEN_SOFTMAX_MODE_INSTANCE ? c * h * w : c;
+    }
+
+    std::size_t Offset(const std::vector<std::size_t>& strides,
+                       std::size_t group,
+                       std::size_t i) const
+    {
+        const auto hw    = mode == MIOPEN_SOFTMAX_MODE_INSTANCE ? i : group;
+        const auto n_idx = mode == MIOPEN_SOFTMAX_MODE_INSTANCE ? group : group / (h * w);
+        const auto c_idx = mode == MIOPEN_SOFTMAX_MODE_INSTANCE ? i / (h * w) : i;
+        return n_idx * strides[0] + c_idx * strides[1] + hw / w % h * strides[2] +
+               hw % w * strides[3];
+    }
+
+    std::size_t outer;
+    std::size_t inner;
+
+private:
+    miopenSoftmaxMode_t mode;
+    std::size_t n, c, h, w;
+};
+
+template <class F>
+void ParForEachGroup(const SoftmaxGroups& groups, F f)
+{
+    par_for(groups.outer, min_grain{std::max<std::size_t>(1, 4096 / groups.inner)}, f);
+}
+
+} // namespace
+
+void SoftmaxForward(const void* alpha,
+                    const void* beta,
+                    const TensorDescriptor& xDesc,
+                    ConstData_t x,
+                    const TensorDescriptor& yDesc,
+                    Data_t y,
+                    miopenSoftmaxAlgorithm_t algorithm,
+                    miopenSoftmaxMode_t mode,
+                    int x_offset,
+                    int y_offset)
+{
+    const auto groups    = SoftmaxGroups{yDesc, mode};
+    const auto& x_stride = xDesc.GetStrides();
+    const auto& y_stride = yDesc.GetStrides();
+    const auto px        = static_cast<const float*>(x) + x_offset;
+    const auto py        = static_cast<float*>(y) + y_offset;
+    const auto alpha_fp  = *static_cast<const float*>(alpha);
+    const auto beta_fp   = *static_cast<const float*>(beta);
+
+    ParForEachGroup(groups, [&](std::size_t g) {
+        const auto x_at = [&](std::size_t i) {
+            return static_cast<double>(px[groups.Offset(x_stride, g, i)]);
+        };
+
+        // The fast algorithm doesn't subtract the maximum.
+        auto max = algorithm == MIOPEN_SOFTMAX_FAST ? 0.0 : -std::numeric_limits<double>::max();
+        if(algorithm != MIOPEN_SOFTMAX_FAST)
+            for(std::size_t i = 0; i < groups.inner; ++i)
+                max = std::max(max, x_at(i));
+
+        auto sum = 0.0;
+        for(std::size_t i = 0; i < groups.inner; ++i)
+            sum += std::exp(x_at(i) - max);
+
+        const auto log_sum = std::log(sum);
+        for(std::size_t i = 0; i < groups.inner; ++i)
+        {
+            const auto value = algorithm == MIOPEN_SOFTMAX_LOG ? x_at(i) - max - log_sum
+                                                               : std::exp(x_at(i) - max) / sum;
+            Blend(py[groups.Offset(y_stride, g, i)], value, alpha_fp, beta_fp);
+        }
+    });
+}
+
+void SoftmaxBackward(const void* alpha,
+                     const TensorDescriptor& yDesc,
+                     ConstData_t y,
+                     const TensorDescriptor& dyDesc,
+                     ConstData_t dy,
+                     const void* beta,
+                     const TensorDescriptor& dxDesc,
+                     Data_t dx,
+                     miopenSoftmaxAlgorithm_t algorithm,
+                     miopenSoftmaxMode_t mode,
+                     int y_offset,
+                     int dy_offset,
+                     int dx_offset)
+{
+    const auto groups     = SoftmaxGroups{dxDesc, mode};
+    const auto& y_stride  = yDesc.GetStrides();
+    const auto& dy_stride = dyDesc.GetStrides();
+    const auto& dx_stride = dxDesc.GetStrides();
+    const auto py         = static_cast<const float*>(y) + y_offset;
+    const auto pdy        = static_cast<const float*>(dy) + dy_offset;
+    const auto pdx        = static_cast<float*>(dx) + dx_offset;
+    const auto alpha_fp   = *static_cast<const float*>(alpha);
+    const auto beta_fp    = *static_cast<const float*>(beta);
+
+    ParForEachGroup(groups, [&](std::size_t g) {
+        const auto y_at = [&](std::size_t i) {
+            return static_cast<double>(py[groups.Offset(y_stride, g, i)]);
+        };
+        const auto dy_at = [&](std::size_t i) {
+            return static_cast<double>(pdy[groups.Offset(dy_stride, g, i)]);
+        };
+
+        auto sum = 0.0;
+        for(std::size_t i = 0; i < groups.inner; ++i)
+            sum += algorithm == MIOPEN_SOFTMAX_LOG ? dy_at(i) : y_at(i) * dy_at(i);
+
+        for(std::size_t i = 0; i < groups.inner; ++i)
+        {
+            const auto value = algorithm == MIOPEN_SOFTMAX_LOG
+                                   ? dy_at(i) - sum * std::exp(y_at(i))
+                                   : y_at(i) * (dy_at(i) - sum);
+            Blend(pdx[groups.Offset(dx_stride, g, i)], value, alpha_fp, beta_fp);
+        }
+    });
+}
+
+void OpTensor(miopenTensorOp_t tensorOp,
+              const void* alpha0,
+              const TensorDescriptor& aTensorDesc,
+              ConstData_t ATensor,
+              const void* alpha1,
+              const TensorDescriptor& bTensorDesc,
+              ConstData_t BTensor,
+              const void* beta,
+              const TensorDescriptor& cTensorDesc,
+              Data_t CTensor,
+              std::size_t Aoffset,
+              std::size_t Boffset,
+              std::size_t Coffset)
+{
+    const auto& clens = cTensorDesc.GetLengths();
+    const auto& blens = bTensorDesc.GetLengths();
+
+    // A only has to have as many elements as C, in which case it is read as a packed C.
+    const auto a_strides = aTensorDesc.GetLengths() == clens
+                               ? aTensorDesc.GetStrides()
+                               : TensorDescriptor{cTensorDesc.GetType(), clens}.GetStrides();
+    auto b_strides = bTensorDesc.GetStrides();
+    for(std::size_t i = 0; i < clens.size(); ++i)
+        if(blens[i] == 1)
+            b_strides[i] = 0;
+    const auto& c_strides = cTensorDesc.GetStrides();
+
+    const auto pa        = static_cast<const float*>(ATensor) + Aoffset;
+    const auto pb        = static_cast<const float*>(BTensor) + Boffset;
+    const auto pc        = static_cast<float*>(CTensor) + Coffset;
+    const auto alpha0_fp = *static_cast<const float*>(alpha0);
+    const auto alpha1_fp = *static_cast<const float*>(alpha1);
+    const auto beta_fp   = *static_cast<const float*>(beta);
+
+    const auto op = [&](float a, float b) {
+        switch(tensorOp)
+        {
+        case miopenTensorOpAdd: return a + b;
+        case miopenTensorOpMul: return a * b;
+        case miopenTensorOpMin: return std::min(a, b);
+        case miopenTensorOpMax: return std::max(a, b);
+        }
+        MIOPEN_THROW(miopenStatusBadParm, "Unknown tensor operation");
+    };
+
+    ParForEachRow<3>(clens,
+                     {&a_strides, &b_strides, &c_strides},
+                     [&](const auto& offsets, std::size_t len, const auto& inner) {
+                         for(std::size_t i = 0; i < len; ++i)
+                         {
+                             const auto a = alpha0_fp * pa[offsets[0] + i * inner[0]];
+                             const auto b = alpha1_fp * pb[offsets[1] + i * inner[1]];
+                             Blend(pc[offsets[2] + i * inner[2]], op(a, b), 1.0f, beta_fp);
+                         }
+                     });
+}
+
+void SetTensor(const TensorDescriptor& yDesc, Data_t y, const void* alpha, int offset)
+{
+    const auto py    = static_cast<float*>(y) + offset;
+    const auto value = *static_cast<const float*>(alpha);
+    ParForEachRow<1>(yDesc.GetLengths(),
+                     {&yDesc.GetStrides()},
+                     [&](const auto& offsets, std::size_t len, const auto& inner) {
+                         for(std::size_t i = 0; i < len; ++i)
+                             py[offsets[0] + i * inner[0]] = value;
+                     });
+}
+
+void ScaleTensor(const TensorDescriptor& yDesc, Data_t y, const void* alpha, int offset)
+{
+    const auto py    = static_cast<float*>(y) + offset;
+    const auto value = *static_cast<const float*>(alpha);
+    ParForEachRow<1>(yDesc.GetLengths(),
+                     {&yDesc.GetStrides()},
+                     [&](const auto& offsets, std::size_t len, const auto& inner) {
+                         for(std::size_t i = 0; i < len; ++i)
+                             py[offsets[0] + i * inner[0]] *= value;
+                     });
+}
+
+void CopyTensor(const TensorDescriptor& srcDesc,
+                ConstData_t src,
+                const TensorDescriptor& dstDesc,
+                Data_t dst,
+                int srcOffset,
+                int dstOffset)
+{
+    const auto size = GetTypeSize(dstDesc.GetType());
+    const auto psrc = static_cast<const char*>(src) + srcOffset * size;
+    const auto pdst = static_cast<char*>(dst) + dstOffset * size;
+    ParForEachRow<2>(dstDesc.GetLengths(),
+                     {&srcDesc.GetStrides(), &dstDesc.GetStrides()},
+                     [&](const auto& offsets, std::size_t len, const auto& inner) {
+                         const auto from = psrc + offsets[0] * size;
+                         const auto to   = pdst + offsets[1] * size;
+                         if(inner[0] == 1 && inner[1] == 1)
+                         {
+                             std::memcpy(to, from, len * size);
+                             return;
+                         }
+                         for(std::size_t i = 0; i < len; ++i)
+                             std::memcpy(
+                                 to + i * inner[1] * size, from + i * inner[0] * size, size);
+                     });
+}
+
+} // namespace host
+
+} // namespace solver
+
+} // namespace miopen
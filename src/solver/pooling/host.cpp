@@ -0,0 +1,362 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/pooling/solvers.hpp>
+
+#include <miopen/pooling/invoke_params.hpp>
+#include <miopen/solver/host.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <limits>
+
+namespace miopen {
+
+namespace solver {
+
+namespace pooling {
+
+namespace {
+
+/// 2d pooling is handled as 3d pooling with a depth of 1.
+struct HostPoolingGeometry
+{
+    HostPoolingGeometry(const PoolingDescriptor& pooling,
+                        const TensorDescriptor& x_desc,
+                        const TensorDescriptor& y_desc)
+    {
+        const auto spatial = x_desc.GetLengths().size() - 2;
+        const auto first   = 3 - spatial;
+        for(std::size_t i = 0; i < 2; ++i)
+        {
+            x_strides[i] = x_desc.GetStrides()[i];
+            y_strides[i] = y_desc.GetStrides()[i];
+        }
+        for(std::size_t i = 0; i < spatial; ++i)
+        {
+            in[first + i]            = static_cast<int>(x_desc.GetLengths()[i + 2]);
+            out[first + i]           = static_cast<int>(y_desc.GetLengths()[i + 2]);
+            x_strides[first + i + 2] = x_desc.GetStrides()[i + 2];
+            y_strides[first + i + 2] = y_desc.GetStrides()[i + 2];
+            kernel[first + i]        = pooling.GetLengths()[i];
+            stride[first + i]        = pooling.GetStrides()[i];
+            pad[first + i]           = pooling.GetPads()[i];
+        }
+        n        = x_desc.GetLengths()[0];
+        c        = x_desc.GetLengths()[1];
+        mode     = pooling.GetMode();
+        mask     = pooling.GetWorkspaceIndexMode() == miopenPoolingWorkspaceIndexMask;
+        ker_size = kernel[0] * kernel[1] * kernel[2];
+    }
+
+    std::size_t XOffset(std::size_t b, std::size_t ch, int d, int h, int w) const
+    {
+        return b * x_strides[0] + ch * x_strides[1] + d * x_strides[2] + h * x_strides[3] +
+               w * x_strides[4];
+    }
+
+    std::size_t YOffset(std::size_t b, std::size_t ch, int d, int h, int w) const
+    {
+        return b * y_strides[0] + ch * y_strides[1] + d * y_strides[2] + h * y_strides[3] +
+               w * y_strides[4];
+    }
+
+    /// The window of output o in dimension i, clipped to the image: [begin, end).
+    /// `origin` is the unclipped beginning, which mask indices are relative to.
+    void Window(std::size_t i, int o, int& origin, int& begin, int& end) const
+    {
+        origin = o * stride[i] - pad[i];
+        begin  = std::max(origin, 0);
+        end    = std::min(origin + kernel[i], in[i]);
+    }
+
+    int PoolSize(const std::array<int, 3>& begin, const std::array<int, 3>& end) const
+    {
+        if(mode == miopenPoolingAverageInclusive)
+            return ker_size;
+        auto size = 1;
+        for(std::size_t i = 0; i < 3; ++i)
+            size *= std::max(end[i] - begin[i], 1);
+        return size;
+    }
+
+    /// Workspace index of input element (d, h, w) for the window beginning at origin.
+    std::size_t Index(const std::array<int, 3>& origin, int d, int h, int w) const
+    {
+        if(mask)
+            return ((d - origin[0]) * kernel[1] + (h - origin[1])) * kernel[2] + (w - origin[2]);
+        return (static_cast<std::size_t>(d) * in[1] + h) * in[2] + w;
+    }
+
+    /// Inverse of Index().
+    void Unindex(std::size_t index, const std::array<int, 3>& origin, int& d, int& h, int& w) const
+    {
+        if(mask)
+        {
+            const auto k = static_cast<int>(index);
+            d            = origin[0] + k / (kernel[1] * kernel[2]);
+            h            = origin[1] + k / kernel[2] % kernel[1];
+            w            = origin[2] + k % kernel[2];
+            return;
+        }
+        d = static_cast<int>(index / (static_cast<std::size_t>(in[1]) * in[2]));
+        h = static_cast<int>(index / in[2] % in[1]);
+        w = static_cast<int>(index % in[2]);
+    }
+
+    std::size_t n = 0;
+    std::size_t c = 0;
+    std::array<int, 3> in{1, 1, 1};
+    std::array<int, 3> out{1, 1, 1};
+    std::array<int, 3> kernel{1, 1, 1};
+    std::array<int, 3> stride{1, 1, 1};
+    std::array<int, 3> pad{0, 0, 0};
+    std::array<std::size_t, 5> x_strides{};
+    std::array<std::size_t, 5> y_strides{};
+    miopenPoolingMode_t mode = miopenPoolingMax;
+    bool mask                = false;
+    int ker_size             = 1;
+};
+
+template <class F>
+void VisitIndexType(miopenIndexType_t type, F f)
+{
+    switch(type)
+    {
+    case miopenIndexUint8: f(std::uint8_t{}); break;
+    case miopenIndexUint16: f(std::uint16_t{}); break;
+    case miopenIndexUint32: f(std::uint32_t{}); break;
+    case miopenIndexUint64: f(std::uint64_t{}); break;
+    default: MIOPEN_THROW(miopenStatusBadParm, "Unsupported pooling index type");
+    }
+}
+
+/// Images (n, c) are independent, so they are spread over host threads.
+template <class F>
+void ParForEachImage(const HostPoolingGeometry& geo, F f)
+{
+    const auto image_work = static_cast<std::size_t>(geo.out[0]) * geo.out[1] * geo.out[2] *
+                            static_cast<std::size_t>(geo.ker_size);
+    const auto grain =
+        std::max<std::size_t>(1, (std::size_t{1} << 16) / std::max<std::size_t>(1, image_work));
+    par_for(geo.n * geo.c, min_grain{grain}, [&](std::size_t image) {
+        f(image / geo.c, image % geo.c);
+    });
+}
+
+template <class Index>
+void PoolingForward(const HostPoolingGeometry& geo, const float* x, float* y, Index* indices)
+{
+    ParForEachImage(geo, [&](std::size_t b, std::size_t ch) {
+        auto origin = std::array<int, 3>{};
+        auto begin  = std::array<int, 3>{};
+        auto end    = std::array<int, 3>{};
+
+        for(auto od = 0; od < geo.out[0]; ++od)
+        {
+            geo.Window(0, od, origin[0], begin[0], end[0]);
+            for(auto oh = 0; oh < geo.out[1]; ++oh)
+            {
+                geo.Window(1, oh, origin[1], begin[1], end[1]);
+                for(auto ow = 0; ow < geo.out[2]; ++ow)
+                {
+                    geo.Window(2, ow, origin[2], begin[2], end[2]);
+
+                    const auto y_offset = geo.YOffset(b, ch, od, oh, ow);
+                    if(geo.mode == miopenPoolingMax)
+                    {
+                        auto best  = std::numeric_limits<float>::lowest();
+                        auto index = std::size_t{0};
+                        for(auto d = begin[0]; d < end[0]; ++d)
+                            for(auto h = begin[1]; h < end[1]; ++h)
+                                for(auto w = begin[2]; w < end[2]; ++w)
+                                {
+                                    const auto v = x[geo.XOffset(b, ch, d, h, w)];
+                                    if(v > best)
+                                    {
+                                        best  = v;
+                                        index = geo.Index(origin, d, h, w);
+                                    }
+                                }
+                        y[y_offset] = best;
+                        if(indices != nullptr)
+                            indices[y_offset] = static_cast<Index>(index);
+                    }
+                    else
+                    {
+                        auto sum = 0.f;
+                        for(auto d = begin[0]; d < end[0]; ++d)
+                            for(auto h = begin[1]; h < end[1]; ++h)
+                                for(auto w = begin[2]; w < end[2]; ++w)
+                                    sum += x[geo.XOffset(b, ch, d, h, w)];
+                        y[y_offset] = sum / static_cast<float>(geo.PoolSize(begin, end));
+                    }
+                }
+            }
+        }
+    });
+}
+
+template <class Index>
+void PoolingBackward(const HostPoolingGeometry& geo,
+                     const float* dy,
+                     float* dx,
+                     const Index* indices)
+{
+    ParForEachImage(geo, [&](std::size_t b, std::size_t ch) {
+        for(auto d = 0; d < geo.in[0]; ++d)
+            for(auto h = 0; h < geo.in[1]; ++h)
+                for(auto w = 0; w < geo.in[2]; ++w)
+                    dx[geo.XOffset(b, ch, d, h, w)] = 0.f;
+
+        auto origin = std::array<int, 3>{};
+        auto begin  = std::array<int, 3>{};
+        auto end    = std::array<int, 3>{};
+
+        for(auto od = 0; od < geo.out[0]; ++od)
+        {
+            geo.Window(0, od, origin[0], begin[0], end[0]);
+            for(auto oh = 0; oh < geo.out[1]; ++oh)
+            {
+                geo.Window(1, oh, origin[1], begin[1], end[1]);
+                for(auto ow = 0; ow < geo.out[2]; ++ow)
+                {
+                    geo.Window(2, ow, origin[2], begin[2], end[2]);
+
+                    const auto dy_offset = geo.YOffset(b, ch, od, oh, ow);
+                    if(geo.mode == miopenPoolingMax)
+                    {
+                        auto d = 0, h = 0, w = 0;
+                        geo.Unindex(indices[dy_offset], origin, d, h, w);
+                        if(d >= begin[0] && d < end[0] && h >= begin[1] && h < end[1] &&
+                           w >= begin[2] && w < end[2])
+                            dx[geo.XOffset(b, ch, d, h, w)] += dy[dy_offset];
+                    }
+                    else
+                    {
+                        const auto grad =
+                            dy[dy_offset] / static_cast<float>(geo.PoolSize(begin, end));
+                        for(auto d = begin[0]; d < end[0]; ++d)
+                            for(auto h = begin[1]; h < end[1]; ++h)
+                                for(auto w = begin[2]; w < end[2]; ++w)
+                                    dx[geo.XOffset(b, ch, d, h, w)] += grad;
+                    }
+                }
+            }
+        }
+    });
+}
+
+bool IsHostApplicable(const ExecutionContext& ctx,
+                      const miopen::pooling::ProblemDescription& problem,
+                      const TensorDescriptor& x,
+                      const TensorDescriptor& y)
+{
+    if(!IsHostSolverEnabled(ctx.GetStream()))
+        return false;
+    const auto mode = problem.GetPooling().GetMode();
+    if(mode != miopenPoolingMax && mode != miopenPoolingAverage &&
+       mode != miopenPoolingAverageInclusive)
+        return false;
+    const auto dims = x.GetLengths().size();
+    return (dims == 4 || dims == 5) && y.GetLengths().size() == dims && IsHostSolverType(x) &&
+           IsHostSolverType(y);
+}
+
+} // namespace
+
+bool PoolingForwardHost::IsApplicable(const ExecutionContext& ctx,
+                                      const miopen::pooling::ProblemDescription& problem) const
+{
+    return problem.GetDirection() == miopen::pooling::Direction::Forward &&
+           IsHostApplicable(ctx, problem, problem.GetXDesc(), problem.GetYDesc());
+}
+
+ConvSolution
+PoolingForwardHost::GetSolution(const ExecutionContext&,
+                                const miopen::pooling::ProblemDescription& problem) const
+{
+    auto result = ConvSolution{miopenStatusSuccess};
+
+    const auto save_index = problem.SaveIndex();
+
+    result.invoker_factory = [=](const std::vector<Kernel>&) {
+        return [=](const Handle&, const AnyInvokeParams& raw_params) {
+            decltype(auto) params = raw_params.CastTo<miopen::pooling::FwdInvokeParams>();
+
+            const auto geo = HostPoolingGeometry{params.pooling, params.xDesc, params.yDesc};
+            const auto x   = static_cast<const float*>(params.x);
+            const auto y   = static_cast<float*>(params.y);
+
+            VisitIndexType(params.pooling.GetIndexType(), [&](auto index) {
+                using Index = decltype(index);
+                const auto indices = save_index && geo.mode == miopenPoolingMax
+                                         ? static_cast<Index*>(params.workspace)
+                                         : nullptr;
+                PoolingForward(geo, x, y, indices);
+            });
+        };
+    };
+
+    return result;
+}
+
+bool PoolingBackwardHost::IsApplicable(const ExecutionContext& ctx,
+                                       const miopen::pooling::ProblemDescription& problem) const
+{
+    return problem.GetDirection() == miopen::pooling::Direction::Backward &&
+           IsHostApplicable(ctx, problem, problem.GetDXDesc(), problem.GetDYDesc());
+}
+
+ConvSolution PoolingBackwardHost::GetSolution(const ExecutionContext&,
+                                              const miopen::pooling::ProblemDescription&) const
+{
+    auto result = ConvSolution{miopenStatusSuccess};
+
+    result.invoker_factory = [](const std::vector<Kernel>&) {
+        return [](const Handle&, const AnyInvokeParams& raw_params) {
+            decltype(auto) params = raw_params.CastTo<miopen::pooling::BwdInvokeParams>();
+
+            const auto geo = HostPoolingGeometry{params.pooling, params.dxDesc, params.dyDesc};
+            const auto dy  = static_cast<const float*>(params.dy);
+            const auto dx  = static_cast<float*>(params.dx);
+
+            VisitIndexType(params.pooling.GetIndexType(), [&](auto index) {
+                using Index = decltype(index);
+                PoolingBackward(geo, dy, dx, static_cast<const Index*>(params.workspace));
+            });
+        };
+    };
+
+    return result;
+}
+
+} // namespace pooling
+
+} // namespace solver
+
+} // namespace miopen
@@ -0,0 +1,88 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/thread_pool.hpp>
+
+#include <miopen/errors.hpp>
+
+#include <algorithm>
+
+namespace miopen {
+
+ThreadPool::ThreadPool(std::size_t threads) : ThreadPool(threads, {}) {}
+
+ThreadPool::ThreadPool(std::size_t threads, const std::function<void()>& init)
+{
+    workers.reserve(std::max<std::size_t>(threads, 1));
+    for(auto i = std::size_t{0}; i < std::max<std::size_t>(threads, 1); ++i)
+        workers.emplace_back([this, init]() { Work(init); });
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+        tasks.clear();
+    }
+    has_tasks.notify_all();
+
+    for(auto& worker : workers)
+        worker.join();
+}
+
+void ThreadPool::Enqueue(std::function<void()> task)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if(stopping)
+            MIOPEN_THROW(miopenStatusInternalError, "Thread pool is being destroyed.");
+        tasks.push_back(std::move(task));
+    }
+    has_tasks.notify_one();
+}
+
+void ThreadPool::Work(const std::function<void()>& init)
+{
+    if(init)
+        init();
+
+    while(true)
+    {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            has_tasks.wait(lock, [&]() { return stopping || !tasks.empty(); });
+            if(stopping)
+                return;
+            task = std::move(tasks.front());
+            tasks.pop_front();
+        }
+        task();
+    }
+}
+
+} // namespace miopen
@@ -0,0 +1,217 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/trace.hpp>
+#include <miopen/env.hpp>
+#include <miopen/logger.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <mutex>
+#include <ostream>
+#include <vector>
+
+#ifndef _WIN32
+#include <unistd.h>
+#else
+#include <process.h>
+#endif
+
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_TRACE_FILE)
+
+namespace miopen {
+
+namespace {
+
+struct TraceEvent
+{
+    const char* category;
+    std::string name;
+    std::chrono::steady_clock::time_point start;
+    std::chrono::steady_clock::time_point end;
+    int tid;
+};
+
+struct TraceState
+{
+    std::mutex mutex;
+    std::string path;
+    std::vector<TraceEvent> events;
+    std::chrono::steady_clock::time_point epoch;
+};
+
+// Never destroyed, so that spans ending during static destruction are still safe to record.
+TraceState& GetTraceState()
+{
+    static auto* const state = new TraceState{};
+    return *state;
+}
+
+// NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
+std::atomic<bool> trace_enabled{false};
+
+int GetTraceThreadId()
+{
+    static std::atomic<int> next_id{1};
+    thread_local const int id = next_id++;
+    return id;
+}
+
+void WriteJsonString(std::ostream& os, const std::string& str)
+{
+    os << '"';
+    for(const auto c : str)
+    {
+        switch(c)
+        {
+        case '"': os << "\\\""; break;
+        case '\\': os << "\\\\"; break;
+        case '\n': os << "\\n"; break;
+        case '\t': os << "\\t"; break;
+        default:
+            if(static_cast<unsigned char>(c) < 0x20)
+            {
+                char buf[8];
+                std::snprintf(buf, sizeof(buf), "\\u%04x", static_cast<unsigned>(c));
+                os << buf;
+            }
+            else
+            {
+                os << c;
+            }
+        }
+    }
+    os << '"';
+}
+
+std::string ToMicroseconds(std::chrono::steady_clock::duration d)
+{
+    char buf[32];
+    std::snprintf(buf,
+                  sizeof(buf),
+                  "%.3f",
+                  std::chrono::duration<double, std::micro>(d).count());
+    return buf;
+}
+
+void WriteTraceAtExit() { WriteTrace(); }
+
+} // namespace
+
+bool IsTraceEnabled()
+{
+    static const bool from_env = [] {
+        const auto* const path = GetStringEnv(MIOPEN_TRACE_FILE{});
+        if(path != nullptr && *path != '\0' && !trace_enabled)
+            EnableTrace(path);
+        return true;
+    }();
+    (void)from_env;
+    return trace_enabled.load(std::memory_order_relaxed);
+}
+
+void EnableTrace(const std::string& path)
+{
+    auto& state = GetTraceState();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    state.path = path;
+    if(trace_enabled)
+        return;
+    state.epoch = std::chrono::steady_clock::now();
+    std::atexit(WriteTraceAtExit);
+    trace_enabled = true;
+}
+
+void AddTraceSpan(const char* category,
+                  std::string name,
+                  std::chrono::steady_clock::time_point start,
+                  std::chrono::steady_clock::time_point end)
+{
+    if(!trace_enabled.load(std::memory_order_relaxed))
+        return;
+    const auto tid = GetTraceThreadId();
+    auto& state    = GetTraceState();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    state.events.push_back({category, std::move(name), start, end, tid});
+}
+
+void WriteTrace(std::ostream& os)
+{
+    auto& state = GetTraceState();
+    std::lock_guard<std::mutex> lock(state.mutex);
+
+    // Sorting by start time, longest first, keeps the spans of a thread properly nested.
+    auto events = state.events;
+    std::sort(events.begin(), events.end(), [](const auto& lhs, const auto& rhs) {
+        if(lhs.start != rhs.start)
+            return lhs.start < rhs.start;
+        return lhs.end > rhs.end;
+    });
+
+#ifndef _WIN32
+    const auto pid = ::getpid();
+#else
+    const auto pid = ::_getpid();
+#endif
+    os << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    for(auto i = 0u; i < events.size(); ++i)
+    {
+        const auto& event = events[i];
+        os << (i == 0 ? "\n" : ",\n") << "{\"name\":";
+        WriteJsonString(os, event.name);
+        os << ",\"cat\":\"" << event.category << "\",\"ph\":\"X\",\"pid\":" << pid
+           << ",\"tid\":" << event.tid << ",\"ts\":" << ToMicroseconds(event.start - state.epoch)
+           << ",\"dur\":" << ToMicroseconds(event.end - event.start) << '}';
+    }
+    os << "\n]}\n";
+}
+
+void WriteTrace()
+{
+    auto path = std::string{};
+    {
+        auto& state = GetTraceState();
+        std::lock_guard<std::mutex> lock(state.mutex);
+        path = state.path;
+    }
+    if(path.empty())
+        return;
+
+    auto file = std::ofstream{path};
+    if(!file)
+    {
+        MIOPEN_LOG_W("Unable to write trace to " << path);
+        return;
+    }
+    WriteTrace(file);
+    MIOPEN_LOG_I("Trace written to " << path);
+}
+
+} // namespace miopen
@@ -0,0 +1,153 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/background_compiler.hpp>
+#include <miopen/errors.hpp>
+
+#include "test.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <future>
+#include <string>
+#include <thread>
+
+namespace {
+
+/// Occupies the only worker until released.
+struct Blocker
+{
+    std::promise<void> release;
+    std::promise<void> started;
+
+    explicit Blocker(const std::string& key)
+    {
+        auto released = release.get_future().share();
+        miopen::BackgroundCompiler::Get().Enqueue(key, [this, released]() {
+            started.set_value();
+            released.wait();
+        });
+        started.get_future().wait();
+    }
+};
+
+void CheckDeduplication()
+{
+    auto& compiler     = miopen::BackgroundCompiler::Get();
+    const auto initial = compiler.GetCompletedCount();
+
+    auto release  = std::promise<void>{};
+    auto released = release.get_future().share();
+    auto runs     = std::atomic<int>{0};
+
+    // The job is held until the duplicates are queued, so they are dropped.
+    for(auto i = 0; i < 4; ++i)
+        compiler.Enqueue("program", [&runs, released]() {
+            released.wait();
+            ++runs;
+        });
+    compiler.Enqueue("failing", []() { MIOPEN_THROW("compiler failure"); });
+    release.set_value();
+
+    compiler.Wait();
+    EXPECT(runs == 1);
+    EXPECT(compiler.GetCompletedCount() - initial == 2);
+
+    // Completed jobs can be queued again.
+    compiler.Enqueue("program", [&runs]() { ++runs; });
+    compiler.Wait();
+    EXPECT(runs == 2);
+}
+
+void CheckSteal()
+{
+    auto& compiler = miopen::BackgroundCompiler::Get();
+    auto blocker   = Blocker{"steal blocker"};
+    auto runs      = std::atomic<int>{0};
+
+    compiler.Enqueue("stolen", [&runs]() { ++runs; });
+    miopen::BackgroundCompiler::Steal("stolen");
+    blocker.release.set_value();
+    compiler.Wait();
+    EXPECT(runs == 0);
+
+    // A stolen job can be queued again.
+    compiler.Enqueue("stolen", [&runs]() { ++runs; });
+    compiler.Wait();
+    EXPECT(runs == 1);
+}
+
+void CheckCancel()
+{
+    auto& compiler         = miopen::BackgroundCompiler::Get();
+    auto blocker           = Blocker{"cancel blocker"};
+    auto runs              = std::atomic<int>{0};
+    const auto owner       = 0;
+    const auto other_owner = 0;
+
+    compiler.Enqueue("cancelled", [&runs]() { ++runs; }, &owner);
+    compiler.Enqueue("kept", [&runs]() { runs += 10; }, &other_owner);
+    // Returns right away, as the running job belongs to nobody.
+    miopen::BackgroundCompiler::Cancel(&owner);
+    blocker.release.set_value();
+    compiler.Wait();
+    EXPECT(runs == 10);
+}
+
+void CheckWaitRunsQueuedJobs()
+{
+    auto& compiler = miopen::BackgroundCompiler::Get();
+    auto blocker   = Blocker{"wait blocker"};
+    auto ran_on    = std::promise<std::thread::id>{};
+    auto ran       = ran_on.get_future().share();
+
+    compiler.Enqueue("queued", [&ran_on]() { ran_on.set_value(std::this_thread::get_id()); });
+    // The worker is only released once the queued job has run, so Wait() has to run it itself.
+    auto releaser = std::thread{[&]() {
+        ran.wait();
+        blocker.release.set_value();
+    }};
+    compiler.Wait();
+    releaser.join();
+    EXPECT(ran.get() == std::this_thread::get_id());
+}
+
+} // namespace
+
+int main()
+{
+    // A single worker makes the order of the jobs predictable.
+    setenv("MIOPEN_AOT_COMPILE_THREADS", "1", 1);
+
+    // Handles call these when they are destroyed, whether the compiler is used or not.
+    miopen::BackgroundCompiler::Steal("program");
+    miopen::BackgroundCompiler::Cancel(nullptr);
+
+    CheckDeduplication();
+    CheckSteal();
+    CheckCancel();
+    CheckWaitRunsQueuedJobs();
+}
@@ -104,7 +104,7 @@ struct verify_forward_train_3d_bn_per_activation
         }
         else
         {
-            srand(0);
+            prng::reset_seed(0);
             runMean = tensor<U>{rs_n_batch, rs_channels, rs_depth, rs_height, rs_width};
             runVar  = tensor<U>{rs_n_batch, rs_channels, rs_depth, rs_height, rs_width};
             for(std::size_t i = 0; i < runMean.desc.GetElementSize(); i++)
@@ -237,7 +237,7 @@ struct verify_forward_train_3d_bn_per_activation
         }
         else
         {
-            srand(0);
+            prng::reset_seed(0);
             runMean = tensor<U>{rs_n_batch, rs_channels, rs_depth, rs_height, rs_width};
             runVar  = tensor<U>{rs_n_batch, rs_channels, rs_depth, rs_height, rs_width};
             for(std::size_t i = 0; i < runMean.desc.GetElementSize(); i++)
@@ -1027,7 +1027,7 @@ struct batch_norm_3d_per_activation_driver : test_driver
         }
         else
         {
-            srand(0);
+            prng::reset_seed(0);
             scale = tensor<PREC_TYPE>{ssn, ssc, ssd, ssh, ssw};
             shift = tensor<PREC_TYPE>{ssn, ssc, ssd, ssh, ssw};
             for(std::size_t i = 0; i < scale.desc.GetElementSize(); i++)
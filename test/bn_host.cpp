@@ -0,0 +1,386 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/batchnorm/host.hpp>
+#include "test.hpp"
+
+#include <cmath>
+#include <cstddef>
+#include <random>
+#include <vector>
+
+/// Checks the threaded host batch-norm references against plain loops over NCHW data, and that
+/// NHWC inputs give the same results as their NCHW transposes.
+struct bn_case
+{
+    int n;
+    int c;
+    int d;
+    int h;
+    int w;
+
+    std::size_t batch() const { return n; }
+    std::size_t channels() const { return c; }
+    std::size_t spatial() const { return static_cast<std::size_t>(d) * h * w; }
+};
+
+static std::vector<double> random_vector(std::size_t size, double offset, std::mt19937& gen)
+{
+    auto dist   = std::uniform_real_distribution<double>{-1.0, 1.0};
+    auto result = std::vector<double>(size);
+    for(auto& x : result)
+        x = offset + dist(gen);
+    return result;
+}
+
+static void expect_close(const std::vector<double>& actual, const std::vector<double>& expected)
+{
+    EXPECT_EQUAL(actual.size(), expected.size());
+    for(std::size_t i = 0; i < actual.size(); ++i)
+        EXPECT(std::abs(actual[i] - expected[i]) <= 1e-7 * (1.0 + std::abs(expected[i])));
+}
+
+/// NCHW <-> NHWC with spatial dimensions flattened.
+static std::vector<double> transpose(const std::vector<double>& src,
+                                     std::size_t n,
+                                     std::size_t rows,
+                                     std::size_t cols)
+{
+    auto dst = std::vector<double>(src.size());
+    for(std::size_t b = 0; b < n; ++b)
+        for(std::size_t r = 0; r < rows; ++r)
+            for(std::size_t col = 0; col < cols; ++col)
+                dst[(b * cols + col) * rows + r] = src[(b * rows + r) * cols + col];
+    return dst;
+}
+
+/// Mean and biased variance of every channel (stride 1, count s per image) or of every feature
+/// (count 1 per image).
+static void naive_stats(const std::vector<double>& x,
+                        std::size_t n,
+                        std::size_t groups,
+                        std::size_t group_size,
+                        std::vector<double>& mean,
+                        std::vector<double>& variance)
+{
+    mean     = std::vector<double>(groups, 0.);
+    variance = std::vector<double>(groups, 0.);
+    for(std::size_t g = 0; g < groups; ++g)
+    {
+        for(std::size_t b = 0; b < n; ++b)
+            for(std::size_t i = 0; i < group_size; ++i)
+                mean[g] += x[(b * groups + g) * group_size + i];
+        mean[g] /= n * group_size;
+        for(std::size_t b = 0; b < n; ++b)
+            for(std::size_t i = 0; i < group_size; ++i)
+                variance[g] += std::pow(x[(b * groups + g) * group_size + i] - mean[g], 2);
+        variance[g] /= n * group_size;
+    }
+}
+
+static void check_spatial(const bn_case& p, double offset, std::mt19937& gen)
+{
+    const auto n     = p.batch();
+    const auto c     = p.channels();
+    const auto s     = p.spatial();
+    const auto size  = n * c * s;
+    const auto eps   = 1e-5;
+    const auto x     = random_vector(size, offset, gen);
+    const auto dy    = random_vector(size, 0., gen);
+    auto scale       = random_vector(c, 1., gen);
+    auto bias        = random_vector(c, 0., gen);
+    auto run_mean    = random_vector(c, 0., gen);
+    auto run_var     = random_vector(c, 2., gen);
+    auto save_mean   = std::vector<double>(c);
+    auto save_invvar = std::vector<double>(c);
+    auto y           = std::vector<double>(size);
+
+    auto expected_run_mean = run_mean;
+    auto expected_run_var  = run_var;
+
+    miopenBNFwdTrainSpatialRunHost(n,
+                                   p.c,
+                                   p.d,
+                                   p.h,
+                                   p.w,
+                                   x.data(),
+                                   y.data(),
+                                   scale.data(),
+                                   bias.data(),
+                                   eps,
+                                   true,
+                                   true,
+                                   save_mean.data(),
+                                   save_invvar.data(),
+                                   run_mean.data(),
+                                   run_var.data(),
+                                   0.1);
+
+    auto mean     = std::vector<double>{};
+    auto variance = std::vector<double>{};
+    naive_stats(x, n, c, s, mean, variance);
+    auto expected_y      = std::vector<double>(size);
+    auto expected_invvar = std::vector<double>(c);
+    const auto nhw       = static_cast<double>(n * s);
+    for(std::size_t ch = 0; ch < c; ++ch)
+    {
+        expected_invvar[ch] = 1. / std::sqrt(variance[ch] + eps);
+        expected_run_mean[ch] = 0.9 * expected_run_mean[ch] + 0.1 * mean[ch];
+        expected_run_var[ch] =
+            0.9 * expected_run_var[ch] + 0.1 * (nhw == 1 ? 1. : nhw / (nhw - 1)) * variance[ch];
+        for(std::size_t b = 0; b < n; ++b)
+        {
+            for(std::size_t i = 0; i < s; ++i)
+            {
+                const auto idx  = (b * c + ch) * s + i;
+                expected_y[idx] = scale[ch] * (x[idx] - mean[ch]) * expected_invvar[ch] + bias[ch];
+            }
+        }
+    }
+    expect_close(y, expected_y);
+    expect_close(save_mean, mean);
+    expect_close(save_invvar, expected_invvar);
+    expect_close(run_mean, expected_run_mean);
+    expect_close(run_var, expected_run_var);
+
+    auto dx     = std::vector<double>(size);
+    auto dscale = std::vector<double>(c);
+    auto dbias  = std::vector<double>(c);
+    miopenBNBwdSpatialRunHost(n,
+                              p.c,
+                              p.d,
+                              p.h,
+                              p.w,
+                              x.data(),
+                              dy.data(),
+                              dx.data(),
+                              scale.data(),
+                              dscale.data(),
+                              dbias.data(),
+                              eps,
+                              false,
+                              save_mean.data(),
+                              save_invvar.data());
+
+    auto expected_dx     = std::vector<double>(size);
+    auto expected_dscale = std::vector<double>(c, 0.);
+    auto expected_dbias  = std::vector<double>(c, 0.);
+    for(std::size_t ch = 0; ch < c; ++ch)
+    {
+        for(std::size_t b = 0; b < n; ++b)
+        {
+            for(std::size_t i = 0; i < s; ++i)
+            {
+                const auto idx = (b * c + ch) * s + i;
+                expected_dbias[ch] += dy[idx];
+                expected_dscale[ch] += (x[idx] - mean[ch]) * expected_invvar[ch] * dy[idx];
+            }
+        }
+        for(std::size_t b = 0; b < n; ++b)
+        {
+            for(std::size_t i = 0; i < s; ++i)
+            {
+                const auto idx   = (b * c + ch) * s + i;
+                const auto xhat  = (x[idx] - mean[ch]) * expected_invvar[ch];
+                expected_dx[idx] =
+                    scale[ch] * expected_invvar[ch] / nhw *
+                    (nhw * dy[idx] - expected_dbias[ch] - xhat * expected_dscale[ch]);
+            }
+        }
+    }
+    expect_close(dx, expected_dx);
+    expect_close(dscale, expected_dscale);
+    expect_close(dbias, expected_dbias);
+
+    // NHWC gives the transposed results.
+    const auto x_nhwc  = transpose(x, n, c, s);
+    const auto dy_nhwc = transpose(dy, n, c, s);
+    auto y_nhwc        = std::vector<double>(size);
+    auto dx_nhwc       = std::vector<double>(size);
+    miopenBNFwdInferSpatialRunHost(n,
+                                   p.c,
+                                   p.d,
+                                   p.h,
+                                   p.w,
+                                   x_nhwc.data(),
+                                   y_nhwc.data(),
+                                   scale.data(),
+                                   bias.data(),
+                                   eps,
+                                   false,
+                                   run_mean.data(),
+                                   run_var.data(),
+                                   miopenTensorNHWC);
+    miopenBNBwdSpatialRunHost(n,
+                              p.c,
+                              p.d,
+                              p.h,
+                              p.w,
+                              x_nhwc.data(),
+                              dy_nhwc.data(),
+                              dx_nhwc.data(),
+                              scale.data(),
+                              dscale.data(),
+                              dbias.data(),
+                              eps,
+                              true,
+                              save_mean.data(),
+                              save_invvar.data(),
+                              miopenTensorNHWC);
+    expect_close(transpose(y_nhwc, n, s, c), expected_y);
+    expect_close(transpose(dx_nhwc, n, s, c), expected_dx);
+    expect_close(dscale, expected_dscale);
+    expect_close(dbias, expected_dbias);
+}
+
+static void check_per_activation(const bn_case& p, double offset, std::mt19937& gen)
+{
+    const auto features = p.channels() * p.spatial();
+    const auto size     = p.batch() * features;
+    const auto eps      = 1e-5;
+    const auto x        = random_vector(size, offset, gen);
+    const auto dy       = random_vector(size, 0., gen);
+    auto scale          = random_vector(features, 1., gen);
+    auto bias           = random_vector(features, 0., gen);
+    auto run_mean       = random_vector(features, 0., gen);
+    auto run_var        = random_vector(features, 2., gen);
+    auto save_mean      = std::vector<double>(features);
+    auto save_invvar    = std::vector<double>(features);
+    auto y              = std::vector<double>(size);
+
+    auto expected_run_mean = run_mean;
+    auto expected_run_var  = run_var;
+
+    miopenBNFwdTrainPerActivationRunHost(p.n,
+                                         p.c,
+                                         p.d,
+                                         p.h,
+                                         p.w,
+                                         x.data(),
+                                         y.data(),
+                                         scale.data(),
+                                         bias.data(),
+                                         eps,
+                                         true,
+                                         true,
+                                         save_mean.data(),
+                                         save_invvar.data(),
+                                         run_mean.data(),
+                                         run_var.data(),
+                                         0.1);
+
+    auto mean     = std::vector<double>{};
+    auto variance = std::vector<double>{};
+    naive_stats(x, p.n, features, 1, mean, variance);
+    auto expected_y      = std::vector<double>(size);
+    auto expected_invvar = std::vector<double>(features);
+    const auto n         = static_cast<double>(p.n);
+    for(std::size_t f = 0; f < features; ++f)
+    {
+        expected_invvar[f]   = 1. / std::sqrt(variance[f] + eps);
+        expected_run_mean[f] = 0.9 * expected_run_mean[f] + 0.1 * mean[f];
+        expected_run_var[f] =
+            0.9 * expected_run_var[f] + 0.1 * (n == 1 ? 1. : n / (n - 1)) * variance[f];
+        for(std::size_t b = 0; b < p.batch(); ++b)
+        {
+            const auto idx  = b * features + f;
+            expected_y[idx] = scale[f] * (x[idx] - mean[f]) * expected_invvar[f] + bias[f];
+        }
+    }
+    expect_close(y, expected_y);
+    expect_close(save_mean, mean);
+    expect_close(save_invvar, expected_invvar);
+    expect_close(run_mean, expected_run_mean);
+    expect_close(run_var, expected_run_var);
+
+    auto expected_dx     = std::vector<double>(size);
+    auto expected_dscale = std::vector<double>(features, 0.);
+    auto expected_dbias  = std::vector<double>(features, 0.);
+    for(std::size_t f = 0; f < features; ++f)
+    {
+        auto dxhat    = 0.;
+        auto dxhathat = 0.;
+        for(std::size_t b = 0; b < p.batch(); ++b)
+        {
+            const auto idx  = b * features + f;
+            const auto xhat = (x[idx] - mean[f]) * expected_invvar[f];
+            expected_dbias[f] += dy[idx];
+            expected_dscale[f] += xhat * dy[idx];
+            dxhat += scale[f] * dy[idx];
+            dxhathat += scale[f] * dy[idx] * xhat;
+        }
+        for(std::size_t b = 0; b < p.batch(); ++b)
+        {
+            const auto idx   = b * features + f;
+            const auto xhat  = (x[idx] - mean[f]) * expected_invvar[f];
+            expected_dx[idx] = expected_invvar[f] / n *
+                               (n * scale[f] * dy[idx] - dxhat - xhat * dxhathat);
+        }
+    }
+
+    for(const auto saved : {false, true})
+    {
+        auto dx     = std::vector<double>(size);
+        auto dscale = std::vector<double>(features);
+        auto dbias  = std::vector<double>(features);
+        miopenBNBwdPerActivationRunHost(p.n,
+                                        p.c,
+                                        p.d,
+                                        p.h,
+                                        p.w,
+                                        x.data(),
+                                        dy.data(),
+                                        dx.data(),
+                                        scale.data(),
+                                        dscale.data(),
+                                        dbias.data(),
+                                        eps,
+                                        saved,
+                                        save_mean.data(),
+                                        save_invvar.data());
+        expect_close(dx, expected_dx);
+        expect_close(dscale, expected_dscale);
+        expect_close(dbias, expected_dbias);
+    }
+}
+
+int main()
+{
+    auto gen = std::mt19937{};
+    for(const auto& p : {bn_case{2, 3, 1, 5, 7},
+                         bn_case{1, 1, 1, 1, 2},
+                         bn_case{4, 16, 2, 9, 9},
+                         bn_case{3, 5, 1, 70, 70},
+                         bn_case{2, 600, 1, 4, 3}})
+    {
+        // A large offset makes one-pass variance formulas lose all precision.
+        for(const auto offset : {0., 1e4})
+        {
+            check_spatial(p, offset, gen);
+            check_per_activation(p, offset, gen);
+        }
+    }
+}
@@ -87,7 +87,7 @@ struct verify_forward_train_bn_spatial
         }
         else
         {
-            srand(0);
+            prng::reset_seed(0);
             runMean = tensor<U>{rs_n_batch, rs_height, rs_width, rs_channels};
             runVar  = tensor<U>{rs_n_batch, rs_height, rs_width, rs_channels};
             for(std::size_t i = 0; i < runMean.desc.GetElementSize(); i++)
@@ -207,7 +207,7 @@ struct verify_forward_train_bn_spatial
         }
         else
         {
-            srand(0);
+            prng::reset_seed(0);
             runMean = tensor<U>{rs_n_batch, rs_height, rs_width, rs_channels};
             runVar  = tensor<U>{rs_n_batch, rs_height, rs_width, rs_channels};
             for(std::size_t i = 0; i < runMean.desc.GetElementSize(); i++)
@@ -696,7 +696,7 @@ struct batch_norm_spatial_nhwc_driver : test_driver
         }
         else
         {
-            srand(0);
+            prng::reset_seed(0);
             scale = tensor<PREC_TYPE>{ssn, ssh, ssw, ssc};
             shift = tensor<PREC_TYPE>{ssn, ssh, ssw, ssc};
             for(std::size_t i = 0; i < scale.desc.GetElementSize(); i++)
@@ -384,7 +384,7 @@ struct cba_fusion_driver : test_driver
                 else
                 {
                     bias = tensor<T>{1, output.desc.GetLengths()[1], 1, 1};
-                    srand(0);
+                    prng::reset_seed(0);
                     for(std::size_t i = 0; i < bias.desc.GetElementSize(); i++)
                     {
                         bias[i] = (((GET_RAND() % 2) == 1) ? -1 : 1) * (0.1 * T(GET_RAND() % 100));
@@ -0,0 +1,162 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/binary_cache.hpp>
+#include <miopen/handle.hpp>
+#include <miopen/tmp_dir.hpp>
+#include <miopen/write_file.hpp>
+
+#include "test.hpp"
+
+#include <boost/filesystem.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sys/wait.h>
+
+namespace {
+
+constexpr auto process_count = 4;
+const auto kernel_name       = std::string{"compile_lock_test.cl"};
+const auto code_object       = std::string{"not really a code object"};
+
+// Pretends to compile the kernel: records the compilation and saves the "code object" to the
+// cache as Handle::LoadProgram does.
+std::string Compile(const miopen::Handle& handle,
+                    const std::string& args,
+                    const boost::filesystem::path& log)
+{
+    std::ofstream{log.string(), std::ios::app} << "compiled" << std::endl;
+    std::this_thread::sleep_for(std::chrono::seconds(1));
+#if MIOPEN_ENABLE_SQLITE_KERN_CACHE
+    miopen::SaveBinary(
+        code_object, handle.GetTargetProperties(), handle.GetMaxComputeUnits(), kernel_name, args);
+#else
+    const auto path = miopen::GetCachePath(false) / boost::filesystem::unique_path();
+    miopen::WriteFile(code_object, path);
+    miopen::SaveBinary(path, handle.GetTargetProperties(), kernel_name, args);
+#endif
+    return code_object;
+}
+
+int RunChild(const std::string& args, const boost::filesystem::path& log)
+{
+    const auto handle = miopen::Handle{};
+    const auto result = miopen::CompileOnce(handle.GetTargetProperties(),
+                                            handle.GetMaxComputeUnits(),
+                                            kernel_name,
+                                            args,
+                                            false,
+                                            [&]() { return Compile(handle, args, log); });
+    return result == code_object ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+// Threads of one process compile unrelated programs at the same time.
+void CheckUnrelatedPrograms(const std::string& args)
+{
+    const auto handle = miopen::Handle{};
+    auto compiling    = std::atomic<int>{0};
+    auto overlapped   = std::atomic<bool>{false};
+
+    auto threads = std::vector<std::thread>{};
+    for(auto i = 0; i < 2; ++i)
+    {
+        threads.emplace_back([&, i]() {
+            miopen::CompileOnce(handle.GetTargetProperties(),
+                                handle.GetMaxComputeUnits(),
+                                kernel_name,
+                                args + " -DPROGRAM=" + std::to_string(i),
+                                false,
+                                [&]() {
+                                    if(++compiling > 1)
+                                        overlapped = true;
+                                    std::this_thread::sleep_for(std::chrono::seconds(1));
+                                    if(compiling > 1)
+                                        overlapped = true;
+                                    --compiling;
+                                    return code_object;
+                                });
+        });
+    }
+    for(auto& thread : threads)
+        thread.join();
+
+    EXPECT(overlapped);
+}
+
+std::size_t CountCompilations(const boost::filesystem::path& log)
+{
+    auto file  = std::ifstream{log.string()};
+    auto line  = std::string{};
+    auto count = std::size_t{0};
+    while(std::getline(file, line))
+        ++count;
+    return count;
+}
+
+} // namespace
+
+int main(int argc, const char* argv[])
+{
+    if(argc == 4 && std::string{argv[1]} == "--child")
+        return RunChild(argv[2], argv[3]);
+
+    const auto cache = miopen::TmpDir{"compile_lock"};
+    setenv("MIOPEN_CUSTOM_CACHE_DIR", cache.path.c_str(), 1);
+
+    if(miopen::IsCacheDisabled())
+    {
+        std::cout << "Kernel cache is disabled, skipping." << std::endl;
+        return EXIT_SUCCESS;
+    }
+
+    // Unique options make sure the program is not in any cache yet.
+    const auto args = "-DCOMPILE_LOCK_TEST=" + boost::filesystem::unique_path().string();
+    const auto log  = cache.path / "compilations.log";
+
+    auto children = std::vector<FILE*>{};
+    for(auto i = 0; i < process_count; ++i)
+    {
+        const auto command = std::string{argv[0]} + " --child " + args + " " + log.string();
+        children.push_back(popen(command.c_str(), "r"));
+        EXPECT(children.back() != nullptr);
+    }
+
+    for(auto child : children)
+        EXPECT(WEXITSTATUS(pclose(child)) == EXIT_SUCCESS);
+
+    // The processes that started while the first one was compiling have loaded its binary.
+    EXPECT(CountCompilations(log) == 1);
+
+    CheckUnrelatedPrograms(args);
+}
@@ -0,0 +1,131 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/conv/heuristics/cost_model.hpp>
+#include <miopen/temp_file.hpp>
+
+#include "test.hpp"
+
+#include <cmath>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace cm = miopen::ai::cost_model;
+
+static std::string MakeKey(int c, int hw, int k, int n)
+{
+    std::ostringstream ss;
+    ss << c << '-' << hw << '-' << hw << "-3x3-" << k << '-' << hw << '-' << hw << '-' << n
+       << "-1x1-1x1-1x1-0-NCHW-FP32-F";
+    return ss.str();
+}
+
+static void check_features()
+{
+    const auto fwd = cm::ExtractFeatures("64-56-56-3x3-128-56-56-8-1x1-1x1-1x1-0-NCHW-FP32-F");
+    EXPECT_EQUAL(fwd.size(), cm::GetFeatureCount());
+    // flops = 2 * N * K * C * OH * OW * FY * FX
+    EXPECT(std::abs(fwd[1] - std::log2(2.0 * 8 * 128 * 64 * 56 * 56 * 9)) < 1e-9);
+
+    // Backward keys swap input and output, which must not change the workload.
+    const auto bwd = cm::ExtractFeatures("128-56-56-3x3-64-56-56-8-1x1-1x1-1x1-0-NCHW-FP32-B");
+    EXPECT_EQUAL(bwd.size(), cm::GetFeatureCount());
+    EXPECT(std::abs(fwd[1] - bwd[1]) < 1e-9);
+    EXPECT(std::abs(fwd[2] - bwd[2]) < 1e-9);
+
+    const auto grouped =
+        cm::ExtractFeatures("64-56-56-3x3-64-56-56-8-1x1-1x1-1x1-0-NHWC-NHWC-NHWC-FP16-F_g64");
+    EXPECT_EQUAL(grouped.size(), cm::GetFeatureCount());
+
+    const auto conv3d =
+        cm::ExtractFeatures("1-1-1-1-1x4x4-512-1-4-4-128-0x0x0-1x1x1-1x1x1-0-NCDHW-FP32-B");
+    EXPECT_EQUAL(conv3d.size(), cm::GetFeatureCount());
+
+    EXPECT(cm::ExtractFeatures("").empty());
+    EXPECT(cm::ExtractFeatures("64-56-56-3x3-128").empty());
+    EXPECT(cm::ExtractFeatures("64-56-56-3x3-128-56-56-8-1x1-1x1-1x1-0-NCHW-FP32-X").empty());
+}
+
+static void check_read_find_db()
+{
+    std::istringstream ss{
+        "64-56-56-3x3-128-56-56-8-1x1-1x1-1x1-0-NCHW-FP32-F="
+        "GemmFwd1x1_0_1:0.5,0,miopenConvolutionFwdAlgoGEMM;"
+        "ConvBinWinogradRxSf2x3:0.25,0,miopenConvolutionFwdAlgoWinograd\n"
+        "1-1-1-3x3-2-3-3-128-0x0-1x1-1x1-0-NCHW-FP32-W="
+        "miopenConvolutionBwdWeightsAlgoWinograd:ConvBinWinogradRxSf2x3,0.12,0,"
+        "miopenConvolutionBwdWeightsAlgoWinograd,<unused>\n"
+        "garbage\n"};
+
+    const auto samples = cm::ReadFindDb(ss);
+    EXPECT(samples.size() == 2);
+    EXPECT(samples[0].times.size() == 2);
+    EXPECT(samples[0].times.at("ConvBinWinogradRxSf2x3") == 0.25f);
+    EXPECT(samples[1].times.at("ConvBinWinogradRxSf2x3") == 0.12f);
+}
+
+static void check_train_and_evaluate()
+{
+    // "Fast" has a large constant overhead and scales well, "Slow" is the opposite,
+    // so the winner depends on the problem size.
+    auto samples = std::vector<cm::Sample>{};
+    for(auto c = 8; c <= 512; c *= 2)
+    {
+        for(auto hw = 7; hw <= 112; hw *= 2)
+        {
+            const auto key  = MakeKey(c, hw, c, 16);
+            const auto work = static_cast<float>(c) * c * hw * hw;
+            samples.push_back({key, {{"Fast", 1.0f + work * 1e-8f}, {"Slow", work * 1e-7f}}});
+        }
+    }
+
+    const auto model = cm::Model::Train(samples);
+    EXPECT(model.GetSolverCount() == 2);
+    EXPECT(model.HasSolver("Fast"));
+    EXPECT(!model.HasSolver("Unknown"));
+    EXPECT(!model.Predict("Unknown", cm::ExtractFeatures(samples.front().key)));
+
+    const auto eval = model.Evaluate(samples);
+    EXPECT_EQUAL(eval.problems, samples.size());
+    EXPECT(eval.Top1Accuracy() > 0.8);
+    EXPECT(eval.mean_regret < 0.1);
+
+    miopen::TempFile file{"cost-model"};
+    model.Save(file.Path());
+    const auto loaded   = cm::Model::Load(file.Path());
+    const auto features = cm::ExtractFeatures(samples.back().key);
+    EXPECT(loaded.GetSolverCount() == 2);
+    EXPECT(std::abs(*loaded.Predict("Slow", features) - *model.Predict("Slow", features)) <
+           1e-3f * *model.Predict("Slow", features));
+}
+
+int main()
+{
+    check_features();
+    check_read_find_db();
+    check_train_and_evaluate();
+}
@@ -0,0 +1,156 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include "cpu_conv.hpp"
+#include "tensor_holder.hpp"
+#include "test.hpp"
+
+#include <cmath>
+#include <cstddef>
+#include <random>
+#include <vector>
+
+/// Cross-checks the im2col + GEMM and Winograd CPU references against the direct one.
+struct conv_case
+{
+    std::size_t n;
+    std::size_t c;
+    std::size_t k;
+    std::size_t groups;
+    std::vector<std::size_t> in_spatial;
+    std::vector<std::size_t> wei_spatial;
+    std::vector<int> pads;
+    std::vector<int> strides;
+    std::vector<int> dilations;
+};
+
+static tensor<float> random_tensor(const std::vector<std::size_t>& lens, std::mt19937& gen)
+{
+    auto dist   = std::uniform_real_distribution<float>{-1.0f, 1.0f};
+    auto result = tensor<float>{lens};
+    for(auto& x : result.data)
+        x = dist(gen);
+    return result;
+}
+
+static void expect_close(const tensor<float>& actual, const tensor<float>& expected)
+{
+    EXPECT_EQUAL(actual.data.size(), expected.data.size());
+    auto max_ref = 1.0;
+    for(const auto x : expected.data)
+        max_ref = std::max(max_ref, std::abs(static_cast<double>(x)));
+    for(std::size_t i = 0; i < actual.data.size(); ++i)
+        EXPECT(std::abs(static_cast<double>(actual.data[i]) - expected.data[i]) <= 1e-5 * max_ref);
+}
+
+static void check_case(const conv_case& cc, cpu_conv_engine engine)
+{
+    const auto dims = cc.in_spatial.size();
+    auto gen        = std::mt19937{static_cast<unsigned>(cc.n + cc.c * 7 + cc.k * 31 + dims)};
+
+    auto in_lens  = std::vector<std::size_t>{cc.n, cc.c};
+    auto wei_lens = std::vector<std::size_t>{cc.k, cc.c / cc.groups};
+    auto out_lens = std::vector<std::size_t>{cc.n, cc.k};
+    for(std::size_t i = 0; i < dims; ++i)
+    {
+        const auto window = cc.dilations[i] * (cc.wei_spatial[i] - 1) + 1;
+        in_lens.push_back(cc.in_spatial[i]);
+        wei_lens.push_back(cc.wei_spatial[i]);
+        out_lens.push_back((cc.in_spatial[i] + 2 * cc.pads[i] - window) / cc.strides[i] + 1);
+    }
+
+    const auto in   = random_tensor(in_lens, gen);
+    const auto wei  = random_tensor(wei_lens, gen);
+    const auto dout = random_tensor(out_lens, gen);
+
+    auto out_ref = tensor<float>{out_lens};
+    auto out     = tensor<float>{out_lens};
+    cpu_convolution_forward(dims,
+                            in,
+                            wei,
+                            out_ref,
+                            cc.pads,
+                            cc.strides,
+                            cc.dilations,
+                            cc.groups,
+                            cpu_conv_engine::direct);
+    cpu_convolution_forward(
+        dims, in, wei, out, cc.pads, cc.strides, cc.dilations, cc.groups, engine);
+    expect_close(out, out_ref);
+
+    auto din_ref = tensor<float>{in_lens};
+    auto din     = tensor<float>{in_lens};
+    cpu_convolution_backward_data(dims,
+                                  din_ref,
+                                  wei,
+                                  dout,
+                                  cc.pads,
+                                  cc.strides,
+                                  cc.dilations,
+                                  cc.groups,
+                                  cpu_conv_engine::direct);
+    cpu_convolution_backward_data(
+        dims, din, wei, dout, cc.pads, cc.strides, cc.dilations, cc.groups, engine);
+    expect_close(din, din_ref);
+
+    auto dwei_ref = tensor<float>{wei_lens};
+    auto dwei     = tensor<float>{wei_lens};
+    cpu_convolution_backward_weight(dims,
+                                    in,
+                                    dwei_ref,
+                                    dout,
+                                    cc.pads,
+                                    cc.strides,
+                                    cc.dilations,
+                                    cc.groups,
+                                    cpu_conv_engine::direct);
+    cpu_convolution_backward_weight(
+        dims, in, dwei, dout, cc.pads, cc.strides, cc.dilations, cc.groups, engine);
+    expect_close(dwei, dwei_ref);
+}
+
+int main()
+{
+    const conv_case cases[] = {
+        // Winograd F(2,3): odd and even outputs, with and without padding.
+        {2, 8, 16, 1, {9, 12}, {3, 3}, {1, 1}, {1, 1}, {1, 1}},
+        {1, 5, 3, 1, {8, 7}, {3, 3}, {0, 0}, {1, 1}, {1, 1}},
+        {3, 8, 8, 2, {6, 6}, {3, 3}, {2, 1}, {1, 1}, {1, 1}},
+        // Strided, dilated, grouped and 1x1 problems run on im2col + GEMM.
+        {2, 6, 4, 1, {11, 10}, {3, 3}, {1, 1}, {2, 2}, {1, 1}},
+        {1, 4, 6, 2, {13, 9}, {3, 2}, {2, 0}, {1, 2}, {2, 1}},
+        {4, 32, 16, 1, {7, 7}, {1, 1}, {0, 0}, {1, 1}, {1, 1}},
+        {2, 3, 5, 1, {70, 70}, {5, 5}, {2, 2}, {1, 1}, {1, 1}},
+        {2, 4, 4, 4, {17}, {3}, {1}, {2}, {1}},
+        {1, 4, 6, 1, {5, 6, 7}, {3, 3, 3}, {1, 1, 1}, {1, 2, 1}, {1, 1, 1}},
+    };
+
+    for(const auto& cc : cases)
+    {
+        check_case(cc, cpu_conv_engine::gemm);
+        check_case(cc, cpu_conv_engine::winograd);
+    }
+}
@@ -36,6 +36,7 @@
 #include <miopen/tensor.hpp>
 #include <utility>
 
+#include "cpu_conv_gemm.hpp"
 #include "tensor_holder.hpp"
 #include <miopen/stringutils.hpp>
 #include <miopen/functional.hpp>
@@ -76,12 +77,36 @@ void cpu_convolution_forward_impl(const tensor<Tin>& in,
                                   const Range& pads,
                                   const Range& strides,
                                   const Range& dilations,
-                                  std::size_t group_count)
+                                  std::size_t group_count,
+                                  cpu_conv_engine engine)
 {
     static_assert(ConvDim > 0, "wrong! convolution dim should be larger than 0");
     assert(in.desc.GetSize() == ConvDim + 2 and wei.desc.GetSize() == ConvDim + 2 and
            out.desc.GetSize() == ConvDim + 2 and pads.size() == ConvDim and
            strides.size() == ConvDim and dilations.size() == ConvDim);
+
+    if constexpr(std::is_floating_point<Tacc>{})
+    {
+        if(engine != cpu_conv_engine::direct && cpu_conv_gemm::applicable(in.desc, wei.desc))
+        {
+            const auto problem = cpu_conv_gemm::problem<ConvDim>{
+                in.desc, wei.desc, out.desc, pads, strides, dilations, group_count};
+            if constexpr(ConvDim == 2)
+            {
+                if(engine == cpu_conv_engine::winograd &&
+                   cpu_conv_gemm::winograd_applicable(problem))
+                {
+                    cpu_conv_gemm::forward_winograd<ConvDim, Tacc>(
+                        in.data.data(), wei.data.data(), out.data.data(), problem);
+                    return;
+                }
+            }
+            cpu_conv_gemm::forward<ConvDim, Tacc>(
+                in.data.data(), wei.data.data(), out.data.data(), problem);
+            return;
+        }
+    }
+
     std::size_t out_n_len = out.desc.GetLengths()[0];
 
     std::size_t wei_k_len = wei.desc.GetLengths()[0];
@@ -188,13 +213,28 @@ void cpu_convolution_backward_data_impl(tensor<Tin>& in,
                                         const Range& pads,
                                         const Range& strides,
                                         const Range& dilations,
-                                        std::size_t group_count)
+                                        std::size_t group_count,
+                                        cpu_conv_engine engine)
 {
     static_assert(ConvDim > 0, "wrong! convolution dim should be larger than 0");
     assert(in.desc.GetSize() == ConvDim + 2 and wei.desc.GetSize() == ConvDim + 2 and
            out.desc.GetSize() == ConvDim + 2 and pads.size() == ConvDim and
            strides.size() == ConvDim and dilations.size() == ConvDim);
 
+    if constexpr(std::is_floating_point<Tacc>{})
+    {
+        if(engine != cpu_conv_engine::direct && cpu_conv_gemm::applicable(in.desc, wei.desc))
+        {
+            cpu_conv_gemm::backward_data<ConvDim, Tacc>(
+                in.data.data(),
+                wei.data.data(),
+                out.data.data(),
+                cpu_conv_gemm::problem<ConvDim>{
+                    in.desc, wei.desc, out.desc, pads, strides, dilations, group_count});
+            return;
+        }
+    }
+
     std::size_t in_n_len = in.desc.GetLengths()[0];
     std::size_t in_c_len = in.desc.GetLengths()[1];
 
@@ -278,13 +318,28 @@ void cpu_convolution_backward_weight_impl(const tensor<Tin>& in,
                                           const Range& pads,
                                           const Range& strides,
                                           const Range& dilations,
-                                          std::size_t group_count)
+                                          std::size_t group_count,
+                                          cpu_conv_engine engine)
 {
     static_assert(ConvDim > 0, "wrong! convolution dim should be larger than 0");
     assert(in.desc.GetSize() == ConvDim + 2 and wei.desc.GetSize() == ConvDim + 2 and
            out.desc.GetSize() == ConvDim + 2 and pads.size() == ConvDim and
            strides.size() == ConvDim and dilations.size() == ConvDim);
 
+    if constexpr(std::is_floating_point<Tacc>{})
+    {
+        if(engine != cpu_conv_engine::direct && cpu_conv_gemm::applicable(in.desc, wei.desc))
+        {
+            cpu_conv_gemm::backward_weights<ConvDim, Tacc>(
+                in.data.data(),
+                wei.data.data(),
+                out.data.data(),
+                cpu_conv_gemm::problem<ConvDim>{
+                    in.desc, wei.desc, out.desc, pads, strides, dilations, group_count});
+            return;
+        }
+    }
+
     std::size_t out_n_len = out.desc.GetLengths()[0];
 
     std::size_t wei_k_len = wei.desc.GetLengths()[0];
@@ -358,7 +413,8 @@ void cpu_convolution_forward(std::size_t spatial_dim,
                              const Range& pads,
                              const Range& strides,
                              const Range& dilations,
-                             std::size_t group_count)
+                             std::size_t group_count,
+                             cpu_conv_engine engine = get_cpu_conv_engine())
 {
     using acc_type = typename cpu_convolution_acc_type<Tin, Twei, Tout>::type;
 
@@ -366,22 +422,22 @@ void cpu_convolution_forward(std::size_t spatial_dim,
     {
     case 1: {
         cpu_convolution_forward_impl<1, acc_type>(
-            in, wei, out, pads, strides, dilations, group_count);
+            in, wei, out, pads, strides, dilations, group_count, engine);
         break;
     }
     case 2: {
         cpu_convolution_forward_impl<2, acc_type>(
-            in, wei, out, pads, strides, dilations, group_count);
+            in, wei, out, pads, strides, dilations, group_count, engine);
         break;
     }
     case 3: {
         cpu_convolution_forward_impl<3, acc_type>(
-            in, wei, out, pads, strides, dilations, group_count);
+            in, wei, out, pads, strides, dilations, group_count, engine);
         break;
     }
     case 4: {
         cpu_convolution_forward_impl<4, acc_type>(
-            in, wei, out, pads, strides, dilations, group_count);
+            in, wei, out, pads, strides, dilations, group_count, engine);
         break;
     }
     default: {
@@ -398,7 +454,8 @@ void cpu_convolution_backward_data(std::size_t spatial_dim,
                                    const Range& pads,
                                    const Range& strides,
                                    const Range& dilations,
-                                   std::size_t group_count)
+                                   std::size_t group_count,
+                                   cpu_conv_engine engine = get_cpu_conv_engine())
 {
     using acc_type = typename cpu_convolution_acc_type<Tin, Twei, Tout>::type;
 
@@ -406,22 +463,22 @@ void cpu_convolution_backward_data(std::size_t spatial_dim,
     {
     case 1: {
         cpu_convolution_backward_data_impl<1, acc_type>(
-            in, wei, out, pads, strides, dilations, group_count);
+            in, wei, out, pads, strides, dilations, group_count, engine);
         break;
     }
     case 2: {
         cpu_convolution_backward_data_impl<2, acc_type>(
-            in, wei, out, pads, strides, dilations, group_count);
+            in, wei, out, pads, strides, dilations, group_count, engine);
         break;
     }
     case 3: {
         cpu_convolution_backward_data_impl<3, acc_type>(
-            in, wei, out, pads, strides, dilations, group_count);
+            in, wei, out, pads, strides, dilations, group_count, engine);
         break;
     }
     case 4: {
         cpu_convolution_backward_data_impl<4, acc_type>(
-            in, wei, out, pads, strides, dilations, group_count);
+            in, wei, out, pads, strides, dilations, group_count, engine);
         break;
     }
     default: {
@@ -438,7 +495,8 @@ void cpu_convolution_backward_weight(std::size_t spatial_dim,
                                      const Range& pads,
                                      const Range& strides,
                                      const Range& dilations,
-                                     std::size_t group_count)
+                                     std::size_t group_count,
+                                     cpu_conv_engine engine = get_cpu_conv_engine())
 {
     using acc_type = typename cpu_convolution_acc_type<Tin, Twei, Tout>::type;
 
@@ -446,22 +504,22 @@ void cpu_convolution_backward_weight(std::size_t spatial_dim,
     {
     case 1: {
         cpu_convolution_backward_weight_impl<1, acc_type>(
-            in, wei, out, pads, strides, dilations, group_count);
+            in, wei, out, pads, strides, dilations, group_count, engine);
         break;
     }
     case 2: {
         cpu_convolution_backward_weight_impl<2, acc_type>(
-            in, wei, out, pads, strides, dilations, group_count);
+            in, wei, out, pads, strides, dilations, group_count, engine);
         break;
     }
     case 3: {
         cpu_convolution_backward_weight_impl<3, acc_type>(
-            in, wei, out, pads, strides, dilations, group_count);
+            in, wei, out, pads, strides, dilations, group_count, engine);
         break;
     }
     case 4: {
         cpu_convolution_backward_weight_impl<4, acc_type>(
-            in, wei, out, pads, strides, dilations, group_count);
+            in, wei, out, pads, strides, dilations, group_count, engine);
         break;
     }
     default: {
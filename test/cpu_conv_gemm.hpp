@@ -0,0 +1,66 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#ifndef GUARD_CPU_CONV_GEMM_HPP
+#define GUARD_CPU_CONV_GEMM_HPP
+
+#include <miopen/cpu_conv_gemm.hpp>
+#include <miopen/env.hpp>
+
+#include <string>
+
+/// Selects the engine of the CPU reference convolution (see cpu_conv.hpp):
+///   direct   - loops over the output and the filter taps (default),
+///   gemm     - im2col + blocked GEMM,
+///   winograd - Winograd F(2,3) for 2D 3x3 stride 1 forward convolutions, gemm otherwise.
+/// Problems the gemm engine can't handle (vectorized tensors, integer accumulation) always
+/// run on the direct one. Tests can also pass the engine to the cpu_convolution_* calls.
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_TEST_CPU_CONV_ENGINE)
+
+enum class cpu_conv_engine
+{
+    direct,
+    gemm,
+    winograd,
+};
+
+inline cpu_conv_engine get_cpu_conv_engine()
+{
+    const auto* const value = miopen::GetStringEnv(MIOPEN_DEBUG_TEST_CPU_CONV_ENGINE{});
+    if(value == nullptr)
+        return cpu_conv_engine::direct;
+    const auto str = std::string{value};
+    if(str == "gemm")
+        return cpu_conv_engine::gemm;
+    if(str == "winograd")
+        return cpu_conv_engine::winograd;
+    return cpu_conv_engine::direct;
+}
+
+// The gemm and winograd engines live in the library, next to the host solvers that share them.
+namespace cpu_conv_gemm = miopen::cpu_conv_gemm;
+
+#endif
@@ -0,0 +1,181 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include "cpu_ctc.hpp"
+#include "test.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <random>
+#include <vector>
+
+/// Checks the host CTC reference against a sum over every alignment of tiny problems, and its
+/// gradients against central differences of that sum.
+struct ctc_case
+{
+    int classes;
+    int blank;
+    bool apply_softmax;
+    std::vector<int> input_lengths;
+    std::vector<std::vector<int>> labels;
+
+    std::size_t batch() const { return input_lengths.size(); }
+};
+
+/// Probabilities are stored batch-major to exercise the strides: [batch, time, class].
+static std::size_t offset(const ctc_case& p, int max_time, int t, std::size_t b, int c)
+{
+    return (b * max_time + t) * p.classes + c;
+}
+
+/// -log of the summed probability of all alignments that collapse to the label. Without the
+/// softmax layer the inputs are log-probabilities.
+static double brute_force_loss(const ctc_case& p,
+                               const std::vector<double>& in,
+                               int max_time,
+                               std::size_t b)
+{
+    const auto steps = p.input_lengths[b];
+    auto logp        = std::vector<double>(steps * p.classes);
+    for(auto t = 0; t < steps; ++t)
+    {
+        auto sum = 0.0;
+        for(auto c = 0; c < p.classes; ++c)
+            sum += std::exp(in[offset(p, max_time, t, b, c)]);
+        for(auto c = 0; c < p.classes; ++c)
+            logp[t * p.classes + c] = in[offset(p, max_time, t, b, c)] -
+                                      (p.apply_softmax ? std::log(sum) : 0.0);
+    }
+
+    const auto blank = std::min(p.blank, p.classes - 1);
+    auto total       = 0.0;
+    auto path        = std::vector<int>(steps, 0);
+    for(;;)
+    {
+        auto collapsed = std::vector<int>{};
+        for(auto t = 0; t < steps; ++t)
+            if(path[t] != blank && (t == 0 || path[t] != path[t - 1]))
+                collapsed.push_back(path[t]);
+        if(collapsed == p.labels[b])
+        {
+            auto log_prob = 0.0;
+            for(auto t = 0; t < steps; ++t)
+                log_prob += logp[t * p.classes + path[t]];
+            total += std::exp(log_prob);
+        }
+
+        auto t = 0;
+        while(t < steps && ++path[t] == p.classes)
+            path[t++] = 0;
+        if(t == steps)
+            break;
+    }
+    return -std::log(total);
+}
+
+static void check(const ctc_case& p, std::mt19937& gen)
+{
+    auto max_time = 0;
+    for(const auto len : p.input_lengths)
+        max_time = std::max(max_time, len);
+
+    auto labels        = std::vector<int>{};
+    auto label_lengths = std::vector<int>{};
+    for(const auto& label : p.labels)
+    {
+        labels.insert(labels.end(), label.begin(), label.end());
+        label_lengths.push_back(label.size());
+    }
+
+    const auto size = p.batch() * max_time * p.classes;
+    auto dist       = std::uniform_real_distribution<double>{-2.0, 1.0};
+    auto in         = std::vector<double>(size);
+    for(auto& x : in)
+        x = dist(gen);
+
+    const auto strides = std::vector<std::size_t>{
+        static_cast<std::size_t>(p.classes), max_time * static_cast<std::size_t>(p.classes), 1};
+    auto reference = ctc::HostCTCLoss<double>{
+        max_time, p.classes, labels, label_lengths, p.input_lengths, p.blank, p.apply_softmax};
+
+    auto losses    = std::vector<double>(p.batch());
+    auto gradients = std::vector<double>(size, 1.0);
+    reference.Run(in.data(), strides, losses.data(), gradients.data(), strides);
+
+    for(std::size_t b = 0; b < p.batch(); ++b)
+    {
+        const auto expected = brute_force_loss(p, in, max_time, b);
+        EXPECT(std::abs(losses[b] - expected) < 1e-9 * std::abs(expected) + 1e-12);
+
+        for(auto t = 0; t < max_time; ++t)
+        {
+            for(auto c = 0; c < p.classes; ++c)
+            {
+                const auto i = offset(p, max_time, t, b, c);
+                if(t >= p.input_lengths[b])
+                {
+                    EXPECT_EQUAL(gradients[i], 0.0);
+                    continue;
+                }
+
+                const auto h = 1e-5;
+                auto shifted = in;
+                shifted[i]   = in[i] + h;
+                const auto up = brute_force_loss(p, shifted, max_time, b);
+                shifted[i]    = in[i] - h;
+                const auto down = brute_force_loss(p, shifted, max_time, b);
+                auto numeric    = (up - down) / (2 * h);
+                // Without the softmax layer the gradient is taken w.r.t. the probability.
+                if(!p.apply_softmax)
+                    numeric /= std::exp(in[i]);
+                EXPECT(std::abs(gradients[i] - numeric) < 1e-6 * (1 + std::abs(numeric)));
+            }
+        }
+    }
+
+    // The lattices are reused, so a second run must reproduce the first one exactly.
+    auto losses2    = std::vector<double>(p.batch());
+    auto gradients2 = std::vector<double>(size);
+    reference.Run(in.data(), strides, losses2.data(), gradients2.data(), strides);
+    EXPECT(losses2 == losses);
+    EXPECT(gradients2 == gradients);
+}
+
+int main()
+{
+    auto gen = std::mt19937{2023};
+    for(const auto softmax : {true, false})
+    {
+        check({3, 0, softmax, {4}, {{1, 2}}}, gen);
+        check({3, 0, softmax, {5, 3, 6}, {{1, 1}, {2}, {2, 1, 2}}}, gen);
+        check({4, 2, softmax, {6, 4}, {{0, 1, 3}, {3, 3}}}, gen);
+        // Out of range blank ids are clamped to the last class.
+        check({3, 7, softmax, {5, 2}, {{0, 1}, {1}}}, gen);
+        // Label length plus repeats equals the input length: a single alignment.
+        check({3, 0, softmax, {5}, {{1, 1, 2}}}, gen);
+    }
+}
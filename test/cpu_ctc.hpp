@@ -0,0 +1,279 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#ifndef GUARD_CPU_CTC_HPP
+#define GUARD_CPU_CTC_HPP
+
+#include <miopen/par_for.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace ctc {
+
+/// Log-domain stand-in for zero probability; every lattice entry is clamped to it.
+constexpr double negative_cutoff = -1e20;
+
+/// log(exp(x) + exp(y)). The difference of the arguments is never compared against the cutoff:
+/// below it exp() underflows to zero and the result is max(x, y) either way, so the function
+/// stays branch-free in the lattice loops.
+template <typename T>
+inline T LogAddExp(T x, T y)
+{
+    const auto a = std::max(x, y);
+    const auto b = std::min(x, y);
+    return std::max(T(a + std::log1p(std::exp(b - a))), T(negative_cutoff));
+}
+
+/// CTC loss and its gradients for a [time, batch, class] tensor of probabilities. Batch entries
+/// are independent and run in parallel, and so do the log-softmax rows. The alpha lattices, the
+/// two rolling beta rows and the per-class accumulators are allocated by the constructor, so
+/// Run() doesn't allocate.
+template <typename T>
+class HostCTCLoss
+{
+public:
+    HostCTCLoss(int max_time_step_,
+                int class_sz_,
+                const std::vector<int>& labels,
+                const std::vector<int>& label_lengths,
+                const std::vector<int>& input_lengths_,
+                int blank_lb,
+                bool apply_softmax_layer_)
+        : max_time_step(max_time_step_),
+          batch_size(input_lengths_.size()),
+          class_sz(class_sz_),
+          apply_softmax_layer(apply_softmax_layer_),
+          input_lengths(input_lengths_.begin(), input_lengths_.end()),
+          states(batch_size)
+    {
+        if(label_lengths.size() != batch_size)
+            throw std::runtime_error("CTC: label batch size does not match input batch size");
+
+        blank = blank_lb < 0 ? 0 : (blank_lb >= class_sz_ ? class_sz_ - 1 : blank_lb);
+
+        auto max_label_len = 0;
+        for(const auto len : label_lengths)
+            max_label_len = std::max(max_label_len, len);
+        max_states = 2 * max_label_len + 1;
+        width      = max_states + 4;
+
+        label_prime.resize(batch_size * max_states, blank);
+        skips.resize(batch_size * width, 0);
+
+        auto offset = std::size_t{0};
+        for(std::size_t b = 0; b < batch_size; ++b)
+        {
+            const auto len = label_lengths[b];
+            auto repeat    = 0;
+            for(auto i = 0; i < len; ++i)
+            {
+                const auto label = labels.at(offset + i);
+                if(label < 0 || label >= class_sz_)
+                    throw std::runtime_error("CTC: wrong label id at batch " + std::to_string(b));
+                if(i > 0 && label == labels[offset + i - 1])
+                    ++repeat;
+                label_prime[b * max_states + 2 * i + 1] = label;
+            }
+            offset += len;
+
+            if(len < 1 || input_lengths[b] > max_time_step_ || len + repeat > input_lengths[b])
+                throw std::runtime_error("CTC: wrong input or label length at batch " +
+                                         std::to_string(b));
+
+            states[b]       = 2 * len + 1;
+            const auto* lab = &label_prime[b * max_states];
+            auto* skip      = &skips[b * width] + 2;
+            for(auto s = 2; s < states[b]; ++s)
+                skip[s] = lab[s] != blank && lab[s] != lab[s - 2];
+        }
+
+        logp.resize(static_cast<std::size_t>(max_time_step) * batch_size * class_sz);
+        alphas.resize(batch_size * max_time_step * width, T(negative_cutoff));
+        betas.resize(batch_size * 2 * width, T(negative_cutoff));
+        accumulators.resize(batch_size * class_sz, T(negative_cutoff));
+    }
+
+    /// Strides are those of the [time, batch, class] tensors. Gradients past the input length of
+    /// a batch entry are zeroed.
+    template <typename Tin>
+    void Run(const Tin* probs,
+             const std::vector<std::size_t>& probs_strides,
+             T* losses,
+             T* gradients,
+             const std::vector<std::size_t>& grads_strides)
+    {
+        LogSoftmax(probs, probs_strides);
+        miopen::par_for(batch_size, miopen::min_grain{1}, [&](auto b) {
+            losses[b] = RunBatch(b, gradients, grads_strides);
+        });
+    }
+
+private:
+    static constexpr std::size_t softmax_work = std::size_t{1} << 14;
+
+    int max_time_step;
+    std::size_t batch_size;
+    int class_sz;
+    int blank = 0;
+    bool apply_softmax_layer;
+    std::vector<int> input_lengths;
+    std::vector<int> states;
+    int max_states = 1;
+    std::size_t width;
+
+    std::vector<int> label_prime;
+    std::vector<char> skips; // skip[s]: state s may be entered from s - 2
+    std::vector<T> logp;     // packed [time, batch, class]
+    std::vector<T> alphas;   // [batch, time, width], two cutoff pads on either side of a row
+    std::vector<T> betas;    // [batch, 2, width]
+    std::vector<T> accumulators;
+
+    const T* LogProbs(int t, std::size_t b) const
+    {
+        return &logp[(t * batch_size + b) * class_sz];
+    }
+    T* Alpha(std::size_t b, int t) { return &alphas[(b * max_time_step + t) * width] + 2; }
+    T* Beta(std::size_t b, int t) { return &betas[(b * 2 + t % 2) * width] + 2; }
+
+    template <typename Tin>
+    void LogSoftmax(const Tin* probs, const std::vector<std::size_t>& strides)
+    {
+        const auto rows  = max_time_step * batch_size;
+        const auto grain = std::max<std::size_t>(1, softmax_work / class_sz);
+        miopen::par_for(rows, miopen::min_grain{grain}, [&](auto row) {
+            const auto t = row / batch_size;
+            const auto b = row % batch_size;
+            if(static_cast<int>(t) >= input_lengths[b])
+                return;
+
+            const auto* in = probs + t * strides[0] + b * strides[1];
+            auto* out      = &logp[row * class_sz];
+            for(auto c = 0; c < class_sz; ++c)
+                out[c] = static_cast<T>(in[c * strides[2]]);
+            if(!apply_softmax_layer)
+                return;
+
+            const auto max_val = *std::max_element(out, out + class_sz);
+            auto sum           = T(0);
+            for(auto c = 0; c < class_sz; ++c)
+                sum += std::exp(out[c] - max_val);
+            const auto log_sum = max_val + std::log(sum);
+            for(auto c = 0; c < class_sz; ++c)
+                out[c] = std::max(T(out[c] - log_sum), T(negative_cutoff));
+        });
+    }
+
+    T RunBatch(std::size_t b, T* gradients, const std::vector<std::size_t>& strides)
+    {
+        const auto steps = input_lengths[b];
+        const auto S     = states[b];
+        const auto* lab  = &label_prime[b * max_states];
+        const auto* skip = &skips[b * width] + 2;
+        const auto none  = T(negative_cutoff);
+
+        // The cutoff pads make s - 1, s - 2 and s + 1, s + 2 valid for every state, so both
+        // recurrences run without bound checks.
+        auto* alpha0 = Alpha(b, 0);
+        alpha0[0]    = LogProbs(0, b)[lab[0]];
+        alpha0[1]    = LogProbs(0, b)[lab[1]];
+        for(auto t = 1; t < steps; ++t)
+        {
+            const auto* prev = Alpha(b, t - 1);
+            const auto* p    = LogProbs(t, b);
+            auto* cur        = Alpha(b, t);
+            for(auto s = 0; s < S; ++s)
+            {
+                const auto x =
+                    LogAddExp(LogAddExp(prev[s], prev[s - 1]), skip[s] ? prev[s - 2] : none);
+                cur[s] = std::max(T(x + p[lab[s]]), none);
+            }
+        }
+
+        const auto* last   = Alpha(b, steps - 1);
+        const auto prob_lx = LogAddExp(last[S - 1], last[S - 2]);
+
+        auto* acc = &accumulators[b * class_sz];
+        for(auto t = steps - 1; t >= 0; --t)
+        {
+            const auto* p     = LogProbs(t, b);
+            const auto* alpha = Alpha(b, t);
+            auto* cur         = Beta(b, t);
+            if(t == steps - 1)
+            {
+                std::fill(cur, cur + S - 2, none);
+                cur[S - 2] = p[lab[S - 2]];
+                cur[S - 1] = p[lab[S - 1]];
+            }
+            else
+            {
+                const auto* next = Beta(b, t + 1);
+                for(auto s = 0; s < S; ++s)
+                {
+                    const auto x = LogAddExp(LogAddExp(next[s], next[s + 1]),
+                                             skip[s + 2] ? next[s + 2] : none);
+                    cur[s] = std::max(T(x + p[lab[s]]), none);
+                }
+            }
+
+            for(auto s = 0; s < S; ++s)
+                acc[lab[s]] = LogAddExp(acc[lab[s]], T(alpha[s] + cur[s]));
+
+            // Classes that are not in the label only get the cutoff from the lattice, which
+            // vanishes after exp(), so just the label classes need the accumulated term. The
+            // accumulator is reset as it is consumed to handle classes repeated in the label.
+            auto* grad = gradients + t * strides[0] + b * strides[1];
+            for(auto c = 0; c < class_sz; ++c)
+                grad[c * strides[2]] = apply_softmax_layer ? T(std::exp(p[c])) : T(0);
+            for(auto s = 0; s < S; ++s)
+            {
+                const auto c = lab[s];
+                if(acc[c] == none)
+                    continue;
+                const auto excess = apply_softmax_layer ? p[c] : T(2 * p[c]);
+                grad[c * strides[2]] -= std::exp(std::max(T(acc[c] - excess - prob_lx), none));
+                acc[c] = none;
+            }
+        }
+
+        for(auto t = steps; t < max_time_step; ++t)
+        {
+            auto* grad = gradients + t * strides[0] + b * strides[1];
+            for(auto c = 0; c < class_sz; ++c)
+                grad[c * strides[2]] = T(0);
+        }
+
+        return -prob_lx;
+    }
+};
+
+} // namespace ctc
+
+#endif
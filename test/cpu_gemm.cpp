@@ -0,0 +1,143 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/bfloat16.hpp>
+#include <miopen/cpu_gemm.hpp>
+
+#include <half.hpp>
+
+#include "test.hpp"
+
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <random>
+#include <vector>
+
+struct GemmCase
+{
+    std::size_t m;
+    std::size_t n;
+    std::size_t k;
+};
+
+template <class T>
+static std::vector<T> RandomMatrix(std::size_t size, std::mt19937& gen)
+{
+    auto dist   = std::uniform_real_distribution<float>{-1.0f, 1.0f};
+    auto result = std::vector<T>(size);
+    for(auto& x : result)
+        x = static_cast<T>(dist(gen));
+    return result;
+}
+
+template <class Tacc, class T>
+static void check_gemm(const GemmCase& shape, bool trans_a, bool trans_b, double beta, double tol)
+{
+    auto gen = std::mt19937{static_cast<unsigned>(shape.m * 131 + shape.n * 17 + shape.k)};
+
+    // Leading dimensions are padded to check that the strides are honored.
+    const auto lda = (trans_a ? shape.m : shape.k) + 3;
+    const auto ldb = (trans_b ? shape.k : shape.n) + 1;
+    const auto ldc = shape.n + 2;
+    const auto a   = RandomMatrix<T>((trans_a ? shape.k : shape.m) * lda, gen);
+    const auto b   = RandomMatrix<T>((trans_b ? shape.n : shape.k) * ldb, gen);
+    auto c         = RandomMatrix<T>(shape.m * ldc, gen);
+    if(beta == 0)
+        std::fill(c.begin(), c.end(), static_cast<T>(std::numeric_limits<float>::quiet_NaN()));
+    auto ref = std::vector<double>(c.begin(), c.end());
+
+    const auto alpha = 0.75;
+    for(std::size_t i = 0; i < shape.m; ++i)
+    {
+        for(std::size_t j = 0; j < shape.n; ++j)
+        {
+            auto sum = 0.0;
+            for(std::size_t p = 0; p < shape.k; ++p)
+            {
+                const auto x = trans_a ? a[p * lda + i] : a[i * lda + p];
+                const auto y = trans_b ? b[j * ldb + p] : b[p * ldb + j];
+                sum += static_cast<double>(x) * static_cast<double>(y);
+            }
+            const auto prior   = beta == 0 ? 0.0 : beta * ref[i * ldc + j];
+            ref[i * ldc + j] = alpha * sum + prior;
+        }
+    }
+
+    miopen::CpuGemm<Tacc>(trans_a,
+                          trans_b,
+                          shape.m,
+                          shape.n,
+                          shape.k,
+                          alpha,
+                          a.data(),
+                          lda,
+                          b.data(),
+                          ldb,
+                          beta,
+                          c.data(),
+                          ldc);
+
+    for(std::size_t i = 0; i < shape.m; ++i)
+    {
+        for(std::size_t j = 0; j < shape.n; ++j)
+        {
+            const auto expected = ref[i * ldc + j];
+            const auto actual   = static_cast<double>(c[i * ldc + j]);
+            EXPECT(std::abs(actual - expected) <= tol * (1.0 + std::sqrt(shape.k)));
+        }
+        // Padding between rows of C must stay untouched.
+        for(std::size_t j = shape.n; j < ldc && i + 1 < shape.m; ++j)
+            EXPECT(beta == 0 ? std::isnan(static_cast<double>(c[i * ldc + j]))
+                             : static_cast<double>(c[i * ldc + j]) == ref[i * ldc + j]);
+    }
+}
+
+template <class Tacc, class T>
+static void check_all(double tol)
+{
+    const GemmCase shapes[] = {
+        {1, 1, 1}, {7, 5, 3}, {6, 16, 256}, {97, 257, 300}, {200, 300, 64}, {33, 1000, 17}};
+    for(const auto& shape : shapes)
+    {
+        for(const auto trans_a : {false, true})
+        {
+            for(const auto trans_b : {false, true})
+            {
+                check_gemm<Tacc, T>(shape, trans_a, trans_b, 0.0, tol);
+                check_gemm<Tacc, T>(shape, trans_a, trans_b, 0.5, tol);
+            }
+        }
+    }
+}
+
+int main()
+{
+    check_all<double, double>(1e-12);
+    check_all<float, float>(1e-5);
+    check_all<float, half_float::half>(1e-2);
+    check_all<double, bfloat16>(1e-1);
+}
@@ -0,0 +1,226 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include "cpu_reduce.hpp"
+#include "test.hpp"
+
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+/// Checks the host ReduceTensor reference against a per-element walk over index vectors.
+struct reduce_case
+{
+    std::vector<int> lengths;
+    std::vector<int> strides;
+    std::vector<int> toReduceDims;
+};
+
+static std::vector<int> packed_strides(const std::vector<int>& lengths)
+{
+    auto strides = std::vector<int>(lengths.size(), 1);
+    for(auto i = static_cast<int>(lengths.size()) - 2; i >= 0; --i)
+        strides[i] = strides[i + 1] * lengths[i + 1];
+    return strides;
+}
+
+static float naive_pre(miopenReduceTensorOp_t op, float x)
+{
+    if(op == MIOPEN_REDUCE_TENSOR_NORM1 || op == MIOPEN_REDUCE_TENSOR_AMAX)
+        return std::abs(x);
+    if(op == MIOPEN_REDUCE_TENSOR_NORM2)
+        return x * x;
+    return x;
+}
+
+static void check(const reduce_case& c,
+                  miopenReduceTensorOp_t op,
+                  miopenNanPropagation_t nanOpt,
+                  miopenReduceTensorIndices_t indicesOpt,
+                  const std::vector<float>& input)
+{
+    const auto dims       = c.lengths.size();
+    auto invariantDims    = std::vector<int>{};
+    auto outLengths       = c.lengths;
+    auto invariantLengths = std::vector<int>{};
+    auto toReduceLengths  = std::vector<int>{};
+    auto is_reduced       = std::vector<bool>(dims, false);
+    for(const auto dim : c.toReduceDims)
+    {
+        is_reduced[dim] = true;
+        outLengths[dim] = 1;
+        toReduceLengths.push_back(c.lengths[dim]);
+    }
+    for(std::size_t dim = 0; dim < dims; ++dim)
+    {
+        if(!is_reduced[dim])
+        {
+            invariantDims.push_back(dim);
+            invariantLengths.push_back(c.lengths[dim]);
+        }
+    }
+    const auto outStrides = packed_strides(outLengths);
+    auto outSize          = std::size_t{1};
+    for(const auto len : outLengths)
+        outSize *= len;
+
+    const auto reduction = reduce::HostReduction<float, float>{op,
+                                                              miopenFloat,
+                                                              nanOpt,
+                                                              indicesOpt,
+                                                              c.lengths,
+                                                              c.strides,
+                                                              outStrides,
+                                                              invariantDims,
+                                                              c.toReduceDims};
+    const auto alpha = 2.0f;
+    const auto beta  = 0.5f;
+    auto out         = std::vector<float>(outSize, 1.0f);
+    auto indices     = std::vector<int>(outSize, -1);
+    reduction.Run(alpha, input.data(), beta, out.data(), indices.data());
+
+    const auto extremum = op == MIOPEN_REDUCE_TENSOR_MIN || op == MIOPEN_REDUCE_TENSOR_MAX ||
+                          op == MIOPEN_REDUCE_TENSOR_AMAX;
+    auto indexes_1 = std::vector<std::vector<int>>{};
+    auto indexes_2 = std::vector<std::vector<int>>{};
+    if(!invariantLengths.empty())
+        get_all_indexes(invariantLengths, 0, indexes_1);
+    else
+        indexes_1.push_back({});
+    get_all_indexes(toReduceLengths, 0, indexes_2);
+
+    for(const auto& index_1 : indexes_1)
+    {
+        auto src_index = std::vector<int>(dims, 0);
+        auto dst_index = std::vector<int>(dims, 0);
+        for(std::size_t k = 0; k < invariantDims.size(); ++k)
+            src_index[invariantDims[k]] = dst_index[invariantDims[k]] = index_1[k];
+
+        auto accu      = double{reduce::ReduceOpZeroVal<float>(op)};
+        auto accuIndex = 0;
+        for(const auto& index_2 : indexes_2)
+        {
+            for(std::size_t k = 0; k < c.toReduceDims.size(); ++k)
+                src_index[c.toReduceDims[k]] = index_2[k];
+            const auto value =
+                naive_pre(op, input[get_offset_from_index(c.strides, src_index)]);
+            const auto index = get_flatten_offset(toReduceLengths, index_2);
+            if(nanOpt == MIOPEN_PROPAGATE_NAN && std::isnan(value))
+            {
+                accu      = value;
+                accuIndex = index;
+            }
+            else if(op == MIOPEN_REDUCE_TENSOR_MIN ? accu > value
+                    : extremum                     ? accu < value
+                                                   : false)
+            {
+                accu      = value;
+                accuIndex = index;
+            }
+            else if(op == MIOPEN_REDUCE_TENSOR_MUL)
+                accu *= value;
+            else if(!extremum)
+                accu += value;
+        }
+        if(op == MIOPEN_REDUCE_TENSOR_NORM2)
+            accu = std::sqrt(accu);
+        if(op == MIOPEN_REDUCE_TENSOR_AVG)
+            accu /= indexes_2.size();
+        accu = accu * alpha + beta;
+
+        const auto dst = get_offset_from_index(outStrides, dst_index);
+        if(std::isnan(accu))
+        {
+            EXPECT(std::isnan(out[dst]));
+        }
+        else
+        {
+            EXPECT(std::abs(out[dst] - accu) <= 1e-4 * (1.0 + std::abs(accu)));
+        }
+        if(extremum && indicesOpt == MIOPEN_REDUCE_TENSOR_FLATTENED_INDICES)
+            EXPECT_EQUAL(indices[dst], accuIndex);
+    }
+}
+
+int main()
+{
+    auto gen = std::mt19937{};
+    // Few distinct values, so extrema are tied and indices must point at the first one.
+    auto dist = std::uniform_int_distribution<int>{-8, 8};
+
+    const auto cases = std::vector<reduce_case>{
+        {{2, 3, 4, 5}, packed_strides({2, 3, 4, 5}), {1}},
+        {{2, 3, 4, 5}, packed_strides({2, 3, 4, 5}), {2, 3}},
+        {{2, 3, 4, 5}, packed_strides({2, 3, 4, 5}), {0, 2}},
+        {{2, 3, 4, 5}, packed_strides({2, 3, 4, 5}), {0, 1, 2, 3}},
+        // NHWC strides of an NCHW-ordered descriptor
+        {{2, 3, 4, 5}, {60, 1, 15, 3}, {1}},
+        {{2, 3, 4, 5}, {60, 1, 15, 3}, {0, 2, 3}},
+        // Large enough to be split into several chunks per output
+        {{3, 257, 301}, packed_strides({3, 257, 301}), {1, 2}},
+        {{200001}, {1}, {0}},
+    };
+
+    const auto ops = {MIOPEN_REDUCE_TENSOR_ADD,
+                      MIOPEN_REDUCE_TENSOR_MUL,
+                      MIOPEN_REDUCE_TENSOR_MIN,
+                      MIOPEN_REDUCE_TENSOR_MAX,
+                      MIOPEN_REDUCE_TENSOR_AMAX,
+                      MIOPEN_REDUCE_TENSOR_AVG,
+                      MIOPEN_REDUCE_TENSOR_NORM1,
+                      MIOPEN_REDUCE_TENSOR_NORM2};
+
+    for(const auto& c : cases)
+    {
+        auto size = std::size_t{1};
+        for(std::size_t dim = 0; dim < c.lengths.size(); ++dim)
+            size += static_cast<std::size_t>(c.lengths[dim] - 1) * c.strides[dim];
+
+        auto input = std::vector<float>(size);
+        for(auto& x : input)
+            x = dist(gen) / 8.0f;
+
+        for(const auto op : ops)
+        {
+            // Keep products finite and away from zero.
+            auto data = input;
+            if(op == MIOPEN_REDUCE_TENSOR_MUL)
+                for(auto& x : data)
+                    x = 1.0f + x / 4096.0f;
+
+            for(const auto indicesOpt :
+                {MIOPEN_REDUCE_TENSOR_NO_INDICES, MIOPEN_REDUCE_TENSOR_FLATTENED_INDICES})
+            {
+                auto nan_data      = data;
+                nan_data[size / 3] = std::numeric_limits<float>::quiet_NaN();
+                nan_data[size / 2] = std::numeric_limits<float>::quiet_NaN();
+                check(c, op, MIOPEN_NOT_PROPAGATE_NAN, indicesOpt, data);
+                check(c, op, MIOPEN_PROPAGATE_NAN, indicesOpt, nan_data);
+            }
+        }
+    }
+}
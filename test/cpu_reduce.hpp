@@ -0,0 +1,409 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#ifndef GUARD_CPU_REDUCE_HPP
+#define GUARD_CPU_REDUCE_HPP
+
+#include "cpu_reduce_util.hpp"
+
+#include <miopen/par_for.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace reduce {
+
+template <miopenReduceTensorOp_t Op>
+constexpr bool IsExtremum()
+{
+    return Op == MIOPEN_REDUCE_TENSOR_MIN || Op == MIOPEN_REDUCE_TENSOR_MAX ||
+           Op == MIOPEN_REDUCE_TENSOR_AMAX;
+}
+
+template <miopenReduceTensorOp_t Op, typename compType>
+inline compType PreUnaryOp(compType a)
+{
+    using std::abs;
+
+    if constexpr(Op == MIOPEN_REDUCE_TENSOR_NORM1 || Op == MIOPEN_REDUCE_TENSOR_AMAX)
+        return abs(a);
+    else if constexpr(Op == MIOPEN_REDUCE_TENSOR_NORM2)
+        return a * a;
+    else
+        return a;
+}
+
+/// Whether b replaces a as the extremum. Ties keep a, so the first extremum wins.
+template <miopenReduceTensorOp_t Op, typename compType>
+inline bool Replaces(compType a, compType b)
+{
+    if constexpr(Op == MIOPEN_REDUCE_TENSOR_MIN)
+        return a > b;
+    else
+        return a < b;
+}
+
+template <miopenReduceTensorOp_t Op, bool PropagateNan, typename compType>
+inline void ReduceOp(compType& a, compType b)
+{
+    using std::isnan;
+
+    if constexpr(IsExtremum<Op>())
+    {
+        // NaN propagates through arithmetic operations by itself.
+        if((PropagateNan && isnan(b)) || Replaces<Op>(a, b))
+            a = b;
+    }
+    else if constexpr(Op == MIOPEN_REDUCE_TENSOR_MUL)
+        a = a * b;
+    else
+        a = a + b;
+}
+
+/// Host reference of ReduceTensor.
+///
+/// Dimension lengths and strides are linearized once. Reduced dimensions keep their order, so
+/// flattened indices match the device, and neighbours that are contiguous in memory are merged
+/// to make the innermost loop as long as possible. Outputs, and reductions cut into fixed size
+/// chunks, are spread over host threads. Chunks are merged in order, so results don't depend on
+/// the number of threads and indices keep pointing at the first extremum.
+template <typename Tin, typename Tout>
+class HostReduction
+{
+public:
+    HostReduction(miopenReduceTensorOp_t reduceOp_,
+                  miopenDataType_t compTypeVal_,
+                  miopenNanPropagation_t nanOpt_,
+                  miopenReduceTensorIndices_t indicesOpt_,
+                  const std::vector<int>& inLengths,
+                  const std::vector<int>& inStrides,
+                  const std::vector<int>& outStrides,
+                  const std::vector<int>& invariantDims,
+                  const std::vector<int>& toReduceDims)
+        : reduceOp(reduceOp_), compTypeVal(compTypeVal_), nanOpt(nanOpt_), indicesOpt(indicesOpt_)
+    {
+        assert(!toReduceDims.empty());
+
+        for(const auto dim : invariantDims)
+        {
+            invariant.push_back({static_cast<std::size_t>(inLengths[dim]),
+                                 static_cast<std::size_t>(inStrides[dim]),
+                                 static_cast<std::size_t>(outStrides[dim])});
+            outputs *= invariant.back().length;
+        }
+
+        for(const auto dim : toReduceDims)
+        {
+            const auto length = static_cast<std::size_t>(inLengths[dim]);
+            const auto stride = static_cast<std::size_t>(inStrides[dim]);
+            reduceTotal *= length;
+            if(!reduced.empty() && reduced.back().inStride == length * stride)
+            {
+                reduced.back().length *= length;
+                reduced.back().inStride = stride;
+            }
+            else
+            {
+                reduced.push_back({length, stride, 0});
+            }
+        }
+        assert(reduced.size() <= max_dims);
+    }
+
+    void Run(float alpha, const Tin* in_data, float beta, Tout* out_data, int* indices) const
+    {
+        if(compTypeVal == miopenFloat)
+        {
+            if(std::is_same<Tout, double>::value)
+                RunImpl<double>(alpha, in_data, beta, out_data, indices);
+            else
+                RunImpl<float>(alpha, in_data, beta, out_data, indices);
+        }
+        else if(compTypeVal == miopenHalf)
+        {
+            if(std::is_same<Tout, double>::value || std::is_same<Tout, float>::value)
+                RunImpl<Tout>(alpha, in_data, beta, out_data, indices);
+            else
+                RunImpl<half_float::half>(alpha, in_data, beta, out_data, indices);
+        }
+        else if(compTypeVal == miopenDouble)
+            RunImpl<double>(alpha, in_data, beta, out_data, indices);
+    }
+
+private:
+    struct Dim
+    {
+        std::size_t length;
+        std::size_t inStride;
+        std::size_t outStride;
+    };
+
+    static constexpr std::size_t max_dims   = 8;
+    static constexpr std::size_t chunk_size = std::size_t{1} << 16;
+    static constexpr std::size_t lanes      = 8;
+
+    miopenReduceTensorOp_t reduceOp;
+    miopenDataType_t compTypeVal;
+    miopenNanPropagation_t nanOpt;
+    miopenReduceTensorIndices_t indicesOpt;
+
+    std::vector<Dim> invariant;
+    std::vector<Dim> reduced; // innermost last
+    std::size_t outputs     = 1;
+    std::size_t reduceTotal = 1;
+
+    template <typename compType>
+    void RunImpl(float alpha, const Tin* in_data, float beta, Tout* out_data, int* indices) const
+    {
+        switch(reduceOp)
+        {
+        case MIOPEN_REDUCE_TENSOR_ADD:
+            return RunNan<compType, MIOPEN_REDUCE_TENSOR_ADD>(
+                alpha, in_data, beta, out_data, indices);
+        case MIOPEN_REDUCE_TENSOR_MUL:
+            return RunNan<compType, MIOPEN_REDUCE_TENSOR_MUL>(
+                alpha, in_data, beta, out_data, indices);
+        case MIOPEN_REDUCE_TENSOR_MIN:
+            return RunNan<compType, MIOPEN_REDUCE_TENSOR_MIN>(
+                alpha, in_data, beta, out_data, indices);
+        case MIOPEN_REDUCE_TENSOR_MAX:
+            return RunNan<compType, MIOPEN_REDUCE_TENSOR_MAX>(
+                alpha, in_data, beta, out_data, indices);
+        case MIOPEN_REDUCE_TENSOR_AMAX:
+            return RunNan<compType, MIOPEN_REDUCE_TENSOR_AMAX>(
+                alpha, in_data, beta, out_data, indices);
+        case MIOPEN_REDUCE_TENSOR_AVG:
+            return RunNan<compType, MIOPEN_REDUCE_TENSOR_AVG>(
+                alpha, in_data, beta, out_data, indices);
+        case MIOPEN_REDUCE_TENSOR_NORM1:
+            return RunNan<compType, MIOPEN_REDUCE_TENSOR_NORM1>(
+                alpha, in_data, beta, out_data, indices);
+        case MIOPEN_REDUCE_TENSOR_NORM2:
+            return RunNan<compType, MIOPEN_REDUCE_TENSOR_NORM2>(
+                alpha, in_data, beta, out_data, indices);
+        }
+
+        throw std::runtime_error(std::string(__FUNCTION__) +
+                                 ": using undefined Reduction operation is not permitted");
+    }
+
+    template <typename compType, miopenReduceTensorOp_t Op>
+    void RunNan(float alpha, const Tin* in_data, float beta, Tout* out_data, int* indices) const
+    {
+        if(nanOpt == MIOPEN_PROPAGATE_NAN)
+            RunOp<compType, Op, true>(alpha, in_data, beta, out_data, indices);
+        else
+            RunOp<compType, Op, false>(alpha, in_data, beta, out_data, indices);
+    }
+
+    template <typename compType, miopenReduceTensorOp_t Op, bool PropagateNan>
+    void RunOp(float alpha, const Tin* in_data, float beta, Tout* out_data, int* indices) const
+    {
+        using std::isnan;
+        using std::sqrt;
+
+        const bool need_indices =
+            IsExtremum<Op>() && indicesOpt == MIOPEN_REDUCE_TENSOR_FLATTENED_INDICES;
+
+        const auto zero   = ReduceOpZeroVal<compType>(Op);
+        const auto chunks = (reduceTotal + chunk_size - 1) / chunk_size;
+        auto values       = std::vector<compType>(outputs * chunks, zero);
+        auto positions    = std::vector<int>(need_indices ? outputs * chunks : 0, 0);
+
+        // Each chunk reduces part of one output.
+        const auto chunk_work = std::min(reduceTotal, chunk_size);
+        miopen::par_for(
+            outputs * chunks, miopen::min_grain{chunk_size / chunk_work}, [&](std::size_t i) {
+                const auto output = i / chunks;
+                const auto first  = i % chunks * chunk_size;
+                const auto last   = std::min(reduceTotal, first + chunk_size);
+                const auto base   = Offset(output, &Dim::inStride);
+                if(need_indices)
+                    ReduceWithIndex<compType, Op, PropagateNan>(
+                        in_data, base, first, last, values[i], positions[i]);
+                else
+                    values[i] =
+                        Reduce<compType, Op, PropagateNan>(in_data, base, first, last, zero);
+            });
+
+        miopen::par_for(outputs, miopen::min_grain{chunk_size / chunks}, [&](std::size_t output) {
+            const auto first  = output * chunks;
+            compType accuVal  = values[first];
+            int accuIndex     = need_indices ? positions[first] : 0;
+            for(std::size_t i = first + 1; i < first + chunks; ++i)
+            {
+                if(!need_indices)
+                {
+                    ReduceOp<Op, PropagateNan>(accuVal, values[i]);
+                }
+                else if((PropagateNan && isnan(values[i])) || Replaces<Op>(accuVal, values[i]))
+                {
+                    accuVal   = values[i];
+                    accuIndex = positions[i];
+                }
+            }
+
+            if constexpr(Op == MIOPEN_REDUCE_TENSOR_NORM2)
+                accuVal = sqrt(accuVal);
+            if constexpr(Op == MIOPEN_REDUCE_TENSOR_AVG)
+                accuVal = accuVal / convert_type<compType>(static_cast<float>(reduceTotal));
+
+            // scale the accumulated value
+            const auto dst_offset = Offset(output, &Dim::outStride);
+            if(!float_equal_one(alpha))
+                accuVal *= convert_type<compType>(alpha);
+
+            // scale the prior dst value and add it to the accumulated value
+            if(!float_equal_zero(beta))
+                accuVal +=
+                    convert_type<compType>(out_data[dst_offset]) * convert_type<compType>(beta);
+
+            // store the reduced value to dst location
+            out_data[dst_offset] = convert_type<Tout>(accuVal);
+            if(need_indices)
+                indices[dst_offset] = accuIndex;
+        });
+    }
+
+    /// Offset of an output, given as a row-major index over the invariant dimensions.
+    std::size_t Offset(std::size_t output, std::size_t Dim::*stride) const
+    {
+        auto offset = std::size_t{0};
+        for(auto dim = invariant.size(); dim-- > 0;)
+        {
+            offset += output % invariant[dim].length * invariant[dim].*stride;
+            output /= invariant[dim].length;
+        }
+        return offset;
+    }
+
+    /// Calls f(offset, count, stride, index) for the runs along the innermost reduced dimension
+    /// that cover flattened reduction indices [first, last).
+    template <class F>
+    void ForEachRun(std::size_t base, std::size_t first, std::size_t last, F f) const
+    {
+        const auto inner = reduced.size() - 1;
+        std::size_t pos[max_dims];
+        auto offset = base;
+        auto rest   = first;
+        for(auto dim = reduced.size(); dim-- > 0;)
+        {
+            pos[dim] = rest % reduced[dim].length;
+            rest /= reduced[dim].length;
+            offset += pos[dim] * reduced[dim].inStride;
+        }
+
+        for(auto index = first; index < last;)
+        {
+            const auto count = std::min(reduced[inner].length - pos[inner], last - index);
+            f(offset, count, reduced[inner].inStride, index);
+            index += count;
+            offset += count * reduced[inner].inStride;
+            pos[inner] += count;
+
+            // carry into the outer dimensions
+            for(auto dim = inner; dim > 0 && pos[dim] == reduced[dim].length; --dim)
+            {
+                offset -= pos[dim] * reduced[dim].inStride;
+                pos[dim] = 0;
+                ++pos[dim - 1];
+                offset += reduced[dim - 1].inStride;
+            }
+        }
+    }
+
+    template <typename compType, miopenReduceTensorOp_t Op, bool PropagateNan>
+    compType Reduce(
+        const Tin* in_data, std::size_t base, std::size_t first, std::size_t last, compType zero)
+        const
+    {
+        // Independent accumulators let the inner loop vectorize.
+        compType accu[lanes];
+        std::fill(accu, accu + lanes, zero);
+
+        ForEachRun(base, first, last, [&](auto offset, auto count, auto stride, auto) {
+            const auto data = in_data + offset;
+            const auto run  = [&](auto step) {
+                std::size_t i = 0;
+                for(; i + lanes <= count; i += lanes)
+                {
+                    for(std::size_t l = 0; l < lanes; ++l)
+                    {
+                        const auto value = convert_type<compType>(data[(i + l) * step]);
+                        ReduceOp<Op, PropagateNan>(accu[l], PreUnaryOp<Op>(value));
+                    }
+                }
+                for(; i < count; ++i)
+                {
+                    const auto value = convert_type<compType>(data[i * step]);
+                    ReduceOp<Op, PropagateNan>(accu[0], PreUnaryOp<Op>(value));
+                }
+            };
+            if(stride == 1)
+                run(std::integral_constant<std::size_t, 1>{});
+            else
+                run(stride);
+        });
+
+        for(std::size_t l = 1; l < lanes; ++l)
+            ReduceOp<Op, PropagateNan>(accu[0], accu[l]);
+        return accu[0];
+    }
+
+    template <typename compType, miopenReduceTensorOp_t Op, bool PropagateNan>
+    void ReduceWithIndex(const Tin* in_data,
+                         std::size_t base,
+                         std::size_t first,
+                         std::size_t last,
+                         compType& accuVal,
+                         int& accuIndex) const
+    {
+        using std::isnan;
+
+        ForEachRun(base, first, last, [&](auto offset, auto count, auto stride, auto index) {
+            for(std::size_t i = 0; i < count; ++i)
+            {
+                const auto value =
+                    PreUnaryOp<Op>(convert_type<compType>(in_data[offset + i * stride]));
+                if((PropagateNan && isnan(value)) || Replaces<Op>(accuVal, value))
+                {
+                    accuVal   = value;
+                    accuIndex = static_cast<int>(index + i);
+                }
+            }
+        });
+    }
+};
+
+} // namespace reduce
+
+#endif
@@ -30,6 +30,7 @@
 #include <limits>
 #include <cmath>
 #include <cassert>
+#include <functional>
 #include <stdexcept>
 #include <string>
 #include <miopen/miopen.h>
@@ -643,32 +643,29 @@ struct test_driver
                     }
                 }
 
-                auto mxdiff = miopen::max_diff(out_cpu, out_gpu);
-                std::cout << "Max diff: " << mxdiff << std::endl;
-                //            auto max_idx = miopen::mismatch_diff(out_cpu, out_gpu, mxdiff);
-                //            std::cout << "Max diff at " << max_idx << ": " << out_cpu[max_idx] <<
-                //            " !=
-                //            " << out_gpu[max_idx] << std::endl;
-
-                if(miopen::range_zero(out_cpu))
+                const auto diff = miopen::compare_ranges(out_cpu, out_gpu);
+                std::cout << "Max diff: " << diff.max_abs << std::endl;
+                std::cout << "Max relative diff: " << diff.max_rel << std::endl;
+
+                if(diff.max_mag1 == 0 && diff.not_finite1 == diff.size)
                     std::cout << "Cpu data is all zeros" << std::endl;
-                if(miopen::range_zero(out_gpu))
+                if(diff.max_mag2 == 0 && diff.not_finite2 == diff.size)
                     std::cout << "Gpu data is all zeros" << std::endl;
 
-                auto idx = miopen::mismatch_idx(out_cpu, out_gpu, miopen::float_equal);
-                if(idx < miopen::range_distance(out_cpu))
+                const auto idx = diff.mismatch;
+                if(idx < diff.size)
                 {
                     std::cout << "Mismatch at " << idx << ": " << out_cpu[idx]
                               << " != " << out_gpu[idx] << std::endl;
                 }
 
-                auto cpu_nan_idx = find_idx(out_cpu, miopen::not_finite);
-                if(cpu_nan_idx >= 0)
+                const auto cpu_nan_idx = diff.not_finite1;
+                if(cpu_nan_idx < diff.size)
                     std::cout << "Non finite number found in cpu at " << cpu_nan_idx << ": "
                               << out_cpu[cpu_nan_idx] << std::endl;
 
-                auto gpu_nan_idx = find_idx(out_gpu, miopen::not_finite);
-                if(gpu_nan_idx >= 0)
+                const auto gpu_nan_idx = diff.not_finite2;
+                if(gpu_nan_idx < diff.size)
                     std::cout << "Non finite number found in gpu at " << gpu_nan_idx << ": "
                               << out_gpu[gpu_nan_idx] << std::endl;
             }
@@ -912,9 +909,9 @@ struct test_driver
             }
             else
             {
-                std::srand(65521);
+                prng::reset_seed(65521);
                 static_cast<Derived*>(this)->run();
-                std::srand(65521);
+                prng::reset_seed(65521);
             }
         }
         this->iteration++;
@@ -1088,10 +1085,10 @@ build_configs(Driver& d,
     std::vector<typename Driver::argument*> data_args = get_data_args<Driver>(d, arg_map);
 
     run_data(data_args.begin(), data_args.end(), [&] {
-        std::srand(65521);
+        prng::reset_seed(65521);
         std::vector<std::string> config = d.get_config();
         configs.push_back(config);
-        std::srand(65521);
+        prng::reset_seed(65521);
     });
     std::cout << " done." << std::endl;
     return configs;
@@ -1147,9 +1144,9 @@ void run_config(std::vector<std::string>& config,
     for(int j = 0; j < test_repeat_count; j++)
     {
         run_data(config_data_args.begin(), config_data_args.end(), [&] {
-            std::srand(65521);
+            prng::reset_seed(65521);
             config_driver.run();
-            std::srand(65521);
+            prng::reset_seed(65521);
         });
     }
 }
@@ -1291,7 +1288,7 @@ void test_drive_impl_1(std::string program_name, std::vector<std::string> as)
             data_args.push_back(&arg);
         }
     }
-    std::srand(65521);
+    prng::reset_seed(65521);
     for(int i = 0; i < d.repeat; i++)
     {
         d.iteration = 0;
@@ -310,7 +310,7 @@ struct dropout_driver : test_driver
         auto reserveSpace = std::vector<unsigned char>(in.desc.GetElementSize());
         if(mask)
         {
-            srand(0);
+            prng::reset_seed(0);
             for(size_t i = 0; i < in.desc.GetElementSize(); i++)
                 reserveSpace[i] =
                     static_cast<unsigned char>(float(GET_RAND()) / float(RAND_MAX) > dropout_rate);
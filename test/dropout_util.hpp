@@ -37,11 +37,14 @@
 #include <utility>
 
 #include <miopen/dropout.hpp>
+#include <miopen/float_equal.hpp>
 #include <miopen/miopen.h>
 #include <miopen/tensor.hpp>
 #include <miopen/precalc_xorwow_skipahead_matrices.hpp>
 #include <miopen/precalc_xorwow_skipahead_sequence_matrices.hpp>
 
+#include "ford.hpp"
+
 #define ROCRAND_2POW32_INV (2.3283064e-10f)
 
 #define XORWOW_DIM 5
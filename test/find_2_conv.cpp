@@ -31,6 +31,7 @@
 #include <miopen/miopen.h>
 
 #include <miopen/convolution.hpp>
+#include <miopen/find_session.hpp>
 #include <miopen/solution.hpp>
 
 #include <nlohmann/json.hpp>
@@ -119,9 +120,11 @@ private:
 
         std::ignore          = TestFindSolutions(handle, problem);
         const auto solutions = TestFindSolutionsWithOptions(handle, problem);
+        TestFindSolutionsAsync(handle, problem);
 
         TestSolutionAttributes(solutions);
         TestRunSolutions(handle, solutions);
+        TestFindSession(handle, problem);
 
         EXPECT_EQUAL(miopenDestroyProblem(problem), miopenStatusSuccess);
     }
@@ -292,6 +295,25 @@ private:
             EXPECT_EQUAL(miopenDestroySolution(solution), miopenStatusSuccess);
 
             miopenSolution_t read_solution;
+            EXPECT_EQUAL(
+                miopenLoadSolution(&read_solution, solution_binary.data(), solution_binary.size()),
+                miopenStatusSuccess);
+
+            TestRunSolution(handle, read_solution, 3, names, descriptors, buffers);
+
+            // Save-load cycle with embedded kernels
+            EXPECT_EQUAL(miopenEmbedSolutionKernels(handle, read_solution), miopenStatusSuccess);
+
+            std::size_t embedded_size;
+            EXPECT_EQUAL(miopenGetSolutionSize(read_solution, &embedded_size),
+                         miopenStatusSuccess);
+            EXPECT(embedded_size > solution_size);
+
+            solution_binary.resize(embedded_size);
+            EXPECT_EQUAL(miopenSaveSolution(read_solution, solution_binary.data()),
+                         miopenStatusSuccess);
+            EXPECT_EQUAL(miopenDestroySolution(read_solution), miopenStatusSuccess);
+
             EXPECT_EQUAL(
                 miopenLoadSolution(&read_solution, solution_binary.data(), solution_binary.size()),
                 miopenStatusSuccess);
@@ -303,6 +325,97 @@ private:
         std::cerr << "Finished testing solution functions." << std::endl;
     }
 
+    void TestFindSolutionsAsync(miopenHandle_t handle, miopenProblem_t problem)
+    {
+        std::cerr << "Testing miopenFindSolutionsAsync..." << std::endl;
+
+        miopenFindFuture_t future;
+        EXPECT_EQUAL(miopenFindSolutionsAsync(handle, problem, nullptr, 100, &future),
+                     miopenStatusSuccess);
+        EXPECT_EQUAL(miopenWaitFindFuture(future), miopenStatusSuccess);
+
+        int ready;
+        EXPECT_EQUAL(miopenIsFindFutureReady(future, &ready), miopenStatusSuccess);
+        EXPECT_EQUAL(ready, 1);
+
+        std::size_t found;
+        auto solutions = std::vector<miopenSolution_t>(100);
+        EXPECT_EQUAL(
+            miopenGetFindFutureSolutions(future, solutions.data(), &found, solutions.size()),
+            miopenStatusSuccess);
+        for(auto i = std::size_t{0}; i < found; ++i)
+            EXPECT_EQUAL(miopenDestroySolution(solutions[i]), miopenStatusSuccess);
+        EXPECT_EQUAL(miopenDestroyFindFuture(future), miopenStatusSuccess);
+
+        // Find results may come from the find-db, so the cancelled find may complete before the
+        // cancellation request and both outcomes are valid.
+        EXPECT_EQUAL(miopenFindSolutionsAsync(handle, problem, nullptr, 100, &future),
+                     miopenStatusSuccess);
+        EXPECT_EQUAL(miopenCancelFindFuture(future), miopenStatusSuccess);
+        const auto status =
+            miopenGetFindFutureSolutions(future, solutions.data(), &found, solutions.size());
+        EXPECT(status == miopenStatusSuccess || status == miopenStatusCanceled);
+        if(status == miopenStatusSuccess)
+        {
+            for(auto i = std::size_t{0}; i < found; ++i)
+                EXPECT_EQUAL(miopenDestroySolution(solutions[i]), miopenStatusSuccess);
+        }
+        EXPECT_EQUAL(miopenDestroyFindFuture(future), miopenStatusSuccess);
+
+        std::cerr << "Finished testing miopenFindSolutionsAsync." << std::endl;
+    }
+
+    void TestFindSession(miopenHandle_t handle, miopenProblem_t problem)
+    {
+        std::cerr << "Testing find session..." << std::endl;
+
+        miopenFindSession_t session;
+        EXPECT_EQUAL(miopenCreateFindSession(&session), miopenStatusSuccess);
+
+        // The same problem twice is found only once
+        std::size_t ids[2];
+        EXPECT_EQUAL(miopenFindSessionAddProblem(session, problem, &ids[0]), miopenStatusSuccess);
+        EXPECT_EQUAL(miopenFindSessionAddProblem(session, problem, &ids[1]), miopenStatusSuccess);
+        EXPECT(ids[0] != ids[1]);
+        EXPECT(miopen::deref(session).GetUniqueProblemCount() == 1);
+
+        EXPECT_EQUAL(miopenRunFindSession(handle, session, nullptr, 100), miopenStatusSuccess);
+
+        std::size_t fastest_workspace, planned_workspace;
+        EXPECT_EQUAL(miopenPlanFindSessionWorkspace(session, 0.f, &fastest_workspace),
+                     miopenStatusSuccess);
+        EXPECT_EQUAL(miopenPlanFindSessionWorkspace(session, 1e6f, &planned_workspace),
+                     miopenStatusSuccess);
+        EXPECT_OP(planned_workspace, <=, fastest_workspace);
+
+        for(const auto id : ids)
+        {
+            std::size_t found;
+            auto solutions = std::vector<miopenSolution_t>(100);
+            EXPECT_EQUAL(miopenGetFindSessionSolutions(
+                             session, id, solutions.data(), &found, solutions.size()),
+                         miopenStatusSuccess);
+            for(auto i = std::size_t{0}; i < found; ++i)
+                EXPECT_EQUAL(miopenDestroySolution(solutions[i]), miopenStatusSuccess);
+
+            if(found == 0)
+                continue;
+
+            miopenSolution_t planned;
+            std::size_t workspace_size;
+            EXPECT_EQUAL(miopenGetFindSessionPlannedSolution(session, id, &planned),
+                         miopenStatusSuccess);
+            EXPECT_EQUAL(miopenGetSolutionWorkspaceSize(planned, &workspace_size),
+                         miopenStatusSuccess);
+            EXPECT_OP(workspace_size, <=, planned_workspace);
+            EXPECT_EQUAL(miopenDestroySolution(planned), miopenStatusSuccess);
+        }
+
+        EXPECT_EQUAL(miopenDestroyFindSession(session), miopenStatusSuccess);
+
+        std::cerr << "Finished testing find session." << std::endl;
+    }
+
     void TestRunSolution(miopenHandle_t handle,
                          miopenSolution_t solution,
                          std::size_t num_arguments,
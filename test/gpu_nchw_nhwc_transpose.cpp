@@ -184,7 +184,7 @@ struct to_miopen_data_type<uint8_t>
 static int gen_rand_integer()
 {
     static const int inited = []() -> int {
-        std::srand(std::time(nullptr));
+        prng::reset_seed(std::time(nullptr));
         return 1;
     }();
     std::ignore = inited;
@@ -70,7 +70,7 @@ std::string tensor_layout_to_string(tensor_layout_t layout)
 static int gen_rand_integer()
 {
     static const bool once = []() {
-        std::srand(std::time(nullptr));
+        prng::reset_seed(std::time(nullptr));
         return true;
     }();
     std::ignore = once;
@@ -25,8 +25,6 @@
  *******************************************************************************/
 #pragma once
 
-#include <random>
-
 #include <gtest/gtest.h>
 #include <miopen/miopen.h>
 #include <miopen/solver_id.hpp>
@@ -35,6 +33,7 @@
 
 #include "tensor_util.hpp"
 #include "get_handle.hpp"
+#include "random.hpp"
 #include "conv_common.hpp"
 
 template <typename T>
@@ -132,10 +131,7 @@ protected:
         std::tie(activ_mode, conv_config, tensor_layout) = GetParam();
         input   = tensor<T>{miopen_type<T>{}, tensor_layout, conv_config.GetInput()};
         weights = tensor<T>{miopen_type<T>{}, tensor_layout, conv_config.GetWeights()};
-        std::random_device rd{};
-        std::mt19937 gen{rd()};
-        std::uniform_real_distribution<> d{-3, 3};
-        auto gen_value = [&](auto...) { return d(gen); };
+        auto gen_value = [](auto...) { return prng::gen_A_to_B(-3.0, 3.0); };
         input.generate(gen_value);
         weights.generate(gen_value);
         activ_desc = {activ_mode, activ_alpha, activ_beta, activ_gamma};
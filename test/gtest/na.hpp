@@ -25,8 +25,6 @@
  *******************************************************************************/
 #pragma once
 
-#include <random>
-
 #include <gtest/gtest.h>
 #include <miopen/miopen.h>
 #include <miopen/solver_id.hpp>
@@ -35,6 +33,7 @@
 
 #include "tensor_util.hpp"
 #include "get_handle.hpp"
+#include "random.hpp"
 
 struct BNTestCase
 {
@@ -107,17 +106,14 @@ protected:
         shift       = tensor<T>{derivedBnDesc.GetLengths()};
         estMean     = tensor<T>{derivedBnDesc.GetLengths()};
         estVariance = tensor<T>{derivedBnDesc.GetLengths()};
-        std::random_device rd{};
-        std::mt19937 gen{rd()};
-        std::uniform_int_distribution<> d{0, 100};
-        auto gen_value = [&](auto...) {
-            return 1e-2 * static_cast<T>(d(gen)) * ((d(gen) % 2 == 1) ? -1 : 1);
+        auto gen_value = [](auto...) {
+            return 1e-2 * static_cast<T>(GET_RAND() % 101) * ((GET_RAND() % 2 == 1) ? -1 : 1);
         };
         input.generate(gen_value);
         scale.generate(gen_value);
         shift.generate(gen_value);
         estMean.generate(gen_value);
-        auto gen_var = [&](auto...) { return 1e-2 * (static_cast<T>(d(gen)) + 1); };
+        auto gen_var = [](auto...) { return 1e-2 * (static_cast<T>(GET_RAND() % 101) + 1); };
         estVariance.generate(gen_var);
         activ_desc    = {activ_mode, activ_alpha, activ_beta, activ_gamma};
         output        = tensor<T>{bn_config.GetInput()};
@@ -0,0 +1,389 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/activ.hpp>
+#include <miopen/batch_norm.hpp>
+#include <miopen/convolution.hpp>
+#include <miopen/pooling.hpp>
+#include <miopen/softmax.hpp>
+#include <miopen/solver.hpp>
+#include <miopen/solver/host.hpp>
+#include <miopen/tensor_ops.hpp>
+
+#include "cpu_conv.hpp"
+#include "fusionHost.hpp"
+#include "get_handle.hpp"
+#include "pooling_common.hpp"
+#include "random.hpp"
+#include "tensor_holder.hpp"
+#include "test.hpp"
+#include "verify.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+/// Runs the host solvers of the nogpu backend through the library and compares them with the
+/// CPU references of the other tests. Does nothing on the backends without host solvers.
+namespace {
+
+using Direction = miopen::conv::Direction;
+
+constexpr double tolerance = 1e-5;
+
+template <class T>
+tensor<T> random_tensor(const std::vector<std::size_t>& lens)
+{
+    return tensor<T>{lens}.generate([](auto...) { return prng::gen_A_to_B(-1.0f, 1.0f); });
+}
+
+template <class T>
+bool near(const tensor<T>& actual, const tensor<T>& expected)
+{
+    const auto error = miopen::rms_range(actual.data, expected.data);
+    if(!(error <= tolerance))
+        std::cout << "FAILED: rms error " << error << std::endl;
+    return error <= tolerance;
+}
+
+const miopen::solver::Id conv_host_solvers[] = {
+    miopen::solver::Id{miopen::solver::ConvDirectHost{}.SolverDbId()},
+    miopen::solver::Id{miopen::solver::ConvGemmHost{}.SolverDbId()},
+};
+
+struct conv_case
+{
+    std::vector<std::size_t> in;
+    std::vector<std::size_t> wei;
+    std::vector<int> pads;
+    std::vector<int> strides;
+    std::vector<int> dilations;
+    int groups;
+};
+
+void check_convolution(const conv_case& c)
+{
+    auto&& handle   = get_handle();
+    const auto ctx  = miopen::ExecutionContext{&handle}.DetectRocm();
+    const auto dims = c.in.size() - 2;
+    const auto conv = miopen::ConvolutionDescriptor{dims,
+                                                    miopenConvolution,
+                                                    miopenPaddingDefault,
+                                                    c.pads,
+                                                    c.strides,
+                                                    c.dilations,
+                                                    std::vector<int>(dims, 0),
+                                                    c.groups};
+
+    const auto x = random_tensor<float>(c.in);
+    const auto w = random_tensor<float>(c.wei);
+    auto y       = tensor<float>{conv.GetForwardOutputTensor(x.desc, w.desc)};
+    y.generate([](auto...) { return prng::gen_A_to_B(-1.0f, 1.0f); });
+
+    auto y_ref = tensor<float>{y.desc};
+    auto x_ref = tensor<float>{x.desc};
+    auto w_ref = tensor<float>{w.desc};
+    cpu_convolution_forward(dims, x, w, y_ref, c.pads, c.strides, c.dilations, c.groups);
+    cpu_convolution_backward_data(dims, x_ref, w, y, c.pads, c.strides, c.dilations, c.groups);
+    cpu_convolution_backward_weight(dims, x, w_ref, y, c.pads, c.strides, c.dilations, c.groups);
+
+    const auto fwd =
+        miopen::conv::ProblemDescription{x.desc, w.desc, y.desc, conv, Direction::Forward};
+    const auto bwd =
+        miopen::conv::ProblemDescription{y.desc, w.desc, x.desc, conv, Direction::BackwardData};
+    const auto wrw =
+        miopen::conv::ProblemDescription{y.desc, w.desc, x.desc, conv, Direction::BackwardWeights};
+
+    // Without find-db records the immediate mode falls back to the host solvers.
+    for(const auto& problem : {fwd, bwd, wrw})
+    {
+        auto fallback        = false;
+        const auto solutions = conv.GetSolutions(ctx, problem, 1, &fallback);
+        EXPECT(!solutions.empty());
+        if(fallback)
+            EXPECT(std::count(std::begin(conv_host_solvers),
+                              std::end(conv_host_solvers),
+                              miopen::solver::Id{solutions.front().solution_id}) == 1);
+    }
+
+    auto x_dev = handle.Write(x.data);
+    auto w_dev = handle.Write(w.data);
+    auto y_dev = handle.Write(y.data);
+
+    for(const auto& id : conv_host_solvers)
+    {
+        std::cout << id.ToString() << std::endl;
+
+        auto ws_size = conv.GetForwardSolutionWorkspaceSize(handle, w.desc, x.desc, y.desc, id);
+        auto ws_dev  = handle.Create(std::max<std::size_t>(ws_size, 1));
+        auto out_dev = handle.Create<float>(y.data.size());
+        conv.CompileSolution(ctx, fwd, id);
+        conv.ConvolutionForwardImmediate(handle,
+                                         w.desc,
+                                         w_dev.get(),
+                                         x.desc,
+                                         x_dev.get(),
+                                         y.desc,
+                                         out_dev.get(),
+                                         ws_dev.get(),
+                                         ws_size,
+                                         id);
+        auto out = tensor<float>{y.desc};
+        out.data = handle.Read<float>(out_dev, out.data.size());
+        EXPECT(near(out, y_ref));
+
+        ws_size = conv.GetBackwardSolutionWorkspaceSize(handle, y.desc, w.desc, x.desc, id);
+        ws_dev  = handle.Create(std::max<std::size_t>(ws_size, 1));
+        out_dev = handle.Create<float>(x.data.size());
+        conv.CompileSolution(ctx, bwd, id);
+        conv.ConvolutionBackwardImmediate(handle,
+                                          y.desc,
+                                          y_dev.get(),
+                                          w.desc,
+                                          w_dev.get(),
+                                          x.desc,
+                                          out_dev.get(),
+                                          ws_dev.get(),
+                                          ws_size,
+                                          id);
+        out      = tensor<float>{x.desc};
+        out.data = handle.Read<float>(out_dev, out.data.size());
+        EXPECT(near(out, x_ref));
+
+        ws_size = conv.GetWrwSolutionWorkspaceSize(handle, y.desc, x.desc, w.desc, id);
+        ws_dev  = handle.Create(std::max<std::size_t>(ws_size, 1));
+        out_dev = handle.Create<float>(w.data.size());
+        conv.CompileSolution(ctx, wrw, id);
+        conv.ConvolutionWrwImmediate(handle,
+                                     y.desc,
+                                     y_dev.get(),
+                                     x.desc,
+                                     x_dev.get(),
+                                     w.desc,
+                                     out_dev.get(),
+                                     ws_dev.get(),
+                                     ws_size,
+                                     id);
+        out      = tensor<float>{w.desc};
+        out.data = handle.Read<float>(out_dev, out.data.size());
+        EXPECT(near(out, w_ref));
+    }
+}
+
+void check_activation(miopenActivationMode_t mode)
+{
+    auto&& handle    = get_handle();
+    const auto alpha = 0.5;
+    const auto beta  = 1.5;
+    const auto gamma = 2.0;
+    auto desc        = miopen::ActivationDescriptor{mode, alpha, beta, gamma};
+
+    const auto x = random_tensor<float>({2, 3, 17, 9});
+    auto y_ref   = tensor<float>{x.desc};
+    activationHostInfer(mode, gamma, beta, alpha, x.data, y_ref.data);
+
+    auto x_dev       = handle.Write(x.data);
+    auto y_dev       = handle.Create<float>(x.data.size());
+    const float one  = 1.0f;
+    const float zero = 0.0f;
+    desc.Forward(handle, &one, x.desc, x_dev.get(), &zero, x.desc, y_dev.get());
+    auto y = tensor<float>{x.desc};
+    y.data = handle.Read<float>(y_dev, y.data.size());
+    EXPECT(near(y, y_ref));
+}
+
+void check_pooling(miopenPoolingMode_t mode)
+{
+    auto&& handle = get_handle();
+    const auto desc = miopen::PoolingDescriptor{mode, miopenPaddingDefault, {3, 3}, {2, 2}, {1, 1}};
+
+    const auto x     = random_tensor<float>({2, 3, 13, 11});
+    auto indices     = std::vector<std::uint8_t>{};
+    const auto y_ref = verify_forward_pooling<2>{}.cpu(x, desc, indices);
+
+    auto x_dev         = handle.Write(x.data);
+    auto y_dev         = handle.Create<float>(y_ref.data.size());
+    const auto ws_size = desc.GetWorkSpaceSize(y_ref.desc);
+    auto ws_dev        = handle.Create(std::max<std::size_t>(ws_size, 1));
+    const float one    = 1.0f;
+    const float zero   = 0.0f;
+    desc.Forward(handle,
+                 &one,
+                 x.desc,
+                 x_dev.get(),
+                 &zero,
+                 y_ref.desc,
+                 y_dev.get(),
+                 mode == miopenPoolingMax,
+                 ws_dev.get(),
+                 ws_size);
+    auto y = tensor<float>{y_ref.desc};
+    y.data = handle.Read<float>(y_dev, y.data.size());
+    EXPECT(near(y, y_ref));
+}
+
+void check_batchnorm_inference()
+{
+    auto&& handle       = get_handle();
+    const auto epsilon  = 1e-5;
+    const auto x        = random_tensor<float>({2, 5, 7, 6});
+    const auto scale    = random_tensor<float>({1, 5, 1, 1});
+    const auto bias     = random_tensor<float>({1, 5, 1, 1});
+    const auto mean     = random_tensor<float>({1, 5, 1, 1});
+    const auto variance = tensor<float>{std::vector<std::size_t>{1, 5, 1, 1}}.generate(
+        [](auto...) { return prng::gen_A_to_B(0.5f, 2.0f); });
+    auto y_ref = tensor<float>{x.desc};
+    batchNormSpatialHostInference(x, y_ref, scale, bias, epsilon, mean, variance);
+
+    auto x_dev        = handle.Write(x.data);
+    auto y_dev        = handle.Create<float>(x.data.size());
+    auto scale_dev    = handle.Write(scale.data);
+    auto bias_dev     = handle.Write(bias.data);
+    auto mean_dev     = handle.Write(mean.data);
+    auto variance_dev = handle.Write(variance.data);
+    const float one   = 1.0f;
+    const float zero  = 0.0f;
+    miopen::BatchNormForwardInference(handle,
+                                      miopenBNSpatial,
+                                      &one,
+                                      &zero,
+                                      x.desc,
+                                      x_dev.get(),
+                                      x.desc,
+                                      y_dev.get(),
+                                      scale.desc,
+                                      scale_dev.get(),
+                                      bias_dev.get(),
+                                      mean_dev.get(),
+                                      variance_dev.get(),
+                                      epsilon);
+    auto y = tensor<float>{x.desc};
+    y.data = handle.Read<float>(y_dev, y.data.size());
+    EXPECT(near(y, y_ref));
+}
+
+void check_softmax()
+{
+    auto&& handle = get_handle();
+    const auto x  = random_tensor<float>({3, 7, 5, 4});
+
+    // Accurate softmax over the channels.
+    auto y_ref = tensor<float>{x.desc};
+    std::size_t n, c, h, w;
+    std::tie(n, c, h, w) = miopen::tien<4>(x.desc.GetLengths());
+    ford(n, h, w)([&](auto i, auto j, auto k) {
+        auto max = x(i, 0, j, k);
+        for(std::size_t ch = 1; ch < c; ++ch)
+            max = std::max(max, x(i, ch, j, k));
+        auto sum = 0.0;
+        for(std::size_t ch = 0; ch < c; ++ch)
+            sum += std::exp(x(i, ch, j, k) - max);
+        for(std::size_t ch = 0; ch < c; ++ch)
+            y_ref(i, ch, j, k) = std::exp(x(i, ch, j, k) - max) / sum;
+    });
+
+    auto x_dev       = handle.Write(x.data);
+    auto y_dev       = handle.Create<float>(x.data.size());
+    const float one  = 1.0f;
+    const float zero = 0.0f;
+    miopen::SoftmaxForward(handle,
+                           &one,
+                           &zero,
+                           x.desc,
+                           x_dev.get(),
+                           x.desc,
+                           y_dev.get(),
+                           MIOPEN_SOFTMAX_ACCURATE,
+                           MIOPEN_SOFTMAX_MODE_CHANNEL);
+    auto y = tensor<float>{x.desc};
+    y.data = handle.Read<float>(y_dev, y.data.size());
+    EXPECT(near(y, y_ref));
+}
+
+void check_op_tensor()
+{
+    auto&& handle = get_handle();
+    const auto a  = random_tensor<float>({2, 6, 5, 3});
+    const auto b  = random_tensor<float>({1, 6, 1, 1});
+    auto c        = random_tensor<float>({2, 6, 5, 3});
+
+    // c = 2 * a + 3 * b + 0.5 * c, b broadcast over all but the channels.
+    auto c_ref = c;
+    c_ref.for_each([&](auto i, auto ch, auto j, auto k) {
+        c_ref(i, ch, j, k) = 2 * a(i, ch, j, k) + 3 * b(0, ch, 0, 0) + 0.5f * c(i, ch, j, k);
+    });
+
+    auto a_dev         = handle.Write(a.data);
+    auto b_dev         = handle.Write(b.data);
+    auto c_dev         = handle.Write(c.data);
+    const float alpha0 = 2.0f;
+    const float alpha1 = 3.0f;
+    const float beta   = 0.5f;
+    miopen::OpTensor(handle,
+                     miopenTensorOpAdd,
+                     &alpha0,
+                     a.desc,
+                     a_dev.get(),
+                     &alpha1,
+                     b.desc,
+                     b_dev.get(),
+                     &beta,
+                     c.desc,
+                     c_dev.get());
+    c.data = handle.Read<float>(c_dev, c.data.size());
+    EXPECT(near(c, c_ref));
+}
+
+} // namespace
+
+int main()
+{
+    if(!miopen::solver::IsHostSolverEnabled(get_handle()))
+    {
+        std::cout << "Host solvers are not enabled, skipped" << std::endl;
+        return 0;
+    }
+
+    check_convolution({{2, 4, 9, 9}, {6, 4, 3, 3}, {1, 1}, {1, 1}, {1, 1}, 1});
+    check_convolution({{2, 4, 11, 10}, {6, 2, 3, 2}, {0, 1}, {2, 1}, {1, 2}, 2});
+    check_convolution({{1, 3, 5, 6, 4}, {4, 3, 3, 1, 3}, {1, 0, 1}, {1, 2, 1}, {1, 1, 1}, 1});
+
+    for(const auto mode : {miopenActivationRELU,
+                           miopenActivationLOGISTIC,
+                           miopenActivationTANH,
+                           miopenActivationLEAKYRELU,
+                           miopenActivationELU})
+        check_activation(mode);
+
+    for(const auto mode : {miopenPoolingMax, miopenPoolingAverage, miopenPoolingAverageInclusive})
+        check_pooling(mode);
+
+    check_batchnorm_inference();
+    check_softmax();
+    check_op_tensor();
+}
@@ -0,0 +1,170 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/invoker_cache.hpp>
+
+#include "test.hpp"
+
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+struct TaggedInvoker
+{
+    int id;
+
+    void operator()(const miopen::Handle&, const miopen::AnyInvokeParams&) const {}
+};
+
+miopen::Invoker MakeInvoker(int id) { return TaggedInvoker{id}; }
+
+int GetId(const miopen::Invoker& invoker) { return invoker.target<TaggedInvoker>()->id; }
+
+void check_lookup()
+{
+    auto cache = miopen::InvokerCache{0};
+    cache.Register({"config", "solver1"}, MakeInvoker(1));
+    cache.Register({"config", "solver2"}, MakeInvoker(2));
+    cache.SetAsFound1_0("config", "algo", "solver2");
+
+    const auto invoker = cache[{"config", "solver1"}];
+    EXPECT(invoker);
+    EXPECT(GetId(*invoker) == 1);
+
+    const auto found = cache.GetFound1_0("config", "algo");
+    EXPECT(found);
+    EXPECT(GetId(*found) == 2);
+    EXPECT(*cache.GetFound1_0SolverId("config", "algo") == "solver2");
+
+    EXPECT(!cache[{"config", "solver3"}]);
+    EXPECT(!cache[{"other", "solver1"}]);
+    EXPECT(!cache.GetFound1_0("config", "other"));
+
+    EXPECT(cache.GetStatistics().hits == 2);
+    EXPECT(cache.GetStatistics().misses == 3);
+    EXPECT(cache.GetStatistics().evictions == 0);
+
+    cache.ResetStatistics();
+    EXPECT(cache.GetStatistics().hits == 0);
+    EXPECT(cache.GetStatistics().misses == 0);
+
+    EXPECT(throws([&] { cache.SetAsFound1_0("other", "algo", "solver1"); }));
+    EXPECT(throws([&] { cache.SetAsFound1_0("config", "algo", "solver3"); }));
+}
+
+void check_eviction()
+{
+    auto cache = miopen::InvokerCache{2};
+    cache.Register({"a", "solver"}, MakeInvoker(1));
+    cache.Register({"b", "solver"}, MakeInvoker(2));
+
+    // Touching "a" makes "b" the least recently used one.
+    EXPECT(cache[{"a", "solver"}]);
+    cache.Register({"c", "solver"}, MakeInvoker(3));
+
+    EXPECT(cache.GetSize() == 2);
+    EXPECT(cache.GetStatistics().evictions == 1);
+    EXPECT(cache[{"a", "solver"}]);
+    EXPECT(!cache[{"b", "solver"}]);
+    EXPECT(cache[{"c", "solver"}]);
+
+    // Registering another solver for a cached config doesn't evict anything.
+    cache.Register({"c", "other"}, MakeInvoker(4));
+    EXPECT(cache.GetSize() == 2);
+    EXPECT(cache.GetStatistics().evictions == 1);
+
+    // "a" was used before "c" last, so it goes first.
+    cache.SetCapacity(1);
+    EXPECT(cache.GetSize() == 1);
+    EXPECT(cache.GetStatistics().evictions == 2);
+    EXPECT(!cache[{"a", "solver"}]);
+    EXPECT(cache[{"c", "other"}]);
+
+    // Evicted configs can be registered again.
+    cache.SetCapacity(0);
+    cache.Register({"a", "solver"}, MakeInvoker(1));
+    cache.Register({"b", "solver"}, MakeInvoker(2));
+    EXPECT(cache.GetSize() == 3);
+    EXPECT(cache.GetStatistics().evictions == 2);
+}
+
+void check_find_1_0_is_kept()
+{
+    auto cache = miopen::InvokerCache{1};
+    cache.Register({"a", "solver"}, MakeInvoker(1));
+    cache.SetAsFound1_0("a", "algo", "solver");
+
+    // "a" doesn't count against the capacity any more.
+    cache.Register({"b", "solver"}, MakeInvoker(2));
+    cache.Register({"c", "solver"}, MakeInvoker(3));
+    cache.Register({"a", "other"}, MakeInvoker(4));
+    EXPECT(cache.GetSize() == 2);
+    EXPECT(cache.GetStatistics().evictions == 1);
+    EXPECT(!cache[{"b", "solver"}]);
+    EXPECT(GetId(*cache.GetFound1_0("a", "algo")) == 1);
+    EXPECT(cache[{"a", "other"}]);
+
+    cache.SetCapacity(1);
+    cache.Register({"d", "solver"}, MakeInvoker(5));
+    EXPECT(cache.GetFound1_0("a", "algo"));
+    EXPECT(!cache[{"c", "solver"}]);
+    EXPECT(cache[{"d", "solver"}]);
+}
+
+void check_concurrent_lookups()
+{
+    auto cache = miopen::InvokerCache{0};
+    for(auto i = 0; i < 16; ++i)
+        cache.Register({std::to_string(i), "solver"}, MakeInvoker(i));
+
+    std::vector<std::thread> threads;
+    for(auto t = 0; t < 4; ++t)
+        threads.emplace_back([&, t] {
+            for(auto i = 0; i < 10000; ++i)
+            {
+                const auto id = (i * 7 + t) % 16;
+                if(GetId(*cache[{std::to_string(id), "solver"}]) != id)
+                    std::abort();
+            }
+        });
+    for(auto& thread : threads)
+        thread.join();
+
+    EXPECT(cache.GetStatistics().hits == 4 * 10000);
+}
+
+} // namespace
+
+int main()
+{
+    check_lookup();
+    check_eviction();
+    check_find_1_0_is_kept();
+    check_concurrent_lookups();
+}
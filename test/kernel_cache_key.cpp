@@ -0,0 +1,89 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/kernel_cache_key.hpp>
+
+#include "test.hpp"
+
+#include <cstdint>
+#include <set>
+#include <sstream>
+#include <string>
+#include <utility>
+
+using miopen::KernelCacheKey;
+
+static void check_reference()
+{
+    // Empty first string leaves the state at zero, so this is plain MurmurHash3 x64_128.
+    const auto key = KernelCacheKey{"", "hello"};
+    EXPECT(key.GetLow() == 0xcbd8a7b341bd9b02ull);
+    EXPECT(key.GetHigh() == 0x5b1e906a48ae1d19ull);
+
+    std::ostringstream ss;
+    ss << key;
+    EXPECT_EQUAL(ss.str(), "5b1e906a48ae1d19cbd8a7b341bd9b02");
+}
+
+static void check_equality()
+{
+    const auto options = std::string(4096, 'x') + " -DMIOPEN_USE_FP32=1";
+    EXPECT(KernelCacheKey("conv", options) == KernelCacheKey("conv", options));
+    EXPECT(KernelCacheKey("conv", options) != KernelCacheKey("conv", options + " "));
+    EXPECT(KernelCacheKey("ab", "c") != KernelCacheKey("a", "bc"));
+    EXPECT(KernelCacheKey("ab", "") != KernelCacheKey("", "ab"));
+    EXPECT(KernelCacheKey{} == KernelCacheKey{});
+}
+
+static void check_strings()
+{
+    // The strings are kept, so a hash collision can't make two different keys equal.
+    const auto key = KernelCacheKey{"algo", "config"};
+    EXPECT_EQUAL(key.GetFirst(), "algo");
+    EXPECT_EQUAL(key.GetSecond(), "config");
+}
+
+static void check_distinct()
+{
+    // Every tail length of the hash is exercised by the growing strings.
+    auto seen = std::set<std::pair<std::uint64_t, std::uint64_t>>{};
+    auto str  = std::string{};
+    for(auto i = 0; i < 256; ++i)
+    {
+        const auto key = KernelCacheKey{"algo", str};
+        seen.emplace(key.GetLow(), key.GetHigh());
+        str.push_back(static_cast<char>('a' + i % 26));
+    }
+    EXPECT_EQUAL(seen.size(), 256u);
+}
+
+int main()
+{
+    check_reference();
+    check_equality();
+    check_strings();
+    check_distinct();
+}
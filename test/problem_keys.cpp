@@ -0,0 +1,127 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/conv/problem_description.hpp>
+#include <miopen/key_builder.hpp>
+#include <miopen/problem_description.hpp>
+
+#include "test.hpp"
+
+#include <limits>
+#include <sstream>
+#include <string>
+
+static std::string DbKey(const miopen::conv::ProblemDescription& problem)
+{
+    std::ostringstream ss;
+    ss << problem;
+    return ss.str();
+}
+
+static std::string LegacyDbKey(const miopen::conv::ProblemDescription& problem)
+{
+    std::ostringstream ss;
+    ss << miopen::ProblemDescription{problem};
+    return ss.str();
+}
+
+static void check_key_builder()
+{
+    miopen::KeyBuilder key;
+    key << 64 << 'x' << std::size_t{56} << "-NCHW-" << std::string{"FP32"} << '-' << -1;
+    key << '-' << std::numeric_limits<long long>::min();
+    EXPECT_EQUAL(key.Str(), "64x56-NCHW-FP32--1--9223372036854775808");
+
+    miopen::KeyBuilder dhw;
+    dhw.DHW('x', 2, 0, 3, 3) << '-';
+    dhw.DHW('-', 3, 1, 2, 3);
+    EXPECT_EQUAL(dhw.Str(), "3x3-1-2-3");
+
+    miopen::KeyBuilder full;
+    EXPECT(throws([&] {
+        for(std::size_t i = 0; i <= miopen::KeyBuilder::capacity; ++i)
+            full << 'x';
+    }));
+    EXPECT_EQUAL(full.Size(), miopen::KeyBuilder::capacity);
+}
+
+static void check_2d()
+{
+    const auto in      = miopen::TensorDescriptor{miopenFloat, {8, 64, 56, 56}};
+    const auto weights = miopen::TensorDescriptor{miopenFloat, {128, 64, 3, 3}};
+    const auto out     = miopen::TensorDescriptor{miopenFloat, {8, 128, 56, 56}};
+    const auto conv    = miopen::ConvolutionDescriptor{{1, 1}, {1, 1}, {1, 1}};
+    const auto problem = miopen::conv::ProblemDescription{
+        in, weights, out, conv, miopen::conv::Direction::Forward};
+
+    EXPECT_EQUAL(problem.BuildConfKey().ToString(),
+                 "64x56x56x3x3x128x56x56x8xNCHWxFP32x1x1x1x1x1x1x1xF");
+    EXPECT_EQUAL(DbKey(problem), "64-56-56-3x3-128-56-56-8-1x1-1x1-1x1-0-NCHW-FP32-F");
+    EXPECT_EQUAL(LegacyDbKey(problem), DbKey(problem));
+
+    // Copies share the keys built by the constructor.
+    const auto copy = problem;
+    EXPECT_EQUAL(copy.BuildConfKey().ToString(), problem.BuildConfKey().ToString());
+}
+
+static void check_grouped()
+{
+    const auto in      = miopen::TensorDescriptor{miopenFloat, {1, 64, 56, 56}};
+    const auto weights = miopen::TensorDescriptor{miopenFloat, {64, 1, 3, 3}};
+    const auto out     = miopen::TensorDescriptor{miopenFloat, {1, 64, 56, 56}};
+    const auto conv    = miopen::ConvolutionDescriptor{{1, 1}, {1, 1}, {1, 1}, {0, 0}, 64};
+    const auto problem = miopen::conv::ProblemDescription{
+        in, weights, out, conv, miopen::conv::Direction::Forward};
+
+    EXPECT_EQUAL(problem.BuildConfKey().ToString(),
+                 "64x56x56x3x3x64x56x56x1xNCHWxFP32x1x1x1x1x1x1x64xF");
+    EXPECT_EQUAL(DbKey(problem), "64-56-56-3x3-64-56-56-1-1x1-1x1-1x1-0-NCHW-FP32-F_g64");
+    EXPECT_EQUAL(LegacyDbKey(problem), DbKey(problem));
+}
+
+static void check_3d()
+{
+    const auto in      = miopen::TensorDescriptor{miopenFloat, {2, 16, 8, 8, 8}};
+    const auto weights = miopen::TensorDescriptor{miopenFloat, {32, 16, 3, 3, 3}};
+    const auto out     = miopen::TensorDescriptor{miopenFloat, {2, 32, 6, 6, 6}};
+    const auto conv    = miopen::ConvolutionDescriptor{
+        3, miopenConvolution, miopenPaddingDefault, {0, 0, 0}, {1, 1, 1}, {1, 1, 1}, {0, 0, 0}};
+    const auto problem = miopen::conv::ProblemDescription{
+        in, weights, out, conv, miopen::conv::Direction::Forward};
+
+    EXPECT_EQUAL(problem.BuildConfKey().ToString(),
+                 "16x8x8x8x3x3x3x32x6x6x6x2xNCDHWxFP32x0x0x0x1x1x1x1x1x1x1xF");
+    EXPECT_EQUAL(DbKey(problem), "16-8-8-8-3x3x3-32-6-6-6-2-0x0x0-1x1x1-1x1x1-0-NCDHW-FP32-F");
+    EXPECT_EQUAL(LegacyDbKey(problem), DbKey(problem));
+}
+
+int main()
+{
+    check_key_builder();
+    check_2d();
+    check_grouped();
+    check_3d();
+}
@@ -26,31 +26,43 @@
 #ifndef GUARD_MIOPEN_TEST_RANDOM_HPP
 #define GUARD_MIOPEN_TEST_RANDOM_HPP
 
-#include <cstdlib>
+#include "../driver/random.hpp"
 
-// template <typename T>
-// static T FRAND(void)
-//{
-//    double d = static_cast<double>(rand() / (static_cast<double>(RAND_MAX)));
-//    return static_cast<T>(d);
-//}
+#include <algorithm>
 
-/// Basically, this is a copy of driver/random.hpp. Why:
-/// We want to have the same functionality as implemented in driver/random.hpp,
-/// But we want this functionality to be independent, so changes in tests won't affect the driver
-/// and vice versa. This independency could be important, because, for example, the driver
-/// implements its own cache of verification data and change or GET_RAND() would break it.
+/// The generator, GET_RAND() and prng::reset_seed() are shared with the driver, as both end
+/// up in the same translation unit when the driver uses test utilities. The driver caches its
+/// verification data, so the way it draws numbers must not change: the tests extend it, but
+/// never modify it.
+///
+/// Unlike the driver, tests generate tensors element by element through arbitrary functions,
+/// which may draw any number of values. So every block of a tensor gets its own subsequence of
+/// the generator instead of a range of a single stream, see prng::par_generate().
+namespace prng {
 
-static int GET_RAND()
+/// Calls f(first, last) in parallel for fixed blocks of [0, n). While a block is being processed,
+/// GET_RAND() draws from subsequence #block of the generator seeded with `seed`, so the results
+/// don't depend on the number of threads. The generator of the calling thread is preserved.
+template <class F>
+void par_generate(unsigned long long seed, std::size_t n, F f)
 {
-    return rand(); // NOLINT (concurrency-mt-unsafe)
+    constexpr std::size_t block_size = 4096;
+    const auto blocks                = (n + block_size - 1) / block_size;
+    miopen::par_for(blocks, miopen::min_grain{1}, [&](std::size_t block) {
+        auto& engine     = details::get_engine();
+        const auto saved = engine;
+        engine           = miopen::Xorwow{seed, block};
+        f(block * block_size, std::min(n, (block + 1) * block_size));
+        engine = saved;
+    });
 }
 
-// template <typename T>
-// static T RAN_GEN(T A, T B)
-//{
-//    T r = (FRAND<T>() * (B - A)) + A;
-//    return r;
-//}
+template <typename T>
+T gen_A_to_B(T A, T B)
+{
+    return static_cast<T>(A + (B - A) * details::get_engine().Canonical());
+}
+
+} // namespace prng
 
 #endif
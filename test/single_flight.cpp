@@ -0,0 +1,130 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/single_flight.hpp>
+
+#include "test.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr auto thread_count = 8;
+
+// Blocks the first call until all the other threads are waiting for it.
+template <class F>
+std::vector<std::string> RunConcurrently(miopen::SingleFlight<std::string>& flights, F f)
+{
+    const auto deduplicated = flights.GetDeduplicatedCount();
+    const auto deadline     = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    auto results            = std::vector<std::string>(thread_count);
+    auto threads            = std::vector<std::thread>{};
+
+    for(auto i = 0; i < thread_count; ++i)
+    {
+        threads.emplace_back([&, i]() {
+            try
+            {
+                results[i] = flights.Do("key", [&]() {
+                    while(flights.GetDeduplicatedCount() - deduplicated < thread_count - 1 &&
+                          std::chrono::steady_clock::now() < deadline)
+                        std::this_thread::yield();
+                    return f();
+                });
+            }
+            catch(const std::runtime_error& ex)
+            {
+                results[i] = ex.what();
+            }
+        });
+    }
+
+    for(auto& thread : threads)
+        thread.join();
+    return results;
+}
+
+void check_deduplication()
+{
+    auto flights = miopen::SingleFlight<std::string>{};
+    auto calls   = std::atomic<int>{0};
+
+    const auto results = RunConcurrently(flights, [&]() {
+        ++calls;
+        return std::string{"code object"};
+    });
+
+    EXPECT(calls == 1);
+    EXPECT(flights.GetDeduplicatedCount() == thread_count - 1);
+    for(const auto& result : results)
+        EXPECT(result == "code object");
+
+    // The key is released once the call completes.
+    EXPECT(flights.Do("key", []() { return std::string{"again"}; }) == "again");
+    EXPECT(flights.GetDeduplicatedCount() == thread_count - 1);
+}
+
+void check_exception()
+{
+    auto flights = miopen::SingleFlight<std::string>{};
+    auto calls   = std::atomic<int>{0};
+
+    const auto results = RunConcurrently(flights, [&]() -> std::string {
+        ++calls;
+        throw std::runtime_error("failed");
+    });
+
+    EXPECT(calls == 1);
+    for(const auto& result : results)
+        EXPECT(result == "failed");
+
+    EXPECT(flights.Do("key", []() { return std::string{"recovered"}; }) == "recovered");
+}
+
+void check_independent_keys()
+{
+    auto flights = miopen::SingleFlight<std::string>{};
+    const auto a = flights.Do("a", [&]() {
+        // A nested call with another key must not wait for the outer one.
+        return flights.Do("b", []() { return std::string{"b"}; }) + "a";
+    });
+    EXPECT(a == "ba");
+    EXPECT(flights.GetDeduplicatedCount() == 0);
+}
+
+} // namespace
+
+int main()
+{
+    check_deduplication();
+    check_exception();
+    check_independent_keys();
+}
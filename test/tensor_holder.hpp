@@ -28,6 +28,7 @@
 
 #include "ford.hpp"
 #include "network_data.hpp"
+#include "random.hpp"
 #include <miopen/tensor.hpp>
 #include <miopen/functional.hpp>
 #include <miopen/type_name.hpp>
@@ -183,47 +184,76 @@ struct tensor
     template <class G>
     tensor& generate(G g) &
     {
-        if(this->desc.GetVectorLength() > 1)
-            this->generate_vect_impl(g);
-        else
-            this->generate_impl(g);
+        this->generate_impl(g);
         return *this;
     }
 
     template <class G>
     tensor&& generate(G g) &&
     {
-        if(this->desc.GetVectorLength() > 1)
-            this->generate_vect_impl(g);
-        else
-            this->generate_impl(g);
+        this->generate_impl(g);
         return std::move(*this);
     }
 
+    /// Writes g(indices...) of the i-th element (in lexicographic order) to the i-th position, or
+    /// to the i-th vector of the vectorized tensor.
     template <class G>
-    void generate_impl(G g)
+    struct generate_assign
     {
-        auto seed = std::accumulate(desc.GetLengths().begin(),
-                                    desc.GetLengths().end(),
-                                    std::size_t{521288629},
-                                    [](auto x, auto y) {
-                                        x ^= x << 1U;
-                                        return x ^ y;
-                                    });
-        seed ^= data.size();
-        seed ^= desc.GetLengths().size();
-        std::srand(seed);
-        auto iterator = data.begin();
-        auto assign   = [&](T x) {
-            *iterator = x;
-            ++iterator;
-        };
-        this->for_each(
-            miopen::compose(miopen::compose(assign, miopen::cast_to<T>()), std::move(g)));
-    }
+        tensor* self;
+        G g;
+
+        template <class... Ts>
+        auto operator()(Ts... xs) const -> decltype(std::declval<const G&>()(xs...), void())
+        {
+            const auto& lens         = self->desc.GetLengths();
+            const auto vector_length = self->desc.GetVectorLength();
+            std::size_t i            = 0;
+            std::size_t dim          = 0;
+            miopen::each_args([&](auto x) { i = i * lens[dim++] + x; }, xs...);
+            assert((i + 1) * vector_length <= self->data.size());
+            std::fill_n(self->data.begin() + i * vector_length,
+                        vector_length,
+                        miopen::cast_to<T>()(g(xs...)));
+        }
+    };
+
+    /// Parallel multidimensional loop for generate(). Iterations are split into blocks that
+    /// don't depend on the number of threads, and every block gets its own random sequence,
+    /// so generators using GET_RAND() give the same tensor with any number of threads.
+    struct generate_loop
+    {
+        unsigned long long seed;
+
+        template <class... Ts>
+        auto operator()(Ts... xs) const
+        {
+            return [=, seed = seed](auto f) {
+                using array_type      = std::array<std::size_t, sizeof...(Ts)>;
+                const array_type lens = {{static_cast<std::size_t>(xs)...}};
+                const auto n          = std::accumulate(
+                    lens.begin(), lens.end(), std::size_t{1}, std::multiplies<std::size_t>());
+                prng::par_generate(seed, n, [&](std::size_t first, std::size_t last) {
+                    array_type indices{};
+                    for(auto dim = lens.size(), i = first; dim > 0; --dim)
+                    {
+                        indices[dim - 1] = i % lens[dim - 1];
+                        i /= lens[dim - 1];
+                    }
+                    for(auto i = first; i < last; ++i)
+                    {
+                        miopen::unpack(f, indices);
+                        for(auto dim = lens.size(); dim > 0 && ++indices[dim - 1] == lens[dim - 1];
+                            --dim)
+                            indices[dim - 1] = 0;
+                    }
+                });
+            };
+        }
+    };
 
     template <class G>
-    void generate_vect_impl(G g)
+    void generate_impl(G g)
     {
         auto seed = std::accumulate(desc.GetLengths().begin(),
                                     desc.GetLengths().end(),
@@ -234,20 +264,12 @@ struct tensor
                                     });
         seed ^= data.size();
         seed ^= desc.GetLengths().size();
-        std::srand(seed);
-        auto iterator     = data.begin();
-        auto vectorLength = desc.GetVectorLength();
-        auto assign       = [&](T x) {
-            assert(iterator < data.end());
-            // for debugging
-            for(auto i = 0; i < vectorLength; i++)
-            {
-                *(iterator + i) = x;
-            }
-            iterator += vectorLength;
-        };
-        this->for_each(
-            miopen::compose(miopen::compose(assign, miopen::cast_to<T>()), std::move(g)));
+        visit_tensor_size(desc.GetLengths().size(),
+                          std::bind(for_each_handler{},
+                                    this,
+                                    generate_loop{seed},
+                                    generate_assign<G>{this, std::move(g)},
+                                    std::placeholders::_1));
     }
 
     template <class Loop, class F>
@@ -251,7 +251,7 @@ static int gen_rand_integer()
     static int inited = 0;
     if(inited == 0)
     {
-        std::srand(std::time(nullptr));
+        prng::reset_seed(std::time(nullptr));
         inited = 1;
     }
     return GET_RAND();
@@ -0,0 +1,135 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/cancellation.hpp>
+#include <miopen/errors.hpp>
+#include <miopen/thread_pool.hpp>
+
+#include "test.hpp"
+
+#include <atomic>
+#include <future>
+#include <vector>
+
+static void check_fifo_order()
+{
+    auto order = std::vector<int>{};
+    auto pool  = miopen::ThreadPool{1};
+
+    auto futures = std::vector<std::future<void>>{};
+    for(auto i = 0; i < 16; ++i)
+        futures.push_back(pool.Submit([&order, i]() { order.push_back(i); }));
+    for(auto& future : futures)
+        future.get();
+
+    EXPECT(order.size() == 16);
+    for(auto i = 0; i < 16; ++i)
+        EXPECT(order[i] == i);
+}
+
+static void check_results_and_exceptions()
+{
+    auto pool = miopen::ThreadPool{4};
+    EXPECT(pool.GetThreadCount() == 4);
+
+    auto sum     = std::atomic<int>{0};
+    auto futures = std::vector<std::future<int>>{};
+    for(auto i = 1; i <= 100; ++i)
+        futures.push_back(pool.Submit([&sum, i]() {
+            sum += i;
+            return i * 2;
+        }));
+
+    auto total = 0;
+    for(auto& future : futures)
+        total += future.get();
+    EXPECT(total == 10100);
+    EXPECT(sum == 5050);
+
+    auto failing = pool.Submit([]() -> int { MIOPEN_THROW(miopenStatusBadParm, "failed"); });
+    EXPECT(throws([&]() { failing.get(); }));
+}
+
+static void check_init()
+{
+    thread_local auto initialized = false;
+    auto count                    = std::atomic<int>{0};
+    const auto init               = [&]() {
+        initialized = true;
+        ++count;
+    };
+    auto pool = miopen::ThreadPool{2, init};
+
+    auto futures = std::vector<std::future<bool>>{};
+    for(auto i = 0; i < 8; ++i)
+        futures.push_back(pool.Submit([]() { return initialized; }));
+    for(auto& future : futures)
+        EXPECT(future.get());
+    EXPECT(count == 2);
+}
+
+static void check_cancellation()
+{
+    EXPECT(!miopen::CancellationToken::Current().IsCancelled());
+
+    auto token = miopen::CancellationToken{};
+    auto pool  = miopen::ThreadPool{1};
+
+    auto task = pool.Submit([token]() {
+        const auto scope = miopen::CancellationScope{token};
+        return miopen::CancellationToken::Current().IsCancelled();
+    });
+    EXPECT(!task.get());
+
+    token.Cancel();
+    auto cancelled = pool.Submit([token]() {
+        const auto scope = miopen::CancellationScope{token};
+        miopen::CancellationToken::Current().ThrowIfCancelled();
+    });
+
+    try
+    {
+        cancelled.get();
+        EXPECT(false);
+    }
+    catch(const miopen::Exception& ex)
+    {
+        EXPECT(ex.status == miopenStatusCanceled);
+    }
+
+    // The scope restores the token of the thread.
+    auto restored =
+        pool.Submit([]() { return miopen::CancellationToken::Current().IsCancelled(); });
+    EXPECT(!restored.get());
+}
+
+int main()
+{
+    check_fifo_order();
+    check_results_and_exceptions();
+    check_init();
+    check_cancellation();
+}
@@ -0,0 +1,79 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/load_file.hpp>
+#include <miopen/temp_file.hpp>
+#include <miopen/timer.hpp>
+#include <miopen/trace.hpp>
+
+#include "test.hpp"
+
+#include <sstream>
+#include <string>
+#include <thread>
+
+static std::size_t Count(const std::string& str, const std::string& what)
+{
+    auto n = std::size_t{0};
+    for(auto pos = str.find(what); pos != std::string::npos; pos = str.find(what, pos + 1))
+        ++n;
+    return n;
+}
+
+int main()
+{
+    {
+        miopen::TraceScope ignored{"Before enable"};
+    }
+
+    // Static, so that the file outlives the write at exit.
+    static const miopen::TempFile file{"trace"};
+    miopen::EnableTrace(file.Path());
+    EXPECT(miopen::IsTraceEnabled());
+
+    {
+        miopen::TraceScope outer{"Outer"};
+        miopen::TraceScope inner{"Inner", "with \"quotes\"\n"};
+        auto ct = miopen::CompileTimer{};
+        ct.Log("Kernel", "a.cl");
+    }
+    std::thread{[] { miopen::TraceScope other{"Other thread"}; }}.join();
+
+    auto ss = std::ostringstream{};
+    miopen::WriteTrace(ss);
+    const auto trace = ss.str();
+
+    EXPECT(trace.find("Before enable") == std::string::npos);
+    EXPECT_EQUAL(Count(trace, "\"ph\":\"X\""), 4u);
+    EXPECT(trace.find("\"Inner with \\\"quotes\\\"\\n\"") != std::string::npos);
+    EXPECT(trace.find("\"cat\":\"compile\"") != std::string::npos);
+    EXPECT(trace.find("\"name\":\"Outer\"") < trace.find("\"name\":\"Inner"));
+    EXPECT_EQUAL(Count(trace, "\"tid\":1,"), 3u);
+    EXPECT_EQUAL(Count(trace, "\"tid\":2,"), 1u);
+
+    miopen::WriteTrace();
+    EXPECT_EQUAL(miopen::LoadFile(file.Path()), trace);
+}
@@ -0,0 +1,130 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include "verify.hpp"
+#include "test.hpp"
+
+#include <half.hpp>
+#include <miopen/bfloat16.hpp>
+
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <list>
+#include <random>
+#include <vector>
+
+/// Checks the one-pass parallel comparison of verify.hpp against serial definitions, on sizes
+/// around the block and chunk boundaries.
+static std::vector<float> random_vector(std::size_t size, std::mt19937& gen)
+{
+    auto dist   = std::uniform_real_distribution<float>{-1.0f, 1.0f};
+    auto result = std::vector<float>(size);
+    for(auto& x : result)
+        x = dist(gen);
+    return result;
+}
+
+static double serial_rms(const std::vector<float>& r1, const std::vector<float>& r2)
+{
+    auto square_sum = 0.0;
+    auto mag        = std::numeric_limits<double>::min();
+    for(std::size_t i = 0; i < r1.size(); ++i)
+    {
+        const auto diff = static_cast<double>(r1[i]) - r2[i];
+        square_sum += diff * diff;
+        mag = std::max({mag, std::fabs(static_cast<double>(r1[i])), std::fabs(double{r2[i]})});
+    }
+    return std::sqrt(square_sum) / (std::sqrt(r1.size()) * mag);
+}
+
+static void check_size(std::size_t n, std::mt19937& gen)
+{
+    const auto r1 = random_vector(n, gen);
+    auto r2       = r1;
+
+    auto diff = miopen::compare_ranges(r1, r2);
+    EXPECT_EQUAL(diff.size, n);
+    EXPECT_EQUAL(diff.mismatch, n);
+    EXPECT_EQUAL(diff.not_finite1, n);
+    EXPECT_EQUAL(diff.not_finite2, n);
+    EXPECT(diff.max_abs == 0.0);
+    EXPECT(miopen::mismatch_idx(r1, r2, miopen::float_equal) == n);
+    if(n < 4)
+        return;
+
+    // One ulp is equal, denormal differences are not.
+    r2[1]     = std::nextafter(r2[1], 2.0f);
+    r2[n - 2] = r2[n - 2] + 0.5f;
+    r2[n - 1] = r1[n - 1] + 1e-30f;
+    diff      = miopen::compare_ranges(r1, r2);
+    EXPECT_EQUAL(diff.mismatch, n - 2);
+    EXPECT(std::abs(diff.max_abs - 0.5) < 1e-6);
+    EXPECT(std::abs(diff.rms() - serial_rms(r1, r2)) <= 1e-6 * serial_rms(r1, r2));
+    EXPECT(miopen::mismatch_idx(r1, r2, miopen::float_equal) == n - 2);
+    EXPECT(miopen::mismatch_idx(r1, r2, std::equal_to<float>{}) == 1);
+    EXPECT(miopen::max_diff(r1, r2) == diff.max_abs);
+
+    r2[n / 2] = std::numeric_limits<float>::quiet_NaN();
+    diff      = miopen::compare_ranges(r1, r2);
+    EXPECT_EQUAL(diff.not_finite1, n);
+    EXPECT_EQUAL(diff.not_finite2, n / 2);
+    EXPECT_EQUAL(diff.mismatch, n / 2);
+    EXPECT(miopen::find_idx(r2, miopen::not_finite) == static_cast<long>(n / 2));
+    EXPECT(miopen::find_idx(r1, miopen::not_finite) == -1);
+
+    // Ranges without random access iterators take the same path through a copy.
+    const auto list = std::list<float>(r1.begin(), r1.end());
+    EXPECT_EQUAL(miopen::compare_ranges(list, r2).mismatch, n / 2);
+}
+
+static void check_types(std::mt19937& gen)
+{
+    const auto values = random_vector(1000, gen);
+
+    auto h1 = std::vector<half_float::half>(values.begin(), values.end());
+    auto h2 = h1;
+    h2[999] = half_float::half{static_cast<float>(h2[999]) + 0.25f};
+    EXPECT_EQUAL(miopen::compare_ranges(h1, h2).mismatch, 999);
+
+    auto b1 = std::vector<bfloat16>(values.begin(), values.end());
+    auto b2 = b1;
+    EXPECT_EQUAL(miopen::compare_ranges(b1, b2).mismatch, 1000);
+
+    // The reference is usually computed in double.
+    const auto d1 = std::vector<double>(values.begin(), values.end());
+    EXPECT(miopen::rms_range(d1, values) == 0.0);
+    EXPECT(!miopen::range_zero(values));
+    EXPECT(miopen::range_zero(std::vector<float>(100000, 0.0f)));
+}
+
+int main()
+{
+    auto gen = std::mt19937{};
+    for(auto n : {0, 1, 255, 257, 65537, 200000})
+        check_size(n, gen);
+    check_types(gen);
+}
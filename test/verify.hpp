@@ -27,12 +27,17 @@
 #define GUARD_VERIFY_HPP
 
 #include <algorithm>
+#include <array>
 #include <cmath>
 #include <functional>
 #include <iostream>
+#include <iterator>
 #include <miopen/float_equal.hpp>
+#include <miopen/par_for.hpp>
 #include <miopen/returns.hpp>
 #include <numeric>
+#include <type_traits>
+#include <vector>
 
 namespace miopen {
 
@@ -119,10 +124,231 @@ bool range_empty(R1&& r1)
 template <class R1>
 auto range_distance(R1&& r1) MIOPEN_RETURNS(std::distance(r1.begin(), r1.end()));
 
+namespace verify_detail {
+
+/// Ranges are cut into chunks that are processed in parallel and combined in order, so that
+/// results don't depend on the number of threads.
+constexpr std::size_t chunk_size = std::size_t{1} << 16;
+/// Chunks are converted to the calculation type block by block, and the statistics of a block
+/// are accumulated in `lanes` independent lanes that the compiler can map onto SIMD registers.
+constexpr std::size_t block_size = 256;
+constexpr std::size_t lanes      = 8;
+
+template <class R>
+using is_random_access = std::is_base_of<
+    std::random_access_iterator_tag,
+    typename std::iterator_traits<decltype(std::declval<R>().begin())>::iterator_category>;
+
+/// fp32, fp16 and bf16 are compared in float, everything else in double.
+template <class T>
+using calc_type =
+    typename std::conditional<std::is_integral<T>{} || (sizeof(T) > 4), double, float>::type;
+
+/// Calls f(first, last) for every chunk [first, last) of n elements, in parallel.
+template <class F>
+void par_for_chunks(std::size_t n, F f)
+{
+    const auto chunks = (n + chunk_size - 1) / chunk_size;
+    par_for(chunks, min_grain{1}, [&](std::size_t chunk) {
+        const auto first = chunk * chunk_size;
+        f(first, std::min(n, first + chunk_size));
+    });
+}
+
+/// Index of the first element of r1 in [first, last) that satisfies p(r1[i], r2[i]), or last.
+template <class It1, class It2, class Predicate>
+std::size_t find_first(It1 it1, It2 it2, std::size_t first, std::size_t last, Predicate p)
+{
+    for(auto i = first; i < last; ++i)
+        if(p(it1[i], it2[i]))
+            return i;
+    return last;
+}
+
+/// Parallel search for the first index where p(r1[i], r2[i]) holds, or the size of r1.
+template <class R1, class R2, class Predicate>
+std::size_t par_find_first(R1&& r1, R2&& r2, Predicate p)
+{
+    const auto n     = static_cast<std::size_t>(range_distance(r1));
+    const auto it1   = r1.begin();
+    const auto it2   = r2.begin();
+    auto chunk_first = std::vector<std::size_t>((n + chunk_size - 1) / chunk_size, n);
+    par_for_chunks(n, [&](std::size_t first, std::size_t last) {
+        const auto i = find_first(it1, it2, first, last, p);
+        if(i != last)
+            chunk_first[first / chunk_size] = i;
+    });
+    const auto it = std::find_if(
+        chunk_first.begin(), chunk_first.end(), [&](std::size_t i) { return i != n; });
+    return it == chunk_first.end() ? n : *it;
+}
+
+} // namespace verify_detail
+
+/// Differences of two ranges of equal size, all gathered in one pass. r1 is the reference.
+struct range_diff
+{
+    std::size_t size        = 0;
+    double max_abs          = 0; ///< max |r1[i] - r2[i]|
+    double max_rel          = 0; ///< max |r1[i] - r2[i]| / |r1[i]|
+    double square_sum       = 0; ///< sum (r1[i] - r2[i])^2
+    double max_mag1         = 0; ///< max |r1[i]|
+    double max_mag2         = 0; ///< max |r2[i]|
+    std::size_t mismatch    = 0; ///< First index where not float_equal(r1[i], r2[i]), or size.
+    std::size_t not_finite1 = 0; ///< First non-finite element of r1, or size.
+    std::size_t not_finite2 = 0; ///< First non-finite element of r2, or size.
+
+    /// Same as rms_range.
+    double rms() const
+    {
+        const auto mag = std::max({max_mag1, max_mag2, std::numeric_limits<double>::min()});
+        return std::sqrt(square_sum) / (std::sqrt(size) * mag);
+    }
+};
+
+namespace verify_detail {
+
+/// Statistics of elements [first, last) of two random access ranges.
+template <class It1, class It2>
+range_diff diff_chunk(It1 it1, It2 it2, std::size_t first, std::size_t last, std::size_t size)
+{
+    using value1 = typename std::iterator_traits<It1>::value_type;
+    using value2 = typename std::iterator_traits<It2>::value_type;
+    using calc   = typename std::common_type<calc_type<value1>, calc_type<value2>>::type;
+
+    auto result        = range_diff{};
+    result.mismatch    = size;
+    result.not_finite1 = size;
+    result.not_finite2 = size;
+
+    auto a = std::array<calc, block_size>{};
+    auto b = std::array<calc, block_size>{};
+    for(auto block = first; block < last; block += block_size)
+    {
+        const auto n = std::min(block_size, last - block);
+        for(std::size_t i = 0; i < n; ++i)
+        {
+            a[i] = static_cast<calc>(it1[block + i]);
+            b[i] = static_cast<calc>(it2[block + i]);
+        }
+        // Padding of the last block compares equal and doesn't change any statistic.
+        std::fill(a.begin() + n, a.end(), calc{0});
+        std::fill(b.begin() + n, b.end(), calc{0});
+
+        auto sq   = std::array<calc, lanes>{};
+        auto diff = std::array<calc, lanes>{};
+        auto rel  = std::array<calc, lanes>{};
+        auto mag1 = std::array<calc, lanes>{};
+        auto mag2 = std::array<calc, lanes>{};
+        for(std::size_t i = 0; i < block_size; i += lanes)
+        {
+            for(std::size_t l = 0; l < lanes; ++l)
+            {
+                using std::fabs;
+                const auto x = fabs(a[i + l]);
+                const auto y = fabs(b[i + l]);
+                const auto d = fabs(a[i + l] - b[i + l]);
+                const auto r = d / (x > std::numeric_limits<calc>::min()
+                                        ? x
+                                        : std::numeric_limits<calc>::min());
+                sq[l] += d * d;
+                diff[l] = d > diff[l] ? d : diff[l];
+                rel[l]  = r > rel[l] ? r : rel[l];
+                mag1[l] = x > mag1[l] ? x : mag1[l];
+                mag2[l] = y > mag2[l] ? y : mag2[l];
+            }
+        }
+
+        auto block_sq   = 0.0;
+        auto block_diff = 0.0;
+        for(std::size_t l = 0; l < lanes; ++l)
+        {
+            block_sq += sq[l];
+            block_diff      = std::max<double>(block_diff, diff[l]);
+            result.max_abs  = std::max<double>(result.max_abs, diff[l]);
+            result.max_rel  = std::max<double>(result.max_rel, rel[l]);
+            result.max_mag1 = std::max<double>(result.max_mag1, mag1[l]);
+            result.max_mag2 = std::max<double>(result.max_mag2, mag2[l]);
+        }
+        result.square_sum += block_sq;
+
+        // NaN and infinities are ignored by the maximums, but never by the sum of squares. Equal
+        // finite blocks, the common case, skip the element-wise checks.
+        using std::isfinite;
+        const auto suspicious = !isfinite(block_sq) || block_diff != 0.0;
+        if(suspicious && result.mismatch == size)
+        {
+            const auto i = find_first(it1, it2, block, block + n, std::not_fn(float_equal));
+            result.mismatch = i == block + n ? size : i;
+        }
+        if(!isfinite(block_sq))
+        {
+            for(auto i = block; i < block + n; ++i)
+            {
+                if(result.not_finite1 == size && !isfinite(a[i - block]))
+                    result.not_finite1 = i;
+                if(result.not_finite2 == size && !isfinite(b[i - block]))
+                    result.not_finite2 = i;
+            }
+        }
+    }
+    return result;
+}
+
+} // namespace verify_detail
+
+/// Compares two ranges of equal size in one parallel pass.
+template <class R1, class R2>
+range_diff compare_ranges(R1&& r1, R2&& r2)
+{
+    using verify_detail::is_random_access;
+    if constexpr(!is_random_access<R1>{} || !is_random_access<R2>{})
+    {
+        using value1 = range_value<R1>;
+        using value2 = range_value<R2>;
+        return compare_ranges(std::vector<value1>(r1.begin(), r1.end()),
+                              std::vector<value2>(r2.begin(), r2.end()));
+    }
+    else
+    {
+        const auto n   = static_cast<std::size_t>(range_distance(r1));
+        const auto it1 = r1.begin();
+        const auto it2 = r2.begin();
+        auto chunks    = std::vector<range_diff>((n + verify_detail::chunk_size - 1) /
+                                              verify_detail::chunk_size);
+        verify_detail::par_for_chunks(n, [&](std::size_t first, std::size_t last) {
+            chunks[first / verify_detail::chunk_size] =
+                verify_detail::diff_chunk(it1, it2, first, last, n);
+        });
+
+        auto result        = range_diff{};
+        result.size        = n;
+        result.mismatch    = n;
+        result.not_finite1 = n;
+        result.not_finite2 = n;
+        for(const auto& chunk : chunks)
+        {
+            result.max_abs  = std::max(result.max_abs, chunk.max_abs);
+            result.max_rel  = std::max(result.max_rel, chunk.max_rel);
+            result.max_mag1 = std::max(result.max_mag1, chunk.max_mag1);
+            result.max_mag2 = std::max(result.max_mag2, chunk.max_mag2);
+            result.square_sum += chunk.square_sum;
+            result.mismatch    = std::min(result.mismatch, chunk.mismatch);
+            result.not_finite1 = std::min(result.not_finite1, chunk.not_finite1);
+            result.not_finite2 = std::min(result.not_finite2, chunk.not_finite2);
+        }
+        return result;
+    }
+}
+
 template <class R1>
 bool range_zero(R1&& r1)
 {
-    return std::all_of(r1.begin(), r1.end(), [](float x) { return x == 0.0; });
+    if constexpr(verify_detail::is_random_access<R1>{})
+        return verify_detail::par_find_first(r1, r1, [](float x, float) { return x != 0.0; }) ==
+               static_cast<std::size_t>(range_distance(r1));
+    else
+        return std::all_of(r1.begin(), r1.end(), [](float x) { return x == 0.0; });
 }
 
 template <class R1, class R2, class T, class Reducer, class Product>
@@ -134,24 +360,47 @@ T range_product(R1&& r1, R2&& r2, T state, Reducer r, Product p)
 template <class R1, class R2, class Compare>
 std::size_t mismatch_idx(R1&& r1, R2&& r2, Compare compare)
 {
-    auto p = std::mismatch(r1.begin(), r1.end(), r2.begin(), compare);
-    return std::distance(r1.begin(), p.first);
+    if constexpr(verify_detail::is_random_access<R1>{} && verify_detail::is_random_access<R2>{})
+    {
+        return verify_detail::par_find_first(r1, r2, std::not_fn(compare));
+    }
+    else
+    {
+        auto p = std::mismatch(r1.begin(), r1.end(), r2.begin(), compare);
+        return std::distance(r1.begin(), p.first);
+    }
+}
+
+/// float_equal mismatches are found by the vectorized pass of compare_ranges.
+template <class R1, class R2>
+std::size_t mismatch_idx(R1&& r1, R2&& r2, float_equal_fn)
+{
+    return compare_ranges(r1, r2).mismatch;
 }
 
 template <class R1, class Predicate>
 long find_idx(R1&& r1, Predicate p)
 {
-    auto it = std::find_if(r1.begin(), r1.end(), p);
-    if(it == r1.end())
-        return -1;
+    if constexpr(verify_detail::is_random_access<R1>{})
+    {
+        const auto i = verify_detail::par_find_first(
+            r1, r1, [&](const auto& x, const auto&) { return p(x); });
+        return i == static_cast<std::size_t>(range_distance(r1)) ? -1 : static_cast<long>(i);
+    }
     else
-        return std::distance(r1.begin(), it);
+    {
+        auto it = std::find_if(r1.begin(), r1.end(), p);
+        if(it == r1.end())
+            return -1;
+        else
+            return std::distance(r1.begin(), it);
+    }
 }
 
 template <class R1, class R2>
 double max_diff(R1&& r1, R2&& r2)
 {
-    return range_product(r1, r2, 0.0, max, abs_diff);
+    return compare_ranges(r1, r2).max_abs;
 }
 
 template <class R1, class R2, class T>
@@ -167,16 +416,8 @@ std::size_t mismatch_diff(R1&& r1, R2&& r2, T diff)
 template <class R1, class R2>
 double rms_range(R1&& r1, R2&& r2)
 {
-    std::size_t n = range_distance(r1);
-    if(n == range_distance(r2))
-    {
-        double square_difference = range_product(r1, r2, 0.0, sum_fn{}, square_diff);
-        double mag1              = *std::max_element(r1.begin(), r1.end(), compare_mag);
-        double mag2              = *std::max_element(r2.begin(), r2.end(), compare_mag);
-        double mag =
-            std::max({std::fabs(mag1), std::fabs(mag2), std::numeric_limits<double>::min()});
-        return std::sqrt(square_difference) / (std::sqrt(n) * mag);
-    }
+    if(range_distance(r1) == range_distance(r2))
+        return compare_ranges(r1, r2).rms();
     else
         return std::numeric_limits<range_value<R1>>::max();
 }
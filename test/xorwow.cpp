@@ -0,0 +1,122 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/float_equal.hpp>
+#include <miopen/xorwow.hpp>
+
+#include "dropout_util.hpp"
+#include "random.hpp"
+#include "test.hpp"
+
+#include <vector>
+
+namespace {
+
+const unsigned long long seeds[] = {0, 1, 0x123456789abcdefULL, ~0ULL};
+
+// Compares the next few numbers drawn from both generators.
+template <class F>
+bool same_stream(miopen::Xorwow x, F next)
+{
+    for(auto i = 0; i < 16; ++i)
+    {
+        if(x() != next())
+            return false;
+    }
+    return true;
+}
+
+void check_discard()
+{
+    for(const auto seed : seeds)
+    {
+        for(const auto n : {0ULL, 1ULL, 3ULL, 4ULL, 5ULL, 17ULL, 1000ULL, 65537ULL})
+        {
+            auto stepped   = miopen::Xorwow{seed};
+            auto discarded = stepped;
+            for(auto i = 0ULL; i < n; ++i)
+                stepped();
+            discarded.Discard(n);
+            EXPECT(same_stream(discarded, stepped));
+        }
+    }
+}
+
+void check_dropout_emulator()
+{
+    for(const auto seed : seeds)
+    {
+        for(const auto subsequence : {0ULL, 1ULL, 5ULL, 1234567ULL, (1ULL << 40) + 3})
+        {
+            for(const auto offset : {0ULL, 1ULL, 7ULL, 4096ULL, (1ULL << 33) + 11})
+            {
+                prngStates state;
+                xorwow_lite_init_emu(&state, seed, subsequence, offset);
+                const auto next = [&]() { return xorwow_next(&state); };
+                EXPECT(same_stream(miopen::Xorwow{seed, subsequence, offset}, next));
+            }
+
+            // The same subsequence reached after seeding.
+            auto x = miopen::Xorwow{seed};
+            x.DiscardSubsequences(subsequence);
+            prngStates state;
+            xorwow_lite_init_emu(&state, seed, subsequence, 0);
+            EXPECT(same_stream(x, [&]() { return xorwow_next(&state); }));
+        }
+    }
+}
+
+void check_generate()
+{
+    for(const auto seed : seeds)
+    {
+        // Several blocks and a partial one, so that the blocks run on different threads.
+        const auto n = 3 * prng::details::block_size + 123;
+        auto data    = std::vector<double>(n);
+        prng::reset_seed(seed);
+        prng::generate(data.data(), n, [](std::size_t, double u) { return u; });
+
+        auto serial = miopen::Xorwow{seed};
+        auto same   = true;
+        for(const auto u : data)
+            same = same && miopen::float_equal(u, serial.Canonical());
+        EXPECT(same);
+
+        // The stream continues where a serial loop would leave it.
+        EXPECT(miopen::float_equal(FRAND<double>(), serial.Canonical()));
+        EXPECT(prng::seed() == seed);
+    }
+    prng::reset_seed();
+}
+
+} // namespace
+
+int main()
+{
+    check_discard();
+    check_dropout_emulator();
+    check_generate();
+}
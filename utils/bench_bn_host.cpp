@@ -0,0 +1,242 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+/// Measures the host batch-norm references used by the driver, in elements per second.
+///
+/// Usage: bench_bn_host [n c h w]
+///
+/// "serial" is the channel-by-channel loop over the batch the references used to run, for the
+/// spatial forward training and backward passes.
+
+#include <miopen/batchnorm/host.hpp>
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace {
+
+struct Problem
+{
+    std::size_t n;
+    std::size_t c;
+    std::size_t h;
+    std::size_t w;
+
+    std::size_t Elements() const { return n * c * h * w; }
+};
+
+struct Buffers
+{
+    explicit Buffers(const Problem& problem)
+        : x(problem.Elements()),
+          dy(problem.Elements()),
+          y(problem.Elements()),
+          dx(problem.Elements()),
+          scale(problem.c, 1.5),
+          bias(problem.c, 0.5),
+          mean(problem.c),
+          inv_var(problem.c),
+          dscale(problem.c),
+          dbias(problem.c)
+    {
+        auto gen  = std::mt19937{};
+        auto dist = std::uniform_real_distribution<float>{-1.0f, 1.0f};
+        for(auto& v : x)
+            v = dist(gen);
+        for(auto& v : dy)
+            v = dist(gen);
+    }
+
+    std::vector<float> x;
+    std::vector<float> dy;
+    std::vector<double> y;
+    std::vector<double> dx;
+    std::vector<double> scale;
+    std::vector<double> bias;
+    std::vector<double> mean;
+    std::vector<double> inv_var;
+    std::vector<double> dscale;
+    std::vector<double> dbias;
+};
+
+void SerialFwdTrain(const Problem& p, Buffers& b)
+{
+    const auto hw  = p.h * p.w;
+    const auto nhw = static_cast<double>(p.n * hw);
+    for(std::size_t c = 0; c < p.c; ++c)
+    {
+        auto mean = 0.;
+        for(std::size_t i = 0; i < hw; ++i)
+            for(std::size_t n = 0; n < p.n; ++n)
+                mean += b.x[(n * p.c + c) * hw + i];
+        mean /= nhw;
+        auto variance = 0.;
+        for(std::size_t i = 0; i < hw; ++i)
+        {
+            for(std::size_t n = 0; n < p.n; ++n)
+            {
+                const auto d = b.x[(n * p.c + c) * hw + i] - mean;
+                variance += d * d;
+            }
+        }
+        const auto inv_var = 1. / std::sqrt(variance / nhw + 1e-5);
+        b.mean[c]          = mean;
+        b.inv_var[c]       = inv_var;
+        for(std::size_t i = 0; i < hw; ++i)
+        {
+            for(std::size_t n = 0; n < p.n; ++n)
+            {
+                const auto idx = (n * p.c + c) * hw + i;
+                b.y[idx]       = b.scale[c] * (inv_var * (b.x[idx] - mean)) + b.bias[c];
+            }
+        }
+    }
+}
+
+void SerialBwd(const Problem& p, Buffers& b)
+{
+    const auto hw  = p.h * p.w;
+    const auto nhw = static_cast<double>(p.n * hw);
+    for(std::size_t c = 0; c < p.c; ++c)
+    {
+        auto dbias  = 0.;
+        auto dscale = 0.;
+        for(std::size_t i = 0; i < hw; ++i)
+        {
+            for(std::size_t n = 0; n < p.n; ++n)
+            {
+                const auto idx = (n * p.c + c) * hw + i;
+                dbias += b.dy[idx];
+                dscale += (b.x[idx] - b.mean[c]) * b.inv_var[c] * b.dy[idx];
+            }
+        }
+        b.dbias[c]  = dbias;
+        b.dscale[c] = dscale;
+        for(std::size_t i = 0; i < hw; ++i)
+        {
+            for(std::size_t n = 0; n < p.n; ++n)
+            {
+                const auto idx  = (n * p.c + c) * hw + i;
+                const auto xhat = (b.x[idx] - b.mean[c]) * b.inv_var[c];
+                b.dx[idx]       = b.scale[c] * b.inv_var[c] / nhw *
+                            (nhw * b.dy[idx] - dbias - xhat * dscale);
+            }
+        }
+    }
+}
+
+void HostFwdTrain(const Problem& p, Buffers& b, miopenTensorLayout_t layout)
+{
+    miopenBNFwdTrainSpatialRunHost(static_cast<int>(p.n),
+                                   static_cast<int>(p.c),
+                                   1,
+                                   static_cast<int>(p.h),
+                                   static_cast<int>(p.w),
+                                   b.x.data(),
+                                   b.y.data(),
+                                   b.scale.data(),
+                                   b.bias.data(),
+                                   1e-5,
+                                   true,
+                                   false,
+                                   b.mean.data(),
+                                   b.inv_var.data(),
+                                   static_cast<double*>(nullptr),
+                                   static_cast<double*>(nullptr),
+                                   0.1,
+                                   layout);
+}
+
+void HostBwd(const Problem& p, Buffers& b, miopenTensorLayout_t layout)
+{
+    miopenBNBwdSpatialRunHost(static_cast<int>(p.n),
+                              static_cast<int>(p.c),
+                              1,
+                              static_cast<int>(p.h),
+                              static_cast<int>(p.w),
+                              b.x.data(),
+                              b.dy.data(),
+                              b.dx.data(),
+                              b.scale.data(),
+                              b.dscale.data(),
+                              b.dbias.data(),
+                              1e-5,
+                              true,
+                              b.mean.data(),
+                              b.inv_var.data(),
+                              layout);
+}
+
+template <class F>
+double Measure(const char* name, const Problem& p, F f)
+{
+    f(); // warm-up
+    auto runs       = 0;
+    const auto from = std::chrono::steady_clock::now();
+    auto seconds    = 0.0;
+    do
+    {
+        f();
+        ++runs;
+        seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - from).count();
+    } while(seconds < 1.0);
+
+    const auto rate = p.Elements() * runs / seconds;
+    std::cout << std::left << std::setw(24) << name << std::fixed << std::setprecision(2)
+              << std::setw(10) << rate / 1e6 << " Melem/s" << std::endl;
+    return rate;
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    auto p = Problem{32, 64, 112, 112};
+    if(argc > 4)
+    {
+        p = Problem{std::strtoul(argv[1], nullptr, 10),
+                    std::strtoul(argv[2], nullptr, 10),
+                    std::strtoul(argv[3], nullptr, 10),
+                    std::strtoul(argv[4], nullptr, 10)};
+    }
+    std::cout << "n=" << p.n << " c=" << p.c << " h=" << p.h << " w=" << p.w << std::endl;
+
+    auto b           = Buffers{p};
+    const auto fwd   = Measure("serial fwd train", p, [&] { SerialFwdTrain(p, b); });
+    const auto bwd   = Measure("serial bwd", p, [&] { SerialBwd(p, b); });
+    const auto fwd_n = Measure("NCHW fwd train", p, [&] { HostFwdTrain(p, b, miopenTensorNCHW); });
+    const auto bwd_n = Measure("NCHW bwd", p, [&] { HostBwd(p, b, miopenTensorNCHW); });
+    const auto fwd_h = Measure("NHWC fwd train", p, [&] { HostFwdTrain(p, b, miopenTensorNHWC); });
+    const auto bwd_h = Measure("NHWC bwd", p, [&] { HostBwd(p, b, miopenTensorNHWC); });
+    std::cout << std::setprecision(1) << "speedup fwd " << fwd_n / fwd << "x (NHWC " << fwd_h / fwd
+              << "x), bwd " << bwd_n / bwd << "x (NHWC " << bwd_h / bwd << "x)" << std::endl;
+    return EXIT_SUCCESS;
+}
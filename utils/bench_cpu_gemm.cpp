@@ -0,0 +1,132 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+/// Measures the host GEMM used by the driver and test references, in GFLOP/s.
+///
+/// Usage: bench_cpu_gemm [m n k]
+///
+/// "naive" is the triple loop the references used to run. It is skipped for large problems
+/// because it takes minutes there.
+
+#include <miopen/cpu_gemm.hpp>
+
+#include <half.hpp>
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace {
+
+template <class T>
+std::vector<T> RandomMatrix(std::size_t size)
+{
+    auto gen    = std::mt19937{};
+    auto dist   = std::uniform_real_distribution<float>{-1.0f, 1.0f};
+    auto result = std::vector<T>(size);
+    for(auto& x : result)
+        x = static_cast<T>(dist(gen));
+    return result;
+}
+
+template <class T>
+void NaiveGemm(std::size_t m, std::size_t n, std::size_t k, const T* a, const T* b, T* c)
+{
+    for(std::size_t i = 0; i < m; ++i)
+    {
+        for(std::size_t j = 0; j < n; ++j)
+        {
+            auto sum = T{0};
+            for(std::size_t p = 0; p < k; ++p)
+                sum += a[i * k + p] * b[p * n + j];
+            c[i * n + j] = sum;
+        }
+    }
+}
+
+template <class F>
+void Measure(const char* name, std::size_t m, std::size_t n, std::size_t k, F f)
+{
+    f(); // warm-up
+    auto runs       = 0;
+    const auto from = std::chrono::steady_clock::now();
+    auto seconds    = 0.0;
+    do
+    {
+        f();
+        ++runs;
+        seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - from).count();
+    } while(seconds < 1.0);
+
+    std::cout << std::left << std::setw(24) << name << std::fixed << std::setprecision(2)
+              << std::setw(10) << 2.0 * m * n * k * runs / seconds / 1e9 << " GFLOP/s"
+              << std::endl;
+}
+
+template <class Tacc, class T>
+void MeasureCpuGemm(const char* name, std::size_t m, std::size_t n, std::size_t k)
+{
+    const auto a = RandomMatrix<T>(m * k);
+    const auto b = RandomMatrix<T>(k * n);
+    auto c       = std::vector<T>(m * n);
+    Measure(name, m, n, k, [&] {
+        miopen::CpuGemm<Tacc>(
+            false, false, m, n, k, 1.0, a.data(), k, b.data(), n, 0.0, c.data(), n);
+    });
+}
+
+template <class T>
+void MeasureNaive(const char* name, std::size_t m, std::size_t n, std::size_t k)
+{
+    const auto a = RandomMatrix<T>(m * k);
+    const auto b = RandomMatrix<T>(k * n);
+    auto c       = std::vector<T>(m * n);
+    Measure(name, m, n, k, [&] { NaiveGemm(m, n, k, a.data(), b.data(), c.data()); });
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    const auto m = argc > 3 ? std::strtoul(argv[1], nullptr, 10) : 1024ul;
+    const auto n = argc > 3 ? std::strtoul(argv[2], nullptr, 10) : 1024ul;
+    const auto k = argc > 3 ? std::strtoul(argv[3], nullptr, 10) : 1024ul;
+    std::cout << "m=" << m << " n=" << n << " k=" << k << std::endl;
+
+    if(2.0 * m * n * k <= 4.0e9)
+    {
+        MeasureNaive<float>("naive float", m, n, k);
+        MeasureNaive<double>("naive double", m, n, k);
+    }
+    MeasureCpuGemm<float, float>("CpuGemm float", m, n, k);
+    MeasureCpuGemm<double, double>("CpuGemm double", m, n, k);
+    MeasureCpuGemm<float, half_float::half>("CpuGemm half/float", m, n, k);
+    MeasureCpuGemm<double, float>("CpuGemm float/double", m, n, k);
+    return EXIT_SUCCESS;
+}
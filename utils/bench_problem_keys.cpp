@@ -0,0 +1,113 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+/// Measures how many convolution problem keys can be built per second.
+///
+/// Usage: bench_problem_keys [iterations]
+///
+/// "ostringstream" composes the db key the way it used to be done, "KeyBuilder" composes the
+/// same key in a stack buffer, "cached" copies the keys a ProblemDescription built once.
+
+#include <miopen/conv/problem_description.hpp>
+#include <miopen/key_builder.hpp>
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+namespace {
+
+using miopen::conv::ProblemDescription;
+
+std::string StreamKey(const ProblemDescription& p)
+{
+    std::ostringstream ss;
+    ss << p.GetInChannels() << '-' << p.GetInHeight() << '-' << p.GetInWidth() << '-'
+       << p.GetWeightsHeight() << 'x' << p.GetWeightsWidth() << '-' << p.GetOutChannels() << '-'
+       << p.GetOutHeight() << '-' << p.GetOutWidth() << '-' << p.GetInBatchSize() << '-'
+       << p.GetPadH() << 'x' << p.GetPadW() << '-' << p.GetKernelStrideH() << 'x'
+       << p.GetKernelStrideW() << '-' << p.GetDilationH() << 'x' << p.GetDilationW() << '-'
+       << p.GetBias() << '-' << p.GetInLayout() << '-'
+       << miopen::EncodeDataTypesForKey(
+              p.GetInDataType(), p.GetWeightsDataType(), p.GetOutDataType())
+       << "-F";
+    return ss.str();
+}
+
+std::string BuilderKey(const ProblemDescription& p)
+{
+    miopen::KeyBuilder key;
+    key << p.GetInChannels() << '-' << p.GetInHeight() << '-' << p.GetInWidth() << '-'
+        << p.GetWeightsHeight() << 'x' << p.GetWeightsWidth() << '-' << p.GetOutChannels() << '-'
+        << p.GetOutHeight() << '-' << p.GetOutWidth() << '-' << p.GetInBatchSize() << '-'
+        << p.GetPadH() << 'x' << p.GetPadW() << '-' << p.GetKernelStrideH() << 'x'
+        << p.GetKernelStrideW() << '-' << p.GetDilationH() << 'x' << p.GetDilationW() << '-'
+        << p.GetBias() << '-' << p.GetInLayout() << '-'
+        << miopen::EncodeDataTypesForKey(
+               p.GetInDataType(), p.GetWeightsDataType(), p.GetOutDataType())
+        << "-F";
+    return key.Str();
+}
+
+std::string CachedKey(const ProblemDescription& p) { return p.BuildConfKey().ToString(); }
+
+template <class F>
+void Measure(const char* name, const ProblemDescription& problem, std::size_t iterations, F f)
+{
+    auto length     = std::size_t{0};
+    const auto from = std::chrono::steady_clock::now();
+    for(std::size_t i = 0; i < iterations; ++i)
+        length += f(problem).size();
+    const auto to      = std::chrono::steady_clock::now();
+    const auto seconds = std::chrono::duration<double>(to - from).count();
+
+    // length is printed so that the loop isn't optimized away.
+    std::cout << std::left << std::setw(16) << name << std::fixed << std::setprecision(2)
+              << std::setw(10) << iterations / seconds / 1e6 << " M keys/s (" << length
+              << " chars)" << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    const auto iterations = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 1000000ul;
+
+    const auto in      = miopen::TensorDescriptor{miopenHalf, {256, 1024, 14, 14}};
+    const auto weights = miopen::TensorDescriptor{miopenHalf, {256, 1024, 1, 1}};
+    const auto out     = miopen::TensorDescriptor{miopenHalf, {256, 256, 14, 14}};
+    const auto conv    = miopen::ConvolutionDescriptor{{0, 0}, {1, 1}, {1, 1}};
+    const auto problem =
+        ProblemDescription{in, weights, out, conv, miopen::conv::Direction::Forward};
+
+    Measure("ostringstream", problem, iterations, StreamKey);
+    Measure("KeyBuilder", problem, iterations, BuilderKey);
+    Measure("cached", problem, iterations, CachedKey);
+    return EXIT_SUCCESS;
+}
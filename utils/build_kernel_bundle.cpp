@@ -0,0 +1,424 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+/// Builds a precompiled kernel bundle (.kdb) for a target without a GPU, from MIOpenDriver
+/// command lines such as the ones logged with MIOPEN_ENABLE_LOGGING_CMD=1 or listed in
+/// test/perf_models/*.txt.
+///
+/// Usage: build_kernel_bundle --arch <arch> --num-cu <N> [--jobs N] [--top-k K]
+///                            [--output <file.kdb>] <commands.txt>...
+///
+/// For every convolution and direction the tool asks the library for the solutions immediate
+/// mode would return (find-db records first, then the fallback heuristics) and compiles the
+/// first K of them, all of them by default. With a find-db hit these are the solutions find mode
+/// loads as well. Compiled programs end up in a scratch user kernel cache, which is then copied
+/// to the output, by default <arch>_<num_cu>.kdb as expected next to the system find-db.
+///
+/// Needs the library to be built with MIOPEN_BACKEND=HIPNOGPU.
+
+#include <miopen/binary_cache.hpp>
+#include <miopen/convolution.hpp>
+#include <miopen/conv/problem_description.hpp>
+#include <miopen/errors.hpp>
+#include <miopen/execution_context.hpp>
+#include <miopen/handle.hpp>
+#include <miopen/solver_id.hpp>
+#include <miopen/tensor.hpp>
+#include <miopen/thread_pool.hpp>
+#include <miopen/tmp_dir.hpp>
+
+#include <boost/filesystem.hpp>
+#include <boost/optional.hpp>
+
+#include <atomic>
+#include <cstdlib>
+#include <exception>
+#include <fstream>
+#include <future>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using miopen::conv::Direction;
+
+// Long names of the driver flags describing a convolution, by the short ones.
+const std::map<std::string, std::string>& GetFlagNames()
+{
+    static const auto names = std::map<std::string, std::string>{
+        {"n", "batchsize"},
+        {"c", "in_channels"},
+        {"!", "in_d"},
+        {"H", "in_h"},
+        {"W", "in_w"},
+        {"k", "out_channels"},
+        {"@", "fil_d"},
+        {"y", "fil_h"},
+        {"x", "fil_w"},
+        {"#", "conv_stride_d"},
+        {"u", "conv_stride_h"},
+        {"v", "conv_stride_w"},
+        {"$", "pad_d"},
+        {"p", "pad_h"},
+        {"q", "pad_w"},
+        {"^", "dilation_d"},
+        {"l", "dilation_h"},
+        {"j", "dilation_w"},
+        {"%", "trans_output_pad_d"},
+        {"Y", "trans_output_pad_h"},
+        {"X", "trans_output_pad_w"},
+        {"g", "group_count"},
+        {"m", "mode"},
+        {"z", "pad_mode"},
+        {"_", "spatial_dim"},
+        {"F", "forw"},
+        {"I", "in_layout"},
+        {"O", "out_layout"},
+        {"f", "fil_layout"},
+    };
+    return names;
+}
+
+struct DriverCommand
+{
+    miopenDataType_t type;
+    std::map<std::string, std::string> flags;
+
+    int Int(const std::string& name, int fallback) const
+    {
+        const auto flag = flags.find(name);
+        return flag == flags.end() ? fallback : std::stoi(flag->second);
+    }
+
+    std::string Str(const std::string& name, const std::string& fallback) const
+    {
+        const auto flag = flags.find(name);
+        return flag == flags.end() ? fallback : flag->second;
+    }
+};
+
+/// Returns none for lines that are not convolution driver commands.
+boost::optional<DriverCommand> ParseCommand(const std::string& line)
+{
+    auto tokens = std::vector<std::string>{};
+    {
+        auto ss    = std::istringstream{line};
+        auto token = std::string{};
+        while(ss >> token)
+            tokens.push_back(token);
+    }
+
+    static const auto types = std::map<std::string, miopenDataType_t>{
+        {"conv", miopenFloat}, {"convfp16", miopenHalf}, {"convbfp16", miopenBFloat16}};
+
+    auto i = std::size_t{0};
+    while(i < tokens.size() && types.count(tokens[i]) == 0)
+        ++i;
+    if(i == tokens.size())
+        return boost::none;
+
+    auto command = DriverCommand{types.at(tokens[i]), {}};
+    for(++i; i + 1 < tokens.size(); i += 2)
+    {
+        const auto& flag = tokens[i];
+        if(flag.size() > 2 && flag.compare(0, 2, "--") == 0)
+        {
+            command.flags[flag.substr(2)] = tokens[i + 1];
+        }
+        else if(flag.size() == 2 && flag[0] == '-')
+        {
+            const auto name = GetFlagNames().find(flag.substr(1));
+            if(name != GetFlagNames().end())
+                command.flags[name->second] = tokens[i + 1];
+        }
+        else
+        {
+            MIOPEN_THROW("Unexpected token " + flag + " in " + line);
+        }
+    }
+    return command;
+}
+
+miopenTensorLayout_t GetLayout(const std::string& layout)
+{
+    static const auto layouts = std::map<std::string, miopenTensorLayout_t>{
+        {"NCHW", miopenTensorNCHW},
+        {"NHWC", miopenTensorNHWC},
+        {"NCDHW", miopenTensorNCDHW},
+        {"NDHWC", miopenTensorNDHWC},
+    };
+    const auto found = layouts.find(layout);
+    if(found == layouts.end())
+        MIOPEN_THROW("Unsupported layout " + layout);
+    return found->second;
+}
+
+/// Mirrors MIOpenDriver and the Make*CtxAndProblem helpers of the convolution API.
+std::vector<miopen::conv::ProblemDescription> MakeProblems(const DriverCommand& cmd)
+{
+    const auto spatial_dim = cmd.Int("spatial_dim", 2);
+    if(spatial_dim != 2 && spatial_dim != 3)
+        MIOPEN_THROW("Unsupported spatial_dim " + std::to_string(spatial_dim));
+    const auto is_3d = spatial_dim == 3;
+
+    const auto spatial = [&](const std::string& prefix, int fallback) {
+        auto values = std::vector<int>{};
+        if(is_3d)
+            values.push_back(cmd.Int(prefix + "_d", fallback));
+        values.push_back(cmd.Int(prefix + "_h", fallback));
+        values.push_back(cmd.Int(prefix + "_w", fallback));
+        return values;
+    };
+
+    const auto group_count = std::max(cmd.Int("group_count", 1), 1);
+    const auto in_c        = cmd.Int("in_channels", 3);
+    const auto out_k       = cmd.Int("out_channels", 32);
+    const auto is_trans    = cmd.Str("mode", "conv") == "trans";
+    const auto mode        = is_trans ? miopenTranspose : miopenConvolution;
+
+    const auto pad_mode_name = cmd.Str("pad_mode", "default");
+    const auto pad_mode      = pad_mode_name == "same"    ? miopenPaddingSame
+                               : pad_mode_name == "valid" ? miopenPaddingValid
+                                                          : miopenPaddingDefault;
+
+    auto in_lens = std::vector<int>{cmd.Int("batchsize", 100), in_c};
+    for(const auto len : spatial("in", 32))
+        in_lens.push_back(len);
+
+    auto wei_lens = is_trans ? std::vector<int>{in_c, out_k / group_count}
+                             : std::vector<int>{out_k, in_c / group_count};
+    for(const auto len : spatial("fil", 3))
+        wei_lens.push_back(len);
+
+    const auto default_layout = std::string{is_3d ? "NCDHW" : "NCHW"};
+    const auto in_layout      = cmd.Str("in_layout", default_layout);
+    const auto fil_layout     = cmd.Str("fil_layout", in_layout);
+    const auto out_layout     = cmd.Str("out_layout", in_layout);
+
+    const auto conv = miopen::ConvolutionDescriptor{static_cast<std::size_t>(spatial_dim),
+                                                    mode,
+                                                    pad_mode,
+                                                    spatial("pad", 0),
+                                                    spatial("conv_stride", 1),
+                                                    spatial("dilation", 1),
+                                                    spatial("trans_output_pad", 0),
+                                                    group_count};
+
+    const auto x = miopen::TensorDescriptor{cmd.type, GetLayout(in_layout), in_lens};
+    const auto w = miopen::TensorDescriptor{cmd.type, GetLayout(fil_layout), wei_lens};
+    const auto y = conv.GetForwardOutputTensorWithLayout(x, w, out_layout, cmd.type);
+
+    const auto forw = cmd.Int("forw", 0);
+    auto problems   = std::vector<miopen::conv::ProblemDescription>{};
+
+    const auto add = [&](const miopen::TensorDescriptor& in,
+                         const miopen::TensorDescriptor& out,
+                         Direction direction) {
+        problems.push_back(miopen::conv::ProblemDescription{in, w, out, conv, direction});
+    };
+
+    if(forw == 0 || (forw & 1) != 0)
+    {
+        if(is_trans)
+            add(y, x, Direction::BackwardData);
+        else
+            add(x, y, Direction::Forward);
+    }
+    if(forw == 0 || (forw & 2) != 0)
+    {
+        if(is_trans)
+            add(x, y, Direction::Forward);
+        else
+            add(y, x, Direction::BackwardData);
+    }
+    if(forw == 0 || (forw & 4) != 0)
+    {
+        if(is_trans)
+            add(x, y, Direction::BackwardWeights);
+        else
+            add(y, x, Direction::BackwardWeights);
+    }
+    return problems;
+}
+
+struct Options
+{
+    std::string arch;
+    std::size_t num_cu = 0;
+    std::size_t jobs   = std::max(std::thread::hardware_concurrency(), 1u);
+    std::size_t top_k  = 0; // all
+    std::string output;
+    std::vector<std::string> inputs;
+};
+
+thread_local std::unique_ptr<miopen::Handle> thread_handle;
+
+/// Compiles the solutions of the problem with the handle of the current worker thread.
+/// Returns the number of compiled solutions.
+std::size_t CompileProblem(const Options& options, const miopen::conv::ProblemDescription& problem)
+{
+    auto& handle = *thread_handle;
+    auto ctx     = miopen::ExecutionContext{&handle};
+    ctx.DetectRocm();
+    problem.SetupFloats(ctx);
+
+    const auto& conv     = problem.GetConv();
+    const auto max_count = options.top_k == 0 ? std::size_t{1024} : options.top_k;
+    const auto solutions = conv.GetSolutions(ctx, problem, max_count, nullptr);
+
+    for(const auto& solution : solutions)
+        conv.CompileSolution(ctx, problem, miopen::solver::Id{solution.solution_id});
+    return solutions.size();
+}
+
+int Run(const Options& options)
+{
+    // Everything compiled by the library goes to the scratch user kernel cache.
+    const auto cache = miopen::TmpDir{"kernel_bundle"};
+    miopen::SetUserCachePath(cache.path);
+
+    auto problems = std::vector<miopen::conv::ProblemDescription>{};
+    auto keys     = std::map<std::string, std::size_t>{};
+    for(const auto& input : options.inputs)
+    {
+        auto file = std::ifstream{input};
+        if(!file)
+            MIOPEN_THROW("Unable to open " + input);
+
+        auto line = std::string{};
+        while(std::getline(file, line))
+        {
+            const auto command = ParseCommand(line);
+            if(!command)
+                continue;
+            for(auto& problem : MakeProblems(*command))
+            {
+                // Networks repeat layers, there is no need to compile them twice.
+                if(keys.emplace(problem.BuildConfKey().ToString() +
+                                    std::to_string(static_cast<int>(problem.GetDirection())),
+                                problems.size())
+                       .second)
+                    problems.push_back(std::move(problem));
+            }
+        }
+    }
+    std::cout << "Read " << problems.size() << " unique problems" << std::endl;
+
+    auto db_basename = std::string{};
+    auto compiled    = std::atomic<std::size_t>{0};
+    auto failed      = std::atomic<std::size_t>{0};
+    {
+        const auto init = [&]() {
+            // Host solvers are off for a handle with a target device, as they would shadow
+            // the kernels the bundle should contain.
+            thread_handle = std::make_unique<miopen::Handle>();
+            thread_handle->SetTargetDevice(options.arch, options.num_cu);
+        };
+        auto pool    = miopen::ThreadPool{options.jobs, init};
+        auto results = std::vector<std::future<void>>{};
+        for(const auto& problem : problems)
+        {
+            results.push_back(pool.Submit([&]() {
+                try
+                {
+                    compiled += CompileProblem(options, problem);
+                }
+                catch(const std::exception& ex)
+                {
+                    ++failed;
+                    std::cerr << "Skipping " << problem.BuildConfKey().ToString() << ": "
+                              << ex.what() << std::endl;
+                }
+            }));
+        }
+        for(auto& result : results)
+            result.get();
+
+        db_basename = pool.Submit([]() { return thread_handle->GetDbBasename(); }).get();
+    }
+
+    const auto ukdb = cache.path / (db_basename + ".ukdb");
+    if(!boost::filesystem::exists(ukdb))
+        MIOPEN_THROW("Nothing was compiled to " + ukdb.string() +
+                     ", is the kernel cache enabled in this build?");
+
+    const auto output = options.output.empty() ? db_basename + ".kdb" : options.output;
+    boost::filesystem::copy_file(ukdb, output, boost::filesystem::copy_option::overwrite_if_exists);
+    std::cout << "Compiled " << compiled << " solutions, " << failed << " problems failed"
+              << std::endl
+              << "Saved " << boost::filesystem::file_size(output) << " bytes to " << output
+              << std::endl;
+    return failed == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    auto options = Options{};
+    for(auto i = 1; i < argc; ++i)
+    {
+        const auto arg       = std::string{argv[i]};
+        const auto has_value = i + 1 < argc;
+        if(arg == "--arch" && has_value)
+            options.arch = argv[++i];
+        else if(arg == "--num-cu" && has_value)
+            options.num_cu = std::strtoul(argv[++i], nullptr, 10);
+        else if(arg == "--jobs" && has_value)
+            options.jobs = std::strtoul(argv[++i], nullptr, 10);
+        else if(arg == "--top-k" && has_value)
+            options.top_k = std::strtoul(argv[++i], nullptr, 10);
+        else if(arg == "--output" && has_value)
+            options.output = argv[++i];
+        else
+            options.inputs.push_back(arg);
+    }
+
+    if(options.arch.empty() || options.num_cu == 0 || options.inputs.empty())
+    {
+        std::cerr << "Usage: " << argv[0]
+                  << " --arch <arch> --num-cu <N> [--jobs N] [--top-k K] [--output <file.kdb>]"
+                     " <commands.txt>..."
+                  << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    try
+    {
+        return Run(options);
+    }
+    catch(const std::exception& ex)
+    {
+        // Both the library errors and the standard ones, such as a malformed number in a command.
+        std::cerr << ex.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+}
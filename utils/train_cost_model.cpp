@@ -0,0 +1,212 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+/// Trains the immediate mode fallback cost model from a find-db text file and
+/// reports how well it ranks solvers on problems excluded from training.
+///
+/// Usage: train_cost_model <arch>.<backend>.fdb.txt [output.cost.model] [--holdout N]
+///
+/// Every N-th problem (by key hash) is held out for evaluation, then the final
+/// model is trained on all problems. The default output is <arch>.cost.model
+/// next to the input, which is where the library looks for it.
+
+#include <miopen/conv/heuristics/cost_model.hpp>
+#include <miopen/errors.hpp>
+
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+using miopen::ai::cost_model::Evaluation;
+using miopen::ai::cost_model::Model;
+using miopen::ai::cost_model::Sample;
+
+std::uint64_t Fnv1a(const std::string& str)
+{
+    auto hash = std::uint64_t{14695981039346656037ull};
+    for(const auto c : str)
+    {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+/// The model ranks only the solvers it knows, and a problem tells something about a ranking
+/// only if at least two of them were measured. Both rankings are scored on these problems and
+/// solvers only, so that their results can be compared.
+std::vector<Sample> GetComparableSamples(const Model& model, const std::vector<Sample>& samples)
+{
+    auto comparable = std::vector<Sample>{};
+    for(const auto& sample : samples)
+    {
+        if(miopen::ai::cost_model::ExtractFeatures(sample.key).empty())
+            continue;
+        auto known = Sample{sample.key, {}};
+        for(const auto& solver_time : sample.times)
+        {
+            if(model.HasSolver(solver_time.first))
+                known.times.insert(solver_time);
+        }
+        if(known.times.size() >= 2)
+            comparable.push_back(std::move(known));
+    }
+    return comparable;
+}
+
+/// Baseline that doesn't look at the problem at all: solvers are ranked by the
+/// number of training problems they have won.
+Evaluation EvaluateStaticRanking(const std::vector<Sample>& train, const std::vector<Sample>& test)
+{
+    auto wins = std::map<std::string, std::size_t>{};
+    for(const auto& sample : train)
+    {
+        auto best = sample.times.begin();
+        for(auto it = sample.times.begin(); it != sample.times.end(); ++it)
+            if(it->second < best->second)
+                best = it;
+        ++wins[best->first];
+    }
+
+    auto eval = Evaluation{};
+    for(const auto& sample : test)
+    {
+        if(sample.times.size() < 2)
+            continue;
+        auto best_time   = sample.times.begin()->second;
+        auto chosen      = sample.times.begin();
+        auto chosen_wins = std::size_t{0};
+        for(auto it = sample.times.begin(); it != sample.times.end(); ++it)
+        {
+            best_time       = std::min(best_time, it->second);
+            const auto w_it = wins.find(it->first);
+            const auto w    = w_it == wins.end() ? 0 : w_it->second;
+            if(w > chosen_wins)
+            {
+                chosen      = it;
+                chosen_wins = w;
+            }
+        }
+        const auto regret = static_cast<double>(chosen->second) / best_time - 1.0;
+        ++eval.problems;
+        if(chosen->second <= best_time)
+            ++eval.top1;
+        eval.mean_regret += regret;
+        eval.max_regret = std::max(eval.max_regret, regret);
+    }
+    if(eval.problems != 0)
+        eval.mean_regret /= eval.problems;
+    return eval;
+}
+
+void Report(const std::string& name, const Evaluation& eval)
+{
+    std::cout << std::left << std::setw(16) << name << " problems: " << std::setw(8)
+              << eval.problems << " top-1: " << std::fixed << std::setprecision(2)
+              << std::setw(7) << 100.0 * eval.Top1Accuracy() << "% mean regret: " << std::setw(7)
+              << 100.0 * eval.mean_regret << "% max regret: " << 100.0 * eval.max_regret << "%"
+              << std::endl;
+}
+
+std::string DefaultOutput(const std::string& input)
+{
+    const auto slash = input.find_last_of('/');
+    const auto dir   = slash == std::string::npos ? std::string{} : input.substr(0, slash + 1);
+    const auto name  = input.substr(dir.size());
+    return dir + name.substr(0, name.find('.')) + ".cost.model";
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    auto args    = std::vector<std::string>{};
+    auto holdout = 5ul;
+    for(auto i = 1; i < argc; ++i)
+    {
+        const auto arg = std::string{argv[i]};
+        if(arg == "--holdout" && i + 1 < argc)
+            holdout = std::strtoul(argv[++i], nullptr, 10);
+        else
+            args.push_back(arg);
+    }
+
+    if(args.empty() || args.size() > 2)
+    {
+        std::cerr << "Usage: " << argv[0]
+                  << " <arch>.<backend>.fdb.txt [output.cost.model] [--holdout N]" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    try
+    {
+        auto file = std::ifstream{args[0]};
+        if(!file)
+        {
+            std::cerr << "Unable to open " << args[0] << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        const auto samples = miopen::ai::cost_model::ReadFindDb(file);
+        std::cout << "Read " << samples.size() << " problems from " << args[0] << std::endl;
+
+        if(holdout > 1)
+        {
+            auto train = std::vector<Sample>{};
+            auto test  = std::vector<Sample>{};
+            for(const auto& sample : samples)
+                (Fnv1a(sample.key) % holdout == 0 ? test : train).push_back(sample);
+
+            const auto model      = Model::Train(train);
+            const auto comparable = GetComparableSamples(model, test);
+            std::cout << "Held out " << test.size() << " problems, modeled "
+                      << model.GetSolverCount() << " solvers, " << comparable.size()
+                      << " problems have at least two of them" << std::endl;
+            Report("cost model", model.Evaluate(comparable));
+            Report("static ranking", EvaluateStaticRanking(train, comparable));
+        }
+
+        const auto output = args.size() > 1 ? args[1] : DefaultOutput(args[0]);
+        const auto model  = Model::Train(samples);
+        model.Save(output);
+        std::cout << "Saved " << model.GetSolverCount() << " solvers to " << output << std::endl;
+    }
+    catch(const miopen::Exception& ex)
+    {
+        std::cerr << ex.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}